@@ -0,0 +1,198 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Battery-backed cartridge RAM, a shared writable mapping of the .sav file. The
+// Cartridge is given data() as its RAM, so every write the game makes lands in the
+// page cache right away and survives the emulator crashing. A background thread
+// flushes the mapping to disk every FLUSH_MS, which bounds what an OS crash or a
+// power cut can lose, and the emulation thread never waits on the file.
+//
+// The file holds the raw RAM, like the .sav files of other emulators. A new or
+// short file is extended to the size the header asks for, with 0xFF.
+
+class BatteryRam
+{
+private:
+    uint8_t* view;
+    size_t view_size;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#endif
+
+    std::thread flusher;
+    std::mutex lock;
+    std::condition_variable wake;
+    bool stopping;
+
+    // Blocks until the dirty pages are on disk
+    void flush( void )
+    {
+#ifdef _WIN32
+        FlushViewOfFile( view, 0 );
+        FlushFileBuffers( file );
+#else
+        msync( view, view_size, MS_SYNC );
+#endif
+    }
+
+    void flush_loop( void )
+    {
+        std::unique_lock<std::mutex> guard( lock );
+        while ( !stopping ) {
+            wake.wait_for( guard, std::chrono::milliseconds( FLUSH_MS ) );
+            flush();
+        }
+    }
+
+public:
+    static constexpr int FLUSH_MS = 1000;
+
+    const char* error; // why open failed, null otherwise
+
+    BatteryRam( void )
+        : view( nullptr ), view_size( 0 ),
+#ifdef _WIN32
+          file( INVALID_HANDLE_VALUE ), mapping( nullptr ),
+#endif
+          stopping( false ), error( nullptr )
+    {
+    }
+
+    ~BatteryRam( void )
+    {
+        close();
+    }
+
+    BatteryRam( const BatteryRam& ) = delete;
+    BatteryRam& operator=( const BatteryRam& ) = delete;
+
+    // Maps size bytes of the file at path, creating it if needed, and starts the
+    // flusher. Returns false and sets error when the file can't be mapped.
+    bool open( const char* path, size_t size )
+    {
+        close();
+
+        size_t existing = 0;
+
+#ifdef _WIN32
+        file = CreateFileA( path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL,
+                            nullptr );
+        if ( file == INVALID_HANDLE_VALUE ) {
+            error = "Unable to open the save file";
+            return false;
+        }
+
+        LARGE_INTEGER length;
+        if ( GetFileSizeEx( file, &length ) ) {
+            existing = (size_t)length.QuadPart;
+        }
+
+        // Maps exactly size bytes, growing the file when it is shorter
+        mapping = CreateFileMappingA( file, nullptr, PAGE_READWRITE, 0, (DWORD)size, nullptr );
+        view = mapping ? (uint8_t*)MapViewOfFile( mapping, FILE_MAP_WRITE, 0, 0, size ) : nullptr;
+#else
+        int fd = ::open( path, O_RDWR | O_CREAT, 0644 );
+        if ( fd < 0 ) {
+            error = "Unable to open the save file";
+            return false;
+        }
+
+        struct stat st;
+        if ( !fstat( fd, &st ) ) {
+            existing = (size_t)st.st_size;
+        }
+
+        if ( existing < size && ftruncate( fd, (off_t)size ) ) {
+            ::close( fd );
+            error = "Unable to grow the save file";
+            return false;
+        }
+
+        void* mapped = mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+        ::close( fd );
+        view = mapped != MAP_FAILED ? (uint8_t*)mapped : nullptr;
+#endif
+
+        if ( !view ) {
+            close();
+            error = "Unable to map the save file";
+            return false;
+        }
+
+        view_size = size;
+        if ( existing < size ) {
+            memset( view + existing, 0xFF, size - existing );
+        }
+
+        stopping = false;
+        flusher = std::thread( &BatteryRam::flush_loop, this );
+
+        return true;
+    }
+
+    // Stops the flusher, flushes one last time and unmaps
+    void close( void )
+    {
+        if ( flusher.joinable() ) {
+            {
+                std::lock_guard<std::mutex> guard( lock );
+                stopping = true;
+            }
+            wake.notify_one();
+            flusher.join();
+        }
+
+#ifdef _WIN32
+        if ( view ) {
+            flush();
+            UnmapViewOfFile( view );
+        }
+        if ( mapping ) {
+            CloseHandle( mapping );
+        }
+        if ( file != INVALID_HANDLE_VALUE ) {
+            CloseHandle( file );
+        }
+        file = INVALID_HANDLE_VALUE;
+        mapping = nullptr;
+#else
+        if ( view ) {
+            flush();
+            munmap( view, view_size );
+        }
+#endif
+        view = nullptr;
+        view_size = 0;
+        error = nullptr;
+    }
+
+    bool is_open( void ) const
+    {
+        return view != nullptr;
+    }
+
+    uint8_t* data( void )
+    {
+        return view;
+    }
+
+    size_t size( void ) const
+    {
+        return view_size;
+    }
+};
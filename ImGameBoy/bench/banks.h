@@ -0,0 +1,124 @@
+#pragma once
+#include <vector>
+#include "bench.h"
+#include "../cartridge.h"
+#include "../interpreter.h"
+#include "../blockcache.h"
+#include "../jit.h"
+
+// banks: a 2MB MBC5 cartridge whose bank 0 loop selects one of 64 banks and jumps
+//        into it, ten instructions per bank switch, a few thousand switches per
+//        frame. Each core runs it once writing the same bank every time ("fixed")
+//        and once switching on every pass ("switch"), so the difference is the cost
+//        of the switches themselves.
+
+static const uint8_t bench_banks_loop[] = {
+    0x0C, // 0150 INC C
+    0x79, // 0151 LD A,C
+    0xE6, 0x3F, // 0152 AND 3Fh
+    0x3C, // 0154 INC A, banks 1-64
+    0xEA, 0x00, 0x20, // 0155 LD (2000h),A
+    0xC3, 0x00, 0x40, // 0158 JP 4000h
+};
+
+static const uint8_t bench_banks_fixed[] = {
+    0x3E, 0x01, // 0152 LD A,01h
+    0x00, // 0154 NOP
+};
+
+static const uint8_t bench_banks_routine[] = {
+    0xFA, 0x10, 0x40, // 4000 LD A,(4010h), the bank number
+    0x80, // 4003 ADD A,B
+    0x47, // 4004 LD B,A
+    0xC3, 0x50, 0x01, // 4005 JP 0150h
+};
+
+static std::vector<uint8_t> bench_banks_rom( bool fixed )
+{
+    std::vector<uint8_t> rom( 128 * 0x4000, 0 );
+
+    memcpy( &rom[0x0150], bench_banks_loop, sizeof( bench_banks_loop ) );
+    if ( fixed ) {
+        memcpy( &rom[0x0152], bench_banks_fixed, sizeof( bench_banks_fixed ) );
+    }
+
+    for ( int bank = 1; bank < 128; bank++ ) {
+        memcpy( &rom[bank * 0x4000], bench_banks_routine, sizeof( bench_banks_routine ) );
+        rom[bank * 0x4000 + 0x10] = (uint8_t)bank;
+    }
+
+    return rom;
+}
+
+template <typename Core>
+static double bench_banks_mips( const char* name, bool fixed, uint64_t total, Core core )
+{
+    std::vector<uint8_t> rom = bench_banks_rom( fixed );
+    Memory* mem = new Memory();
+    Cartridge* cart = new Cartridge( rom.data(), rom.size(), Mbc::MBC5, 0 );
+    Registers r;
+    StepState sstate = StepState::RUN;
+
+    cart->attach( mem );
+    r.PC = 0x0150;
+
+    uint64_t executed = 0;
+    uint64_t cycles = 0;
+    Timer timer;
+
+    while ( executed < total ) {
+        int count = 0;
+        cycles += core( mem, &r, sstate, 70224, &count );
+        executed += count;
+    }
+
+    double elapsed = timer.seconds();
+    double mips = executed / elapsed / 1e6;
+
+    // One bank register write every ten instructions
+    printf( "%-8s %-6s %12llu instructions %8.3f s %10.2f MIPS %8.2f M writes/s (B=%02X)\n", name, fixed ? "fixed" : "switch",
+            (unsigned long long)executed, elapsed, mips, mips / 10, r.B );
+
+    delete cart;
+    delete mem;
+
+    return mips;
+}
+
+static void bench_banks( uint64_t total )
+{
+    printf( "banks: MBC5 2MB, %llu instructions per run\n", (unsigned long long)total );
+
+    double fixed = bench_banks_mips( "interp", true, total, Interpreter::run );
+    double switching = bench_banks_mips( "interp", false, total, Interpreter::run );
+    printf( "interp   switching runs at %.2fx\n", switching / fixed );
+
+    // The two ROMs differ in bank 0, which no write can invalidate, so each run starts
+    // with an empty cache
+    BlockCache* cache = new BlockCache();
+    auto blocks = [cache]( Memory* m, Registers* r, StepState& sstate, int budget, int* executed ) {
+        return cache->run( m, r, sstate, budget, executed );
+    };
+
+    fixed = bench_banks_mips( "blocks", true, total, blocks );
+    cache->flush();
+    switching = bench_banks_mips( "blocks", false, total, blocks );
+    printf( "blocks   switching runs at %.2fx\n", switching / fixed );
+
+    delete cache;
+
+#if GB_JIT
+    Jit* jit = new Jit();
+    if ( jit->available() ) {
+        auto native = [jit]( Memory* m, Registers* r, StepState& sstate, int budget, int* executed ) {
+            return jit->run( m, r, sstate, budget, executed );
+        };
+
+        fixed = bench_banks_mips( "jit", true, total, native );
+        jit->flush();
+        switching = bench_banks_mips( "jit", false, total, native );
+        printf( "jit      switching runs at %.2fx\n", switching / fixed );
+    }
+    delete jit;
+#endif
+}
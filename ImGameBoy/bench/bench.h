@@ -0,0 +1,33 @@
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "../memory.h"
+#include "../registers.h"
+#include "../bootrom.h"
+#include "../shared.h"
+
+// Loads up to 32kB of the cartridge at path into mem and maps the boot ROM over
+// 0x0000-0x00FF the same way Emulator does. A null path benchmarks the boot ROM alone.
+static bool bench_load( Memory* mem, const char* path )
+{
+    memset( mem->map, 0, sizeof( mem->map ) );
+
+    if ( path ) {
+        FILE* hFile = fopen( path, "rb" );
+        if ( !hFile ) {
+            fprintf( stderr, "Unable to open %s\n", path );
+            return false;
+        }
+        size_t read = fread( mem->rom, 1, sizeof( mem->rom ), hFile );
+        bool failed = ferror( hFile ) != 0;
+        fclose( hFile );
+        if ( failed || !read ) {
+            fprintf( stderr, "Unable to read %s\n", path );
+            return false;
+        }
+    }
+
+    memcpy( mem->map, bootrom, sizeof( bootrom ) );
+    return true;
+}
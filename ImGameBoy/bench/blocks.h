@@ -0,0 +1,67 @@
+#pragma once
+#include "bench.h"
+#include "../interpreter.h"
+#include "../blockcache.h"
+
+// Runs the flat Interpreter and the BlockCache over the same ROM and reports
+// millions of instructions per second for each. False when the ROM can't be read.
+
+template <typename Core>
+static bool bench_blocks_mips( const char* name, const char* rom, uint64_t total, Core core, double* mips )
+{
+    Memory* mem = new Memory();
+    Registers r;
+    StepState sstate = StepState::RUN;
+
+    if ( !bench_load( mem, rom ) ) {
+        delete mem;
+        return false;
+    }
+
+    uint64_t executed = 0;
+    uint64_t cycles = 0;
+    Timer timer;
+
+    while ( executed < total ) {
+        int count = 0;
+        cycles += core( mem, &r, sstate, 70224, &count );
+        executed += count;
+
+        // HALT and STOP park the debugger, the benchmark just keeps going
+        sstate = StepState::RUN;
+    }
+
+    double elapsed = timer.seconds();
+    *mips = executed / elapsed / 1e6;
+
+    printf( "%-8s %12llu instructions %8.3f s %10.2f MIPS %8.1fx realtime (PC=%04X)\n", name,
+            (unsigned long long)executed, elapsed, *mips, cycles / elapsed / 4194304.0, r.PC );
+
+    delete mem;
+
+    return true;
+}
+
+static bool bench_blocks( const char* rom, uint64_t total )
+{
+    printf( "blocks: %s, %llu instructions per core\n", rom ? rom : "bootrom", (unsigned long long)total );
+
+    BlockCache* cache = new BlockCache();
+
+    double imips, bmips;
+    bool ok = bench_blocks_mips( "interp", rom, total, Interpreter::run, &imips ) &&
+              bench_blocks_mips(
+                  "blocks", rom, total,
+                  [cache]( Memory* m, Registers* r, StepState& sstate, int budget, int* executed ) {
+                      return cache->run( m, r, sstate, budget, executed );
+                  },
+                  &bmips );
+
+    if ( ok ) {
+        printf( "speedup  %.2fx\n", bmips / imips );
+    }
+
+    delete cache;
+
+    return ok;
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include "bench.h"
+
+// bus: cost of the Memory page table against indexing map directly, on work RAM.
+//      "chase" makes every address depend on the byte read before it, so anything
+//      read8 put in front of the byte would be on the critical path. "stream" takes
+//      the addresses from a counter, like most loads and stores of a program, so
+//      only the added instructions count.
+
+static void bench_bus_fill( Memory* mem )
+{
+    for ( int i = 0; i < 0x2000; i++ ) {
+        mem->wram[i] = (uint8_t)( i * 13 );
+    }
+}
+
+static void bench_bus_report( const char* name, uint64_t accesses, double elapsed, uint32_t sum )
+{
+    printf( "%-8s %12llu accesses %8.3f s %10.2f M/s (sum=%08X)\n", name, (unsigned long long)accesses, elapsed,
+            accesses / elapsed / 1e6, sum );
+}
+
+// One read and one write per step, the next address from the byte read when chase
+// is set, from the step counter otherwise. Every walk gets a function of its own, so
+// the loops don't share registers and code placement with each other.
+#define BENCH_BUS_WALK( function, READ, WRITE )                                        \
+    static GB_NOINLINE void function( const char* name, Memory* mem, bool chase, uint64_t total ) \
+    {                                                                                  \
+        uint16_t address = 0xC000;                                                     \
+        uint32_t sum = 0;                                                              \
+        bench_bus_fill( mem );                                                         \
+        Timer timer;                                                                   \
+                                                                                       \
+        for ( uint64_t i = 0; i < total; i += 2 ) {                                    \
+            uint8_t value = READ( address );                                           \
+            sum += value;                                                              \
+            WRITE( address ^ 1, (uint8_t)sum );                                        \
+            uint32_t next = chase ? address * 5 + value + 1 : (uint32_t)i * 5 + 1;     \
+            address = 0xC000 | ( next & 0x1FFF );                                      \
+        }                                                                              \
+                                                                                       \
+        bench_bus_report( name, total, timer.seconds(), sum );                         \
+    }
+
+#define MAP_READ( a ) mem->map[a]
+#define MAP_WRITE( a, v ) mem->map[a] = v
+#define BUS_READ( a ) mem->read8( a )
+#define BUS_WRITE( a, v ) mem->write8( a, v )
+
+BENCH_BUS_WALK( bench_bus_map, MAP_READ, MAP_WRITE )
+BENCH_BUS_WALK( bench_bus_pages, BUS_READ, BUS_WRITE )
+
+#undef MAP_READ
+#undef MAP_WRITE
+#undef BUS_READ
+#undef BUS_WRITE
+#undef BENCH_BUS_WALK
+
+static void bench_bus( uint64_t total )
+{
+    printf( "bus: %llu reads and writes\n", (unsigned long long)total );
+
+    Memory* mem = new Memory();
+
+    bench_bus_map( "chase", mem, true, total );
+    bench_bus_pages( "bus", mem, true, total );
+    bench_bus_map( "stream", mem, false, total );
+    bench_bus_pages( "bus", mem, false, total );
+
+    delete mem;
+}
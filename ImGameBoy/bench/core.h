@@ -0,0 +1,88 @@
+#pragma once
+#include "bench.h"
+#include "../instruction.h"
+#include "../interpreter.h"
+
+// Runs the virtual Instruction table and the flat Interpreter over the same ROM
+// and reports millions of instructions per second for each. False when the ROM
+// can't be read.
+
+static int bench_core_virtual( Instruction** op, Memory* m, Registers* r, StepState& sstate, int budget, int* executed )
+{
+    int spent = 0;
+    int count = 0;
+
+    while ( spent < budget && sstate != StepState::STOP ) {
+        spent += op[m->fetch8( r->PC )]->execute( m, r );
+        count++;
+    }
+
+    *executed = count;
+    return spent;
+}
+
+static int bench_core_switch( Instruction** op, Memory* m, Registers* r, StepState& sstate, int budget, int* executed )
+{
+    return Interpreter::run( m, r, sstate, budget, executed );
+}
+
+static bool bench_core_mips( const char* name, const char* rom, uint64_t total,
+                             int ( *core )( Instruction**, Memory*, Registers*, StepState&, int, int* ), double* mips )
+{
+    Memory* mem = new Memory();
+    Registers r;
+    StepState sstate = StepState::RUN;
+
+    if ( !bench_load( mem, rom ) ) {
+        delete mem;
+        return false;
+    }
+
+    Instruction* op[0x100];
+    Instruction::create_table( op, sstate );
+
+    uint64_t executed = 0;
+    uint64_t cycles = 0;
+    Timer timer;
+
+    while ( executed < total ) {
+        int count = 0;
+        cycles += core( op, mem, &r, sstate, 70224, &count );
+        executed += count;
+
+        // HALT and STOP park the debugger, the benchmark just keeps going
+        sstate = StepState::RUN;
+    }
+
+    double elapsed = timer.seconds();
+    *mips = executed / elapsed / 1e6;
+
+    printf( "%-8s %12llu instructions %8.3f s %10.2f MIPS %8.1fx realtime (PC=%04X)\n", name,
+            (unsigned long long)executed, elapsed, *mips, cycles / elapsed / 4194304.0, r.PC );
+
+    for ( int i = 0; i < 0x100; i++ ) {
+        delete op[i];
+    }
+    delete mem;
+
+    return true;
+}
+
+static bool bench_core( const char* rom, uint64_t total )
+{
+    printf( "core: %s, %llu instructions per core\n", rom ? rom : "bootrom", (unsigned long long)total );
+
+    double vmips, smips;
+#if GB_COMPUTED_GOTO
+    const char* name = "goto";
+#else
+    const char* name = "switch";
+#endif
+    if ( !bench_core_mips( "virtual", rom, total, bench_core_virtual, &vmips ) ||
+         !bench_core_mips( name, rom, total, bench_core_switch, &smips ) ) {
+        return false;
+    }
+
+    printf( "speedup  %.2fx\n", smips / vmips );
+    return true;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include "bench.h"
+#include "../interpreter.h"
+
+// flags: MIPS of the flat Interpreter on a loop of ALU instructions whose flags are
+//        mostly overwritten before anything reads them. Build once with and once
+//        without GB_LAZY_FLAGS to compare eager and lazy flag evaluation.
+
+static const uint8_t bench_flags_loop[] = {
+    0x80, // ADD A,B
+    0x89, // ADC A,C
+    0x92, // SUB D
+    0xA3, // AND E
+    0xAC, // XOR H
+    0xB5, // OR L
+    0xB8, // CP B
+    0x3C, // INC A
+    0x05, // DEC B
+    0x0C, // INC C
+    0x07, // RLCA
+    0xC6, 0x13, // ADD A,13h
+    0x9B, // SBC A,E
+    0xCB, 0x11, // RL C
+    0xCB, 0x7F, // BIT 7,A
+    0x20, 0x00, // JR NZ,+0
+    0x18, 0x100 - 22, // JR loop
+};
+
+static void bench_flags( uint64_t total )
+{
+#ifdef GB_LAZY_FLAGS
+    printf( "flags: lazy, %llu instructions\n", (unsigned long long)total );
+#else
+    printf( "flags: eager, %llu instructions\n", (unsigned long long)total );
+#endif
+
+    Memory* mem = new Memory();
+    Registers r;
+    StepState sstate = StepState::RUN;
+
+    memset( mem->map, 0, sizeof( mem->map ) );
+    memcpy( &mem->map[0x0100], bench_flags_loop, sizeof( bench_flags_loop ) );
+    r.PC = 0x0100;
+
+    uint64_t executed = 0;
+    uint64_t cycles = 0;
+    Timer timer;
+
+    while ( executed < total ) {
+        int count = 0;
+        cycles += Interpreter::run( mem, &r, sstate, 70224, &count );
+        executed += count;
+    }
+
+    double elapsed = timer.seconds();
+    double mips = executed / elapsed / 1e6;
+
+    r.sync_flags();
+    printf( "%-8s %12llu instructions %8.3f s %10.2f MIPS %8.1fx realtime (AF=%04X)\n", "interp",
+            (unsigned long long)executed, elapsed, mips, cycles / elapsed / 4194304.0, r.AF );
+
+    delete mem;
+}
@@ -0,0 +1,223 @@
+#pragma once
+#include "bench.h"
+#include "blocks.h"
+#include "../cartridge.h"
+#include "../interpreter.h"
+#include "../jit.h"
+
+// jit:      MIPS of the flat Interpreter vs. the Jit, same loop as the blocks suite
+// jitcheck: runs the Jit one block at a time in lockstep with the Interpreter, each
+//           on its own copy of memory, and compares Registers after every block and
+//           memory after every frame. Stops at the first difference. Without a ROM
+//           it checks the boot ROM, which runs into empty memory after its 24k or so
+//           instructions, and then the cartridge of bench_jit_rom().
+
+#if GB_JIT
+
+static bool bench_jit( const char* rom, uint64_t total )
+{
+    printf( "jit: %s, %llu instructions per core\n", rom ? rom : "bootrom", (unsigned long long)total );
+
+    Jit* jit = new Jit();
+    if ( !jit->available() ) {
+        fprintf( stderr, "Unable to allocate the JIT code arena\n" );
+        delete jit;
+        return false;
+    }
+
+    double imips, jmips;
+    bool ok = bench_blocks_mips( "interp", rom, total, Interpreter::run, &imips ) &&
+              bench_blocks_mips(
+                  "jit", rom, total,
+                  [jit]( Memory* m, Registers* r, StepState& sstate, int budget, int* executed ) {
+                      return jit->run( m, r, sstate, budget, executed );
+                  },
+                  &jmips );
+
+    if ( ok ) {
+        printf( "speedup  %.2fx\n", jmips / imips );
+    }
+
+    delete jit;
+
+    return ok;
+}
+
+static const uint8_t bench_jit_loop[] = {
+    0x31, 0xFE, 0xFF, // 0150 LD SP,FFFEh
+    0x0C, // 0153 INC C
+    0x79, // 0154 LD A,C
+    0xE6, 0x0F, // 0155 AND 0Fh
+    0x3C, // 0157 INC A, banks 1-16
+    0xEA, 0x00, 0x20, // 0158 LD (2000h),A
+    0xCD, 0x00, 0x40, // 015B CALL 4000h
+    0xCD, 0x70, 0x01, // 015E CALL 0170h
+    0xC4, 0x70, 0x01, // 0161 CALL NZ,0170h
+    0x18, 0xED, // 0164 JR 0153h
+};
+
+static const uint8_t bench_jit_bits[] = {
+    0x21, 0x00, 0xC0, // 0170 LD HL,C000h
+    0x77, // 0173 LD (HL),A
+    0xCB, 0x36, // 0174 SWAP (HL)
+    0xCB, 0x06, // 0176 RLC (HL)
+    0xCB, 0x5E, // 0178 BIT 3,(HL)
+    0x28, 0x02, // 017A JR Z,017Eh
+    0xCB, 0xFA, // 017C SET 7,D
+    0xCB, 0x3A, // 017E SRL D
+    0xCB, 0x83, // 0180 RES 0,E
+    0xCB, 0x13, // 0182 RL E
+    0xD0, // 0184 RET NC
+    0xD5, // 0185 PUSH DE
+    0xE1, // 0186 POP HL
+    0xCB, 0x2C, // 0187 SRA H
+    0xC9, // 0189 RET
+};
+
+static const uint8_t bench_jit_routine[] = {
+    0xFA, 0x20, 0x40, // 4000 LD A,(4020h), the bank number
+    0x80, // 4003 ADD A,B
+    0x47, // 4004 LD B,A
+    0xCD, 0x10, 0x40, // 4005 CALL 4010h
+    0xC9, // 4008 RET
+    0, 0, 0, 0, 0, 0, 0,
+    0xCB, 0x10, // 4010 RL B
+    0x8A, // 4012 ADC A,D
+    0x57, // 4013 LD D,A
+    0xD8, // 4014 RET C
+    0x1C, // 4015 INC E
+    0xC0, // 4016 RET NZ
+    0xC9, // 4017 RET
+};
+
+// A 512kB MBC5 cartridge starting at 0x0150: its bank 0 loop switches to one of 16
+// banks on every pass, calls into it and from there on within the bank, then calls
+// a routine of CB operations on registers and (HL), conditional returns included
+static std::vector<uint8_t> bench_jit_rom( void )
+{
+    std::vector<uint8_t> rom( 32 * 0x4000, 0 );
+
+    memcpy( &rom[0x0150], bench_jit_loop, sizeof( bench_jit_loop ) );
+    memcpy( &rom[0x0170], bench_jit_bits, sizeof( bench_jit_bits ) );
+    for ( int bank = 1; bank < 32; bank++ ) {
+        memcpy( &rom[bank * 0x4000], bench_jit_routine, sizeof( bench_jit_routine ) );
+        rom[bank * 0x4000 + 0x20] = (uint8_t)bank;
+    }
+
+    return rom;
+}
+
+static void bench_jit_dump( const char* name, Registers* r )
+{
+    printf( "  %-6s AF=%04X BC=%04X DE=%04X HL=%04X SP=%04X PC=%04X\n", name, r->AF, r->BC, r->DE, r->HL, r->SP, r->PC );
+}
+
+static bool bench_jit_same( Registers* a, Registers* b )
+{
+    return a->AF == b->AF && a->BC == b->BC && a->DE == b->DE && a->HL == b->HL && a->SP == b->SP && a->PC == b->PC;
+}
+
+// Runs jit on jm and the Interpreter on im from the same registers r. Returns true
+// when both agreed for total instructions.
+static bool bench_jit_lockstep( const char* name, Jit* jit, Memory* jm, Memory* im, const Registers& r, uint64_t total )
+{
+    printf( "jitcheck: %s, %llu instructions\n", name, (unsigned long long)total );
+
+    Registers jr = r, ir = r;
+    StepState js = StepState::RUN, is = StepState::RUN;
+    bool ok = true;
+
+    uint64_t executed = 0;
+    uint64_t blocks = 0;
+    int frame = 0;
+
+    while ( ok && executed < total ) {
+        Registers before = jr;
+        int jcount = 0, icount = 0;
+
+        int spent = jit->run_block( jm, &jr, js, 70224, &jcount );
+        int ispent = Interpreter::run( im, &ir, is, spent, &icount );
+        ir.sync_flags();
+
+        if ( jcount != icount || spent != ispent || !bench_jit_same( &jr, &ir ) || js != is ) {
+            printf( "mismatch after block %llu at %04X, %llu instructions in\n", (unsigned long long)blocks, before.PC,
+                    (unsigned long long)executed );
+            printf( "  jit    %d instructions, %d cycles\n", jcount, spent );
+            printf( "  interp %d instructions, %d cycles\n", icount, ispent );
+            bench_jit_dump( "before", &before );
+            bench_jit_dump( "jit", &jr );
+            bench_jit_dump( "interp", &ir );
+            ok = false;
+            break;
+        }
+
+        executed += jcount;
+        blocks++;
+        frame += spent;
+
+        if ( frame >= 70224 ) {
+            frame = 0;
+            for ( int i = 0; i < 0x10000; i++ ) {
+                if ( jm->map[i] != im->map[i] ) {
+                    printf( "memory mismatch at %04X (jit %02X, interp %02X), %llu instructions in\n", i, jm->map[i],
+                            im->map[i], (unsigned long long)executed );
+                    ok = false;
+                    break;
+                }
+            }
+        }
+
+        // HALT and STOP park the debugger, the check just keeps going
+        js = is = StepState::RUN;
+    }
+
+    if ( ok ) {
+        printf( "ok       %llu instructions in %llu blocks (PC=%04X)\n", (unsigned long long)executed,
+                (unsigned long long)blocks, jr.PC );
+    }
+
+    return ok;
+}
+
+// Returns true when both cores agreed for total instructions on rom, or on the boot
+// ROM and bench_jit_rom() without one
+static bool bench_jit_check( const char* rom, uint64_t total )
+{
+    Jit* jit = new Jit();
+    if ( !jit->available() ) {
+        fprintf( stderr, "Unable to allocate the JIT code arena\n" );
+        delete jit;
+        return false;
+    }
+
+    Memory* jm = new Memory();
+    Memory* im = new Memory();
+    bool ok = bench_load( jm, rom ) && bench_load( im, rom ) &&
+              bench_jit_lockstep( rom ? rom : "bootrom", jit, jm, im, Registers(), total );
+
+    if ( ok && !rom ) {
+        std::vector<uint8_t> image = bench_jit_rom();
+        Cartridge* jcart = new Cartridge( image.data(), image.size(), Mbc::MBC5, 0 );
+        Cartridge* icart = new Cartridge( image.data(), image.size(), Mbc::MBC5, 0 );
+        memset( jm->map, 0, sizeof( jm->map ) );
+        memset( im->map, 0, sizeof( im->map ) );
+        jcart->attach( jm );
+        icart->attach( im );
+        jit->flush();
+
+        Registers r;
+        r.PC = 0x0150;
+        ok = bench_jit_lockstep( "MBC5 calls and CB operations", jit, jm, im, r, total );
+
+        delete icart;
+        delete jcart;
+    }
+
+    delete im;
+    delete jm;
+    delete jit;
+
+    return ok;
+}
+
+#endif
@@ -0,0 +1,165 @@
+#pragma once
+#include <vector>
+#include "bench.h"
+#include "../cartridge.h"
+#include "../interpreter.h"
+#include "../lockstep.h"
+
+// lockstep: many instances of a ROM with a different seed each, the way a search
+//           runs one game over and over. Bank 0 mixes the seed into B sixteen times
+//           with a branch on its low bits, so lanes split and meet again, and stores
+//           every other step to WRAM. The seed then picks bank 1 or 2, which pushes,
+//           SWAPs and pops, work only the scalar path does.
+//
+//           Lockstep is timed against the same instances each on its own Memory,
+//           Cartridge and Interpreter::run, the flat core Emulator runs with
+//           GB_CORE_SWITCH. Every lane has to end with the registers and memory of
+//           its scalar twin.
+
+static const int BENCH_LOCKSTEP_LANES = 512;
+
+static const uint8_t bench_lockstep_loop[] = {
+    0x31, 0xFE, 0xFF, // 0150 LD SP,FFFEh
+    0x21, 0x00, 0xC0, // 0153 LD HL,C000h
+    0xF0, 0x80, // 0156 LDH A,(80h), the seed
+    0x47, // 0158 LD B,A
+    0x0E, 0x10, // 0159 LD C,10h
+    0x78, // 015B LD A,B
+    0x81, // 015C ADD A,C
+    0xEE, 0x5A, // 015D XOR 5Ah
+    0x47, // 015F LD B,A
+    0xE6, 0x03, // 0160 AND 03h
+    0x28, 0x03, // 0162 JR Z,0167h
+    0x78, // 0164 LD A,B
+    0x22, // 0165 LD (HL+),A
+    0x04, // 0166 INC B
+    0x0D, // 0167 DEC C
+    0x20, 0xF1, // 0168 JR NZ,015Bh
+    0x78, // 016A LD A,B
+    0xE0, 0x80, // 016B LDH (80h),A
+    0xE6, 0x01, // 016D AND 01h
+    0x3C, // 016F INC A, bank 1 or 2
+    0xEA, 0x00, 0x20, // 0170 LD (2000h),A
+    0xC3, 0x00, 0x40, // 0173 JP 4000h
+};
+
+static const uint8_t bench_lockstep_routine[] = {
+    0xFA, 0x10, 0x40, // 4000 LD A,(4010h), the bank number
+    0x80, // 4003 ADD A,B
+    0xF5, // 4004 PUSH AF
+    0xCB, 0x37, // 4005 SWAP A
+    0x57, // 4007 LD D,A
+    0xF1, // 4008 POP AF
+    0x1C, // 4009 INC E
+    0xC3, 0x53, 0x01, // 400A JP 0153h
+};
+
+static std::vector<uint8_t> bench_lockstep_rom( void )
+{
+    std::vector<uint8_t> rom( 4 * 0x4000, 0 );
+
+    rom[0x0100] = 0xC3; // JP 0150h
+    rom[0x0101] = 0x50;
+    rom[0x0102] = 0x01;
+    memcpy( &rom[0x0150], bench_lockstep_loop, sizeof( bench_lockstep_loop ) );
+
+    for ( int bank = 1; bank < 4; bank++ ) {
+        memcpy( &rom[bank * 0x4000], bench_lockstep_routine, sizeof( bench_lockstep_routine ) );
+        rom[bank * 0x4000 + 0x10] = (uint8_t)bank;
+    }
+
+    return rom;
+}
+
+static uint8_t bench_lockstep_seed( size_t lane )
+{
+    return (uint8_t)( lane * 37 + 11 );
+}
+
+static bool bench_lockstep( uint64_t frames )
+{
+    const int FRAME = 70224;
+    std::vector<uint8_t> rom = bench_lockstep_rom();
+    size_t lanes = BENCH_LOCKSTEP_LANES;
+
+    printf( "lockstep: %zu instances, %llu frames each, %s lanes\n", lanes, (unsigned long long)frames,
+            GB_LOCKSTEP_AVX2 ? "AVX2" : GB_LOCKSTEP_SSE2 ? "SSE2" : "generic" );
+
+    // Scalar
+    std::vector<Memory*> mems;
+    std::vector<Cartridge*> carts;
+    std::vector<Registers> regs( lanes );
+    std::vector<int> overrun( lanes, 0 );
+    for ( size_t i = 0; i < lanes; i++ ) {
+        mems.push_back( new Memory() );
+        carts.push_back( new Cartridge( rom.data(), rom.size(), Mbc::MBC5, 0 ) );
+        carts[i]->attach( mems[i] );
+        mems[i]->write8( 0xFF80, bench_lockstep_seed( i ) );
+        regs[i].AF = 0x01B0;
+        regs[i].BC = 0x0013;
+        regs[i].DE = 0x00D8;
+        regs[i].HL = 0x014D;
+        regs[i].SP = 0xFFFE;
+        regs[i].PC = 0x0100;
+    }
+
+    uint64_t executed = 0;
+    Timer timer;
+    for ( uint64_t frame = 0; frame < frames; frame++ ) {
+        for ( size_t i = 0; i < lanes; i++ ) {
+            StepState sstate = StepState::RUN;
+            int count = 0;
+            int spent = Interpreter::run( mems[i], &regs[i], sstate, FRAME - overrun[i], &count );
+            overrun[i] = spent - ( FRAME - overrun[i] );
+            executed += count;
+        }
+    }
+    double scalar = timer.seconds();
+    printf( "scalar   %8.3f s %10.1f frames/s %8.2f MIPS\n", scalar, lanes * frames / scalar,
+            executed / scalar / 1e6 );
+
+    // Lockstep
+    Lockstep* group = new Lockstep( rom.data(), rom.size(), Mbc::MBC5, 0, lanes );
+    for ( size_t i = 0; i < lanes; i++ ) {
+        group->memory( i )->write8( 0xFF80, bench_lockstep_seed( i ) );
+    }
+
+    timer = Timer();
+    for ( uint64_t frame = 0; frame < frames; frame++ ) {
+        group->run_cycles( FRAME );
+    }
+    double lockstep = timer.seconds();
+    uint64_t steps = group->vector_steps + group->scalar_steps;
+    printf( "lockstep %8.3f s %10.1f frames/s %8.2f MIPS, %.1f%% of instructions in vector steps\n", lockstep,
+            lanes * frames / lockstep, steps / lockstep / 1e6, steps ? 100.0 * group->vector_steps / steps : 0.0 );
+    printf( "lockstep runs at %.2fx\n", scalar / lockstep );
+
+    // Every lane against its scalar twin
+    size_t wrong = 0;
+    for ( size_t i = 0; i < lanes; i++ ) {
+        Registers r = group->registers( i );
+        regs[i].sync_flags();
+        bool same = r.AF == regs[i].AF && r.BC == regs[i].BC && r.DE == regs[i].DE && r.HL == regs[i].HL &&
+                    r.SP == regs[i].SP && r.PC == regs[i].PC;
+        for ( uint32_t address = 0x8000; same && address < 0x10000; address++ ) {
+            same = group->memory( i )->peek( (uint16_t)address ) == mems[i]->peek( (uint16_t)address );
+        }
+        if ( !same && !wrong++ ) {
+            printf( "lane %zu: PC=%04X AF=%04X BC=%04X DE=%04X HL=%04X SP=%04X, scalar PC=%04X AF=%04X BC=%04X "
+                    "DE=%04X HL=%04X SP=%04X\n",
+                    i, r.PC, r.AF, r.BC, r.DE, r.HL, r.SP, regs[i].PC, regs[i].AF, regs[i].BC, regs[i].DE,
+                    regs[i].HL, regs[i].SP );
+        }
+    }
+    if ( wrong ) {
+        printf( "%zu of %zu lanes differ from the scalar run\n", wrong, lanes );
+    }
+
+    delete group;
+    for ( size_t i = 0; i < lanes; i++ ) {
+        delete carts[i];
+        delete mems[i];
+    }
+
+    return wrong == 0;
+}
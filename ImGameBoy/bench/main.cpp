@@ -0,0 +1,80 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "core.h"
+#include "blocks.h"
+#include "jit.h"
+#include "flags.h"
+#include "optable.h"
+#include "bus.h"
+#include "banks.h"
+#include "state.h"
+#include "rewind.h"
+#include "lockstep.h"
+#include "micro.h"
+#include "trace.h"
+
+// Usage: bench <suite> [rom] [count]
+//
+//   core      MIPS of the virtual Instruction table vs. the flat Interpreter
+//   blocks    MIPS of the flat Interpreter vs. the BlockCache
+//   jit       MIPS of the flat Interpreter vs. the Jit
+//   jitcheck  Jit and Interpreter in lockstep, exits with 1 on the first difference
+//   flags     MIPS of the Interpreter on ALU code, eager or GB_LAZY_FLAGS flags (rom ignored)
+//   optable   checks Interpreter cycles and lengths against optable, exits with 1 on a difference
+//   bus       accesses per second of map[] vs. the Memory page table (rom ignored)
+//   banks     MIPS of every core on an MBC5 loop with and without bank switches (rom ignored)
+//   state     save and restore latency of save states, count is states (rom ignored)
+//   rewind    push and pop latency of the rewind buffer, count is frames (rom ignored)
+//   lockstep  frames/s of many instances in Lockstep vs. one Interpreter each, count is
+//             frames, exits with 1 when a lane ends up elsewhere (rom ignored)
+//   micro     JSON of ns per opcode and per frame of synthetic workloads on every core,
+//             count is repeats per opcode (rom ignored)
+//   trace     ns per instruction of tracing vs. disassembling every instruction, reads
+//             the trace back and exits with 1 when it differs (rom ignored)
+//
+// The suites that take a ROM exit with 1 when it can't be read.
+
+int main( int argc, char** argv )
+{
+    const char* suite = argc > 1 ? argv[1] : "core";
+    const char* rom = argc > 2 && strcmp( argv[2], "-" ) ? argv[2] : nullptr;
+    uint64_t count = argc > 3 ? strtoull( argv[3], nullptr, 0 ) : 100000000;
+
+    if ( !strcmp( suite, "core" ) ) {
+        return bench_core( rom, count ) ? 0 : 1;
+    } else if ( !strcmp( suite, "blocks" ) ) {
+        return bench_blocks( rom, count ) ? 0 : 1;
+    } else if ( !strcmp( suite, "flags" ) ) {
+        bench_flags( count );
+    } else if ( !strcmp( suite, "optable" ) ) {
+        return bench_optable() ? 0 : 1;
+    } else if ( !strcmp( suite, "bus" ) ) {
+        bench_bus( count );
+    } else if ( !strcmp( suite, "banks" ) ) {
+        bench_banks( count );
+    } else if ( !strcmp( suite, "state" ) ) {
+        return bench_state( argc > 3 ? count : 100000 ) ? 0 : 1;
+    } else if ( !strcmp( suite, "rewind" ) ) {
+        return bench_rewind( argc > 3 ? count : 18000 ) ? 0 : 1;
+    } else if ( !strcmp( suite, "lockstep" ) ) {
+        return bench_lockstep( argc > 3 ? count : 60 ) ? 0 : 1;
+    } else if ( !strcmp( suite, "micro" ) ) {
+        bench_micro( argc > 3 ? count : 100000 );
+    } else if ( !strcmp( suite, "trace" ) ) {
+        return bench_trace( argc > 3 ? count : 20000000 ) ? 0 : 1;
+#if GB_JIT
+    } else if ( !strcmp( suite, "jit" ) ) {
+        return bench_jit( rom, count ) ? 0 : 1;
+    } else if ( !strcmp( suite, "jitcheck" ) ) {
+        return bench_jit_check( rom, count ) ? 0 : 1;
+#endif
+    } else {
+        fprintf( stderr, "Unknown benchmark suite %s\n", suite );
+        return 1;
+    }
+
+    return 0;
+}
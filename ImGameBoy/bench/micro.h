@@ -0,0 +1,262 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <vector>
+#include "bench.h"
+#include "flags.h"
+#include "banks.h"
+#include "../instruction.h"
+#include "../interpreter.h"
+#include "../blockcache.h"
+#include "../jit.h"
+#include "../screen.h"
+
+// micro: numbers to track from commit to commit, written to stdout as JSON.
+//
+//        opcodes  ns per execute() of every opcode in the Instruction table, CB
+//                 ones through the 0xCB entry, each repeated count times from the
+//                 same registers. Operands point into WRAM and HRAM, F is 0, so
+//                 NZ and NC branches are taken and Z and C ones are not. The copy
+//                 of the registers is in every number, NOP is the floor.
+//        frames   ns per 70224 cycle frame of each core on synthetic workloads:
+//                 alu       the ALU loop of the flags suite
+//                 memcpy    LD A,(HL+) / LD (DE),A copying 4kB of WRAM
+//                 banks     an MBC5 bank switch every ten instructions, see banks.h
+//                 vram      filling all of VRAM, and drawing the screen every frame
+//                 bootrom   the embedded boot ROM over an empty cartridge
+
+static const int BENCH_MICRO_FRAMES = 300;
+
+static const uint8_t bench_micro_memcpy[] = {
+    0x21, 0x00, 0xC0, // 0100 LD HL,C000h
+    0x11, 0x00, 0xD0, // 0103 LD DE,D000h
+    0x01, 0x00, 0x10, // 0106 LD BC,1000h
+    0x2A, // 0109 LD A,(HL+)
+    0x12, // 010A LD (DE),A
+    0x13, // 010B INC DE
+    0x0B, // 010C DEC BC
+    0x78, // 010D LD A,B
+    0xB1, // 010E OR C
+    0x20, 0xF8, // 010F JR NZ,0109h
+    0x18, 0xED, // 0111 JR 0100h
+};
+
+static const uint8_t bench_micro_vram[] = {
+    0x3E, 0x91, // 0100 LD A,91h
+    0xE0, 0x40, // 0102 LDH (40h),A, LCD and background on
+    0x21, 0x00, 0x80, // 0104 LD HL,8000h
+    0x01, 0x00, 0x20, // 0107 LD BC,2000h
+    0x7B, // 010A LD A,E
+    0x22, // 010B LD (HL+),A
+    0x0B, // 010C DEC BC
+    0x78, // 010D LD A,B
+    0xB1, // 010E OR C
+    0x20, 0xF9, // 010F JR NZ,010Ah
+    0x1C, // 0111 INC E
+    0x18, 0xF0, // 0112 JR 0104h
+};
+
+static const char* const bench_micro_workloads[] = { "alu", "memcpy", "banks", "vram", "bootrom" };
+
+typedef std::function<int( Memory*, Registers*, StepState&, int, int* )> BenchMicroCore;
+
+struct BenchMicroFrame {
+    std::string workload;
+    std::string core;
+    double ns; // per frame
+    double mips;
+};
+
+// Sets up mem for workload, returns the cartridge it needs, if any
+static Cartridge* bench_micro_load( const char* workload, Memory* mem, Registers* r, std::vector<uint8_t>* rom )
+{
+    memset( mem->map, 0, sizeof( mem->map ) );
+    r->PC = 0x0100;
+    r->SP = 0xFFFE;
+
+    if ( !strcmp( workload, "alu" ) ) {
+        memcpy( &mem->map[0x0100], bench_flags_loop, sizeof( bench_flags_loop ) );
+    } else if ( !strcmp( workload, "memcpy" ) ) {
+        memcpy( &mem->map[0x0100], bench_micro_memcpy, sizeof( bench_micro_memcpy ) );
+    } else if ( !strcmp( workload, "vram" ) ) {
+        memcpy( &mem->map[0x0100], bench_micro_vram, sizeof( bench_micro_vram ) );
+        mem->map[0xFF47] = 0xE4; // BGP
+    } else if ( !strcmp( workload, "banks" ) ) {
+        *rom = bench_banks_rom( false );
+        Cartridge* cart = new Cartridge( rom->data(), rom->size(), Mbc::MBC5, 0 );
+        cart->attach( mem );
+        r->PC = 0x0150;
+        return cart;
+    } else {
+        bench_load( mem, nullptr );
+        r->PC = 0x0000;
+    }
+
+    return nullptr;
+}
+
+static BenchMicroFrame bench_micro_frames( const char* workload, const char* name, int frames, const BenchMicroCore& core )
+{
+    Memory* mem = new Memory();
+    Registers r;
+    StepState sstate = StepState::RUN;
+    std::vector<uint8_t> rom;
+    Cartridge* cart = bench_micro_load( workload, mem, &r, &rom );
+    bool draw = !strcmp( workload, "vram" );
+    uint8_t screen[SCREEN_WIDTH * SCREEN_HEIGHT];
+
+    uint64_t executed = 0;
+    int overrun = 0;
+    Timer timer;
+
+    for ( int frame = 0; frame < frames; frame++ ) {
+        int count = 0;
+        overrun = core( mem, &r, sstate, 70224 - overrun, &count ) - ( 70224 - overrun );
+        executed += count;
+        if ( overrun < 0 ) {
+            overrun = 0;
+        }
+        if ( draw ) {
+            render_screen( mem, screen );
+        }
+
+        // HALT and STOP park the debugger, the benchmark just keeps going
+        sstate = StepState::RUN;
+    }
+
+    double elapsed = timer.seconds();
+
+    delete cart;
+    delete mem;
+
+    return { workload, name, elapsed * 1e9 / frames, executed / elapsed / 1e6 };
+}
+
+// ns per execute() of opcode, 0x100-0x1FF being CB opcodes
+static double bench_micro_opcode( Instruction** table, StepState& sstate, Memory* mem, uint16_t opcode, uint64_t count )
+{
+    const uint16_t pc = 0xC000;
+
+    memset( &mem->map[0xC000], 0, 0x2000 );
+    if ( opcode & 0x100 ) {
+        mem->map[pc] = 0xCB;
+        mem->map[pc + 1] = (uint8_t)opcode;
+    } else {
+        mem->map[pc] = (uint8_t)opcode;
+        mem->map[pc + 1] = 0x80; // (nn) is C280, (FF00+n) FF80
+        mem->map[pc + 2] = 0xC2;
+    }
+
+    Registers start;
+    start.PC = pc;
+    start.SP = 0xD000;
+    start.BC = 0xC180; // (C) is FF80 too
+    start.DE = 0xC200;
+    start.HL = 0xC100;
+
+    Instruction* op = table[opcode & 0x100 ? 0xCB : opcode];
+    Registers r;
+    int cycles = 0;
+    Timer timer;
+
+    for ( uint64_t i = 0; i < count; i++ ) {
+        r = start;
+        sstate = StepState::RUN;
+        cycles += op->execute( mem, &r );
+    }
+
+    double elapsed = timer.seconds();
+
+    // Keeps the loop from being thrown away without writing into the JSON
+    volatile int sink = cycles;
+    (void)sink;
+
+    return elapsed * 1e9 / count;
+}
+
+static void bench_micro( uint64_t count )
+{
+    Memory* mem = new Memory();
+    StepState sstate = StepState::RUN;
+    Instruction* table[0x100];
+
+    Instruction::create_table( table, sstate );
+    memset( mem->map, 0, sizeof( mem->map ) );
+
+#ifdef GB_LAZY_FLAGS
+    bool lazy = true;
+#else
+    bool lazy = false;
+#endif
+    printf( "{\n  \"suite\": \"micro\",\n  \"lazy_flags\": %s,\n  \"jit\": %s,\n  \"repeat\": %llu,\n  \"frames\": %d,\n",
+            lazy ? "true" : "false", GB_JIT ? "true" : "false", (unsigned long long)count, BENCH_MICRO_FRAMES );
+
+    printf( "  \"opcodes\": [\n" );
+    bool first = true;
+    for ( uint16_t opcode = 0; opcode < 0x200; opcode++ ) {
+        if ( opcode == 0xCB || ( optable[opcode].control & OPC_ILLEGAL ) ) {
+            continue;
+        }
+
+        double ns = bench_micro_opcode( table, sstate, mem, opcode, count );
+        char dis[64];
+        optable.dis( dis, sizeof( dis ), mem, 0xC000 );
+        printf( "%s    {\"opcode\": \"%03X\", \"dis\": \"%s\", \"cycles\": %d, \"ns\": %.3f}", first ? "" : ",\n",
+                opcode, dis, optable[opcode].cycles, ns );
+        first = false;
+    }
+    printf( "\n  ],\n" );
+
+    for ( int i = 0; i < 0x100; i++ ) {
+        delete table[i];
+    }
+    delete mem;
+
+    // Every core starts each workload cold
+    std::vector<BenchMicroFrame> results;
+    for ( const char* workload : bench_micro_workloads ) {
+        StepState vstate = StepState::RUN;
+        Instruction* vtable[0x100];
+        Instruction::create_table( vtable, vstate );
+        results.push_back( bench_micro_frames( workload, "virtual", BENCH_MICRO_FRAMES,
+                                               [&]( Memory* m, Registers* r, StepState& s, int budget, int* executed ) {
+                                                   int spent = 0;
+                                                   vstate = StepState::RUN;
+                                                   while ( spent < budget && vstate != StepState::STOP ) {
+                                                       spent += vtable[m->fetch8( r->PC )]->execute( m, r );
+                                                       ( *executed )++;
+                                                   }
+                                                   return spent;
+                                               } ) );
+        for ( int i = 0; i < 0x100; i++ ) {
+            delete vtable[i];
+        }
+
+        results.push_back( bench_micro_frames( workload, "interp", BENCH_MICRO_FRAMES, Interpreter::run ) );
+
+        BlockCache* cache = new BlockCache();
+        results.push_back( bench_micro_frames( workload, "blocks", BENCH_MICRO_FRAMES,
+                                               [cache]( Memory* m, Registers* r, StepState& s, int budget, int* executed ) {
+                                                   return cache->run( m, r, s, budget, executed );
+                                               } ) );
+        delete cache;
+
+#if GB_JIT
+        Jit* jit = new Jit();
+        if ( jit->available() ) {
+            results.push_back( bench_micro_frames( workload, "jit", BENCH_MICRO_FRAMES,
+                                                   [jit]( Memory* m, Registers* r, StepState& s, int budget,
+                                                          int* executed ) { return jit->run( m, r, s, budget, executed ); } ) );
+        }
+        delete jit;
+#endif
+    }
+
+    printf( "  \"workloads\": [\n" );
+    for ( size_t i = 0; i < results.size(); i++ ) {
+        const BenchMicroFrame& f = results[i];
+        printf( "    {\"workload\": \"%s\", \"core\": \"%s\", \"ns_per_frame\": %.0f, \"mips\": %.2f, \"realtime\": %.2f}%s\n",
+                f.workload.c_str(), f.core.c_str(), f.ns, f.mips, 1e9 / 59.7275 / f.ns, i + 1 < results.size() ? "," : "" );
+    }
+    printf( "  ]\n}\n" );
+}
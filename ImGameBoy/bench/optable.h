@@ -0,0 +1,77 @@
+#pragma once
+#include "bench.h"
+#include "../interpreter.h"
+#include "../optable.h"
+
+// optable: runs every opcode once on the Interpreter, conditional ones with the branch
+//          taken and not taken, and checks the T-cycles and the PC it moved to against
+//          optable. Prints the disassembly of the opcodes that disagree.
+
+// Condition of a conditional opcode in bits 3-4 (NZ Z NC C) against F
+static bool bench_optable_taken( uint16_t opcode, uint8_t f )
+{
+    bool set = f & ( ( opcode >> 3 ) & 2 ? 0x10 : 0x80 );
+    return opcode & 0x08 ? set : !set;
+}
+
+static bool bench_optable( void )
+{
+    printf( "optable: %d opcodes\n", 0x200 );
+
+    Memory* mem = new Memory();
+    int checked = 0, failed = 0;
+
+    for ( uint16_t opcode = 0; opcode < 0x200; opcode++ ) {
+        const OpInfo& info = optable[opcode];
+        if ( opcode == 0xCB || ( info.control & OPC_ILLEGAL ) ) {
+            continue;
+        }
+
+        for ( int pass = 0; pass < 2; pass++ ) {
+            uint8_t f = pass ? 0xF0 : 0x00;
+            Registers r;
+            StepState sstate = StepState::RUN;
+            uint16_t pc = 0xC000;
+
+            memset( mem->map, 0, sizeof( mem->map ) );
+            if ( opcode & 0x100 ) {
+                mem->map[pc] = 0xCB;
+                mem->map[pc + 1] = (uint8_t)opcode;
+            } else {
+                mem->map[pc] = (uint8_t)opcode;
+                mem->map[pc + 1] = 0x10;
+                mem->map[pc + 2] = 0x20;
+            }
+            r.PC = pc;
+            r.SP = 0xD000;
+            r.F = f;
+
+            int count = 0;
+            int spent = Interpreter::run( mem, &r, sstate, 1, &count );
+
+            bool conditional = ( info.control & OPC_CONDITIONAL ) != 0;
+            bool taken = !conditional || bench_optable_taken( opcode, f );
+            bool branched = ( info.control & OPC_BRANCH ) && taken;
+            int cycles = conditional && taken ? info.cycles_taken : info.cycles;
+
+            checked++;
+            if ( spent != cycles || ( !branched && r.PC != (uint16_t)( pc + info.length ) ) ) {
+                char dis[64];
+                optable.dis( dis, sizeof( dis ), mem, pc );
+                printf( "  %03X %-20s %2d cycles, expected %2d, PC +%d, expected +%d\n", opcode, dis, spent, cycles,
+                        (uint16_t)( r.PC - pc ), info.length );
+                failed++;
+            }
+
+            if ( !conditional ) {
+                break;
+            }
+        }
+    }
+
+    printf( "%d checked, %d mismatches\n", checked, failed );
+
+    delete mem;
+
+    return failed == 0;
+}
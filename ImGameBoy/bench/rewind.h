@@ -0,0 +1,72 @@
+#pragma once
+#include <vector>
+#include "bench.h"
+#include "banks.h"
+#include "../savestate.h"
+#include "../rewind.h"
+
+// rewind: push and pop latency of the Rewind buffer on the state suite's machine.
+//         Each frame runs the banks loop and then rewrites a couple hundred bytes
+//         of work RAM, HRAM and OAM, the way game variables and sprites change.
+//         Pops every frame back and checks it against a plain copy.
+
+static bool bench_rewind( uint64_t total )
+{
+    std::vector<uint8_t> rom = bench_banks_rom( false );
+    Memory* mem = new Memory();
+    Cartridge* cart = new Cartridge( rom.data(), rom.size(), Mbc::MBC5, 0x8000 );
+    Rewind* rewind = new Rewind();
+    Registers r;
+    StepState sstate = StepState::RUN;
+    uint64_t cycles = 0;
+    uint32_t seed = 1;
+    bool ok = true;
+
+    cart->attach( mem );
+    r.PC = 0x0150;
+
+    size_t size = state_size( cart );
+    std::vector<uint8_t> state( size ), back( size );
+    std::vector<uint8_t> copies( size * 8 ); // the last frames, for the check
+
+    rewind->reset( size );
+    printf( "rewind: %zu byte states, %llu frames\n", size, (unsigned long long)total );
+
+    double pushing = 0;
+    for ( uint64_t frame = 0; frame < total; frame++ ) {
+        cycles += Interpreter::run( mem, &r, sstate, 70224 );
+        for ( int i = 0; i < 200; i++ ) {
+            seed = seed * 1103515245 + 12345;
+            static const uint16_t bases[] = { 0xC000, 0xC100, 0xFE00, 0xFF80 };
+            mem->write8( bases[i & 3] + ( ( seed >> 16 ) & 0x7F ), (uint8_t)( seed >> 8 ) );
+        }
+        save_state( state.data(), &r, mem, cart, cycles, 0 );
+        memcpy( &copies[( frame & 7 ) * size], state.data(), size );
+
+        Timer timer;
+        rewind->push( state.data() );
+        pushing += timer.seconds();
+    }
+
+    printf( "push     %10.2f us/frame, %llu frames in %.1f MB, %.0f bytes/frame\n", pushing / total * 1e6,
+            (unsigned long long)rewind->frames(), rewind->used() / 1e6, (double)rewind->used() / rewind->frames() );
+
+    uint64_t popped = 0;
+    Timer timer;
+    while ( rewind->pop( back.data() ) ) {
+        if ( popped < 8 && memcmp( back.data(), &copies[( ( total - 1 - popped ) & 7 ) * size], size ) ) {
+            ok = false;
+        }
+        popped++;
+    }
+    double elapsed = timer.seconds();
+
+    printf( "pop      %10.2f us/frame, %llu frames%s\n", elapsed / popped * 1e6, (unsigned long long)popped,
+            ok ? "" : ", MISMATCH" );
+
+    delete rewind;
+    delete cart;
+    delete mem;
+
+    return ok;
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <vector>
+#include "bench.h"
+#include "banks.h"
+#include "../savestate.h"
+
+// state: latency of save_state and load_state on the banks cartridge with 32kB of
+//        RAM, the machine rewind, run-ahead and fuzzing snapshot all the time.
+//        "restore" copies the whole state, "dirty" only the pages that differ, as
+//        the caching cores restore, alternating between two states a frame apart.
+
+static void bench_state_report( const char* name, uint64_t count, double elapsed, size_t bytes )
+{
+    printf( "%-8s %10llu states %8.3f s %10.2f us/state %8.2f GB/s\n", name, (unsigned long long)count, elapsed,
+            elapsed / count * 1e6, bytes * (double)count / elapsed / 1e9 );
+}
+
+// Returns true when every restore brought back the registers that were saved
+static bool bench_state( uint64_t total )
+{
+    std::vector<uint8_t> rom = bench_banks_rom( false );
+    Memory* mem = new Memory();
+    Cartridge* cart = new Cartridge( rom.data(), rom.size(), Mbc::MBC5, 0x8000 );
+    Registers r;
+    StepState sstate = StepState::RUN;
+    uint64_t cycles = 0;
+    int overrun = 0;
+    bool ok = true;
+
+    cart->attach( mem );
+    r.PC = 0x0150;
+
+    size_t size = state_size( cart );
+    std::vector<uint8_t> first( size ), second( size ), scratch( size );
+
+    printf( "state: %zu bytes, %llu states per run\n", size, (unsigned long long)total );
+
+    // Two states one frame apart. The loop only writes MBC registers, so the frame
+    // in between also scatters a few writes over work RAM and HRAM.
+    cycles += Interpreter::run( mem, &r, sstate, 70224 );
+    save_state( first.data(), &r, mem, cart, cycles, overrun );
+    Registers saved = r;
+    cycles += Interpreter::run( mem, &r, sstate, 70224 );
+    for ( int i = 0; i < 16; i++ ) {
+        mem->write8( (uint16_t)( 0xC000 + i * 0x1F3 ), (uint8_t)i );
+    }
+    mem->write8( 0xFF90, 0x12 );
+    save_state( second.data(), &r, mem, cart, cycles, overrun );
+
+    Timer timer;
+    for ( uint64_t i = 0; i < total; i++ ) {
+        save_state( scratch.data(), &r, mem, cart, cycles, overrun );
+    }
+    bench_state_report( "save", total, timer.seconds(), size );
+
+    timer = Timer();
+    for ( uint64_t i = 0; i < total; i++ ) {
+        load_state( ( i & 1 ) ? first.data() : second.data(), size, &r, mem, cart, &cycles, &overrun );
+    }
+    bench_state_report( "restore", total, timer.seconds(), size );
+
+    bool dirty[0x100];
+    int pages = 0;
+    timer = Timer();
+    for ( uint64_t i = 0; i < total; i++ ) {
+        load_state( ( i & 1 ) ? first.data() : second.data(), size, &r, mem, cart, &cycles, &overrun, dirty );
+    }
+    bench_state_report( "dirty", total, timer.seconds(), size );
+
+    for ( int page = 0; page < 0x100; page++ ) {
+        pages += dirty[page];
+    }
+
+    saved.sync_flags();
+    if ( !load_state( first.data(), size, &r, mem, cart, &cycles, &overrun ) || r.AF != saved.AF || r.BC != saved.BC ||
+         r.DE != saved.DE || r.HL != saved.HL || r.SP != saved.SP || r.PC != saved.PC ) {
+        printf( "restore mismatch\n" );
+        ok = false;
+    }
+
+    printf( "%d pages differ between the two states\n", pages );
+
+    delete cart;
+    delete mem;
+
+    return ok;
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include <stdio.h>
+#include "bench.h"
+#include "../interpreter.h"
+#include "../optable.h"
+#include "../trace.h"
+
+// trace: the boot ROM an instruction at a time on the Interpreter, as Emulator
+//        steps it while tracing, three times: alone, with a disassembly of every
+//        instruction as a text log would need, and recorded by a TraceWriter. Then
+//        reads the trace back against a fourth run and exits with 1 on the first
+//        record that differs.
+
+static void bench_trace_start( Memory* mem, Registers* r )
+{
+    bench_load( mem, nullptr );
+    *r = Registers();
+}
+
+static bool bench_trace( uint64_t total )
+{
+    printf( "trace: bootrom, %llu instructions\n", (unsigned long long)total );
+
+    const char* path = "bench_trace.bin";
+    Memory* mem = new Memory();
+    Registers r;
+    StepState sstate = StepState::RUN;
+    uint64_t cycle = 0;
+
+    // Alone
+    bench_trace_start( mem, &r );
+    Timer timer;
+    for ( uint64_t i = 0; i < total; i++ ) {
+        cycle += Interpreter::run( mem, &r, sstate, 1 );
+    }
+    double alone = timer.seconds();
+    printf( "step     %8.3f s %8.2f ns/instruction\n", alone, alone * 1e9 / total );
+
+    // Disassembled
+    bench_trace_start( mem, &r );
+    size_t length = 0; // keeps the disassembly from being thrown away
+    timer = Timer();
+    for ( uint64_t i = 0; i < total; i++ ) {
+        char line[64];
+        length += optable.dis( line, sizeof( line ), mem, r.PC );
+        cycle += Interpreter::run( mem, &r, sstate, 1 );
+    }
+    double dis = timer.seconds();
+    printf( "dis      %8.3f s %8.2f ns/instruction (%zu bytes)\n", dis, dis * 1e9 / total, length );
+
+    // Traced, with what it takes to get the rest to disk
+    TraceWriter* writer = new TraceWriter();
+    if ( !writer->open( path ) ) {
+        fprintf( stderr, "Unable to create %s\n", path );
+        delete writer;
+        delete mem;
+        return false;
+    }
+    bench_trace_start( mem, &r );
+    cycle = 0;
+    timer = Timer();
+    for ( uint64_t i = 0; i < total; i++ ) {
+        r.sync_flags();
+        writer->record( &r, mem, cycle );
+        cycle += Interpreter::run( mem, &r, sstate, 1 );
+    }
+    double traced = timer.seconds();
+    bool written = writer->close();
+    double closed = timer.seconds();
+    printf( "trace    %8.3f s %8.2f ns/instruction, %.3f s to close, %llu stalls, %.2f bytes/instruction\n", traced,
+            traced * 1e9 / total, closed - traced, (unsigned long long)writer->stalls, (double)writer->bytes / total );
+    delete writer;
+
+    // Read back
+    TraceReader* reader = new TraceReader();
+    bool ok = written && reader->open( path );
+    bench_trace_start( mem, &r );
+    cycle = 0;
+    for ( uint64_t i = 0; ok && i < total; i++ ) {
+        TraceRecord rec;
+        r.sync_flags();
+        ok = reader->next( &rec ) && rec.cycle == cycle && rec.pc == r.PC && rec.sp == r.SP && rec.regs[0] == r.A &&
+             rec.regs[1] == r.F && rec.regs[2] == r.B && rec.regs[3] == r.C && rec.regs[4] == r.D &&
+             rec.regs[5] == r.E && rec.regs[6] == r.H && rec.regs[7] == r.L;
+        for ( int k = 0; k < 4; k++ ) {
+            ok = ok && rec.mem[k] == mem->peek( (uint16_t)( r.PC + k ) );
+        }
+        if ( !ok ) {
+            printf( "record %llu differs, PC=%04X\n", (unsigned long long)i, r.PC );
+        }
+        cycle += Interpreter::run( mem, &r, sstate, 1 );
+    }
+    TraceRecord extra;
+    if ( ok && reader->next( &extra ) ) {
+        printf( "more records than instructions\n" );
+        ok = false;
+    }
+    delete reader;
+    remove( path );
+
+    printf( "%s\n", ok ? "read back the same" : "read back differs" );
+
+    delete mem;
+
+    return ok;
+}
@@ -0,0 +1,356 @@
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include <unordered_map>
+#include <vector>
+#include "memory.h"
+#include "registers.h"
+#include "instruction.h"
+#include "optable.h"
+#include "interpreter.h"
+#include "shared.h"
+
+// Basic block cache: straight-line runs of instructions are decoded once into
+// records holding the handler and the operand, keyed by (bank, PC), and executed
+// back to back without fetching or decoding anything from memory. The handler
+// bodies are the ones of Interpreter (opcodes.h), only operand fetch and memory
+// writes differ.
+//
+// Every write goes through write8/write16, which pass it on to the bus and drop the
+// blocks decoded from the written page. The records of a dropped block are overwritten with the exit
+// record, so a block that modifies its own code (or the HRAM routine it is about to
+// jump to) leaves right after the write and the next lookup decodes it again.
+//
+// Memory changed behind the cache's back, by the debugger's memory editor for
+// example, has to be followed by flush().
+//
+// Blocks decoded from 0x4000-0x7FFF are keyed by Memory::rom_bank as well and stay
+// around when the MBC switches banks, so code calling back and forth between banks
+// does not decode anything again. A bank switch leaves a block running from
+// 0x4000-0x7FFF right after the write. The MBC1 low bank at 0x0000-0x3FFF and the
+// cartridge RAM bank change rarely, the blocks of those are dropped when they do.
+
+class BlockCache
+{
+private:
+    static const uint16_t BLOCK_END = 0x200; // exit record, after the 512 opcodes
+    static const int MAX_BLOCK = 64; // instructions per block
+    static const int PAGE_SHIFT = 7; // 128 byte pages keep I/O registers and HRAM apart
+    static const int PAGES = 0x10000 >> PAGE_SHIFT;
+    static const int ARENA_SIZE = 0x40000; // records, flushed when full
+
+    struct Op {
+        const void* handler; // computed goto target, unused by the switch build
+        uint16_t opcode; // 0x000-0x1FF, 0x100-0x1FF is the CB page
+        uint16_t imm; // 8 or 16 bit operand
+    };
+
+    struct Block {
+        uint32_t first; // first record in the arena
+        uint32_t end; // address following the last instruction
+        uint16_t pc;
+        uint16_t bank; // ROM bank for blocks in 0x4000-0x7FFF
+        bool valid;
+    };
+
+    std::vector<Op> arena;
+    uint32_t used;
+    std::vector<Block> blocks;
+    std::vector<uint32_t> lookup; // PC -> first record + 1, 0 when not decoded
+    std::vector<uint16_t> lookup_bank; // bank the block at PC was decoded from
+    std::unordered_map<uint32_t, uint32_t> banked; // bank << 16 | PC -> first record + 1, 0x4000-0x7FFF
+    std::vector<uint32_t> page_blocks[PAGES]; // blocks decoded from each page
+    bool code[PAGES]; // page_blocks[page] is not empty
+    Op single[2]; // one instruction and the exit record, for budgets of one cycle
+    const void* exit_handler; // handler of the exit record
+
+    static bool switchable( uint16_t pc )
+    {
+        return pc >= 0x4000 && pc < 0x8000;
+    }
+
+    // Only 0x4000-0x7FFF is switchable, blocks elsewhere are tagged bank 0
+    static uint16_t bank_of( Memory* m, uint16_t pc )
+    {
+        return switchable( pc ) ? m->rom_bank : 0;
+    }
+
+    // Decodes the instruction at pc into op and returns its length
+    static int decode( Memory* m, uint16_t pc, Op& op, void* const* dispatch )
+    {
+        op.opcode = OpTable::fetch( m, pc );
+        int len = optable[op.opcode].length;
+
+        op.imm = 0;
+        if ( len == 2 ) {
+            op.imm = m->peek( pc + 1 );
+        }
+        else if ( len == 3 ) {
+            op.imm = m->peek( pc + 1 ) | ( m->peek( pc + 2 ) << 8 );
+        }
+        op.handler = dispatch ? dispatch[op.opcode] : nullptr;
+
+        return len;
+    }
+
+    void end_record( Op& op, void* const* dispatch )
+    {
+        exit_handler = dispatch ? dispatch[BLOCK_END] : nullptr;
+        op.opcode = BLOCK_END;
+        op.imm = 0;
+        op.handler = exit_handler;
+    }
+
+    // Decodes the block starting at pc and returns its records
+    const Op* fetch( Memory* m, uint16_t pc, void* const* dispatch )
+    {
+        uint16_t bank = bank_of( m, pc );
+
+        // Decoded before, from the bank that is now mapped in again
+        if ( switchable( pc ) ) {
+            auto it = banked.find( ( (uint32_t)bank << 16 ) | pc );
+            if ( it != banked.end() ) {
+                lookup[pc] = it->second;
+                lookup_bank[pc] = bank;
+                return &arena[it->second - 1];
+            }
+        }
+
+        if ( used + MAX_BLOCK + 1 > arena.size() || blocks.size() >= 0xFFFFFF ) {
+            flush();
+        }
+
+        Block block;
+        block.first = used;
+        block.pc = pc;
+        block.bank = bank;
+        block.valid = true;
+
+        // A block stays inside one bank region and never wraps around 0xFFFF
+        uint32_t limit = pc < 0x4000 ? 0x4000 : pc < 0x8000 ? 0x8000 : 0x10000;
+        uint32_t addr = pc;
+        for ( int i = 0; i < MAX_BLOCK && addr < limit; i++ ) {
+            Op& op = arena[used++];
+            addr += decode( m, (uint16_t)addr, op, dispatch );
+            if ( optable[op.opcode].ends_block() ) {
+                break;
+            }
+        }
+        end_record( arena[used++], dispatch );
+        block.end = addr < 0x10000 ? addr : 0x10000;
+
+        blocks.push_back( block );
+        lookup[pc] = block.first + 1;
+        lookup_bank[pc] = bank;
+        if ( switchable( pc ) ) {
+            banked[( (uint32_t)bank << 16 ) | pc] = block.first + 1;
+        }
+
+        // Filed under the page writes land on, code run from echo RAM under work RAM
+        for ( uint32_t i = pc >> PAGE_SHIFT; i <= ( block.end - 1 ) >> PAGE_SHIFT; i++ ) {
+            uint16_t page = Memory::canonical( (uint16_t)( i << PAGE_SHIFT ) ) >> PAGE_SHIFT;
+            page_blocks[page].push_back( (uint32_t)blocks.size() - 1 );
+            code[page] = true;
+        }
+
+        return &arena[block.first];
+    }
+
+    // Drops every block decoded from page. Their records become exit records, so a
+    // block that is running right now stops after the current instruction.
+    void invalidate( uint32_t page )
+    {
+        for ( uint32_t index : page_blocks[page] ) {
+            Block& block = blocks[index];
+            if ( !block.valid ) {
+                continue;
+            }
+
+            block.valid = false;
+            if ( lookup[block.pc] == block.first + 1 ) {
+                lookup[block.pc] = 0;
+            }
+            if ( switchable( block.pc ) ) {
+                banked.erase( ( (uint32_t)block.bank << 16 ) | block.pc );
+            }
+
+            // The operand is left alone, the current instruction may still need it
+            for ( Op* op = &arena[block.first]; op->opcode != BLOCK_END; op++ ) {
+                op->opcode = BLOCK_END;
+                op->handler = exit_handler;
+            }
+        }
+
+        page_blocks[page].clear();
+        code[page] = false;
+    }
+
+    // Writes below 0x8000 go to the MBC and never change ROM, but a bank switch has
+    // to stop the block running from the old bank
+    void write8( Memory* m, Registers* r, uint16_t address, uint8_t value )
+    {
+        if ( address < 0x8000 ) {
+            uint16_t bank = m->rom_bank;
+            const uint8_t* low = m->host_page( 0x00 );
+            const uint8_t* ram = m->host_page( 0xA0 );
+            m->write8( address, value );
+
+            if ( m->rom_bank != bank && switchable( r->PC ) && code[r->PC >> PAGE_SHIFT] ) {
+                invalidate( r->PC >> PAGE_SHIFT );
+            }
+            if ( m->host_page( 0x00 ) != low ) {
+                invalidate_range( 0x0000, 0x4000 );
+            }
+            if ( m->host_page( 0xA0 ) != ram ) {
+                invalidate_range( 0xA000, 0x2000 );
+            }
+            return;
+        }
+        m->write8( address, value );
+
+        uint16_t page = Memory::canonical( address ) >> PAGE_SHIFT;
+        if ( code[page] ) {
+            invalidate( page );
+        }
+    }
+
+    void write16( Memory* m, Registers* r, uint16_t address, uint16_t value )
+    {
+        write8( m, r, address, value & 0xFF );
+        write8( m, r, address + 1, value >> 8 );
+    }
+
+public:
+    BlockCache( void )
+        : arena( ARENA_SIZE ), used( 0 ), lookup( 0x10000 ), lookup_bank( 0x10000 ), code{ false }, exit_handler( nullptr )
+    {
+    }
+
+    // Drops the blocks decoded from length bytes at address, for memory changed
+    // behind the cache's back when only a few pages did, instead of flush()
+    void invalidate_range( uint16_t address, uint32_t length )
+    {
+        uint32_t last = ( address + length - 1 ) >> PAGE_SHIFT;
+        for ( uint32_t i = address >> PAGE_SHIFT; i <= last && i < PAGES; i++ ) {
+            uint32_t page = Memory::canonical( (uint16_t)( i << PAGE_SHIFT ) ) >> PAGE_SHIFT;
+            if ( code[page] ) {
+                invalidate( page );
+            }
+        }
+    }
+
+    // Forgets every decoded block
+    void flush( void )
+    {
+        used = 0;
+        blocks.clear();
+        banked.clear();
+        std::fill( lookup.begin(), lookup.end(), 0 );
+        for ( int page = 0; page < PAGES; page++ ) {
+            page_blocks[page].clear();
+            code[page] = false;
+        }
+    }
+
+    // Same contract as Interpreter::run: the budget is checked after every instruction,
+    // a block left halfway picks up where it stopped on the next lookup of PC. A
+    // budget of 1 runs exactly one instruction, for debugger stepping.
+    int run( Memory* m, Registers* r, StepState& sstate, int budget, int* executed = nullptr )
+    {
+        int spent = 0;
+        int count = 0;
+        const Op* op;
+
+#define IMM8 ( (uint8_t)op->imm )
+#define IMM16 ( op->imm )
+#define READ8( a ) m->read8( a )
+#define WRITE8( a, v ) write8( m, r, a, v )
+#define READ16( a ) m->read16( a )
+#define WRITE16( a, v ) write16( m, r, a, v )
+
+#if GB_COMPUTED_GOTO
+
+#define OPCODE( n ) op_##n:
+#define NEXT( c )                                         \
+    spent += c;                                           \
+    count++;                                              \
+    if ( spent >= budget || sstate == StepState::STOP ) { \
+        goto block_end;                                   \
+    }                                                     \
+    goto*( ++op )->handler
+
+        static void* const dispatch[0x201] = {
+#define OPCODE_LABELS
+#include "opcodes.h"
+#undef OPCODE_LABELS
+            &&block_end,
+        };
+
+#else
+
+        static void* const* const dispatch = nullptr;
+
+#define OPCODE( n ) case n:
+#define NEXT( c )                                         \
+    spent += c;                                           \
+    count++;                                              \
+    if ( spent >= budget || sstate == StepState::STOP ) { \
+        break;                                            \
+    }                                                     \
+    op++;                                                 \
+    continue
+
+#endif
+
+        while ( spent < budget && sstate != StepState::STOP ) {
+            if ( budget == 1 ) {
+                decode( m, r->PC, single[0], dispatch );
+                end_record( single[1], dispatch );
+                op = single;
+            }
+            else if ( lookup[r->PC] && lookup_bank[r->PC] == bank_of( m, r->PC ) ) {
+                op = &arena[lookup[r->PC] - 1];
+            }
+            else {
+                op = fetch( m, r->PC, dispatch );
+            }
+
+#if GB_COMPUTED_GOTO
+            goto* op->handler;
+#else
+            for ( ;; ) {
+                switch ( op->opcode ) {
+#endif
+
+#include "opcodes.h"
+
+#if GB_COMPUTED_GOTO
+        // The CB prefix is decoded into the opcode and never dispatched
+        op_0xCB:
+        block_end:;
+#else
+                case 0xCB:
+                case BLOCK_END:
+                    break;
+                }
+                break;
+            }
+#endif
+        }
+
+#undef OPCODE
+#undef NEXT
+#undef IMM8
+#undef IMM16
+#undef READ8
+#undef WRITE8
+#undef READ16
+#undef WRITE16
+
+        if ( executed ) {
+            *executed = count;
+        }
+
+        return spent;
+    }
+};
@@ -0,0 +1,97 @@
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include "memory.h"
+#include "slots.h"
+
+// PC breakpoints as one bit per CodeSlots slot, so a breakpoint in bank 5 leaves
+// the same address in bank 6 alone and a check is a page table lookup and a bit
+// test however many are set. armed says whether any is, Emulator only looks at the
+// bitmap when it is.
+
+class Breakpoints
+{
+private:
+    CodeSlots slots;
+    std::vector<uint64_t> bits;
+    size_t set_count;
+
+    void assign( size_t slot, bool on )
+    {
+        uint64_t bit = 1ull << ( slot & 63 );
+        bool was = ( bits[slot >> 6] & bit ) != 0;
+        if ( was != on ) {
+            bits[slot >> 6] ^= bit;
+            set_count += on ? 1 : -1;
+            armed = set_count != 0;
+        }
+    }
+
+public:
+    bool armed;
+
+    Breakpoints( void )
+        : set_count( 0 ), armed( false )
+    {
+        reset( nullptr, 0 );
+    }
+
+    // Sizes the bitmap for the cartridge ROM at image, null for none, and clears it
+    void reset( const uint8_t* image, size_t size, bool mbc1 = false )
+    {
+        slots.reset( image, size, mbc1 );
+        bits.assign( ( slots.count() + 63 ) / 64, 0 );
+        set_count = 0;
+        armed = false;
+    }
+
+    bool hit( const Memory* m, uint16_t pc ) const
+    {
+        return test_slot( slots.slot( m, pc ) );
+    }
+
+    // Breakpoint at address in the bank m maps there now
+    bool test( const Memory* m, uint16_t address ) const
+    {
+        return hit( m, address );
+    }
+
+    void set( const Memory* m, uint16_t address, bool on )
+    {
+        assign( slots.slot( m, address ), on );
+    }
+
+    void toggle( const Memory* m, uint16_t address )
+    {
+        set( m, address, !test( m, address ) );
+    }
+
+    // Breakpoint at a CodeSlots slot, for listings of banks that aren't mapped
+    bool test_slot( size_t slot ) const
+    {
+        return ( bits[slot >> 6] >> ( slot & 63 ) ) & 1;
+    }
+
+    void toggle_slot( size_t slot )
+    {
+        assign( slot, !test_slot( slot ) );
+    }
+
+    // Breakpoint at address in every bank that can be mapped there
+    void set_everywhere( uint16_t address, bool on )
+    {
+        if ( address < 0x8000 ) {
+            for ( size_t bank = 0; bank * 0x4000 < slots.rom_size; bank++ ) {
+                if ( slots.maps( (int)bank, address ) ) {
+                    assign( slots.slot( (int)bank, address ), on );
+                }
+            }
+        }
+        assign( slots.rom_size + address, on );
+    }
+
+    size_t count( void ) const
+    {
+        return set_count;
+    }
+};
@@ -0,0 +1,376 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+#include <vector>
+#include "memory.h"
+
+// Memory bank controllers. A bank switch only points the ROM pages 0x40-0x7F
+// (0x00-0x3F for MBC1 in mode 1) and the external RAM pages 0xA0-0xBF somewhere else
+// in the ROM image or the cartridge RAM, nothing is copied. The ROM image belongs to
+// the caller and has to outlive the Cartridge.
+//
+//   MBC1  ROM bank 0x2000 (5 bits), RAM bank or ROM bank bits 5-6 at 0x4000,
+//         banking mode at 0x6000
+//   MBC3  ROM bank 0x2000 (7 bits), RAM bank 0-3 or RTC register 08-0C at 0x4000,
+//         RTC latch at 0x6000 (00 then 01)
+//   MBC5  ROM bank 0x2000 (bits 0-7) and 0x3000 (bit 8), RAM bank 0x4000 (4 bits)
+//
+// All of them enable the RAM with 0x0A in the low nibble of a write to 0x0000-0x1FFF.
+// Disabled RAM reads 0xFF and drops writes.
+
+enum class Mbc : uint8_t {
+    NONE = 0,
+    MBC1,
+    MBC3,
+    MBC5,
+};
+
+// Bank registers and clock of a Cartridge, for save states. RAM is saved apart.
+struct CartState {
+    uint8_t type; // Mbc
+    uint8_t ram_enabled;
+    uint8_t bank_lo;
+    uint8_t bank_hi;
+    uint8_t ram_bank;
+    uint8_t mode;
+    uint8_t rtc_halt;
+    uint8_t rtc_carry;
+    uint8_t rtc_latch;
+    uint8_t rtc_latched[5];
+    uint8_t pad[2];
+    uint64_t rtc_seconds;
+    int64_t rtc_stamp;
+};
+
+static_assert( sizeof( CartState ) == 32, "CartState layout" );
+
+class Cartridge
+{
+private:
+    // RTC registers selected through 0x4000
+    enum : uint8_t {
+        RTC_S = 0x08,
+        RTC_M,
+        RTC_H,
+        RTC_DL,
+        RTC_DH,
+    };
+
+    const uint8_t* rom;
+    uint32_t rom_banks; // 16kB banks in rom
+    uint8_t* ram; // ram_bytes of cartridge RAM, own_ram or the caller's
+    size_t ram_bytes;
+    std::vector<uint8_t> own_ram;
+
+    bool ram_enabled;
+    uint8_t bank_lo; // 0x2000 register
+    uint8_t bank_hi; // MBC1 0x4000 register, MBC5 bit 8 of the ROM bank
+    uint8_t ram_bank; // 0x4000 register, RTC register on MBC3 from 08
+    uint8_t mode; // MBC1 banking mode
+    uint32_t mapped_low, mapped_high; // banks the ROM pages point at, rewritten on change only
+
+    // MBC3 clock, in seconds, running off the host clock while not halted
+    uint64_t rtc_seconds; // at rtc_stamp
+    time_t rtc_stamp;
+    bool rtc_halt;
+    bool rtc_carry; // day counter overflowed
+    uint8_t rtc_latch; // last write to 0x6000
+    uint8_t rtc_latched[5]; // S M H DL DH as latched
+
+    // Bank numbers past the end of the image mirror, like the unconnected address lines
+    uint32_t rom_wrap( uint32_t bank ) const
+    {
+        return bank < rom_banks ? bank : bank % rom_banks;
+    }
+
+    // Points 64 consecutive pages at a 16kB bank
+    static void map_bank( uint8_t** pages, const uint8_t* bank )
+    {
+        uint8_t* p = const_cast<uint8_t*>( bank );
+        for ( int page = 0; page < 0x40; page++ ) {
+            pages[page] = p + page * 0x100;
+        }
+    }
+
+    // Points 0x0000-0x7FFF at the banks the registers select
+    void map_rom( Memory* m )
+    {
+        uint32_t low = 0, high;
+
+        switch ( type ) {
+        case Mbc::MBC1:
+            high = ( bank_hi << 5 ) | ( bank_lo ? bank_lo : 1 );
+            low = mode ? bank_hi << 5 : 0;
+            break;
+        case Mbc::MBC3:
+            high = bank_lo ? bank_lo : 1;
+            break;
+        case Mbc::MBC5:
+            high = ( bank_hi << 8 ) | bank_lo;
+            break;
+        default:
+            high = 1;
+            break;
+        }
+
+        low = rom_wrap( low );
+        high = rom_wrap( high );
+        if ( low == mapped_low && high == mapped_high ) {
+            return;
+        }
+
+        if ( low != mapped_low ) {
+            map_bank( &m->read_page[0x00], &rom[low * 0x4000] );
+            mapped_low = low;
+        }
+        if ( high != mapped_high ) {
+            map_bank( &m->read_page[0x40], &rom[high * 0x4000] );
+            mapped_high = high;
+        }
+
+        m->rom_bank = (uint16_t)high;
+        m->flush_fetch();
+    }
+
+    // Points 0xA000-0xBFFF at the selected RAM bank, or at the RTC or disabled handlers.
+    // MBC3 selects 0D-0F past the last RTC register, nothing answers those.
+    void map_ram( Memory* m )
+    {
+        uint8_t bank = ram_bank;
+        if ( type == Mbc::MBC1 ) {
+            bank = mode ? bank_hi : 0;
+        }
+
+        bool rtc = type == Mbc::MBC3 && bank >= RTC_S;
+        BusRead read = nullptr;
+        BusWrite write = nullptr;
+        if ( !ram_enabled || ( rtc && bank > RTC_DH ) || ( !ram_bytes && !rtc ) ) {
+            read = read_disabled;
+            write = write_disabled;
+        }
+        else if ( rtc ) {
+            read = read_rtc;
+            write = write_rtc;
+        }
+
+        for ( int page = 0; page < 0x20; page++ ) {
+            if ( read ) {
+                m->read_page[0xA0 + page] = m->write_page[0xA0 + page] = nullptr;
+            }
+            else {
+                // 2kB RAM chips repeat over the 8kB window
+                uint8_t* p = &ram[( (size_t)bank * 0x2000 + page * 0x100 ) % ram_bytes];
+                m->read_page[0xA0 + page] = m->write_page[0xA0 + page] = p;
+            }
+            m->read_handler[0xA0 + page] = read;
+            m->write_handler[0xA0 + page] = write;
+        }
+
+        m->flush_fetch();
+    }
+
+    static void write_mbc( Memory* m, uint16_t address, uint8_t value )
+    {
+        m->cart->write( m, address, value );
+    }
+
+    static uint8_t read_disabled( Memory* m, uint16_t address )
+    {
+        return 0xFF;
+    }
+
+    static void write_disabled( Memory* m, uint16_t address, uint8_t value )
+    {
+    }
+
+    static uint8_t read_rtc( Memory* m, uint16_t address )
+    {
+        Cartridge* c = m->cart;
+        return c->rtc_latched[c->ram_bank - RTC_S];
+    }
+
+    static void write_rtc( Memory* m, uint16_t address, uint8_t value )
+    {
+        m->cart->rtc_set( m->cart->ram_bank, value );
+    }
+
+    uint64_t rtc_now( void )
+    {
+        return rtc_halt ? rtc_seconds : rtc_seconds + (uint64_t)( time( nullptr ) - rtc_stamp );
+    }
+
+    // Splits the running clock into S M H DL DH
+    void rtc_split( uint8_t* regs )
+    {
+        uint64_t now = rtc_now();
+        uint64_t days = now / 86400;
+        if ( days > 0x1FF ) {
+            rtc_carry = true;
+        }
+
+        regs[0] = (uint8_t)( now % 60 );
+        regs[1] = (uint8_t)( now / 60 % 60 );
+        regs[2] = (uint8_t)( now / 3600 % 24 );
+        regs[3] = (uint8_t)days;
+        regs[4] = (uint8_t)( ( days >> 8 ) & 1 ) | ( rtc_halt ? 0x40 : 0 ) | ( rtc_carry ? 0x80 : 0 );
+    }
+
+    void rtc_set( uint8_t reg, uint8_t value )
+    {
+        uint8_t regs[5];
+        rtc_split( regs );
+        regs[reg - RTC_S] = value;
+
+        uint64_t days = regs[3] | ( ( regs[4] & 1 ) << 8 );
+        rtc_seconds = days * 86400 + ( regs[2] % 24 ) * 3600 + ( regs[1] % 60 ) * 60 + regs[0] % 60;
+        rtc_stamp = time( nullptr );
+        rtc_halt = ( regs[4] & 0x40 ) != 0;
+        rtc_carry = ( regs[4] & 0x80 ) != 0;
+        rtc_latched[reg - RTC_S] = value;
+    }
+
+public:
+    Mbc type;
+
+    // rom_size is rounded down to whole 16kB banks and has to be 32kB at least. RAM of
+    // a cartridge without MBC is always enabled. A ram_image of ram_size bytes, a
+    // battery save for one, is used in place and has to outlive the Cartridge,
+    // without one the RAM is allocated and starts out as 0xFF.
+    Cartridge( const uint8_t* rom_image, size_t rom_size, Mbc mbc, size_t ram_size, uint8_t* ram_image = nullptr )
+        : rom( rom_image ), rom_banks( (uint32_t)( rom_size / 0x4000 ) ), ram( ram_image ), ram_bytes( ram_size ), ram_enabled( mbc == Mbc::NONE ),
+          bank_lo( 1 ), bank_hi( 0 ), ram_bank( 0 ), mode( 0 ), mapped_low( ~0u ),
+          mapped_high( ~0u ), rtc_seconds( 0 ), rtc_stamp( time( nullptr ) ),
+          rtc_halt( false ), rtc_carry( false ), rtc_latch( 0xFF ), rtc_latched{ 0 }, type( mbc )
+    {
+        if ( rom_banks < 2 ) {
+            rom_banks = 2;
+        }
+        if ( !ram && ram_bytes ) {
+            own_ram.assign( ram_bytes, 0xFF );
+            ram = own_ram.data();
+        }
+    }
+
+    Cartridge( const Cartridge& ) = delete;
+    Cartridge& operator=( const Cartridge& ) = delete;
+
+    // Maps bank 0 and 1, disabled RAM, and takes over ROM writes
+    void attach( Memory* m )
+    {
+        m->cart = this;
+        mapped_low = mapped_high = ~0u;
+        for ( int page = 0; page < 0x80; page++ ) {
+            m->write_page[page] = nullptr;
+            m->write_handler[page] = write_mbc;
+        }
+
+        map_rom( m );
+        map_ram( m );
+    }
+
+    uint8_t* ram_data( void ) const
+    {
+        return ram;
+    }
+
+    size_t ram_size( void ) const
+    {
+        return ram_bytes;
+    }
+
+    void save( CartState* s ) const
+    {
+        *s = CartState{};
+        s->type = (uint8_t)type;
+        s->ram_enabled = ram_enabled;
+        s->bank_lo = bank_lo;
+        s->bank_hi = bank_hi;
+        s->ram_bank = ram_bank;
+        s->mode = mode;
+        s->rtc_halt = rtc_halt;
+        s->rtc_carry = rtc_carry;
+        s->rtc_latch = rtc_latch;
+        memcpy( s->rtc_latched, rtc_latched, sizeof( rtc_latched ) );
+        s->rtc_seconds = rtc_seconds;
+        s->rtc_stamp = (int64_t)rtc_stamp;
+    }
+
+    // Takes the registers from s and maps the banks they select. The caller checks
+    // that s is from a cartridge of the same type.
+    void load( Memory* m, const CartState* s )
+    {
+        ram_enabled = s->ram_enabled != 0;
+        bank_lo = s->bank_lo;
+        bank_hi = s->bank_hi;
+        ram_bank = s->ram_bank & 0x0F; // as the 0x4000 register would
+        mode = s->mode;
+        rtc_halt = s->rtc_halt != 0;
+        rtc_carry = s->rtc_carry != 0;
+        rtc_latch = s->rtc_latch;
+        memcpy( rtc_latched, s->rtc_latched, sizeof( rtc_latched ) );
+        rtc_seconds = s->rtc_seconds;
+        rtc_stamp = (time_t)s->rtc_stamp;
+
+        mapped_low = mapped_high = ~0u;
+        map_rom( m );
+        map_ram( m );
+    }
+
+    // MBC register write, 0x0000-0x7FFF
+    void write( Memory* m, uint16_t address, uint8_t value )
+    {
+        switch ( address >> 13 ) {
+        case 0: // 0x0000-0x1FFF RAM enable
+            if ( type != Mbc::NONE ) {
+                ram_enabled = ( value & 0x0F ) == 0x0A;
+                map_ram( m );
+            }
+            break;
+
+        case 1: // 0x2000-0x3FFF ROM bank
+            if ( type == Mbc::MBC1 ) {
+                bank_lo = value & 0x1F;
+            }
+            else if ( type == Mbc::MBC3 ) {
+                bank_lo = value & 0x7F;
+            }
+            else if ( type == Mbc::MBC5 ) {
+                if ( address < 0x3000 ) {
+                    bank_lo = value;
+                }
+                else {
+                    bank_hi = value & 1;
+                }
+            }
+            map_rom( m );
+            break;
+
+        case 2: // 0x4000-0x5FFF RAM bank, RTC register or MBC1 upper bits
+            if ( type == Mbc::MBC1 ) {
+                bank_hi = value & 3;
+                map_rom( m );
+            }
+            else {
+                ram_bank = value & 0x0F;
+            }
+            map_ram( m );
+            break;
+
+        case 3: // 0x6000-0x7FFF MBC1 mode, MBC3 RTC latch
+            if ( type == Mbc::MBC1 ) {
+                mode = value & 1;
+                map_rom( m );
+                map_ram( m );
+            }
+            else if ( type == Mbc::MBC3 ) {
+                if ( rtc_latch == 0 && value == 1 ) {
+                    rtc_split( rtc_latched );
+                }
+                rtc_latch = value;
+            }
+            break;
+        }
+    }
+};
@@ -0,0 +1,253 @@
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include "memory.h"
+#include "optable.h"
+#include "registers.h"
+#include "slots.h"
+
+// What every byte is, two bits per CodeSlots slot: opcode, operand, data or not
+// known yet. Two sources fill it in:
+//
+//   record()   the code/data logger, called by Emulator before each instruction
+//              while enabled. Marks the opcode and operand bytes at PC, and the byte
+//              a memory operand points at as data. The one instruction at a time
+//              path it needs is the only cost, a stopped logger costs nothing.
+//   explore()  recursive descent over the ROM image from the entry point, the RST
+//              and interrupt vectors and every opcode the logger has seen, following
+//              jumps and calls. The cartridge header is data. A jump from bank 0
+//              into 0x4000-0x7FFF can't tell which bank it lands in unless the ROM
+//              has only one, those are left to the logger.
+//
+// A mark only ever goes up, unknown < data < operand < opcode, so what ran as code
+// stays code. Every 16kB of slots has a version that goes up with each change, for
+// listings built from the marks.
+
+enum CodeMark : uint8_t {
+    CODE_UNKNOWN = 0,
+    CODE_DATA = 1,
+    CODE_OPERAND = 2,
+    CODE_OPCODE = 3,
+};
+
+class CodeMap
+{
+private:
+    CodeSlots slots;
+    const uint8_t* rom;
+    std::vector<uint8_t> marks; // four slots a byte, the first in the low bits
+    std::vector<uint32_t> versions; // per 0x4000 slots
+
+    void raise( size_t slot, uint8_t mark )
+    {
+        uint8_t& byte = marks[slot >> 2];
+        int shift = ( slot & 3 ) * 2;
+        if ( mark > ( ( byte >> shift ) & 3 ) ) {
+            byte = (uint8_t)( ( byte & ~( 3 << shift ) ) | ( mark << shift ) );
+            versions[slot >> 14]++;
+        }
+    }
+
+    // The byte a memory operand of kind points at, -1 for other operands
+    static int operand_address( uint8_t kind, const Registers* r, uint16_t imm16 )
+    {
+        switch ( kind ) {
+        case OPD_HL_IND:
+        case OPD_HLI_IND:
+        case OPD_HLD_IND:
+            return r->HL;
+        case OPD_BC_IND:
+            return r->BC;
+        case OPD_DE_IND:
+            return r->DE;
+        case OPD_C_IND:
+            return 0xFF00 | r->C;
+        case OPD_A8_IND:
+            return 0xFF00 | ( imm16 & 0xFF );
+        case OPD_A16_IND:
+            return imm16;
+        default:
+            return -1;
+        }
+    }
+
+    // Where the branch of the instruction at slot goes in the ROM, -1 when it leaves
+    // the ROM, its bank can't be known or it has no fixed target
+    long branch_target( size_t slot, uint16_t opcode, const OpInfo& info ) const
+    {
+        uint16_t address = slots.address( slot );
+        int target;
+        if ( info.dst == OPD_R8 || info.src == OPD_R8 ) {
+            target = (uint16_t)( address + 2 + (int8_t)rom[slot + 1] );
+        } else if ( info.name == OPN_RST ) {
+            target = opcode & 0x38;
+        } else if ( ( info.name == OPN_JP || info.name == OPN_CALL ) && ( info.dst == OPD_D16 || info.src == OPD_D16 ) ) {
+            target = rom[slot + 1] | ( rom[slot + 2] << 8 );
+        } else {
+            return -1;
+        }
+
+        if ( target < 0x4000 ) {
+            return target;
+        }
+        if ( target >= 0x8000 ) {
+            return -1;
+        }
+        int bank = slots.bank( slot );
+        if ( address < 0x4000 ) {
+            if ( slots.rom_size != 0x8000 ) {
+                return -1;
+            }
+            bank = 1;
+        }
+        return (long)slots.slot( bank, (uint16_t)target );
+    }
+
+public:
+    bool enabled; // the logger
+
+    CodeMap( void )
+        : rom( nullptr ), enabled( false )
+    {
+        reset( nullptr, 0 );
+    }
+
+    // Clears the marks for the cartridge ROM at image, null for none, and explores
+    // it. Keeps the logger running if it was.
+    void reset( const uint8_t* image, size_t size )
+    {
+        slots.reset( image, size );
+        rom = image;
+        marks.assign( ( slots.count() + 3 ) / 4, 0 );
+        versions.assign( ( slots.count() + 0x3FFF ) / 0x4000, 0 );
+        explore();
+    }
+
+    void clear( void )
+    {
+        reset( rom, slots.rom_size );
+    }
+
+    uint8_t get( size_t slot ) const
+    {
+        return ( marks[slot >> 2] >> ( ( slot & 3 ) * 2 ) ) & 3;
+    }
+
+    // Sum of the versions of the 16kB blocks slots first to last fall in, which
+    // changes whenever a mark among them does
+    uint32_t version( size_t first, size_t last ) const
+    {
+        uint32_t sum = 0;
+        for ( size_t block = first >> 14; block <= last >> 14 && block < versions.size(); block++ ) {
+            sum += versions[block];
+        }
+        return sum;
+    }
+
+    const CodeSlots& code_slots( void ) const
+    {
+        return slots;
+    }
+
+    // Marks the instruction at PC as m maps it now, before it runs
+    void record( const Memory* m, const Registers* r )
+    {
+        uint16_t pc = r->PC;
+        uint16_t opcode = m->peek( pc );
+        if ( opcode == 0xCB ) {
+            opcode = 0x100 | m->peek( pc + 1 );
+        }
+        const OpInfo& info = optable[opcode];
+
+        raise( slots.slot( m, pc ), CODE_OPCODE );
+        for ( int i = 1; i < info.length; i++ ) {
+            raise( slots.slot( m, (uint16_t)( pc + i ) ), CODE_OPERAND );
+        }
+
+        // ROM writes are MBC commands, not data
+        uint16_t imm16 = m->peek( pc + 1 ) | ( m->peek( pc + 2 ) << 8 );
+        int address = operand_address( info.src, r, imm16 );
+        if ( address >= 0 ) {
+            raise( slots.slot( m, (uint16_t)address ), CODE_DATA );
+        }
+        address = operand_address( info.dst, r, imm16 );
+        if ( address >= 0 && ( address >= 0x8000 || info.name != OPN_LD ) ) {
+            raise( slots.slot( m, (uint16_t)address ), CODE_DATA );
+        }
+    }
+
+    // Recursive descent over the ROM image, see above
+    void explore( void )
+    {
+        if ( !rom ) {
+            return;
+        }
+
+        size_t size = slots.rom_size;
+
+        // The cartridge header, logo to checksums
+        for ( size_t slot = 0x104; slot < 0x150 && slot < size; slot++ ) {
+            raise( slot, CODE_DATA );
+        }
+
+        std::vector<size_t> work;
+        static const uint16_t vectors[] = { 0x0100, 0x00, 0x08, 0x10, 0x18, 0x20, 0x28, 0x30, 0x38,
+                                            0x40, 0x48, 0x50, 0x58, 0x60 };
+        for ( uint16_t vector : vectors ) {
+            work.push_back( vector );
+        }
+        for ( size_t slot = 0; slot < size; slot++ ) {
+            if ( get( slot ) == CODE_OPCODE ) {
+                work.push_back( slot );
+            }
+        }
+
+        std::vector<bool> seen( size, false );
+        while ( !work.empty() ) {
+            size_t slot = work.back();
+            work.pop_back();
+
+            while ( slot < size && !seen[slot] ) {
+                uint16_t opcode = rom[slot];
+                if ( opcode == 0xCB && slot + 1 < size ) {
+                    opcode = 0x100 | rom[slot + 1];
+                }
+                const OpInfo& info = optable[opcode];
+                if ( ( info.control & OPC_ILLEGAL ) || ( slot & 0x3FFF ) + info.length > 0x4000 ) {
+                    break;
+                }
+
+                // Data, or operand bytes something already ran or read as a byte of
+                // its own, mean this isn't code after all
+                bool clash = get( slot ) == CODE_DATA;
+                for ( int i = 1; i < info.length; i++ ) {
+                    clash |= get( slot + i ) == CODE_OPCODE || get( slot + i ) == CODE_DATA;
+                }
+                if ( clash ) {
+                    break;
+                }
+
+                seen[slot] = true;
+                raise( slot, CODE_OPCODE );
+                for ( int i = 1; i < info.length; i++ ) {
+                    raise( slot + i, CODE_OPERAND );
+                }
+
+                long target = branch_target( slot, opcode, info );
+                if ( target >= 0 && (size_t)target < size ) {
+                    work.push_back( (size_t)target );
+                }
+
+                // JP HL and unconditional jumps and returns don't fall through
+                bool conditional = ( info.control & OPC_CONDITIONAL ) != 0;
+                if ( ( info.control & ( OPC_JUMP | OPC_RETURN ) ) && !conditional ) {
+                    break;
+                }
+                slot += info.length;
+                if ( !( slot & 0x3FFF ) ) {
+                    break;
+                }
+            }
+        }
+    }
+};
@@ -1,24 +1,111 @@
 #pragma once
+#include <algorithm>
 #include <vector>
 #include "imgui/imgui.h"
 #include "imgui/imgui_memory_editor.h"
-#include "memory.h"
-#include "registers.h"
-#include "instruction.h"
+#include "disassembly.h"
+#include "emulator.h"
+#include "optable.h"
 #include "shared.h"
 
+// ImGui windows over an Emulator: memory editor, registers with run/step/break, the
+// disassembly, where clicking a line toggles a breakpoint and the code/data logger
+// is switched on, watchpoints, the call stack, and the profiler, where clicking a
+// line shows it in the disassembly. Labels come from the RGBDS symbols the
+// Emulator loaded with the ROM or the disassembly window loads.
+
 class Debugger
 {
 private:
     MemoryEditor mViewer;
+    Disassembly listing;
+    const uint8_t* listing_rom; // ROM image the listing was made for
+    char listing_path[256];
+    const char* listing_status;
+    int scroll_to; // line the disassembly scrolls to next frame, -1 for none
+    char goto_text[64]; // "Label+0x10", "BB:AAAA" or "AAAA"
+    const char* goto_status;
+    char sym_path[256];
+    const char* sym_status;
+
+    std::vector<ProfileEntry> hot; // profiler snapshot, hottest first
+    int hot_age; // frames since the snapshot
+    char csv_path[256];
+    const char* csv_status;
+
+    uint16_t watch_first; // range the Watchpoints window adds next
+    uint16_t watch_last;
+    bool watch_kinds[3]; // read, write, change
+
+    // The editor is handed mem->map, which is where Memory starts. It goes through
+    // peek/poke so it sees the banks that are mapped in and never triggers I/O.
+    static ImU8 read_memory( const ImU8* data, size_t off )
+    {
+        return ( (const Memory*)data )->peek( (uint16_t)off );
+    }
+
+    static void write_memory( ImU8* data, size_t off, ImU8 d )
+    {
+        ( (Memory*)data )->poke( (uint16_t)off, d );
+        edited = true;
+    }
+
+    // Bank of the ROM address as mem maps it now, -1 on the bus
+    static int mapped_bank( const Memory* mem, uint16_t address )
+    {
+        return address < 0x4000 ? 0 : address < 0x8000 ? mem->rom_bank : -1;
+    }
+
+    // Line of the disassembly text names, a label with an optional offset or a hex
+    // address with an optional bank, its label when it has one. count() for none.
+    size_t resolve( Emulator* emu, const char* text )
+    {
+        int bank = -1;
+        uint16_t address;
+        size_t line = listing.count();
+        char* end;
+        if ( !emu->symbols()->find( text, &bank, &address ) ) {
+            unsigned long value = strtoul( text, &end, 16 );
+            if ( end == text ) {
+                return line;
+            }
+            if ( *end == ':' ) {
+                bank = (int)value;
+                value = strtoul( end + 1, &end, 16 );
+            }
+            if ( *end || value > 0xFFFF ) {
+                return line;
+            }
+            address = (uint16_t)value;
+            if ( bank >= 0 && address < 0x4000 ) {
+                bank = 0;
+            }
+        }
+
+        if ( bank >= 0 || address >= 0x8000 ) {
+            line = listing.find( address < 0x8000 ? bank : -1, address );
+        }
+        if ( line == listing.count() ) {
+            // A bare address, or a bank the listing doesn't have: as mapped now
+            line = listing.find( emu->memory(), address );
+        }
+        if ( line > 0 && line < listing.count() && listing.label( line - 1 ) ) {
+            line--;
+        }
+        return line;
+    }
 
 public:
-    std::vector< uint16_t > bps;
-    StepState sstate;
+    // Set when the memory editor changed a byte, for cores that cache decoded memory
+    static bool edited;
 
     Debugger( void )
+        : listing_rom( nullptr ), listing_path( "listing.asm" ), listing_status( "" ), scroll_to( -1 ), goto_text( "" ),
+          goto_status( "" ), sym_path( "" ), sym_status( "" ), hot_age( 0 ), csv_path( "profile.csv" ), csv_status( "" ),
+          watch_first( 0xC000 ), watch_last( 0xC000 ), watch_kinds{ false, true, false }
     {
-        bps.reserve( 100 );
+        mViewer.ReadFn = read_memory;
+        mViewer.WriteFn = write_memory;
     }
 
     ~Debugger( void )
@@ -30,8 +117,25 @@ public:
         mViewer.DrawWindow( "Memory", mem->map, sizeof( mem->map ) );
     }
 
-    void show_registers( Registers* r )
+    void show( Emulator* emu )
     {
+        show_memory( emu->memory() );
+        show_registers( emu->registers(), emu->sstate );
+        show_disassembly( emu );
+        show_watchpoints( emu );
+        show_call_stack( emu );
+        show_profiler( emu );
+
+        // The memory editor writes behind the core's back
+        if ( edited ) {
+            emu->memory_changed();
+            edited = false;
+        }
+    }
+
+    void show_registers( Registers* r, StepState& sstate )
+    {
+        r->sync_flags(); // the flag checkboxes edit F directly
         ImGui::Begin( "Registers" );
         ImGui::Indent( 10.0f );
         ImGui::AlignTextToFramePadding();
@@ -162,38 +266,273 @@ public:
         ImGui::End();
     }
 
-    void show_disassembly( Memory* mem, Registers* r, Instruction** op )
+    // Only the lines on screen are formatted, see disassembly.h
+    void show_disassembly( Emulator* emu )
     {
+        Memory* mem = emu->memory();
+        if ( emu->rom_image() != listing_rom ) {
+            listing_rom = emu->rom_image();
+            listing.reset( listing_rom, emu->rom_size() );
+        }
+        CodeMap* code = emu->code_map();
+        Symbols* symbols = emu->symbols();
+        listing.refresh( mem, code, symbols );
+        int pc_line = (int)listing.find( mem, emu->registers()->PC );
+
         ImGui::Begin( "Disassembly" );
+        if ( ImGui::Button( "Go to PC" ) ) {
+            scroll_to = pc_line;
+        }
+        ImGui::SameLine();
+        ImGui::Checkbox( "Log code", &code->enabled );
+        ImGui::SameLine();
+        if ( ImGui::Button( "Explore" ) ) {
+            code->explore();
+        }
+        ImGui::SameLine();
+        if ( ImGui::Button( "Export" ) ) {
+            listing_status = listing.save( listing_path ) ? "written" : "unable to write";
+        }
+        ImGui::SameLine();
+        ImGui::PushItemWidth( 200.0f );
+        ImGui::InputText( "##listing_path", listing_path, sizeof( listing_path ) );
+        ImGui::PopItemWidth();
+        ImGui::SameLine();
+        ImGui::Text( "%s", listing_status );
+
+        ImGui::PushItemWidth( 200.0f );
+        bool go = ImGui::InputText( "##goto", goto_text, sizeof( goto_text ), ImGuiInputTextFlags_EnterReturnsTrue );
+        ImGui::SameLine();
+        go |= ImGui::Button( "Go to" );
+        if ( go ) {
+            size_t line = resolve( emu, goto_text );
+            goto_status = line < listing.count() ? "" : "not found";
+            if ( line < listing.count() ) {
+                scroll_to = (int)line;
+            }
+        }
+        ImGui::SameLine();
+        ImGui::Text( "%s", goto_status );
+        ImGui::SameLine();
+        ImGui::InputText( "##sym_path", sym_path, sizeof( sym_path ) );
+        ImGui::PopItemWidth();
+        ImGui::SameLine();
+        if ( ImGui::Button( "Load symbols" ) ) {
+            sym_status = symbols->load( sym_path ) ? "" : "unable to read";
+            // The label lines drawn below come from the labels refresh() saw
+            listing.refresh( mem, code, symbols );
+            pc_line = (int)listing.find( mem, emu->registers()->PC );
+        }
+        ImGui::SameLine();
+        ImGui::Text( "%zu labels %s", symbols->count(), sym_status );
+
+        ImGui::BeginChild( "##listing" );
+        float height = ImGui::GetTextLineHeightWithSpacing();
+        if ( scroll_to >= 0 ) {
+            ImGui::SetScrollY( scroll_to * height - ImGui::GetWindowHeight() * 0.25f );
+            scroll_to = -1;
+        }
+
+        ImGuiListClipper clipper( (int)listing.count(), height );
+        while ( clipper.Step() ) {
+            for ( int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++ ) {
+                char dis[128] = "  ";
+                listing.text( &dis[2], sizeof( dis ) - 2, i );
+                if ( listing.label( i ) ) {
+                    ImGui::TextUnformatted( &dis[2] );
+                    continue;
+                }
+                if ( i == pc_line ) {
+                    dis[0] = '>';
+                }
 
-        // TODO: Implement ImGui List Clipper
+                size_t slot = listing.slot( i );
+                if ( ImGui::Selectable( dis, emu->bps.test_slot( slot ) ) ) {
+                    emu->bps.toggle_slot( slot );
+                }
+            }
+        }
 
-        for ( uint16_t addr = 0; addr < _countof( mem->rom ); ) {
+        ImGui::EndChild();
+        ImGui::End();
+    }
 
-            Instruction* cur = op[mem->rom[addr]];
+    void show_watchpoints( Emulator* emu )
+    {
+        static const char* const names[] = { "read", "write", "change" };
+        Watchpoints* watch = &emu->watch;
+        ImGui::Begin( "Watchpoints" );
 
-            char dis[64];
-            snprintf( dis, sizeof( dis ), "  %04X: ", addr );
+        ImGui::PushItemWidth( 40.0f );
+        ImGui::InputScalar( "##first", ImGuiDataType_U16, &watch_first, nullptr, nullptr, "%04X",
+                            ImGuiInputTextFlags_CharsHexadecimal );
+        ImGui::SameLine();
+        ImGui::Text( "-" );
+        ImGui::SameLine();
+        ImGui::InputScalar( "##last", ImGuiDataType_U16, &watch_last, nullptr, nullptr, "%04X",
+                            ImGuiInputTextFlags_CharsHexadecimal );
+        ImGui::PopItemWidth();
+        uint8_t kinds = 0;
+        for ( int i = 0; i < 3; i++ ) {
+            ImGui::SameLine();
+            ImGui::Checkbox( names[i], &watch_kinds[i] );
+            kinds |= watch_kinds[i] ? 1 << i : 0;
+        }
+        ImGui::SameLine();
+        if ( ImGui::Button( "Add" ) ) {
+            watch->add( emu->memory(), watch_first, watch_first > watch_last ? watch_first : watch_last, kinds );
+        }
 
-            cur->dis( &dis[8], sizeof( dis ) - 8, mem, addr );
+        if ( watch->hits ) {
+            const WatchHit& hit = watch->hit;
+            ImGui::Text( "Last hit: %s %04X %02X->%02X at PC %04X", names[hit.kind >> 1], hit.address, hit.before,
+                         hit.after, hit.pc );
+        }
 
-            if ( r->PC == addr ) {
-                dis[0] = '>';
+        const std::vector<Watchpoint>& list = watch->list();
+        for ( size_t i = 0; i < list.size(); i++ ) {
+            const Watchpoint& w = list[i];
+            ImGui::PushID( (int)i );
+            if ( ImGui::SmallButton( "x" ) ) {
+                watch->remove( emu->memory(), i );
+                ImGui::PopID();
+                break;
             }
+            ImGui::SameLine();
+            ImGui::Text( "%04X-%04X %s%s%s", w.first, w.last, ( w.kinds & WATCH_READ ) ? "r" : "-",
+                         ( w.kinds & WATCH_WRITE ) ? "w" : "-", ( w.kinds & WATCH_CHANGE ) ? "c" : "-" );
+            ImGui::PopID();
+        }
 
-            bool selected = std::find( bps.begin(), bps.end(), addr ) != bps.end();
-            if ( ImGui::Selectable( dis, selected ) ) {
-                if ( selected ) {
-                    bps.erase( std::find( bps.begin(), bps.end(), addr ) );
-                } else {
-                    bps.push_back( addr );
-                }
+        ImGui::End();
+    }
+
+    // Return addresses on the stack from SP up. The stack keeps no frames, so a word
+    // counts as one when the bytes before it, as mapped now, are a CALL or RST that
+    // would have pushed it. Interrupts push the PC of any instruction and don't show.
+    void show_call_stack( Emulator* emu )
+    {
+        static const int DEPTH = 64; // words looked at
+        const Memory* mem = emu->memory();
+        const Symbols* symbols = emu->symbols();
+        uint16_t pc = emu->registers()->PC;
+        ImGui::Begin( "Call stack" );
+
+        char name[96] = "";
+        char line[128];
+        symbols->format( name, sizeof( name ), mapped_bank( mem, pc ), pc );
+        snprintf( line, sizeof( line ), "PC      %04X  %s##pc", pc, name );
+        if ( ImGui::Selectable( line ) ) {
+            scroll_to = (int)listing.find( mem, pc );
+        }
+
+        uint32_t sp = emu->registers()->SP;
+        for ( int i = 0; i < DEPTH && sp + 1 <= 0xFFFF; i++, sp += 2 ) {
+            uint16_t word = mem->peek( (uint16_t)sp ) | ( mem->peek( (uint16_t)( sp + 1 ) ) << 8 );
+            uint8_t call = mem->peek( (uint16_t)( word - 3 ) );
+            bool by_call = call == 0xCD || ( call & 0xE7 ) == 0xC4;
+            bool by_rst = ( mem->peek( (uint16_t)( word - 1 ) ) & 0xC7 ) == 0xC7;
+            if ( !by_call && !by_rst ) {
+                continue;
+            }
+
+            uint16_t site = (uint16_t)( word - ( by_call ? 3 : 1 ) );
+            name[0] = 0;
+            symbols->format( name, sizeof( name ), mapped_bank( mem, site ), site );
+            snprintf( line, sizeof( line ), "SP+%02X   %04X  %s##%d", (unsigned)( sp - emu->registers()->SP ), site,
+                      name, i );
+            if ( ImGui::Selectable( line ) ) {
+                scroll_to = (int)listing.find( mem, site );
             }
+        }
+
+        ImGui::End();
+    }
 
+    // Hottest addresses first, refreshed twice a second since sorting the counters
+    // of a large ROM every frame would cost more than the window is worth
+    void show_profiler( Emulator* emu )
+    {
+        Profiler* profiler = emu->profiler();
+        ImGui::Begin( "Profiler" );
 
-            addr += cur->length;
+        bool on = profiler->enabled;
+        if ( ImGui::Checkbox( "Record", &on ) ) {
+            on ? profiler->start() : profiler->stop();
+        }
+        ImGui::SameLine();
+        if ( ImGui::Button( "Clear" ) ) {
+            profiler->clear();
+            hot.clear();
+        }
+        ImGui::SameLine();
+        if ( ImGui::Button( "Export CSV" ) ) {
+            csv_status = profiler->export_csv( csv_path ) ? "written" : "unable to write";
+        }
+        ImGui::SameLine();
+        ImGui::PushItemWidth( 200.0f );
+        ImGui::InputText( "##csv", csv_path, sizeof( csv_path ) );
+        ImGui::PopItemWidth();
+        ImGui::SameLine();
+        ImGui::Text( "%s", csv_status );
+
+        if ( profiler->enabled && ++hot_age >= 30 ) {
+            hot = profiler->entries();
+            hot_age = 0;
+        }
+
+        uint64_t total = profiler->total_cycles();
+        ImGuiTableFlags flags = ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable;
+        if ( ImGui::BeginTable( "##hot", 6, flags ) ) {
+            ImGui::TableSetupColumn( "Address" );
+            ImGui::TableSetupColumn( "Symbol" );
+            ImGui::TableSetupColumn( "Instruction" );
+            ImGui::TableSetupColumn( "Count" );
+            ImGui::TableSetupColumn( "Cycles" );
+            ImGui::TableSetupColumn( "%" );
+            ImGui::TableAutoHeaders();
+
+            ImGuiListClipper clipper( (int)hot.size() );
+            while ( clipper.Step() ) {
+                for ( int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++ ) {
+                    const ProfileEntry& e = hot[i];
+                    char label[32];
+                    if ( e.bank >= 0 ) {
+                        snprintf( label, sizeof( label ), "%02X:%04X##%d", e.bank, e.address, i );
+                    } else {
+                        snprintf( label, sizeof( label ), "  %04X##%d", e.address, i );
+                    }
+
+                    ImGui::TableNextRow();
+                    ImGui::TableSetColumnIndex( 0 );
+                    if ( ImGui::Selectable( label, false, ImGuiSelectableFlags_SpanAllColumns ) ) {
+                        scroll_to = (int)listing.find( e.bank, e.address );
+                    }
+
+                    // Banks that aren't mapped now would disassemble to whatever is
+                    char dis[64] = "";
+                    if ( e.bank < 0 || e.address < 0x4000 || e.bank == emu->memory()->rom_bank ) {
+                        optable.dis( dis, sizeof( dis ), emu->memory(), e.address );
+                    }
+                    char name[96] = "";
+                    emu->symbols()->format( name, sizeof( name ), e.bank, e.address );
+                    ImGui::TableSetColumnIndex( 1 );
+                    ImGui::Text( "%s", name );
+                    ImGui::TableSetColumnIndex( 2 );
+                    ImGui::Text( "%s", dis );
+                    ImGui::TableSetColumnIndex( 3 );
+                    ImGui::Text( "%llu", (unsigned long long)e.count );
+                    ImGui::TableSetColumnIndex( 4 );
+                    ImGui::Text( "%llu", (unsigned long long)e.cycles );
+                    ImGui::TableSetColumnIndex( 5 );
+                    ImGui::Text( "%.2f", total ? 100.0 * e.cycles / total : 0.0 );
+                }
+            }
+            ImGui::EndTable();
         }
 
         ImGui::End();
     }
-};
\ No newline at end of file
+};
+
+bool Debugger::edited = false;
@@ -0,0 +1,424 @@
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+#include "codemap.h"
+#include "memory.h"
+#include "optable.h"
+#include "slots.h"
+#include "symbols.h"
+
+// The listing the debugger scrolls through, as an index of where every line starts
+// so only the lines on screen are ever formatted. It covers every bank of the
+// cartridge ROM, bank 0 at 0x0000 and the others at 0x4000, then WRAM and HRAM.
+// Without a cartridge the first 32kB are the bus as mapped, boot ROM included.
+//
+// The sweep follows a CodeMap when there is one: marked opcodes start instructions,
+// data and stray operand bytes become DB lines of up to 8 bytes, and bytes nobody
+// has marked are decoded as instructions unless that would swallow a marked byte.
+// Without one it is a plain linear sweep.
+//
+// ROM banks are read from the image, which never changes, so they are swept again
+// only when their marks change and a bank switch only moves the PC marker. The bus
+// regions keep a copy of what they were swept from, refresh() compares it page by
+// page and sweeps again only the regions where a page was written.
+//
+// With Symbols every label gets a line of its own before the address it names, and
+// jumps, calls and memory operands get the label of their target as a comment.
+// Loading other symbols sweeps everything again.
+
+struct DisRegion {
+    int bank; // ROM bank, -1 for the bus
+    uint16_t start;
+    uint32_t end; // exclusive
+    const uint8_t* image; // bytes of a ROM bank, null for the bus
+    std::vector<uint8_t> copy; // what a bus region was swept from
+    std::vector<uint16_t> lines; // address of every line
+    std::vector<uint8_t> data; // bytes of a DB line, 0 for an instruction, LABEL_LINE
+    size_t first; // index of the first line in the whole listing
+    uint32_t version; // of the marks it was swept with
+};
+
+class Disassembly
+{
+private:
+    static constexpr uint8_t LABEL_LINE = 0xFF;
+
+    CodeSlots slots;
+    std::vector<DisRegion> regions;
+    size_t total; // lines
+    Memory* view; // the instruction being formatted, at its address
+    const Symbols* symbols; // null for none
+    uint32_t symbols_version; // of what the regions were swept with
+
+    void add( int bank, uint16_t start, uint32_t end, const uint8_t* image )
+    {
+        DisRegion region;
+        region.bank = bank;
+        region.start = start;
+        region.end = end;
+        region.image = image;
+        region.first = 0;
+        region.version = 0;
+        if ( !image ) {
+            region.copy.assign( end - start, 0 );
+        }
+        regions.push_back( region );
+    }
+
+    // First and last slot of region
+    size_t first_slot( const DisRegion& region ) const
+    {
+        return slots.slot( region.bank, region.start );
+    }
+
+    size_t last_slot( const DisRegion& region ) const
+    {
+        return first_slot( region ) + ( region.end - region.start ) - 1;
+    }
+
+    // One line per instruction by the length of its opcode, see above for the marks
+    void sweep( DisRegion* region, const uint8_t* data, const CodeMap* map )
+    {
+        region->lines.clear();
+        region->data.clear();
+        uint32_t size = region->end - region->start;
+        size_t base = first_slot( *region );
+
+        for ( uint32_t offset = 0; offset < size; ) {
+            uint32_t length = optable[data[offset]].length;
+            uint8_t mark = map ? map->get( base + offset ) : CODE_UNKNOWN;
+            bool code = mark == CODE_OPCODE;
+            if ( mark == CODE_UNKNOWN ) {
+                code = true;
+                for ( uint32_t i = 1; map && i < length && offset + i < size; i++ ) {
+                    code &= map->get( base + offset + i ) == CODE_UNKNOWN;
+                }
+            }
+
+            uint32_t n = length;
+            if ( !code ) {
+                // Data up to an 8 byte boundary, a byte that may be code or a label
+                n = 1;
+                while ( offset + n < size && ( ( region->start + offset + n ) & 7 ) ) {
+                    uint8_t next = map->get( base + offset + n );
+                    if ( next != CODE_DATA && next != CODE_OPERAND ) {
+                        break;
+                    }
+                    if ( symbols && symbols->at( region->bank, (uint16_t)( region->start + offset + n ) ) ) {
+                        break;
+                    }
+                    n++;
+                }
+            }
+
+            uint16_t address = (uint16_t)( region->start + offset );
+            if ( symbols && symbols->at( region->bank, address ) ) {
+                region->lines.push_back( address );
+                region->data.push_back( LABEL_LINE );
+            }
+            region->lines.push_back( address );
+            region->data.push_back( code ? 0 : (uint8_t)n );
+            offset += n;
+        }
+    }
+
+    void number( void )
+    {
+        total = 0;
+        for ( DisRegion& region : regions ) {
+            region.first = total;
+            total += region.lines.size();
+        }
+    }
+
+    // Region of line index
+    size_t region_of( size_t index ) const
+    {
+        size_t lo = 0, hi = regions.size();
+        while ( hi - lo > 1 ) {
+            size_t mid = ( lo + hi ) / 2;
+            if ( regions[mid].first <= index ) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+
+    // "  ; Label" for the target of the instruction at addr in view into dst, returns
+    // 0 when it has none or no label. A target in 0x4000-0x7FFF seen from bank 0
+    // could be in any bank, those get no comment.
+    int target( char* dst, size_t size, const DisRegion& region, uint16_t addr ) const
+    {
+        uint8_t opcode = view->peek( addr );
+        if ( opcode == 0xCB ) {
+            return 0;
+        }
+        const OpInfo& info = optable[opcode];
+        uint16_t imm16 = view->peek( addr + 1 ) | ( view->peek( addr + 2 ) << 8 );
+
+        // Branches land inside a routine as Label+0x12, data only gets the label it
+        // hits exactly: the closest one below could be an unrelated variable, and a
+        // 16-bit load is as likely a number as an address
+        int at = -1;
+        bool exact = true;
+        for ( uint8_t kind : { info.dst, info.src } ) {
+            if ( kind == OPD_R8 ) {
+                at = (uint16_t)( addr + 2 + (int8_t)( imm16 & 0xFF ) );
+                exact = false;
+            } else if ( kind == OPD_A8_IND ) {
+                at = 0xFF00 | ( imm16 & 0xFF );
+            } else if ( kind == OPD_A16_IND ) {
+                at = imm16;
+            } else if ( kind == OPD_D16 ) {
+                at = imm16;
+                exact = info.name != OPN_JP && info.name != OPN_CALL;
+            }
+        }
+        if ( info.name == OPN_RST ) {
+            at = opcode & 0x38;
+            exact = false;
+        }
+        if ( at < 0 ) {
+            return 0;
+        }
+
+        int bank = region.bank;
+        if ( at >= 0x4000 && at < 0x8000 && bank <= 0 ) {
+            if ( slots.rom_size != 0x8000 ) {
+                return 0;
+            }
+            bank = 1;
+        }
+        if ( exact ) {
+            const char* name = symbols->at( bank, (uint16_t)at );
+            return name ? snprintf( dst, size, "  ; %s", name ) : 0;
+        }
+        int n = snprintf( dst, size, "  ; " );
+        int label = n > 0 && (size_t)n < size ? symbols->format( dst + n, size - n, bank, (uint16_t)at ) : 0;
+        if ( !label ) {
+            *dst = 0;
+            return 0;
+        }
+        return n + label;
+    }
+
+public:
+    Disassembly( void )
+        : total( 0 ), view( new Memory() ), symbols( nullptr ), symbols_version( 0 )
+    {
+        reset( nullptr, 0 );
+    }
+
+    ~Disassembly( void )
+    {
+        delete view;
+    }
+
+    Disassembly( const Disassembly& ) = delete;
+    Disassembly& operator=( const Disassembly& ) = delete;
+
+    // Regions for the cartridge ROM at image, null for none, swept on the next
+    // refresh()
+    void reset( const uint8_t* image, size_t size )
+    {
+        slots.reset( image, size );
+        regions.clear();
+
+        if ( image ) {
+            for ( size_t bank = 0; ( bank + 1 ) * 0x4000 <= size; bank++ ) {
+                add( (int)bank, bank ? 0x4000 : 0x0000, bank ? 0x8000 : 0x4000, image + bank * 0x4000 );
+            }
+        } else {
+            add( -1, 0x0000, 0x8000, nullptr );
+        }
+        add( -1, 0xC000, 0xE000, nullptr );
+        add( -1, 0xFF80, 0xFFFF, nullptr );
+        number();
+    }
+
+    // Sweeps again the regions whose marks in map changed and the bus regions where
+    // m differs from the copy they were swept from, and all of them when syms are
+    // other symbols than last time. map and syms may be null, map has to be for the
+    // same ROM. Returns whether the listing changed.
+    bool refresh( const Memory* m, const CodeMap* map = nullptr, const Symbols* syms = nullptr )
+    {
+        bool relabel = syms != symbols || ( syms && syms->version != symbols_version );
+        symbols = syms;
+        symbols_version = syms ? syms->version : 0;
+
+        bool changed = false;
+        for ( DisRegion& region : regions ) {
+            uint32_t version = map ? map->version( first_slot( region ), last_slot( region ) ) : 0;
+            // never swept, marked since or labelled differently
+            bool written = region.lines.empty() || version != region.version || relabel;
+            region.version = version;
+            if ( region.image ) {
+                if ( written ) {
+                    sweep( &region, region.image, map );
+                    changed = true;
+                }
+                continue;
+            }
+
+            for ( uint32_t address = region.start; address < region.end; ) {
+                uint32_t next = std::min<uint32_t>( ( address | 0xFF ) + 1, region.end );
+                uint8_t* copy = &region.copy[address - region.start];
+                const uint8_t* host = m->read_page[address >> 8];
+                if ( !host && m->overlay ) {
+                    host = m->overlay->read_host( address >> 8 );
+                }
+
+                if ( host ) {
+                    if ( memcmp( copy, &host[address & 0xFF], next - address ) ) {
+                        memcpy( copy, &host[address & 0xFF], next - address );
+                        written = true;
+                    }
+                } else {
+                    for ( uint32_t a = address; a < next; a++ ) {
+                        uint8_t value = m->peek( (uint16_t)a );
+                        written |= copy[a - address] != value;
+                        copy[a - address] = value;
+                    }
+                }
+                address = next;
+            }
+
+            if ( written ) {
+                sweep( &region, region.copy.data(), map );
+                changed = true;
+            }
+        }
+
+        if ( changed ) {
+            number();
+        }
+        return changed;
+    }
+
+    size_t count( void ) const
+    {
+        return total;
+    }
+
+    uint16_t address( size_t index ) const
+    {
+        const DisRegion& region = regions[region_of( index )];
+        return region.lines[index - region.first];
+    }
+
+    // ROM bank of line index, -1 on the bus
+    int bank( size_t index ) const
+    {
+        return regions[region_of( index )].bank;
+    }
+
+    // CodeSlots slot of line index, to compare with the slot of PC or a breakpoint
+    size_t slot( size_t index ) const
+    {
+        const DisRegion& region = regions[region_of( index )];
+        return slots.slot( region.bank, region.lines[index - region.first] );
+    }
+
+    // Whether line index is a label rather than the bytes at its address
+    bool label( size_t index ) const
+    {
+        const DisRegion& region = regions[region_of( index )];
+        return region.data[index - region.first] == LABEL_LINE;
+    }
+
+    // Line that holds address of bank, the one just before when address is inside
+    // an instruction, never its label. Bus addresses take bank -1, ROM ones the bank
+    // mapped there. Returns count() when no region has it.
+    size_t find( int bank, uint16_t address ) const
+    {
+        for ( const DisRegion& region : regions ) {
+            bool inside = address >= region.start && address < region.end;
+            if ( !inside || region.bank != bank || region.lines.empty() ) {
+                continue;
+            }
+            auto it = std::upper_bound( region.lines.begin(), region.lines.end(), address );
+            return region.first + ( it - region.lines.begin() ) - 1;
+        }
+        return total;
+    }
+
+    // Line that holds address as m maps it now
+    size_t find( const Memory* m, uint16_t address ) const
+    {
+        size_t at = slots.slot( m, address );
+        int in = slots.bank( at );
+        return find( in, in >= 0 ? slots.address( at ) : address );
+    }
+
+    // Writes line index as "BB:AAAA  instruction", or "   AAAA  instruction" on the
+    // bus, or a label line as "Label:", and returns its length in bytes, 0 for a label
+    int text( char* dst, size_t size, size_t index )
+    {
+        const DisRegion& region = regions[region_of( index )];
+        uint16_t addr = region.lines[index - region.first];
+        uint8_t bytes = region.data[index - region.first];
+        const uint8_t* data = region.image ? region.image : region.copy.data();
+
+        if ( bytes == LABEL_LINE ) {
+            const char* name = symbols->at( region.bank, addr );
+            snprintf( dst, size, "%s:", name ? name : "?" );
+            return 0;
+        }
+        if ( bytes ) {
+            int n = region.bank >= 0 ? snprintf( dst, size, "%02X:%04X  DB ", region.bank, addr )
+                                     : snprintf( dst, size, "   %04X  DB ", addr );
+            for ( int i = 0; i < bytes && n > 0 && (size_t)n < size; i++ ) {
+                n += snprintf( dst + n, size - n, i ? ", 0x%02x" : "0x%02x", data[addr - region.start + i] );
+            }
+            return bytes;
+        }
+
+        // Bytes past the end of the region read as zeros
+        for ( uint32_t k = 0; k < 3; k++ ) {
+            uint32_t at = addr + k;
+            view->map[at & 0xFFFF] = at < region.end ? data[at - region.start] : 0;
+        }
+
+        int n = region.bank >= 0 ? snprintf( dst, size, "%02X:%04X  ", region.bank, addr )
+                                 : snprintf( dst, size, "   %04X  ", addr );
+        int length = 1;
+        if ( n > 0 && (size_t)n < size ) {
+            length = optable.dis( dst + n, size - n, view, addr );
+            n += (int)strlen( dst + n );
+            if ( symbols && (size_t)n < size ) {
+                target( dst + n, size - n, region, addr );
+            }
+        }
+        return length;
+    }
+
+    // Every line, bank by bank, to path. False when it can't be written.
+    bool save( const char* path )
+    {
+        FILE* hFile = fopen( path, "w" );
+        if ( !hFile ) {
+            return false;
+        }
+
+        for ( size_t i = 0; i < total; i++ ) {
+            if ( i == regions[region_of( i )].first ) {
+                const DisRegion& region = regions[region_of( i )];
+                if ( region.bank >= 0 ) {
+                    fprintf( hFile, "%s; ROM bank %02X\n", i ? "\n" : "", region.bank );
+                } else {
+                    fprintf( hFile, "%s; %04X-%04X\n", i ? "\n" : "", region.start, region.end - 1 );
+                }
+            }
+            char line[96];
+            text( line, sizeof( line ), i );
+            fprintf( hFile, "%s\n", line );
+        }
+
+        return fclose( hFile ) == 0;
+    }
+};
@@ -15,6 +15,32 @@
 #include "glfw3.h"
 
 #include "emulator.h"
+#include "debugger.h"
+
+// Tile 0 of VRAM as 2-bit pixel values
+static void draw_tile( Emulator* emu )
+{
+    // tile is 16 bytes array
+    uint8_t* tile = emu->memory()->vram.tile( 0 );
+
+    // tile row is 2 bytes each
+    for ( int row = 0; row < 8; row++ ) {
+
+        uint8_t* trow = &tile[row * 2];
+
+        for ( int col = 7; col >= 0; col-- ) {
+
+            uint8_t pixel = 0;
+            pixel = trow[0] & ( 1 << col );
+            pixel <<= 1;
+            pixel |= trow[1] & ( 1 << col );
+            ImGui::Text( "%d", pixel );
+            if ( col ) {
+                ImGui::SameLine();
+            }
+        }
+    }
+}
 
 
 
@@ -22,7 +48,10 @@
 void wingb( GLFWwindow* window )
 {
     static Emulator* emu = new Emulator();
+    static Debugger* debugger = new Debugger();
     static bool dbg = true;
+    static bool keep_rewind = true; // keep the last minutes to run backwards
+    static const char* failed = nullptr; // what went wrong in File > Open
 
     if ( ImGui::BeginMainMenuBar() ) {
         if ( ImGui::BeginMenu( "File" ) ) {
@@ -37,13 +66,22 @@ void wingb( GLFWwindow* window )
                 ofile.nMaxFile = sizeof( fpath );
 
                 if ( GetOpenFileNameA( &ofile ) ) {
+                    emu->load( fpath );
+                    failed = emu->load_error();
                 }
 #elif __gnu_linux__
                 char fpath[1024];
                 FILE* hFile = popen( "zenity --file-selection", "r" );
-                fgets( fpath, sizeof( fpath ), hFile );
-                if ( fpath[strlen( fpath ) - 1] == '\n' ) {
-                    fpath[strlen( fpath ) - 1] = 0;
+                if ( hFile ) {
+                    // Nothing comes back when the dialog is cancelled
+                    if ( fgets( fpath, sizeof( fpath ), hFile ) ) {
+                        if ( fpath[strlen( fpath ) - 1] == '\n' ) {
+                            fpath[strlen( fpath ) - 1] = 0;
+                        }
+                        emu->load( fpath );
+                        failed = emu->load_error();
+                    }
+                    pclose( hFile );
                 }
 #endif
 
@@ -56,8 +94,20 @@ void wingb( GLFWwindow* window )
 
         if ( ImGui::BeginMenu( "Settings" ) ) {
             ImGui::Checkbox( "Debugger", &dbg );
+            ImGui::Checkbox( "Rewind", &keep_rewind );
             ImGui::EndMenu();
         }
+        emu->enable_rewind( keep_rewind );
+
+        // Runs the game backwards for as long as it is held down
+        if ( keep_rewind ) {
+            ImGui::Button( "Rewind" );
+            emu->set_rewinding( ImGui::IsItemActive() );
+            ImGui::Text( "%.0fs", emu->rewind_seconds() );
+        }
+        else {
+            emu->set_rewinding( false );
+        }
 
         ImGui::Indent( ImGui::GetWindowWidth() - ImGui::GetFontSize() * 7 );
         ImGui::Text( "(%.1f FPS)", ImGui::GetIO().Framerate );
@@ -66,15 +116,25 @@ void wingb( GLFWwindow* window )
         ImGui::EndMainMenuBar();
     }
 
-    if ( dbg ) {
-        emu->debugger();    
+    if ( failed ) {
+        ImGui::OpenPopup( "Open" );
+    }
+    if ( ImGui::BeginPopupModal( "Open", nullptr, ImGuiWindowFlags_AlwaysAutoResize ) ) {
+        ImGui::Text( "%s", failed ? failed : "" );
+        if ( ImGui::Button( "OK" ) ) {
+            failed = nullptr;
+            ImGui::CloseCurrentPopup();
+        }
+        ImGui::EndPopup();
     }
 
-    for ( int cycle = 0; cycle < 70221; cycle += 8 ) {
-        emu->step();
+    if ( dbg ) {
+        debugger->show( emu );
     }
 
+    emu->run_frame();
+
     ImGui::Begin( "Main" );
-    emu->draw();
+    draw_tile( emu );
     ImGui::End();
 }
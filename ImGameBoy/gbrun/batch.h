@@ -0,0 +1,272 @@
+#pragma once
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <mutex>
+#include "run.h"
+#include "pool.h"
+
+// Batch mode: a manifest of ROMs run on a WorkPool, one Emulator per job, with a
+// JSON and a JUnit report. The manifest has a job per line, the ROM and the run
+// options of gbrun:
+//
+//     # blargg
+//     cpu_instrs/01-special.gb --serial Passed --serial Failed --expect-serial Passed
+//     dmg-acid2.gb --frames 120 --expect-hash 8c3a...
+//
+// Blank lines and lines starting with # are skipped, a "quoted argument" may hold
+// spaces and ROM paths are relative to the manifest. Options given on the command
+// line are the defaults of every job.
+
+struct BatchJob {
+    std::string name; // the ROM as the manifest has it
+    RunOptions options;
+};
+
+// Splits a manifest line at spaces, outside of double quotes
+static std::vector<std::string> manifest_tokens( const std::string& line )
+{
+    std::vector<std::string> tokens;
+    size_t i = 0;
+
+    while ( i < line.size() ) {
+        while ( i < line.size() && isspace( (unsigned char)line[i] ) ) {
+            i++;
+        }
+        if ( i == line.size() ) {
+            break;
+        }
+
+        std::string token;
+        bool quoted = false;
+        while ( i < line.size() && ( quoted || !isspace( (unsigned char)line[i] ) ) ) {
+            if ( line[i] == '"' ) {
+                quoted = !quoted;
+            } else {
+                token += line[i];
+            }
+            i++;
+        }
+        tokens.push_back( token );
+    }
+
+    return tokens;
+}
+
+// Reads the jobs of the manifest at path, false with the reason in error when a
+// line doesn't parse
+static bool load_manifest( const char* path, const RunOptions& defaults, std::vector<BatchJob>* jobs,
+                           std::string* error )
+{
+    FILE* hFile = fopen( path, "r" );
+    if ( !hFile ) {
+        *error = std::string( "Unable to open " ) + path;
+        return false;
+    }
+
+    std::string dir( path );
+    size_t slash = dir.find_last_of( "/\\" );
+    dir = slash == std::string::npos ? "" : dir.substr( 0, slash + 1 );
+
+    char buffer[4096];
+    int line = 0;
+    bool ok = true;
+    while ( ok && fgets( buffer, sizeof( buffer ), hFile ) ) {
+        line++;
+        std::vector<std::string> args = manifest_tokens( buffer );
+        if ( args.empty() || args[0][0] == '#' ) {
+            continue;
+        }
+
+        BatchJob job;
+        job.options = defaults;
+        for ( size_t i = 0; ok && i < args.size(); i++ ) {
+            int parsed = parse_option( args, &i, &job.options );
+            if ( parsed < 0 || ( !parsed && ( args[i][0] == '-' || !job.name.empty() ) ) ) {
+                *error = std::string( path ) + ":" + std::to_string( line ) + ": bad argument " + args[i];
+                ok = false;
+            } else if ( !parsed ) {
+                job.name = args[i];
+            }
+        }
+        if ( ok && job.name.empty() ) {
+            *error = std::string( path ) + ":" + std::to_string( line ) + ": no ROM";
+            ok = false;
+        }
+
+        bool absolute = !job.name.empty() && ( job.name[0] == '/' || job.name[0] == '\\' ||
+                                               ( job.name.size() > 1 && job.name[1] == ':' ) );
+        job.options.rom = absolute ? job.name : dir + job.name;
+        jobs->push_back( job );
+    }
+
+    fclose( hFile );
+    return ok;
+}
+
+static std::string json_string( const std::string& text )
+{
+    std::string out = "\"";
+    for ( char c : text ) {
+        switch ( c ) {
+        case '"':
+            out += "\\\"";
+            break;
+        case '\\':
+            out += "\\\\";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        default:
+            if ( (unsigned char)c < 0x20 || (unsigned char)c >= 0x80 ) {
+                char escape[8];
+                snprintf( escape, sizeof( escape ), "\\u%04x", (unsigned char)c );
+                out += escape;
+            } else {
+                out += c;
+            }
+            break;
+        }
+    }
+    return out + "\"";
+}
+
+static std::string xml_string( const std::string& text )
+{
+    std::string out;
+    for ( char c : text ) {
+        switch ( c ) {
+        case '<':
+            out += "&lt;";
+            break;
+        case '>':
+            out += "&gt;";
+            break;
+        case '&':
+            out += "&amp;";
+            break;
+        case '"':
+            out += "&quot;";
+            break;
+        default:
+            // XML 1.0 has no way to write other control characters, serial output may hold any byte
+            if ( ( (unsigned char)c < 0x20 && c != '\n' && c != '\t' ) || (unsigned char)c >= 0x80 ) {
+                out += '?';
+            } else {
+                out += c;
+            }
+            break;
+        }
+    }
+    return out;
+}
+
+static const char* batch_status( const RunResult& result )
+{
+    return !result.loaded ? "error" : result.passed ? "pass" : "fail";
+}
+
+static bool write_json( const char* path, const std::vector<BatchJob>& jobs, const std::vector<RunResult>& results,
+                        double seconds )
+{
+    FILE* hFile = fopen( path, "w" );
+    if ( !hFile ) {
+        return false;
+    }
+
+    fprintf( hFile, "{\n  \"seconds\": %.3f,\n  \"jobs\": [\n", seconds );
+    for ( size_t i = 0; i < jobs.size(); i++ ) {
+        const RunResult& r = results[i];
+        fprintf( hFile,
+                 "    {\"rom\": %s, \"title\": %s, \"status\": \"%s\", \"message\": %s, \"stop\": \"%s\", "
+                 "\"frames\": %llu, \"cycles\": %llu, \"instructions\": %llu, \"seconds\": %.6f, \"mips\": %.2f, "
+                 "\"hash\": \"%016llx\", \"serial\": %s}%s\n",
+                 json_string( jobs[i].name ).c_str(), json_string( r.title ).c_str(), batch_status( r ),
+                 json_string( r.failure ).c_str(), r.stop, (unsigned long long)r.frames, (unsigned long long)r.cycles,
+                 (unsigned long long)r.instructions, r.seconds, r.seconds > 0 ? r.instructions / r.seconds / 1e6 : 0.0,
+                 (unsigned long long)r.hash, json_string( r.serial ).c_str(), i + 1 < jobs.size() ? "," : "" );
+    }
+    fprintf( hFile, "  ]\n}\n" );
+
+    return fclose( hFile ) == 0;
+}
+
+static bool write_junit( const char* path, const std::vector<BatchJob>& jobs, const std::vector<RunResult>& results,
+                         double seconds )
+{
+    FILE* hFile = fopen( path, "w" );
+    if ( !hFile ) {
+        return false;
+    }
+
+    int failures = 0, errors = 0;
+    for ( const RunResult& r : results ) {
+        failures += r.loaded && !r.passed;
+        errors += !r.loaded;
+    }
+
+    fprintf( hFile, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n" );
+    fprintf( hFile, "<testsuite name=\"gbrun\" tests=\"%zu\" failures=\"%d\" errors=\"%d\" time=\"%.3f\">\n",
+             jobs.size(), failures, errors, seconds );
+    for ( size_t i = 0; i < jobs.size(); i++ ) {
+        const RunResult& r = results[i];
+        fprintf( hFile, "  <testcase classname=\"gbrun\" name=\"%s\" time=\"%.3f\">\n",
+                 xml_string( jobs[i].name ).c_str(), r.seconds );
+        if ( !r.loaded ) {
+            fprintf( hFile, "    <error message=\"%s\"/>\n", xml_string( r.failure ).c_str() );
+        } else if ( !r.passed ) {
+            fprintf( hFile, "    <failure message=\"%s\"/>\n", xml_string( r.failure ).c_str() );
+        }
+        if ( !r.serial.empty() ) {
+            fprintf( hFile, "    <system-out>%s</system-out>\n", xml_string( r.serial ).c_str() );
+        }
+        fprintf( hFile, "  </testcase>\n" );
+    }
+    fprintf( hFile, "</testsuite>\n" );
+
+    return fclose( hFile ) == 0;
+}
+
+// Runs every job on threads threads, printing a line as each finishes, and writes
+// the reports asked for. Returns true when every job passed.
+static bool run_batch( const std::vector<BatchJob>& jobs, unsigned threads, const char* json, const char* junit )
+{
+    std::vector<RunResult> results( jobs.size() );
+    std::mutex print;
+    WorkPool pool;
+
+    Timer timer;
+    unsigned workers = pool.run( jobs.size(), threads, [&]( size_t i ) {
+        results[i] = run_rom( jobs[i].options );
+
+        std::lock_guard<std::mutex> guard( print );
+        printf( "%-5s %8.3f s %8.1fx  %s%s%s\n", batch_status( results[i] ), results[i].seconds,
+                results[i].seconds > 0 ? results[i].cycles / results[i].seconds / 4194304.0 : 0.0,
+                jobs[i].name.c_str(), results[i].failure.empty() ? "" : ": ", results[i].failure.c_str() );
+        fflush( stdout );
+    } );
+    double seconds = timer.seconds();
+
+    int passed = 0;
+    uint64_t cycles = 0;
+    for ( const RunResult& r : results ) {
+        passed += r.passed;
+        cycles += r.cycles;
+    }
+    printf( "%d of %zu passed in %.3f s on %u thread%s, %.1fx realtime together\n", passed, jobs.size(), seconds,
+            workers, workers == 1 ? "" : "s", cycles / seconds / 4194304.0 );
+
+    if ( json && !write_json( json, jobs, results, seconds ) ) {
+        fprintf( stderr, "Unable to write %s\n", json );
+        return false;
+    }
+    if ( junit && !write_junit( junit, jobs, results, seconds ) ) {
+        fprintf( stderr, "Unable to write %s\n", junit );
+        return false;
+    }
+
+    return passed == (int)jobs.size();
+}
@@ -0,0 +1,172 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <thread>
+
+#include "run.h"
+#include "batch.h"
+
+// Usage: gbrun [options] rom
+//        gbrun [options] --batch manifest [--jobs N] [--json FILE] [--junit FILE]
+//        gbrun --trace-text trace [--sym FILE]
+//
+//   --frames N             run N frames, 3600 when neither limit is given
+//   --cycles N             run N T-cycles instead
+//   --serial TEXT          stop once the serial output contains TEXT, may be repeated
+//   --pc ADDR              stop before executing ADDR, in any ROM bank
+//   --watch FIRST[-LAST][:KINDS]
+//                          stop after an instruction that accesses FIRST-LAST, KINDS
+//                          of r (read), w (write) and c (write changing the byte),
+//                          w when not given. May be repeated.
+//   --mem ADDR=VALUE       stop at the end of a frame where ADDR holds VALUE
+//   --sav                  keep battery RAM in the .sav next to the ROM
+//   --dump FILE            write the final screen to FILE as a PGM
+//   --profile FILE         write cycles per instruction address to FILE as CSV, which
+//                          runs the core an instruction at a time
+//   --trace FILE           record every instruction to FILE, see trace.h, which also
+//                          runs the core an instruction at a time
+//   --listing FILE         write a disassembly of the ROM to FILE, with code and data
+//                          told apart by running it with the code/data logger, which
+//                          also runs the core an instruction at a time
+//   --sym FILE             label the listing with the RGBDS symbols in FILE, the .sym
+//                          next to the ROM is used when there is one
+//   --hash                 print a hash of the final state
+//   --expect-serial TEXT   pass only when the serial output contains TEXT
+//   --expect-hash HEX      pass only when the final state hashes to HEX
+//   --quiet                don't print the serial output
+//
+// Without expected results a run passes when it met its exit condition, or reached
+// the limit without any. Numbers take a 0x prefix for hex.
+//
+// --trace-text prints a trace in the log format of gameboy-doctor, with --sym each
+// line ends in the label of its PC.
+//
+// --batch runs the jobs of a manifest, see batch.h, on N threads, every core by
+// default, with the other options as defaults for every job.
+//
+// Exits with 0 when every run passed, 2 when one didn't and 1 on errors.
+
+static void usage( void )
+{
+    fprintf( stderr, "Usage: gbrun [--frames N | --cycles N] [--serial TEXT] [--pc ADDR]\n"
+                     "             [--watch FIRST[-LAST][:rwc]] [--mem ADDR=VALUE] [--sav] [--dump FILE]\n"
+                     "             [--profile FILE] [--trace FILE] [--listing FILE] [--sym FILE]\n"
+                     "             [--hash] [--expect-serial TEXT] [--expect-hash HEX] [--quiet] rom\n"
+                     "       gbrun [options] --batch manifest [--jobs N] [--json FILE] [--junit FILE]\n"
+                     "       gbrun --trace-text trace [--sym FILE]\n" );
+}
+
+static int run_single( const RunOptions& options, bool quiet )
+{
+    RunResult result = run_rom( options );
+    if ( !result.loaded ) {
+        fprintf( stderr, "%s: %s\n", options.rom.c_str(), result.error );
+        return 1;
+    }
+
+    printf( "gbrun: %s \"%s\"\n", options.rom.c_str(), result.title.c_str() );
+    printf( "stop     %s after %llu frames\n", result.stop, (unsigned long long)result.frames );
+    if ( !result.watched.empty() ) {
+        printf( "watch    %s\n", result.watched.c_str() );
+    }
+    printf( "cycles   %llu (%.2f s emulated)\n", (unsigned long long)result.cycles, result.cycles / 4194304.0 );
+    printf( "wall     %.3f s\n", result.seconds );
+    printf( "MIPS     %.2f (%llu instructions)\n", result.instructions / result.seconds / 1e6,
+            (unsigned long long)result.instructions );
+    printf( "speed    %.1fx realtime\n", result.cycles / result.seconds / 4194304.0 );
+    if ( options.hash || options.expect_hash ) {
+        printf( "hash     %016llx\n", (unsigned long long)result.hash );
+    }
+    printf( "result   %s%s%s\n", result.passed ? "pass" : "fail", result.passed ? "" : ", ", result.failure.c_str() );
+    if ( !quiet && !result.serial.empty() ) {
+        printf( "serial:\n%s\n", result.serial.c_str() );
+    }
+
+    if ( result.error ) {
+        fprintf( stderr, "%s\n", result.error );
+        return 1;
+    }
+    return result.passed ? 0 : 2;
+}
+
+int main( int argc, char** argv )
+{
+    std::vector<std::string> args( argv + 1, argv + argc );
+    RunOptions options;
+    bool quiet = false;
+    const char* batch = nullptr;
+    const char* json = nullptr;
+    const char* junit = nullptr;
+    const char* trace_text = nullptr;
+    unsigned threads = std::thread::hardware_concurrency();
+
+    for ( size_t i = 0; i < args.size(); i++ ) {
+        int parsed = parse_option( args, &i, &options );
+        if ( parsed > 0 ) {
+            continue;
+        }
+
+        const std::string& arg = args[i];
+        const char* value = i + 1 < args.size() ? args[i + 1].c_str() : nullptr;
+        if ( parsed < 0 ) {
+            usage();
+            return 1;
+        } else if ( arg == "--quiet" ) {
+            quiet = true;
+        } else if ( arg[0] == '-' && !value ) {
+            usage();
+            return 1;
+        } else if ( arg == "--batch" ) {
+            batch = value;
+            i++;
+        } else if ( arg == "--jobs" ) {
+            threads = (unsigned)strtoul( value, nullptr, 0 );
+            i++;
+        } else if ( arg == "--json" ) {
+            json = value;
+            i++;
+        } else if ( arg == "--junit" ) {
+            junit = value;
+            i++;
+        } else if ( arg == "--trace-text" ) {
+            trace_text = value;
+            i++;
+        } else if ( arg[0] == '-' || !options.rom.empty() ) {
+            usage();
+            return 1;
+        } else {
+            options.rom = arg;
+        }
+    }
+
+    if ( trace_text ) {
+        Symbols symbols;
+        if ( !options.symbols.empty() && !symbols.load( options.symbols.c_str() ) ) {
+            fprintf( stderr, "Unable to read %s\n", options.symbols.c_str() );
+            return 1;
+        }
+        if ( trace_to_text( trace_text, stdout, options.symbols.empty() ? nullptr : &symbols ) < 0 ) {
+            fprintf( stderr, "%s is not a trace\n", trace_text );
+            return 1;
+        }
+        return fflush( stdout ) == 0 ? 0 : 1;
+    }
+
+    if ( batch ) {
+        std::vector<BatchJob> jobs;
+        std::string error;
+        if ( !options.rom.empty() || !options.dump.empty() || !options.profile.empty() ||
+             !options.trace.empty() || !options.listing.empty() || !load_manifest( batch, options, &jobs, &error ) ) {
+            fprintf( stderr, "%s\n", error.empty() ? "A batch takes its ROMs and output files from the manifest" : error.c_str() );
+            return 1;
+        }
+        return run_batch( jobs, threads ? threads : 1, json, junit ) ? 0 : 2;
+    }
+
+    if ( options.rom.empty() ) {
+        usage();
+        return 1;
+    }
+    return run_single( options, quiet );
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <stddef.h>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing pool for a fixed set of jobs. The jobs are dealt round-robin onto
+// one deque per thread. A thread takes jobs from the back of its own deque and,
+// once that is empty, steals from the front of the others. A ROM runs for
+// milliseconds to seconds, so a mutex per deque costs nothing next to a job.
+
+class WorkPool
+{
+private:
+    struct Queue {
+        std::mutex lock;
+        std::deque<size_t> jobs;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+
+    bool take( size_t self, size_t* job )
+    {
+        Queue& own = *queues[self];
+        std::lock_guard<std::mutex> guard( own.lock );
+        if ( own.jobs.empty() ) {
+            return false;
+        }
+        *job = own.jobs.back();
+        own.jobs.pop_back();
+        return true;
+    }
+
+    bool steal( size_t self, size_t* job )
+    {
+        for ( size_t k = 1; k < queues.size(); k++ ) {
+            Queue& victim = *queues[( self + k ) % queues.size()];
+            std::lock_guard<std::mutex> guard( victim.lock );
+            if ( !victim.jobs.empty() ) {
+                *job = victim.jobs.front();
+                victim.jobs.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+public:
+    // Calls work( job ) for every job in [0, count) on up to threads threads and
+    // returns once all have run, with the number of threads it used. Nothing is added
+    // while it runs, so a thread that finds every deque empty is done.
+    unsigned run( size_t count, unsigned threads, const std::function<void( size_t job )>& work )
+    {
+        if ( threads < 1 ) {
+            threads = 1;
+        }
+        if ( threads > count ) {
+            threads = count ? (unsigned)count : 1;
+        }
+
+        queues.clear();
+        for ( unsigned t = 0; t < threads; t++ ) {
+            queues.emplace_back( new Queue() );
+        }
+        for ( size_t job = 0; job < count; job++ ) {
+            queues[job % threads]->jobs.push_front( job );
+        }
+
+        std::vector<std::thread> workers;
+        for ( unsigned t = 0; t < threads; t++ ) {
+            workers.emplace_back( [this, t, &work]() {
+                size_t job;
+                while ( take( t, &job ) || steal( t, &job ) ) {
+                    work( job );
+                }
+            } );
+        }
+        for ( std::thread& worker : workers ) {
+            worker.join();
+        }
+        return threads;
+    }
+};
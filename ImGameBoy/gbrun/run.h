@@ -0,0 +1,318 @@
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include "../disassembly.h"
+#include "../emulator.h"
+#include "../screen.h"
+#include "../shared.h"
+
+// One headless run of a ROM: load, run until a limit or an exit condition, collect
+// the numbers. Nothing here touches the front end or any global, so any number of
+// runs can go on side by side.
+
+struct RunOptions {
+    std::string rom;
+    uint64_t frames = 0; // limits, the default when both are 0 is DEFAULT_FRAMES
+    uint64_t cycles = 0;
+    std::vector<std::string> serial; // stop once the serial output contains any of these
+    int pc = -1; // stop before executing this address
+    std::vector<Watchpoint> watch; // stop after an instruction that accesses one of these
+    int mem_address = -1; // stop at the end of a frame where this byte...
+    int mem_value = 0; // ...holds this value
+    bool battery = false; // map the .sav next to the ROM, off so runs repeat
+    std::string dump; // PGM of the final screen
+    std::string profile; // CSV of the profiler, see profiler.h
+    std::string trace; // instruction trace, see trace.h
+    std::string listing; // disassembly of the ROM as the run used it, see disassembly.h
+    std::string symbols; // labels for the listing instead of the .sym next to the ROM
+    bool hash = false; // hash the final state
+
+    // Expected results, without any a run passes when it met its exit condition
+    std::string expect_serial; // the serial output contains this
+    bool expect_hash = false;
+    uint64_t hash_value = 0; // the final state hashes to this
+
+    static const uint64_t DEFAULT_FRAMES = 60 * 60; // an emulated minute
+
+    bool has_condition( void ) const
+    {
+        return !serial.empty() || pc >= 0 || !watch.empty() || mem_address >= 0;
+    }
+};
+
+// Takes the option at args[*i], and the value after it, into options and moves *i
+// to the last argument used. Returns 1 when it was a run option, 0 when it is
+// something else and -1 when its value is missing or malformed.
+static int parse_option( const std::vector<std::string>& args, size_t* i, RunOptions* options )
+{
+    const std::string& arg = args[*i];
+    const char* value = *i + 1 < args.size() ? args[*i + 1].c_str() : nullptr;
+    char* end = nullptr;
+
+    if ( arg == "--sav" ) {
+        options->battery = true;
+        return 1;
+    }
+    if ( arg == "--hash" ) {
+        options->hash = true;
+        return 1;
+    }
+
+    static const char* const valued[] = { "--frames", "--cycles", "--serial", "--pc", "--watch", "--mem",
+                                          "--dump", "--profile", "--listing", "--sym", "--trace",
+                                          "--expect-serial", "--expect-hash" };
+    bool known = false;
+    for ( const char* name : valued ) {
+        known |= arg == name;
+    }
+    if ( !known ) {
+        return 0;
+    }
+    if ( !value ) {
+        return -1;
+    }
+    ( *i )++;
+
+    if ( arg == "--frames" ) {
+        options->frames = strtoull( value, &end, 0 );
+    } else if ( arg == "--cycles" ) {
+        options->cycles = strtoull( value, &end, 0 );
+    } else if ( arg == "--serial" ) {
+        options->serial.push_back( value );
+    } else if ( arg == "--pc" ) {
+        options->pc = (int)( strtoul( value, &end, 0 ) & 0xFFFF );
+    } else if ( arg == "--watch" ) {
+        // FIRST[-LAST][:KINDS], KINDS of r, w and c, writes by default
+        Watchpoint w;
+        w.first = w.last = (uint16_t)strtoul( value, &end, 0 );
+        if ( *end == '-' ) {
+            w.last = (uint16_t)strtoul( end + 1, &end, 0 );
+        }
+        w.kinds = WATCH_WRITE;
+        if ( *end == ':' ) {
+            w.kinds = 0;
+            for ( end++; *end == 'r' || *end == 'w' || *end == 'c'; end++ ) {
+                w.kinds |= *end == 'r' ? WATCH_READ : *end == 'w' ? WATCH_WRITE : WATCH_CHANGE;
+            }
+        }
+        if ( !w.kinds || w.first > w.last ) {
+            return -1;
+        }
+        options->watch.push_back( w );
+    } else if ( arg == "--mem" ) {
+        options->mem_address = (int)( strtoul( value, &end, 0 ) & 0xFFFF );
+        if ( *end != '=' ) {
+            return -1;
+        }
+        options->mem_value = (int)( strtoul( end + 1, &end, 0 ) & 0xFF );
+    } else if ( arg == "--dump" ) {
+        options->dump = value;
+    } else if ( arg == "--profile" ) {
+        options->profile = value;
+    } else if ( arg == "--trace" ) {
+        options->trace = value;
+    } else if ( arg == "--listing" ) {
+        options->listing = value;
+    } else if ( arg == "--sym" ) {
+        options->symbols = value;
+    } else if ( arg == "--expect-serial" ) {
+        options->expect_serial = value;
+    } else {
+        options->expect_hash = true;
+        options->hash_value = strtoull( value, &end, 16 );
+    }
+
+    return end && *end ? -1 : 1;
+}
+
+struct RunResult {
+    bool loaded = false;
+    const char* error = nullptr; // why it didn't load, or which output couldn't be written
+    const char* stop = "limit"; // limit, serial, pc, watch, memory or halt
+    std::string watched; // the access a watch stop was on
+    bool met = false; // stopped on an exit condition, or ran to the limit without any
+    bool passed = false; // met every expected result
+    std::string failure; // the first that wasn't
+    std::string title;
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t frames = 0;
+    double seconds = 0;
+    uint64_t hash = 0;
+    std::string serial;
+};
+
+// FNV-1a over a save state, so equal machines hash equal whatever core ran them.
+// The host time the clock was last set at is left out, it differs from run to run.
+static uint64_t state_hash( Emulator* emu )
+{
+    std::vector<uint8_t> state( emu->state_size() );
+    emu->save_state( state.data() );
+    ( (SaveState*)state.data() )->mbc.rtc_stamp = 0;
+
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for ( uint8_t byte : state ) {
+        hash = ( hash ^ byte ) * 0x100000001B3ull;
+    }
+    return hash;
+}
+
+static bool serial_contains( const std::string& output, const std::vector<std::string>& texts )
+{
+    for ( const std::string& text : texts ) {
+        if ( output.find( text ) != std::string::npos ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Binary PGM, white is shade 0
+static bool dump_screen( Emulator* emu, const char* path )
+{
+    uint8_t screen[SCREEN_WIDTH * SCREEN_HEIGHT];
+    render_screen( emu->memory(), screen );
+    for ( uint8_t& shade : screen ) {
+        shade = 3 - shade;
+    }
+
+    FILE* hFile = fopen( path, "wb" );
+    if ( !hFile ) {
+        return false;
+    }
+    fprintf( hFile, "P5\n%d %d\n3\n", SCREEN_WIDTH, SCREEN_HEIGHT );
+    bool ok = fwrite( screen, 1, sizeof( screen ), hFile ) == sizeof( screen );
+    return fclose( hFile ) == 0 && ok;
+}
+
+// Runs a frame at a time, as fast as the core goes, and checks the serial and
+// memory conditions between frames. A PC condition is a breakpoint, which takes
+// the caching cores down to one instruction per call.
+static RunResult run_rom( const RunOptions& options )
+{
+    RunResult result;
+    Emulator* emu = new Emulator();
+
+    if ( !emu->load( options.rom.c_str(), options.battery ) ) {
+        result.error = emu->load_error();
+        result.failure = result.error;
+        delete emu;
+        return result;
+    }
+    result.loaded = true;
+    result.title = emu->header()->title;
+
+    // Whole frames, or frames and a last partial one for a cycle limit
+    uint64_t frames = options.cycles ? UINT64_MAX : options.frames ? options.frames : RunOptions::DEFAULT_FRAMES;
+    uint64_t limit = options.cycles ? options.cycles : UINT64_MAX;
+    if ( options.pc >= 0 ) {
+        emu->bps.set_everywhere( (uint16_t)options.pc, true );
+    }
+    for ( const Watchpoint& w : options.watch ) {
+        emu->watch.add( emu->memory(), w.first, w.last, w.kinds );
+    }
+    if ( !options.profile.empty() ) {
+        emu->profiler()->start();
+    }
+    emu->code_map()->enabled = !options.listing.empty();
+    if ( !options.symbols.empty() && !emu->symbols()->load( options.symbols.c_str() ) ) {
+        result.error = "Unable to read the symbols";
+    }
+    TraceWriter* tracer = nullptr;
+    if ( !options.trace.empty() ) {
+        tracer = new TraceWriter();
+        if ( tracer->open( options.trace.c_str() ) ) {
+            emu->set_tracer( tracer );
+        } else {
+            result.error = "Unable to create the trace";
+        }
+    }
+    emu->sstate = StepState::RUN;
+
+    Timer timer;
+    // run_cycles takes what the last instruction ran past a budget off the next one
+    // itself, so the budgets asked for add up to the limit, not the cycles run
+    uint64_t asked = 0;
+    while ( result.frames < frames && emu->total_cycles() < limit ) {
+        uint64_t left = limit - asked;
+        int budget = left < Emulator::FRAME_CYCLES ? (int)left : Emulator::FRAME_CYCLES;
+        emu->run_cycles( budget );
+        asked += budget;
+        result.frames++;
+
+        if ( serial_contains( emu->serial_output(), options.serial ) ) {
+            result.stop = "serial";
+            break;
+        }
+        if ( options.mem_address >= 0 && emu->memory()->peek( (uint16_t)options.mem_address ) == options.mem_value ) {
+            result.stop = "memory";
+            break;
+        }
+        if ( emu->sstate == StepState::STOP ) {
+            // Breakpoint, watchpoint, or HALT and STOP with no interrupts to wake them
+            result.stop = options.pc >= 0 && emu->registers()->PC == options.pc ? "pc" : "halt";
+            if ( emu->watch.hits ) {
+                const WatchHit& hit = emu->watch.hit;
+                char text[64];
+                snprintf( text, sizeof( text ), "%s %04X %02X->%02X at %04X",
+                          hit.kind == WATCH_READ ? "read" : hit.kind == WATCH_WRITE ? "write" : "change", hit.address,
+                          hit.before, hit.after, hit.pc );
+                result.stop = "watch";
+                result.watched = text;
+            }
+            break;
+        }
+    }
+    result.seconds = timer.seconds();
+
+    result.met = options.has_condition() ? strcmp( result.stop, "limit" ) && strcmp( result.stop, "halt" )
+                                         : !strcmp( result.stop, "limit" );
+    result.cycles = emu->total_cycles();
+    result.instructions = emu->total_instructions();
+    result.serial = emu->serial_output();
+    if ( options.hash || options.expect_hash ) {
+        result.hash = state_hash( emu );
+    }
+    if ( !options.dump.empty() && !dump_screen( emu, options.dump.c_str() ) ) {
+        result.error = "Unable to write the screen dump";
+    }
+    if ( !options.profile.empty() && !emu->profiler()->export_csv( options.profile.c_str() ) ) {
+        result.error = "Unable to write the profile";
+    }
+    if ( !options.listing.empty() ) {
+        // With what the run executed as more entry points
+        Disassembly* listing = new Disassembly();
+        emu->code_map()->explore();
+        listing->reset( emu->rom_image(), emu->rom_size() );
+        listing->refresh( emu->memory(), emu->code_map(), emu->symbols() );
+        if ( !listing->save( options.listing.c_str() ) ) {
+            result.error = "Unable to write the listing";
+        }
+        delete listing;
+    }
+    if ( tracer && !tracer->close() ) {
+        result.error = "Unable to write the trace";
+    }
+    delete tracer;
+    delete emu;
+
+    char text[128];
+    if ( result.error ) {
+        result.failure = result.error;
+    } else if ( !options.expect_serial.empty() &&
+                result.serial.find( options.expect_serial ) == std::string::npos ) {
+        result.failure = "serial output without \"" + options.expect_serial + "\"";
+    } else if ( options.expect_hash && result.hash != options.hash_value ) {
+        snprintf( text, sizeof( text ), "hash %016llx, expected %016llx", (unsigned long long)result.hash,
+                  (unsigned long long)options.hash_value );
+        result.failure = text;
+    } else if ( options.expect_serial.empty() && !options.expect_hash && !result.met ) {
+        result.failure = std::string( "stopped on " ) + result.stop;
+    }
+    result.passed = result.failure.empty();
+
+    return result;
+}
@@ -59,6 +59,8 @@
 #else
 #define _PRISizeT   "z"
 #define ImSnprintf  snprintf
+#define sprintf_s(buf, ...) snprintf(buf, sizeof(buf), __VA_ARGS__)
+#define sscanf_s    sscanf
 #endif
 
 struct MemoryEditor
@@ -1,176 +1,260 @@
 #pragma once
 #include <stdint.h>
+#include <utility>
 #include "memory.h"
 #include "registers.h"
 #include "shared.h"
+#include "optable.h"
 
 class Instruction
 {
 private:
 public:
     int length;
+    int cycles; // T-cycles, branch not taken for conditional instructions
+    int cycles_taken; // T-cycles when a conditional JR/JP/CALL/RET branches
 
+    // Illegal opcodes, they lock up real hardware
     Instruction( void )
-        : length( 1 )
+        : length( 1 ), cycles( 4 ), cycles_taken( 4 )
     {
     }
 
-    Instruction( const int l )
+    // Length and cycles come from optable, CB instructions are 0x100-0x1FF
+    explicit Instruction( uint16_t opcode )
+        : length( optable[opcode].length ), cycles( optable[opcode].cycles ), cycles_taken( optable[opcode].cycles_taken )
     {
-        length = l;
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    // create_table's entries are deleted through the base
+    virtual ~Instruction( void )
+    {
+    }
+
+    // Executes the instruction at r->PC and returns the T-cycles it took
+    virtual int execute( Memory* m, Registers* r )
     {
         r->PC += length;
+        return cycles;
     }
 
+    // Every opcode disassembles through optable
     virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
     {
-        snprintf( dst, size, "Undef instruction" );
+        optable.dis( dst, size, mem, addr );
     }
 
-    uint8_t increment( Registers* r, uint8_t operand )
+    // Fills the 0x100 entry primary opcode table used by Emulator and the benchmarks,
+    // every entry its own object for the caller to delete
+    static void create_table( Instruction** opcode, StepState& sstate );
+
+    // The ALU helpers set the flags the operation defines, see registers.h for the
+    // GB_LAZY_FLAGS build where they only record the operation
+
+    static uint8_t increment( Registers* r, uint8_t operand )
     {
+#ifdef GB_LAZY_FLAGS
+        r->record( LAZY_INC, operand, 0, r->c(), operand + 1 );
+#else
         r->Flag.N = 0;
         r->Flag.Z = operand == 0xff;
         r->Flag.H = ( operand & 0xf ) == 0xf;
+#endif
         return ++operand;
     }
 
-    uint8_t decrement( Registers* r, uint8_t operand )
+    static uint8_t decrement( Registers* r, uint8_t operand )
     {
+#ifdef GB_LAZY_FLAGS
+        r->record( LAZY_DEC, operand, 0, r->c(), operand - 1 );
+#else
         r->Flag.N = 1;
         r->Flag.Z = operand == 1;
         r->Flag.H = ( operand & 0xf ) == 0;
+#endif
         return --operand;
     }
 
-    uint8_t rlca( Registers* r, uint8_t operand )
+    static uint8_t rlca( Registers* r, uint8_t operand )
     {
+#ifdef GB_LAZY_FLAGS
+        r->record( LAZY_ROTA, 0, 0, operand >> 7, 0 );
+        return ( operand << 1 ) | ( operand >> 7 );
+#else
         r->Flag.Z = r->Flag.N = r->Flag.H = 0;
         r->Flag.C = operand >> 7;
         return ( operand << 1 ) + r->Flag.C;
+#endif
     }
 
-    uint8_t rla( Registers* r, uint8_t operand )
+    static uint8_t rla( Registers* r, uint8_t operand )
     {
+#ifdef GB_LAZY_FLAGS
+        r->record( LAZY_ROTA, 0, 0, operand >> 7, 0 );
+#else
         r->Flag.Z = r->Flag.N = r->Flag.H = 0;
         r->Flag.C = operand >> 7;
+#endif
         return operand << 1;
     }
 
-    uint8_t rrca( Registers* r, uint8_t operand )
+    static uint8_t rrca( Registers* r, uint8_t operand )
     {
+#ifdef GB_LAZY_FLAGS
+        r->record( LAZY_ROTA, 0, 0, operand & 1, 0 );
+        return ( operand >> 1 ) | ( operand << 7 );
+#else
         r->Flag.Z = r->Flag.N = r->Flag.H = 0;
         r->Flag.C = operand & 1;
         return ( operand >> 1 ) | ( r->Flag.C << 7 );
+#endif
     }
 
-    uint8_t rr( Registers* r, uint8_t operand )
+    static uint8_t rr( Registers* r, uint8_t operand )
     {
+#ifdef GB_LAZY_FLAGS
+        r->record( LAZY_ROTA, 0, 0, operand & 1, 0 );
+#else
         r->Flag.Z = r->Flag.N = r->Flag.H = 0;
         r->Flag.C = operand & 1;
+#endif
         return operand >> 1;
     }
 
-    void add_hl_r16( Registers* r, uint16_t r16 )
+    // Keeps Z, so it works on F directly in both builds
+    static void add_hl_r16( Registers* r, uint16_t r16 )
     {
+        r->sync_flags();
         r->Flag.N = 0;
-        r->Flag.H = r16 > ( 0xfff - ( r->HL & 0xfff ) );
+        r->Flag.H = ( r16 & 0xfff ) > ( 0xfff - ( r->HL & 0xfff ) );
         r->Flag.C = r16 > ( 0xffff - r->HL );
         r->HL += r16;
     }
 
     template< class T >
-    T add( Registers* r, T rd, T rs )
+    static T add( Registers* r, T rd, T rs )
     {
         T result = rd + rs;
 
+#ifdef GB_LAZY_FLAGS
+        // H and C only depend on the low byte, Z is cleared by the 16-bit callers
+        r->record( LAZY_ADD, (uint8_t)rd, (uint8_t)rs, 0, result != 0 );
+#else
         r->Flag.N = 0;
         r->Flag.Z = result == 0;
-        r->Flag.H = rs > ( 0xf - ( rd & 0xf ) );
-        r->Flag.C = rs > ( 0xff - rd );
+        r->Flag.H = ( rs & 0xf ) > ( 0xf - ( rd & 0xf ) );
+        r->Flag.C = ( rs & 0xff ) > ( 0xff - ( rd & 0xff ) );
+#endif
 
         return result;
     }
 
-    uint8_t adc( Registers* r, uint8_t rd, uint8_t rs )
+    static uint8_t adc( Registers* r, uint8_t rd, uint8_t rs )
     {
+#ifdef GB_LAZY_FLAGS
+        uint8_t carry = r->c();
+        uint8_t result = rd + rs + carry;
+
+        r->record( LAZY_ADC, rd, rs, carry, result );
+#else
         uint8_t result = rd + rs + r->Flag.C;
 
         r->Flag.N = 0;
         r->Flag.Z = result == 0;
-        r->Flag.H = ( rs + r->Flag.C ) > ( 0xf - ( rd & 0xf ) );
+        r->Flag.H = ( ( rs & 0xf ) + r->Flag.C ) > ( 0xf - ( rd & 0xf ) );
         r->Flag.C = ( rs + r->Flag.C ) > ( 0xff - rd );
+#endif
 
         return result;
     }
 
-    uint8_t sub( Registers* r, uint8_t rd, uint8_t rs )
+    static uint8_t sub( Registers* r, uint8_t rd, uint8_t rs )
     {
         uint8_t result = rd - rs;
 
+#ifdef GB_LAZY_FLAGS
+        r->record( LAZY_SUB, rd, rs, 0, result );
+#else
         r->Flag.Z = result == 0;
         r->Flag.N = 1;
-        r->Flag.H = rs && ( rd & 0xf ) == 0;
+        r->Flag.H = ( rs & 0xf ) > ( rd & 0xf );
         r->Flag.C = rs > rd;
+#endif
 
         return result;
     }
 
-    uint8_t sbc( Registers* r, uint8_t rd, uint8_t rs )
+    static uint8_t sbc( Registers* r, uint8_t rd, uint8_t rs )
     {
+#ifdef GB_LAZY_FLAGS
+        uint8_t carry = r->c();
+        uint8_t result = rd - rs - carry;
+
+        r->record( LAZY_SBC, rd, rs, carry, result );
+#else
         uint8_t result = rd - rs - r->Flag.C;
 
         r->Flag.Z = result == 0;
         r->Flag.N = 1;
-        r->Flag.H = ( rs || r->Flag.C ) && ( rd & 0xf ) == 0;
+        r->Flag.H = ( ( rs & 0xf ) + r->Flag.C ) > ( rd & 0xf );
         r->Flag.C = ( r->Flag.C + rs ) > rd;
+#endif
 
         return result;
     }
 
-    uint8_t _and( Registers* r, uint8_t rd, uint8_t rs )
+    static uint8_t _and( Registers* r, uint8_t rd, uint8_t rs )
     {
         uint8_t result = rd & rs;
 
+#ifdef GB_LAZY_FLAGS
+        r->record( LAZY_AND, 0, 0, 0, result );
+#else
         r->Flag.Z = result == 0;
         r->Flag.N = r->Flag.C = 0;
         r->Flag.H = 1;
+#endif
 
         return result;
     }
 
-    uint8_t _xor( Registers* r, uint8_t rd, uint8_t rs )
+    static uint8_t _xor( Registers* r, uint8_t rd, uint8_t rs )
     {
         uint8_t result = rd ^ rs;
 
+#ifdef GB_LAZY_FLAGS
+        r->record( LAZY_LOGIC, 0, 0, 0, result );
+#else
         r->Flag.Z = result == 0;
         r->Flag.N = r->Flag.H = r->Flag.C = 0;
+#endif
 
         return result;
     }
 
-    uint8_t _or( Registers* r, uint8_t rd, uint8_t rs )
+    static uint8_t _or( Registers* r, uint8_t rd, uint8_t rs )
     {
         uint8_t result = rd | rs;
 
+#ifdef GB_LAZY_FLAGS
+        r->record( LAZY_LOGIC, 0, 0, 0, result );
+#else
         r->Flag.Z = result == 0;
         r->Flag.N = r->Flag.H = r->Flag.C = 0;
+#endif
 
         return result;
     }
 
-    void push( Memory* mem, Registers* r, uint16_t addr )
+    static void push( Memory* mem, Registers* r, uint16_t addr )
     {
         r->SP -= 2;
-        *(uint16_t*)&mem->rom[r->SP] = addr;
+        mem->write16( r->SP, addr );
     }
 
-    uint16_t pop( Memory* mem, Registers* r )
+    static uint16_t pop( Memory* mem, Registers* r )
     {
-        uint16_t result = *(uint16_t*)&mem->rom[r->SP];
+        uint16_t result = mem->read16( r->SP );
         r->SP += 2;
         return result;
     }
@@ -180,18 +264,14 @@ class InstructionNop : public Instruction
 {
 public:
     InstructionNop( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x00 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "NOP" );
+        return cycles;
     }
 };
 
@@ -199,19 +279,15 @@ class InstructionLdBCu16 : public Instruction
 {
 public:
     InstructionLdBCu16( void )
-        : Instruction::Instruction( 3 )
+        : Instruction::Instruction( 0x01 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->BC = *(uint16_t*)&m->map[r->PC + 1];
+        r->BC = m->fetch16( r->PC + 1 );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD BC, %#04x", *(uint16_t*)&mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -219,19 +295,15 @@ class InstructionLdBCA : public Instruction
 {
 public:
     InstructionLdBCA( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x02 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        m->rom[r->BC] = r->A;
+        m->write8( r->BC, r->A );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD (BC), A" );
+        return cycles;
     }
 };
 
@@ -239,19 +311,15 @@ class InstructionIncBC : public Instruction
 {
 public:
     InstructionIncBC( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x03 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->BC++;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "INC BC" );
+        return cycles;
     }
 };
 
@@ -259,19 +327,15 @@ class InstructionIncB : public Instruction
 {
 public:
     InstructionIncB( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x04 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->B = increment( r, r->B );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "INC B" );
+        return cycles;
     }
 };
 
@@ -279,19 +343,15 @@ class InstructionDecB : public Instruction
 {
 public:
     InstructionDecB( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x05 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->B = decrement( r, r->B );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "DEC B" );
+        return cycles;
     }
 };
 
@@ -299,19 +359,15 @@ class InstructionLdB : public Instruction
 {
 public:
     InstructionLdB( void )
-        : Instruction::Instruction( 2 )
+        : Instruction::Instruction( 0x06 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->B = m->rom[r->PC + 1];
+        r->B = m->fetch8( r->PC + 1 );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD B, %#02x", mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -319,19 +375,15 @@ class InstructionRLCA : public Instruction
 {
 public:
     InstructionRLCA( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x07 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = rlca( r, r->A );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RLCA" );
+        return cycles;
     }
 };
 
@@ -339,20 +391,16 @@ class InstructionLdn16SP : public Instruction
 {
 public:
     InstructionLdn16SP( void )
-        : Instruction::Instruction( 3 )
+        : Instruction::Instruction( 0x08 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        uint16_t addr = *(uint16_t*)&m->rom[r->PC + 1];
-        *(uint16_t*)&m->rom[addr] = r->SP;
+        uint16_t addr = m->fetch16( r->PC + 1 );
+        m->write16( addr, r->SP );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD %#04x, SP", *(uint16_t*)&mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -360,19 +408,15 @@ class InstructionAddHLBC : public Instruction
 {
 public:
     InstructionAddHLBC( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x09 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         add_hl_r16( r, r->BC );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "ADD HL, BC" );
+        return cycles;
     }
 };
 
@@ -380,19 +424,15 @@ class InstructionLdABC : public Instruction
 {
 public:
     InstructionLdABC( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x0A )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->A = m->rom[r->BC];
+        r->A = m->read8( r->BC );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD A, (BC)" );
+        return cycles;
     }
 };
 
@@ -400,19 +440,15 @@ class InstructionDecBC : public Instruction
 {
 public:
     InstructionDecBC( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x0B )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->BC--;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "DEC BC" );
+        return cycles;
     }
 };
 
@@ -420,19 +456,15 @@ class InstructionIncC : public Instruction
 {
 public:
     InstructionIncC( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x0C )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->C = increment( r, r->C );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "INC C" );
+        return cycles;
     }
 };
 
@@ -440,19 +472,15 @@ class InstructionDecC : public Instruction
 {
 public:
     InstructionDecC( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x0D )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->C = decrement( r, r->C );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "DEC C" );
+        return cycles;
     }
 };
 
@@ -460,19 +488,15 @@ class InstructionLdC : public Instruction
 {
 public:
     InstructionLdC( void )
-        : Instruction::Instruction( 2 )
+        : Instruction::Instruction( 0x0E )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->C = m->rom[r->PC + 1];
+        r->C = m->fetch8( r->PC + 1 );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD C, %#02x", mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -480,19 +504,15 @@ class InstructionRRCA : public Instruction
 {
 public:
     InstructionRRCA( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x0F )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = rrca( r, r->A );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RRCA" );
+        return cycles;
     }
 };
 
@@ -503,21 +523,17 @@ private:
 
 public:
     InstructionStop( StepState& state )
-        : Instruction::Instruction( 2 ), sstate( state )
+        : Instruction::Instruction( 0x10 ), sstate( state )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        if ( m->rom[r->PC + 1] == 0 ) {
+        if ( m->fetch8( r->PC + 1 ) == 0 ) {
             sstate = StepState::STOP;
         }
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "STOP" );
+        return cycles;
     }
 };
 
@@ -525,19 +541,15 @@ class InstructionLdDEu16 : public Instruction
 {
 public:
     InstructionLdDEu16( void )
-        : Instruction::Instruction( 3 )
+        : Instruction::Instruction( 0x11 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->DE = *(uint16_t*)&m->rom[r->PC + 1];
+        r->DE = m->fetch16( r->PC + 1 );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD DE, %#04x", *(uint16_t*)&mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -545,19 +557,15 @@ class InstructionLdDEA : public Instruction
 {
 public:
     InstructionLdDEA( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x12 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        m->rom[r->DE] = r->A;
+        m->write8( r->DE, r->A );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD (DE), A" );
+        return cycles;
     }
 };
 
@@ -565,19 +573,15 @@ class InstructionIncDE : public Instruction
 {
 public:
     InstructionIncDE( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x13 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->DE++;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "INC DE" );
+        return cycles;
     }
 };
 
@@ -585,19 +589,15 @@ class InstructionIncD : public Instruction
 {
 public:
     InstructionIncD( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x14 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->D = increment( r, r->D );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "INC D" );
+        return cycles;
     }
 };
 
@@ -605,19 +605,15 @@ class InstructionDecD : public Instruction
 {
 public:
     InstructionDecD( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x15 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->D = decrement( r, r->D );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "DEC D" );
+        return cycles;
     }
 };
 
@@ -625,19 +621,15 @@ class InstructionLdD : public Instruction
 {
 public:
     InstructionLdD( void )
-        : Instruction::Instruction( 2 )
+        : Instruction::Instruction( 0x16 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->D = m->rom[r->PC + 1];
+        r->D = m->fetch8( r->PC + 1 );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD D, %#02x", mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -645,19 +637,15 @@ class InstructionRLA : public Instruction
 {
 public:
     InstructionRLA( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x17 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = rla( r, r->A );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RLA" );
+        return cycles;
     }
 };
 
@@ -665,19 +653,15 @@ class InstructionJPe8 : public Instruction
 {
 public:
     InstructionJPe8( void )
-        : Instruction::Instruction( 2 )
+        : Instruction::Instruction( 0x18 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->PC += (int8_t)m->rom[r->PC + 1];
+        r->PC += (int8_t)m->fetch8( r->PC + 1 );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "JP %#x", addr + length + (int8_t)mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -685,19 +669,15 @@ class InstructionAddHLDE : public Instruction
 {
 public:
     InstructionAddHLDE( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x19 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         add_hl_r16( r, r->DE );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "ADD HL, DE" );
+        return cycles;
     }
 };
 
@@ -705,19 +685,15 @@ class InstructionLdADE : public Instruction
 {
 public:
     InstructionLdADE( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x1A )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->A = m->rom[r->DE];
+        r->A = m->read8( r->DE );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD A, (DE)" );
+        return cycles;
     }
 };
 
@@ -725,19 +701,15 @@ class InstructionDecDE : public Instruction
 {
 public:
     InstructionDecDE( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x1B )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->DE--;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "DEC DE" );
+        return cycles;
     }
 };
 
@@ -745,19 +717,15 @@ class InstructionIncE : public Instruction
 {
 public:
     InstructionIncE( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x1C )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->E = increment( r, r->E );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "INC E" );
+        return cycles;
     }
 };
 
@@ -765,19 +733,15 @@ class InstructionDecE : public Instruction
 {
 public:
     InstructionDecE( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x1D )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->E = decrement( r, r->E );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "DEC E" );
+        return cycles;
     }
 };
 
@@ -785,19 +749,15 @@ class InstructionLdE : public Instruction
 {
 public:
     InstructionLdE( void )
-        : Instruction::Instruction( 2 )
+        : Instruction::Instruction( 0x1E )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->E = m->rom[r->PC + 1];
+        r->E = m->fetch8( r->PC + 1 );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD E, %#02x", mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -805,19 +765,15 @@ class InstructionRRA : public Instruction
 {
 public:
     InstructionRRA( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x1F )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = rr( r, r->A );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RRA" );
+        return cycles;
     }
 };
 
@@ -825,21 +781,19 @@ class InstructionJRNZ : public Instruction
 {
 public:
     InstructionJRNZ( void )
-        : Instruction::Instruction( 2 )
+        : Instruction::Instruction( 0x20 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        if ( r->Flag.Z == 0 ) {
-            r->PC += (int8_t)m->rom[r->PC + 1];
+        if ( !r->z() ) {
+            r->PC += (int8_t)m->fetch8( r->PC + 1 );
+            r->PC += length;
+            return cycles_taken;
         }
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "JR NZ, %#04x", addr + length + (int8_t)mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -847,19 +801,15 @@ class InstructionLdHLu16 : public Instruction
 {
 public:
     InstructionLdHLu16( void )
-        : Instruction::Instruction( 3 )
+        : Instruction::Instruction( 0x21 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->HL = *(uint16_t*)&m->rom[r->PC + 1];
+        r->HL = m->fetch16( r->PC + 1 );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD HL, %#04x", *(uint16_t*)&mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -867,19 +817,15 @@ class InstructionLdHLIA : public Instruction
 {
 public:
     InstructionLdHLIA( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x22 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        m->rom[r->HL++] = r->A;
+        m->write8( r->HL++, r->A );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD (HL+), A" );
+        return cycles;
     }
 };
 
@@ -887,19 +833,15 @@ class InstructionIncHL : public Instruction
 {
 public:
     InstructionIncHL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x23 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->HL++;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "INC HL" );
+        return cycles;
     }
 };
 
@@ -907,19 +849,15 @@ class InstructionIncH : public Instruction
 {
 public:
     InstructionIncH( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x24 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->H = increment( r, r->H );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "INC H" );
+        return cycles;
     }
 };
 
@@ -927,19 +865,15 @@ class InstructionDecH : public Instruction
 {
 public:
     InstructionDecH( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x25 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->H = decrement( r, r->H );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "DEC H" );
+        return cycles;
     }
 };
 
@@ -947,19 +881,15 @@ class InstructionLdH : public Instruction
 {
 public:
     InstructionLdH( void )
-        : Instruction::Instruction( 2 )
+        : Instruction::Instruction( 0x26 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->H = m->rom[r->PC + 1];
+        r->H = m->fetch8( r->PC + 1 );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "Ld H, %#02x", mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -967,12 +897,13 @@ class InstructionDAA : public Instruction
 {
 public:
     InstructionDAA( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x27 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
+        r->sync_flags();
         if ( !r->Flag.N ) { // after an addition
             if ( r->Flag.C || r->A > 0x99 ) {
                 r->A += 0x60;
@@ -994,11 +925,7 @@ public:
         r->Flag.H = 0;
 
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "DAA" );
+        return cycles;
     }
 };
 
@@ -1006,21 +933,19 @@ class InstructionJRZ : public Instruction
 {
 public:
     InstructionJRZ( void )
-        : Instruction::Instruction( 2 )
+        : Instruction::Instruction( 0x28 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        if ( r->Flag.Z ) {
-            r->PC += (int8_t)m->rom[r->PC + 1];
+        if ( r->z() ) {
+            r->PC += (int8_t)m->fetch8( r->PC + 1 );
+            r->PC += length;
+            return cycles_taken;
         }
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "JR Z, %#04x", addr + length + (int8_t)mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -1028,19 +953,15 @@ class InstructionAddHLHL : public Instruction
 {
 public:
     InstructionAddHLHL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x29 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         add_hl_r16( r, r->HL );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "ADD HL, HL" );
+        return cycles;
     }
 };
 
@@ -1048,19 +969,15 @@ class InstructionLdAHLI : public Instruction
 {
 public:
     InstructionLdAHLI( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x2A )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->A = m->rom[r->HL++];
+        r->A = m->read8( r->HL++ );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD A, (HL+)" );
+        return cycles;
     }
 };
 
@@ -1068,19 +985,15 @@ class InstructionDecHL : public Instruction
 {
 public:
     InstructionDecHL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x2B )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->HL--;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "DEC HL" );
+        return cycles;
     }
 };
 
@@ -1088,19 +1001,15 @@ class InstructionIncL : public Instruction
 {
 public:
     InstructionIncL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x2C )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->L = increment( r, r->L );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "INC L" );
+        return cycles;
     }
 };
 
@@ -1108,19 +1017,15 @@ class InstructionDecL : public Instruction
 {
 public:
     InstructionDecL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x2D )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->L = decrement( r, r->L );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "DEC L" );
+        return cycles;
     }
 };
 
@@ -1128,19 +1033,15 @@ class InstructionLdL : public Instruction
 {
 public:
     InstructionLdL( void )
-        : Instruction::Instruction( 2 )
+        : Instruction::Instruction( 0x2E )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->L = m->rom[r->PC + 1];
+        r->L = m->fetch8( r->PC + 1 );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD L, %#02x", mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -1148,20 +1049,17 @@ class InstructionCPL : public Instruction
 {
 public:
     InstructionCPL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x2F )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
+        r->sync_flags();
         r->Flag.N = r->Flag.H = 1;
         r->A = ~r->A;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "CPL" );
+        return cycles;
     }
 };
 
@@ -1169,21 +1067,19 @@ class InstructionJRNC : public Instruction
 {
 public:
     InstructionJRNC( void )
-        : Instruction::Instruction( 2 )
+        : Instruction::Instruction( 0x30 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        if ( r->Flag.C == 0 ) {
-            r->PC += (int8_t)m->rom[r->PC + 1];
+        if ( !r->c() ) {
+            r->PC += (int8_t)m->fetch8( r->PC + 1 );
+            r->PC += length;
+            return cycles_taken;
         }
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "JR NC, %#04x", addr + length + (int8_t)mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -1191,19 +1087,15 @@ class InstructionLdSP : public Instruction
 {
 public:
     InstructionLdSP( void )
-        : Instruction::Instruction( 3 )
+        : Instruction::Instruction( 0x31 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->SP = *(uint16_t*)&m->rom[r->PC + 1];
+        r->SP = m->fetch16( r->PC + 1 );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD SP, %#04x", *(uint16_t*)&mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -1211,19 +1103,15 @@ class InstructionLdHLDecA : public Instruction
 {
 public:
     InstructionLdHLDecA( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x32 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        m->rom[r->HL--] = r->A;
+        m->write8( r->HL--, r->A );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD (HL-), A" );
+        return cycles;
     }
 };
 
@@ -1231,19 +1119,15 @@ class InstructionIncSP : public Instruction
 {
 public:
     InstructionIncSP( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x33 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->SP++;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "INC SP" );
+        return cycles;
     }
 };
 
@@ -1251,19 +1135,15 @@ class InstructionIncHLderef : public Instruction
 {
 public:
     InstructionIncHLderef( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x34 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        m->rom[r->HL] = increment( r, m->rom[r->HL] );
+        m->write8( r->HL, increment( r, m->read8( r->HL ) ) );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "INC (HL)" );
+        return cycles;
     }
 };
 
@@ -1271,19 +1151,15 @@ class InstructionDecHLderef : public Instruction
 {
 public:
     InstructionDecHLderef( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x35 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        m->rom[r->HL] = decrement( r, m->rom[r->HL] );
+        m->write8( r->HL, decrement( r, m->read8( r->HL ) ) );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "DEC (HL)" );
+        return cycles;
     }
 };
 
@@ -1291,19 +1167,15 @@ class InstructionLdHLderef : public Instruction
 {
 public:
     InstructionLdHLderef( void )
-        : Instruction::Instruction( 2 )
+        : Instruction::Instruction( 0x36 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        m->rom[r->HL] = m->rom[r->PC + 1];
+        m->write8( r->HL, m->fetch8( r->PC + 1 ) );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD (HL), %#02x", mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -1311,20 +1183,17 @@ class InstructionSCF : public Instruction
 {
 public:
     InstructionSCF( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x37 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
+        r->sync_flags();
         r->Flag.N = r->Flag.H = 0;
         r->Flag.C = 1;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SCF" );
+        return cycles;
     }
 };
 
@@ -1332,21 +1201,19 @@ class InstructionJRC : public Instruction
 {
 public:
     InstructionJRC( void )
-        : Instruction::Instruction( 2 )
+        : Instruction::Instruction( 0x38 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        if ( r->Flag.C ) {
-            r->PC += (int8_t)m->rom[r->PC + 1];
+        if ( r->c() ) {
+            r->PC += (int8_t)m->fetch8( r->PC + 1 );
+            r->PC += length;
+            return cycles_taken;
         }
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "JR C, %#04x", addr + length + (int8_t)mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -1354,19 +1221,15 @@ class InstructionAddHLSP : public Instruction
 {
 public:
     InstructionAddHLSP( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x39 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         add_hl_r16( r, r->SP );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "ADD HL, SP" );
+        return cycles;
     }
 };
 
@@ -1374,19 +1237,15 @@ class InstructionLdAHLD : public Instruction
 {
 public:
     InstructionLdAHLD( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x3A )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->A = m->rom[r->HL--];
+        r->A = m->read8( r->HL-- );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD A, (HL-)" );
+        return cycles;
     }
 };
 
@@ -1394,19 +1253,15 @@ class InstructionDecSP : public Instruction
 {
 public:
     InstructionDecSP( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x3B )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->SP--;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "DEC SP" );
+        return cycles;
     }
 };
 
@@ -1414,19 +1269,15 @@ class InstructionIncA : public Instruction
 {
 public:
     InstructionIncA( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x3C )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = increment( r, r->A );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "INC A" );
+        return cycles;
     }
 };
 
@@ -1434,19 +1285,15 @@ class InstructionDecA : public Instruction
 {
 public:
     InstructionDecA( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x3D )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = decrement( r, r->A );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "DEC A" );
+        return cycles;
     }
 };
 
@@ -1454,19 +1301,15 @@ class InstructionLdA : public Instruction
 {
 public:
     InstructionLdA( void )
-        : Instruction::Instruction( 2 )
+        : Instruction::Instruction( 0x3E )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->A = m->rom[r->PC + 1];
+        r->A = m->fetch8( r->PC + 1 );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD A, %#02x", mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -1474,20 +1317,17 @@ class InstructionCCF : public Instruction
 {
 public:
     InstructionCCF( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x3F )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
+        r->sync_flags();
         r->Flag.N = r->Flag.H = 0;
         r->Flag.C ^= 1;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "CCF" );
+        return cycles;
     }
 };
 
@@ -1495,18 +1335,14 @@ class InstructionLdBB : public Instruction
 {
 public:
     InstructionLdBB( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x40 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD B, B" );
+        return cycles;
     }
 };
 
@@ -1514,19 +1350,15 @@ class InstructionLdBC : public Instruction
 {
 public:
     InstructionLdBC( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x41 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->B = r->C;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD B, C" );
+        return cycles;
     }
 };
 
@@ -1534,19 +1366,15 @@ class InstructionLdBD : public Instruction
 {
 public:
     InstructionLdBD( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x42 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->B = r->D;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD B, D" );
+        return cycles;
     }
 };
 
@@ -1554,19 +1382,15 @@ class InstructionLdBE : public Instruction
 {
 public:
     InstructionLdBE( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x43 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->B = r->E;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD B, E" );
+        return cycles;
     }
 };
 
@@ -1574,19 +1398,15 @@ class InstructionLdBH : public Instruction
 {
 public:
     InstructionLdBH( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x44 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->B = r->H;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD B, H" );
+        return cycles;
     }
 };
 
@@ -1594,19 +1414,15 @@ class InstructionLdBL : public Instruction
 {
 public:
     InstructionLdBL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x45 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->B = r->L;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD B, L" );
+        return cycles;
     }
 };
 
@@ -1614,19 +1430,15 @@ class InstructionLdBHL : public Instruction
 {
 public:
     InstructionLdBHL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x46 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->B = m->rom[r->HL];
+        r->B = m->read8( r->HL );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD B, (HL)" );
+        return cycles;
     }
 };
 
@@ -1634,19 +1446,15 @@ class InstructionLdBA : public Instruction
 {
 public:
     InstructionLdBA( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x47 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->B = r->A;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD B, A" );
+        return cycles;
     }
 };
 
@@ -1654,19 +1462,15 @@ class InstructionLdCB : public Instruction
 {
 public:
     InstructionLdCB( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x48 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->C = r->B;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD C, B" );
+        return cycles;
     }
 };
 
@@ -1674,18 +1478,14 @@ class InstructionLdCC : public Instruction
 {
 public:
     InstructionLdCC( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x49 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD C, C" );
+        return cycles;
     }
 };
 
@@ -1693,19 +1493,15 @@ class InstructionLdCD : public Instruction
 {
 public:
     InstructionLdCD( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x4A )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->C = r->D;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD C, D" );
+        return cycles;
     }
 };
 
@@ -1713,19 +1509,15 @@ class InstructionLdCE : public Instruction
 {
 public:
     InstructionLdCE( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x4B )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->C = r->E;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD C, E" );
+        return cycles;
     }
 };
 
@@ -1733,19 +1525,15 @@ class InstructionLdCH : public Instruction
 {
 public:
     InstructionLdCH( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x4C )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->C = r->H;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD C, H" );
+        return cycles;
     }
 };
 
@@ -1753,19 +1541,15 @@ class InstructionLdCL : public Instruction
 {
 public:
     InstructionLdCL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x4D )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->C = r->L;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD C, L" );
+        return cycles;
     }
 };
 
@@ -1773,19 +1557,15 @@ class InstructionLdCHL : public Instruction
 {
 public:
     InstructionLdCHL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x4E )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->C = m->rom[r->HL];
+        r->C = m->read8( r->HL );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD C, (HL)" );
+        return cycles;
     }
 };
 
@@ -1793,19 +1573,15 @@ class InstructionLdCA : public Instruction
 {
 public:
     InstructionLdCA( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x4F )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->C = r->A;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD C, A" );
+        return cycles;
     }
 };
 
@@ -1813,19 +1589,15 @@ class InstructionLdDB : public Instruction
 {
 public:
     InstructionLdDB( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x50 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->D = r->B;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD D, B" );
+        return cycles;
     }
 };
 
@@ -1833,19 +1605,15 @@ class InstructionLdDC : public Instruction
 {
 public:
     InstructionLdDC( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x51 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->D = r->C;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD D, C" );
+        return cycles;
     }
 };
 
@@ -1853,18 +1621,14 @@ class InstructionLdDD : public Instruction
 {
 public:
     InstructionLdDD( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x52 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD D, D" );
+        return cycles;
     }
 };
 
@@ -1872,19 +1636,15 @@ class InstructionLdDE : public Instruction
 {
 public:
     InstructionLdDE( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x53 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->D = r->E;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD D, E" );
+        return cycles;
     }
 };
 
@@ -1892,19 +1652,15 @@ class InstructionLdDH : public Instruction
 {
 public:
     InstructionLdDH( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x54 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->D = r->H;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD D, H" );
+        return cycles;
     }
 };
 
@@ -1912,19 +1668,15 @@ class InstructionLdDL : public Instruction
 {
 public:
     InstructionLdDL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x55 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->D = r->L;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD D, L" );
+        return cycles;
     }
 };
 
@@ -1932,19 +1684,15 @@ class InstructionLdDHL : public Instruction
 {
 public:
     InstructionLdDHL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x56 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->D = m->rom[r->HL];
+        r->D = m->read8( r->HL );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD D, (HL)" );
+        return cycles;
     }
 };
 
@@ -1952,19 +1700,15 @@ class InstructionLdDA : public Instruction
 {
 public:
     InstructionLdDA( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x57 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->D = r->A;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD D, A" );
+        return cycles;
     }
 };
 
@@ -1972,19 +1716,15 @@ class InstructionLdEB : public Instruction
 {
 public:
     InstructionLdEB( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x58 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->E = r->B;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD E, B" );
+        return cycles;
     }
 };
 
@@ -1992,19 +1732,15 @@ class InstructionLdEC : public Instruction
 {
 public:
     InstructionLdEC( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x59 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->E = r->C;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD E, C" );
+        return cycles;
     }
 };
 
@@ -2012,19 +1748,15 @@ class InstructionLdED : public Instruction
 {
 public:
     InstructionLdED( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x5A )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->E = r->D;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD E, D" );
+        return cycles;
     }
 };
 
@@ -2032,18 +1764,14 @@ class InstructionLdEE : public Instruction
 {
 public:
     InstructionLdEE( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x5B )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD E, E" );
+        return cycles;
     }
 };
 
@@ -2051,19 +1779,15 @@ class InstructionLdEH : public Instruction
 {
 public:
     InstructionLdEH( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x5C )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->E = r->H;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD E, H" );
+        return cycles;
     }
 };
 
@@ -2071,19 +1795,15 @@ class InstructionLdEL : public Instruction
 {
 public:
     InstructionLdEL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x5D )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->E = r->L;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD E, L" );
+        return cycles;
     }
 };
 
@@ -2091,19 +1811,15 @@ class InstructionLdEHL : public Instruction
 {
 public:
     InstructionLdEHL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x5E )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->E = m->rom[r->HL];
+        r->E = m->read8( r->HL );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD E, (HL)" );
+        return cycles;
     }
 };
 
@@ -2111,19 +1827,15 @@ class InstructionLdEA : public Instruction
 {
 public:
     InstructionLdEA( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x5F )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->E = r->A;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD E, A" );
+        return cycles;
     }
 };
 
@@ -2131,19 +1843,15 @@ class InstructionLdHB : public Instruction
 {
 public:
     InstructionLdHB( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x60 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->H = r->B;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD H, B" );
+        return cycles;
     }
 };
 
@@ -2151,19 +1859,15 @@ class InstructionLdHC : public Instruction
 {
 public:
     InstructionLdHC( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x61 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->H = r->C;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD H, C" );
+        return cycles;
     }
 };
 
@@ -2171,19 +1875,15 @@ class InstructionLdHD : public Instruction
 {
 public:
     InstructionLdHD( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x62 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->H = r->D;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD H, D" );
+        return cycles;
     }
 };
 
@@ -2191,19 +1891,15 @@ class InstructionLdHE : public Instruction
 {
 public:
     InstructionLdHE( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x63 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->H = r->E;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD H, E" );
+        return cycles;
     }
 };
 
@@ -2211,18 +1907,14 @@ class InstructionLdHH : public Instruction
 {
 public:
     InstructionLdHH( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x64 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD H, H" );
+        return cycles;
     }
 };
 
@@ -2230,19 +1922,15 @@ class InstructionLdHL : public Instruction
 {
 public:
     InstructionLdHL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x65 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->H = r->L;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD H, L" );
+        return cycles;
     }
 };
 
@@ -2250,19 +1938,15 @@ class InstructionLdHHL : public Instruction
 {
 public:
     InstructionLdHHL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x66 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->H = m->rom[r->HL];
+        r->H = m->read8( r->HL );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD H, (HL)" );
+        return cycles;
     }
 };
 
@@ -2270,19 +1954,15 @@ class InstructionLdHA : public Instruction
 {
 public:
     InstructionLdHA( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x67 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->H = r->A;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD H, A" );
+        return cycles;
     }
 };
 
@@ -2290,19 +1970,15 @@ class InstructionLdLB : public Instruction
 {
 public:
     InstructionLdLB( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x68 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->L = r->B;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD L, B" );
+        return cycles;
     }
 };
 
@@ -2310,19 +1986,15 @@ class InstructionLdLC : public Instruction
 {
 public:
     InstructionLdLC( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x69 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->L = r->C;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD L, C" );
+        return cycles;
     }
 };
 
@@ -2330,19 +2002,15 @@ class InstructionLdLD : public Instruction
 {
 public:
     InstructionLdLD( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x6A )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->L = r->D;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD L, D" );
+        return cycles;
     }
 };
 
@@ -2350,19 +2018,15 @@ class InstructionLdLE : public Instruction
 {
 public:
     InstructionLdLE( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x6B )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->L = r->E;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD L, E" );
+        return cycles;
     }
 };
 
@@ -2370,19 +2034,15 @@ class InstructionLdLH : public Instruction
 {
 public:
     InstructionLdLH( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x6C )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->L = r->H;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD L, H" );
+        return cycles;
     }
 };
 
@@ -2390,18 +2050,14 @@ class InstructionLdLL : public Instruction
 {
 public:
     InstructionLdLL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x6D )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD L, L" );
+        return cycles;
     }
 };
 
@@ -2409,19 +2065,15 @@ class InstructionLdLHL : public Instruction
 {
 public:
     InstructionLdLHL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x6E )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->L = m->rom[r->HL];
+        r->L = m->read8( r->HL );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD L, (HL)" );
+        return cycles;
     }
 };
 
@@ -2429,19 +2081,15 @@ class InstructionLdLA : public Instruction
 {
 public:
     InstructionLdLA( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x6F )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->L = r->A;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD L, A" );
+        return cycles;
     }
 };
 
@@ -2449,19 +2097,15 @@ class InstructionLdHLB : public Instruction
 {
 public:
     InstructionLdHLB( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x70 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        m->rom[r->HL] = r->B;
+        m->write8( r->HL, r->B );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD (HL), B" );
+        return cycles;
     }
 };
 
@@ -2469,19 +2113,15 @@ class InstructionLdHLC : public Instruction
 {
 public:
     InstructionLdHLC( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x71 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        m->rom[r->HL] = r->C;
+        m->write8( r->HL, r->C );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD (HL), C" );
+        return cycles;
     }
 };
 
@@ -2489,19 +2129,15 @@ class InstructionLdHLD : public Instruction
 {
 public:
     InstructionLdHLD( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x72 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        m->rom[r->HL] = r->D;
+        m->write8( r->HL, r->D );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD (HL), D" );
+        return cycles;
     }
 };
 
@@ -2509,19 +2145,15 @@ class InstructionLdHLE : public Instruction
 {
 public:
     InstructionLdHLE( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x73 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        m->rom[r->HL] = r->E;
+        m->write8( r->HL, r->E );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD (HL), E" );
+        return cycles;
     }
 };
 
@@ -2529,19 +2161,15 @@ class InstructionLdHLH : public Instruction
 {
 public:
     InstructionLdHLH( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x74 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        m->rom[r->HL] = r->H;
+        m->write8( r->HL, r->H );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD (HL), H" );
+        return cycles;
     }
 };
 
@@ -2549,19 +2177,15 @@ class InstructionLdHLL : public Instruction
 {
 public:
     InstructionLdHLL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x75 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        m->rom[r->HL] = r->L;
+        m->write8( r->HL, r->L );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD (HL), L" );
+        return cycles;
     }
 };
 
@@ -2572,19 +2196,15 @@ private:
 
 public:
     InstructionHALT( StepState& state )
-        : Instruction::Instruction( 1 ), sstate( state )
+        : Instruction::Instruction( 0x76 ), sstate( state )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         sstate = StepState::STOP;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "HALT" );
+        return cycles;
     }
 };
 
@@ -2592,19 +2212,15 @@ class InstructionLdHLA : public Instruction
 {
 public:
     InstructionLdHLA( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x77 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        m->rom[r->HL] = r->A;
+        m->write8( r->HL, r->A );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD (HL), A" );
+        return cycles;
     }
 };
 
@@ -2612,19 +2228,15 @@ class InstructionLdAB : public Instruction
 {
 public:
     InstructionLdAB( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x78 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = r->B;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD A, B" );
+        return cycles;
     }
 };
 
@@ -2632,19 +2244,15 @@ class InstructionLdAC : public Instruction
 {
 public:
     InstructionLdAC( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x79 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = r->C;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD A, C" );
+        return cycles;
     }
 };
 
@@ -2652,19 +2260,15 @@ class InstructionLdAD : public Instruction
 {
 public:
     InstructionLdAD( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x7A )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = r->D;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD A, D" );
+        return cycles;
     }
 };
 
@@ -2672,19 +2276,15 @@ class InstructionLdAE : public Instruction
 {
 public:
     InstructionLdAE( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x7B )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = r->E;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD A, E" );
+        return cycles;
     }
 };
 
@@ -2692,19 +2292,15 @@ class InstructionLdAH : public Instruction
 {
 public:
     InstructionLdAH( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x7C )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = r->H;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD A, H" );
+        return cycles;
     }
 };
 
@@ -2712,19 +2308,15 @@ class InstructionLdAL : public Instruction
 {
 public:
     InstructionLdAL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x7D )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = r->L;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD A, L" );
+        return cycles;
     }
 };
 
@@ -2732,19 +2324,15 @@ class InstructionLdAHL : public Instruction
 {
 public:
     InstructionLdAHL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x7E )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->A = m->rom[r->HL];
+        r->A = m->read8( r->HL );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD A, (HL)" );
+        return cycles;
     }
 };
 
@@ -2752,18 +2340,14 @@ class InstructionLdAA : public Instruction
 {
 public:
     InstructionLdAA( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x7F )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD A, A" );
+        return cycles;
     }
 };
 
@@ -2771,19 +2355,15 @@ class InstructionAddAB : public Instruction
 {
 public:
     InstructionAddAB( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x80 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = add( r, r->A, r->B );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "ADD A, B" );
+        return cycles;
     }
 };
 
@@ -2791,19 +2371,15 @@ class InstructionAddAC : public Instruction
 {
 public:
     InstructionAddAC( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x81 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = add( r, r->A, r->C );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "ADD A, C" );
+        return cycles;
     }
 };
 
@@ -2811,19 +2387,15 @@ class InstructionAddAD : public Instruction
 {
 public:
     InstructionAddAD( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x82 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = add( r, r->A, r->D );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "ADD A, D" );
+        return cycles;
     }
 };
 
@@ -2831,19 +2403,15 @@ class InstructionAddAE : public Instruction
 {
 public:
     InstructionAddAE( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x83 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = add( r, r->A, r->E );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "ADD A, E" );
+        return cycles;
     }
 };
 
@@ -2851,19 +2419,15 @@ class InstructionAddAH : public Instruction
 {
 public:
     InstructionAddAH( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x84 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = add( r, r->A, r->H );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "ADD A, H" );
+        return cycles;
     }
 };
 
@@ -2871,19 +2435,15 @@ class InstructionAddAL : public Instruction
 {
 public:
     InstructionAddAL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x85 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = add( r, r->A, r->L );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "ADD A, L" );
+        return cycles;
     }
 };
 
@@ -2891,19 +2451,15 @@ class InstructionAddAHL : public Instruction
 {
 public:
     InstructionAddAHL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x86 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->A = add( r, r->A, m->rom[r->HL] );
+        r->A = add( r, r->A, m->read8( r->HL ) );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "ADD A, (HL)" );
+        return cycles;
     }
 };
 
@@ -2911,19 +2467,15 @@ class InstructionAddAA : public Instruction
 {
 public:
     InstructionAddAA( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x87 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = add( r, r->A, r->A );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "ADD A, A" );
+        return cycles;
     }
 };
 
@@ -2931,19 +2483,15 @@ class InstructionAdcAB : public Instruction
 {
 public:
     InstructionAdcAB( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x88 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = adc( r, r->A, r->B );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "ADC A, B" );
+        return cycles;
     }
 };
 
@@ -2951,19 +2499,15 @@ class InstructionAdcAC : public Instruction
 {
 public:
     InstructionAdcAC( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x89 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = adc( r, r->A, r->C );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "ADC A, C" );
+        return cycles;
     }
 };
 
@@ -2971,19 +2515,15 @@ class InstructionAdcAD : public Instruction
 {
 public:
     InstructionAdcAD( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x8A )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = adc( r, r->A, r->D );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "ADC A, D" );
+        return cycles;
     }
 };
 
@@ -2991,19 +2531,15 @@ class InstructionAdcAE : public Instruction
 {
 public:
     InstructionAdcAE( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x8B )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = adc( r, r->A, r->E );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "ADC A, E" );
+        return cycles;
     }
 };
 
@@ -3011,19 +2547,15 @@ class InstructionAdcAH : public Instruction
 {
 public:
     InstructionAdcAH( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x8C )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = adc( r, r->A, r->H );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "ADC A, H" );
+        return cycles;
     }
 };
 
@@ -3031,19 +2563,15 @@ class InstructionAdcAL : public Instruction
 {
 public:
     InstructionAdcAL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x8D )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = adc( r, r->A, r->L );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "ADC A, L" );
+        return cycles;
     }
 };
 
@@ -3051,19 +2579,15 @@ class InstructionAdcAHL : public Instruction
 {
 public:
     InstructionAdcAHL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x8E )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->A = adc( r, r->A, m->rom[r->HL] );
+        r->A = adc( r, r->A, m->read8( r->HL ) );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "ADC A, (HL)" );
+        return cycles;
     }
 };
 
@@ -3071,19 +2595,15 @@ class InstructionAdcAA : public Instruction
 {
 public:
     InstructionAdcAA( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x8F )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = adc( r, r->A, r->A );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "ADC A, A" );
+        return cycles;
     }
 };
 
@@ -3091,19 +2611,15 @@ class InstructionSubAB : public Instruction
 {
 public:
     InstructionSubAB( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x90 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = sub( r, r->A, r->B );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SUB A, B" );
+        return cycles;
     }
 };
 
@@ -3111,19 +2627,15 @@ class InstructionSubAC : public Instruction
 {
 public:
     InstructionSubAC( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x91 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = sub( r, r->A, r->C );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SUB A, C" );
+        return cycles;
     }
 };
 
@@ -3131,19 +2643,15 @@ class InstructionSubAD : public Instruction
 {
 public:
     InstructionSubAD( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x92 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = sub( r, r->A, r->D );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SUB A, D" );
+        return cycles;
     }
 };
 
@@ -3151,19 +2659,15 @@ class InstructionSubAE : public Instruction
 {
 public:
     InstructionSubAE( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x93 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = sub( r, r->A, r->E );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SUB A, E" );
+        return cycles;
     }
 };
 
@@ -3171,19 +2675,15 @@ class InstructionSubAH : public Instruction
 {
 public:
     InstructionSubAH( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x94 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = sub( r, r->A, r->H );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SUB A, H" );
+        return cycles;
     }
 };
 
@@ -3191,19 +2691,15 @@ class InstructionSubAL : public Instruction
 {
 public:
     InstructionSubAL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x95 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = sub( r, r->A, r->L );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SUB A, L" );
+        return cycles;
     }
 };
 
@@ -3211,19 +2707,15 @@ class InstructionSubAHL : public Instruction
 {
 public:
     InstructionSubAHL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x96 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->A = sub( r, r->A, m->rom[r->HL] );
+        r->A = sub( r, r->A, m->read8( r->HL ) );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SUB A, (HL)" );
+        return cycles;
     }
 };
 
@@ -3231,19 +2723,15 @@ class InstructionSubAA : public Instruction
 {
 public:
     InstructionSubAA( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x97 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = sub( r, r->A, r->A );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SUB A, A" );
+        return cycles;
     }
 };
 
@@ -3251,19 +2739,15 @@ class InstructionSbcAB : public Instruction
 {
 public:
     InstructionSbcAB( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x98 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = sbc( r, r->A, r->B );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SBC A, B" );
+        return cycles;
     }
 };
 
@@ -3271,19 +2755,15 @@ class InstructionSbcAC : public Instruction
 {
 public:
     InstructionSbcAC( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x99 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = sbc( r, r->A, r->C );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SBC A, B" );
+        return cycles;
     }
 };
 
@@ -3291,19 +2771,15 @@ class InstructionSbcAD : public Instruction
 {
 public:
     InstructionSbcAD( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x9A )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = sbc( r, r->A, r->D );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SBC A, D" );
+        return cycles;
     }
 };
 
@@ -3311,19 +2787,15 @@ class InstructionSbcAE : public Instruction
 {
 public:
     InstructionSbcAE( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x9B )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = sbc( r, r->A, r->E );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SBC A, E" );
+        return cycles;
     }
 };
 
@@ -3331,19 +2803,15 @@ class InstructionSbcAH : public Instruction
 {
 public:
     InstructionSbcAH( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x9C )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = sbc( r, r->A, r->H );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SBC A, H" );
+        return cycles;
     }
 };
 
@@ -3351,19 +2819,15 @@ class InstructionSbcAL : public Instruction
 {
 public:
     InstructionSbcAL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x9D )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = sbc( r, r->A, r->L );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SBC A, L" );
+        return cycles;
     }
 };
 
@@ -3371,19 +2835,15 @@ class InstructionSbcAHL : public Instruction
 {
 public:
     InstructionSbcAHL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x9E )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->A = sbc( r, r->A, m->rom[r->HL] );
+        r->A = sbc( r, r->A, m->read8( r->HL ) );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SBC A, (HL)" );
+        return cycles;
     }
 };
 
@@ -3391,19 +2851,15 @@ class InstructionSbcAA : public Instruction
 {
 public:
     InstructionSbcAA( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0x9F )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = sbc( r, r->A, r->A );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SBC A, A" );
+        return cycles;
     }
 };
 
@@ -3411,19 +2867,15 @@ class InstructionAndAB : public Instruction
 {
 public:
     InstructionAndAB( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xA0 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = _and( r, r->A, r->B );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "AND A, B" );
+        return cycles;
     }
 };
 
@@ -3431,19 +2883,15 @@ class InstructionAndAC : public Instruction
 {
 public:
     InstructionAndAC( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xA1 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = _and( r, r->A, r->C );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "AND A, C" );
+        return cycles;
     }
 };
 
@@ -3451,19 +2899,15 @@ class InstructionAndAD : public Instruction
 {
 public:
     InstructionAndAD( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xA2 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = _and( r, r->A, r->D );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "AND A, D" );
+        return cycles;
     }
 };
 
@@ -3471,19 +2915,15 @@ class InstructionAndAE : public Instruction
 {
 public:
     InstructionAndAE( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xA3 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = _and( r, r->A, r->E );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "AND A, E" );
+        return cycles;
     }
 };
 
@@ -3491,19 +2931,15 @@ class InstructionAndAH : public Instruction
 {
 public:
     InstructionAndAH( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xA4 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = _and( r, r->A, r->H );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "AND A, H" );
+        return cycles;
     }
 };
 
@@ -3511,19 +2947,15 @@ class InstructionAndAL : public Instruction
 {
 public:
     InstructionAndAL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xA5 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = _and( r, r->A, r->L );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "AND A, L" );
+        return cycles;
     }
 };
 
@@ -3531,19 +2963,15 @@ class InstructionAndAHL : public Instruction
 {
 public:
     InstructionAndAHL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xA6 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->A = _and( r, r->A, m->rom[r->HL] );
+        r->A = _and( r, r->A, m->read8( r->HL ) );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "AND A, (HL)" );
+        return cycles;
     }
 };
 
@@ -3551,19 +2979,15 @@ class InstructionAndAA : public Instruction
 {
 public:
     InstructionAndAA( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xA7 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = _and( r, r->A, r->A );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "AND A, A" );
+        return cycles;
     }
 };
 
@@ -3571,19 +2995,15 @@ class InstructionXorAB : public Instruction
 {
 public:
     InstructionXorAB( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xA8 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = _xor( r, r->A, r->B );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "XOR A, B" );
+        return cycles;
     }
 };
 
@@ -3591,19 +3011,15 @@ class InstructionXorAC : public Instruction
 {
 public:
     InstructionXorAC( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xA9 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = _xor( r, r->A, r->C );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "XOR A, C" );
+        return cycles;
     }
 };
 
@@ -3611,19 +3027,15 @@ class InstructionXorAD : public Instruction
 {
 public:
     InstructionXorAD( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xAA )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = _xor( r, r->A, r->D );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "XOR A, D" );
+        return cycles;
     }
 };
 
@@ -3631,19 +3043,15 @@ class InstructionXorAE : public Instruction
 {
 public:
     InstructionXorAE( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xAB )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = _xor( r, r->A, r->E );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "XOR A, E" );
+        return cycles;
     }
 };
 
@@ -3651,19 +3059,15 @@ class InstructionXorAH : public Instruction
 {
 public:
     InstructionXorAH( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xAC )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = _xor( r, r->A, r->H );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "XOR A, H" );
+        return cycles;
     }
 };
 
@@ -3671,19 +3075,15 @@ class InstructionXorAL : public Instruction
 {
 public:
     InstructionXorAL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xAD )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = _xor( r, r->A, r->L );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "XOR A, L" );
+        return cycles;
     }
 };
 
@@ -3691,19 +3091,15 @@ class InstructionXorAHL : public Instruction
 {
 public:
     InstructionXorAHL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xAE )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->A = _xor( r, r->A, m->rom[r->HL] );
+        r->A = _xor( r, r->A, m->read8( r->HL ) );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "XOR A, (HL)" );
+        return cycles;
     }
 };
 
@@ -3711,19 +3107,15 @@ class InstructionXorAA : public Instruction
 {
 public:
     InstructionXorAA( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xAF )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = _xor( r, r->A, r->A );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "XOR A, A" );
+        return cycles;
     }
 };
 
@@ -3731,19 +3123,15 @@ class InstructionOrAB : public Instruction
 {
 public:
     InstructionOrAB( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xB0 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = _or( r, r->A, r->B );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "OR A, B" );
+        return cycles;
     }
 };
 
@@ -3751,19 +3139,15 @@ class InstructionOrAC : public Instruction
 {
 public:
     InstructionOrAC( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xB1 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = _or( r, r->A, r->C );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "OR A, C" );
+        return cycles;
     }
 };
 
@@ -3771,19 +3155,15 @@ class InstructionOrAD : public Instruction
 {
 public:
     InstructionOrAD( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xB2 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = _or( r, r->A, r->D );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "OR A, D" );
+        return cycles;
     }
 };
 
@@ -3791,19 +3171,15 @@ class InstructionOrAE : public Instruction
 {
 public:
     InstructionOrAE( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xB3 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = _or( r, r->A, r->E );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "OR A, E" );
+        return cycles;
     }
 };
 
@@ -3811,19 +3187,15 @@ class InstructionOrAH : public Instruction
 {
 public:
     InstructionOrAH( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xB4 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = _or( r, r->A, r->H );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "OR A, H" );
+        return cycles;
     }
 };
 
@@ -3831,19 +3203,15 @@ class InstructionOrAL : public Instruction
 {
 public:
     InstructionOrAL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xB5 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = _or( r, r->A, r->L );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "OR A, L" );
+        return cycles;
     }
 };
 
@@ -3851,19 +3219,15 @@ class InstructionOrAHL : public Instruction
 {
 public:
     InstructionOrAHL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xB6 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->A = _or( r, r->A, m->rom[r->HL] );
+        r->A = _or( r, r->A, m->read8( r->HL ) );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "OR A, (HL)" );
+        return cycles;
     }
 };
 
@@ -3871,19 +3235,15 @@ class InstructionOrAA : public Instruction
 {
 public:
     InstructionOrAA( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xB7 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->A = _or( r, r->A, r->A );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "OR A, A" );
+        return cycles;
     }
 };
 
@@ -3891,19 +3251,15 @@ class InstructionCpAB : public Instruction
 {
 public:
     InstructionCpAB( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xB8 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         sub( r, r->A, r->B );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "CP A, B" );
+        return cycles;
     }
 };
 
@@ -3911,19 +3267,15 @@ class InstructionCpAC : public Instruction
 {
 public:
     InstructionCpAC( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xB9 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         sub( r, r->A, r->C );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "CP A, C" );
+        return cycles;
     }
 };
 
@@ -3931,19 +3283,15 @@ class InstructionCpAD : public Instruction
 {
 public:
     InstructionCpAD( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xBA )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         sub( r, r->A, r->D );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "CP A, D" );
+        return cycles;
     }
 };
 
@@ -3951,19 +3299,15 @@ class InstructionCpAE : public Instruction
 {
 public:
     InstructionCpAE( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xBB )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         sub( r, r->A, r->E );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "CP A, E" );
+        return cycles;
     }
 };
 
@@ -3971,19 +3315,15 @@ class InstructionCpAH : public Instruction
 {
 public:
     InstructionCpAH( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xBC )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         sub( r, r->A, r->H );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "CP A, H" );
+        return cycles;
     }
 };
 
@@ -3991,19 +3331,15 @@ class InstructionCpAL : public Instruction
 {
 public:
     InstructionCpAL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xBD )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         sub( r, r->A, r->L );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "CP A, L" );
+        return cycles;
     }
 };
 
@@ -4011,19 +3347,15 @@ class InstructionCpAHL : public Instruction
 {
 public:
     InstructionCpAHL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xBE )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        sub( r, r->A, m->rom[r->HL] );
+        sub( r, r->A, m->read8( r->HL ) );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "CP A, (HL)" );
+        return cycles;
     }
 };
 
@@ -4031,19 +3363,15 @@ class InstructionCpAA : public Instruction
 {
 public:
     InstructionCpAA( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xBF )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         sub( r, r->A, r->A );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "CP A, A" );
+        return cycles;
     }
 };
 
@@ -4051,23 +3379,18 @@ class InstructionRetNZ : public Instruction
 {
 public:
     InstructionRetNZ( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xC0 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        if ( !r->Flag.Z ) {
+        if ( !r->z() ) {
             r->PC = pop( m, r );
-            r->SP += 2;
-            return;
+            return cycles_taken;
         }
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RET NZ" );
+        return cycles;
     }
 };
 
@@ -4075,20 +3398,16 @@ class InstructionPopBC : public Instruction
 {
 public:
     InstructionPopBC( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xC1 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->C = m->rom[r->SP++];
-        r->B = m->rom[r->SP++];
+        r->C = m->read8( r->SP++ );
+        r->B = m->read8( r->SP++ );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "POP BC" );
+        return cycles;
     }
 };
 
@@ -4096,22 +3415,18 @@ class InstructionJpNZu16 : public Instruction
 {
 public:
     InstructionJpNZu16( void )
-        : Instruction::Instruction( 3 )
+        : Instruction::Instruction( 0xC2 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        if ( !r->Flag.Z ) {
-            r->PC = *(uint16_t*)&m->rom[r->PC + 1];
-            return;
+        if ( !r->z() ) {
+            r->PC = m->fetch16( r->PC + 1 );
+            return cycles_taken;
         }
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "JP NZ, %#04x", *(uint16_t*)&mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -4119,18 +3434,14 @@ class InstructionJPu16 : public Instruction
 {
 public:
     InstructionJPu16( void )
-        : Instruction::Instruction( 3 )
+        : Instruction::Instruction( 0xC3 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->PC = *(uint16_t*)&m->rom[r->PC + 1];
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
+    virtual int execute( Memory* m, Registers* r )
     {
-        snprintf( dst, size, "JP %#04x", *(uint16_t*)&mem->rom[addr + 1] );
+        r->PC = m->fetch16( r->PC + 1 );
+        return cycles;
     }
 };
 
@@ -4138,23 +3449,19 @@ class InstructionCallNZ : public Instruction
 {
 public:
     InstructionCallNZ( void )
-        : Instruction::Instruction( 3 )
+        : Instruction::Instruction( 0xC4 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        if ( !r->Flag.Z ) {
+        if ( !r->z() ) {
             push( m, r, r->PC + length );
-            r->PC = *(uint16_t*)&m->rom[r->PC + 1];
-            return;
+            r->PC = m->fetch16( r->PC + 1 );
+            return cycles_taken;
         }
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "CALL NZ, %#04x", *(uint16_t*)&mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -4162,19 +3469,15 @@ class InstructionPushBC : public Instruction
 {
 public:
     InstructionPushBC( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xC5 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         push( m, r, r->BC );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "PUSH BC" );
+        return cycles;
     }
 };
 
@@ -4182,19 +3485,15 @@ class InstructionAddA : public Instruction
 {
 public:
     InstructionAddA( void )
-        : Instruction::Instruction( 2 )
+        : Instruction::Instruction( 0xC6 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->A = add( r, r->A, m->rom[r->PC + 1] );
+        r->A = add( r, r->A, m->fetch8( r->PC + 1 ) );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "ADD A, %#02x", mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -4202,19 +3501,15 @@ class InstructionRST00 : public Instruction
 {
 public:
     InstructionRST00( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xC7 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         push( m, r, r->PC + length );
         r->PC = 0x0000;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RST 0x00" );
+        return cycles;
     }
 };
 
@@ -4222,22 +3517,18 @@ class InstructionRetZ : public Instruction
 {
 public:
     InstructionRetZ( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xC8 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        if ( r->Flag.Z ) {
+        if ( r->z() ) {
             r->PC = pop( m, r );
-            return;
+            return cycles_taken;
         }
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RET Z" );
+        return cycles;
     }
 };
 
@@ -4245,18 +3536,14 @@ class InstructionRet : public Instruction
 {
 public:
     InstructionRet( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xC9 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->PC = pop( m, r );
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RET" );
+        return cycles;
     }
 };
 
@@ -4264,22 +3551,18 @@ class InstructionJpZu16 : public Instruction
 {
 public:
     InstructionJpZu16( void )
-        : Instruction::Instruction( 3 )
+        : Instruction::Instruction( 0xCA )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        if ( r->Flag.Z ) {
-            r->PC = *(uint16_t*)&m->rom[r->PC + 1];
-            return;
+        if ( r->z() ) {
+            r->PC = m->fetch16( r->PC + 1 );
+            return cycles_taken;
         }
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "JP Z, %#04x", *(uint16_t*)&mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -4287,23 +3570,19 @@ class InstructionCallZ : public Instruction
 {
 public:
     InstructionCallZ( void )
-        : Instruction::Instruction( 3 )
+        : Instruction::Instruction( 0xCC )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        if ( r->Flag.Z ) {
+        if ( r->z() ) {
             push( m, r, r->PC + length );
-            r->PC = *(uint16_t*)&m->rom[r->PC + 1];
-            return;
+            r->PC = m->fetch16( r->PC + 1 );
+            return cycles_taken;
         }
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "CALL Z, %#04x", *(uint16_t*)&mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -4311,20 +3590,16 @@ class InstructionCall : public Instruction
 {
 public:
     InstructionCall( void )
-        : Instruction::Instruction( 3 )
+        : Instruction::Instruction( 0xCD )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        uint16_t addr = *(uint16_t*)&m->rom[r->PC + 1];
-        push( m, r, addr );
+        uint16_t addr = m->fetch16( r->PC + 1 );
+        push( m, r, r->PC + length );
         r->PC = addr;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "CALL %#04x", *(uint16_t*)&mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -4332,19 +3607,15 @@ class InstructionAdcA : public Instruction
 {
 public:
     InstructionAdcA( void )
-        : Instruction::Instruction( 2 )
+        : Instruction::Instruction( 0xCE )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->A = adc( r, r->A, m->rom[r->PC + 1] );
+        r->A = adc( r, r->A, m->fetch8( r->PC + 1 ) );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "ADC A, %#02x", mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -4352,19 +3623,15 @@ class InstructionRST08 : public Instruction
 {
 public:
     InstructionRST08( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xCF )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         push( m, r, r->PC + length );
         r->PC = 0x0008;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RST 0x08" );
+        return cycles;
     }
 };
 
@@ -4372,22 +3639,18 @@ class InstructionRetNC : public Instruction
 {
 public:
     InstructionRetNC( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xD0 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        if ( !r->Flag.C ) {
+        if ( !r->c() ) {
             r->PC = pop( m, r );
-            return;
+            return cycles_taken;
         }
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RET NC" );
+        return cycles;
     }
 };
 
@@ -4395,19 +3658,15 @@ class InstructionPopDE : public Instruction
 {
 public:
     InstructionPopDE( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xD1 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->DE = pop( m, r );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "POP DE" );
+        return cycles;
     }
 };
 
@@ -4415,22 +3674,18 @@ class InstructionJpNCu16 : public Instruction
 {
 public:
     InstructionJpNCu16( void )
-        : Instruction::Instruction( 3 )
+        : Instruction::Instruction( 0xD2 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        if ( !r->Flag.C ) {
-            r->PC = *(uint16_t*)&m->rom[r->PC + 1];
-            return;
+        if ( !r->c() ) {
+            r->PC = m->fetch16( r->PC + 1 );
+            return cycles_taken;
         }
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "JP NC, %#04x", *(uint16_t*)&mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -4438,23 +3693,19 @@ class InstructionCallNC : public Instruction
 {
 public:
     InstructionCallNC( void )
-        : Instruction::Instruction( 3 )
+        : Instruction::Instruction( 0xD4 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        if ( !r->Flag.C ) {
+        if ( !r->c() ) {
             push( m, r, r->PC + length );
-            r->PC = *(uint16_t*)&m->rom[r->PC + 1];
-            return;
+            r->PC = m->fetch16( r->PC + 1 );
+            return cycles_taken;
         }
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "CALL NC, %#04x", *(uint16_t*)&mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -4462,19 +3713,15 @@ class InstructionPushDE : public Instruction
 {
 public:
     InstructionPushDE( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xD5 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         push( m, r, r->DE );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "PUSH DE" );
+        return cycles;
     }
 };
 
@@ -4482,19 +3729,15 @@ class InstructionSubAu8 : public Instruction
 {
 public:
     InstructionSubAu8( void )
-        : Instruction::Instruction( 2 )
+        : Instruction::Instruction( 0xD6 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->A = sub( r, r->A, m->rom[r->PC + 1] );
+        r->A = sub( r, r->A, m->fetch8( r->PC + 1 ) );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SUB A, %#02x", mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -4502,19 +3745,15 @@ class InstructionRST10 : public Instruction
 {
 public:
     InstructionRST10( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xD7 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         push( m, r, r->PC + length );
         r->PC = 0x0010;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RST 0x10" );
+        return cycles;
     }
 };
 
@@ -4522,22 +3761,18 @@ class InstructionRetC : public Instruction
 {
 public:
     InstructionRetC( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xD8 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        if ( r->Flag.C ) {
+        if ( r->c() ) {
             r->PC = pop( m, r );
-            return;
+            return cycles_taken;
         }
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RET C" );
+        return cycles;
     }
 };
 
@@ -4545,19 +3780,15 @@ class InstructionRetI : public Instruction
 {
 public:
     InstructionRetI( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xD9 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->PC = pop( m, r );
         m->ie = 1;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RETI" );
+        return cycles;
     }
 };
 
@@ -4565,22 +3796,18 @@ class InstructionJpCu16 : public Instruction
 {
 public:
     InstructionJpCu16( void )
-        : Instruction::Instruction( 3 )
+        : Instruction::Instruction( 0xDA )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        if ( r->Flag.C ) {
-            r->PC = *(uint16_t*)&m->rom[r->PC + 1];
-            return;
+        if ( r->c() ) {
+            r->PC = m->fetch16( r->PC + 1 );
+            return cycles_taken;
         }
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "JP C, %#04x", *(uint16_t*)&mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -4588,24 +3815,20 @@ class InstructionCallC : public Instruction
 {
 public:
     InstructionCallC( void )
-        : Instruction::Instruction( 3 )
+        : Instruction::Instruction( 0xDC )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        if ( r->Flag.C ) {
-            uint16_t addr = *(uint16_t*)&m->rom[r->PC + 1];
+        if ( r->c() ) {
+            uint16_t addr = m->fetch16( r->PC + 1 );
             push( m, r, addr );
             r->PC = addr;
-            return;
+            return cycles_taken;
         }
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "CALL C, %#04x", *(uint16_t*)&mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -4613,19 +3836,15 @@ class InstructionSbcA : public Instruction
 {
 public:
     InstructionSbcA( void )
-        : Instruction::Instruction( 2 )
+        : Instruction::Instruction( 0xDE )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->A = sbc( r, r->A, m->rom[r->PC + 1] );
+        r->A = sbc( r, r->A, m->fetch8( r->PC + 1 ) );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SBC A, %#02x", mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -4633,19 +3852,15 @@ class InstructionRST18 : public Instruction
 {
 public:
     InstructionRST18( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xDF )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         push( m, r, r->PC + length );
         r->PC = 0x0018;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RST 0x18" );
+        return cycles;
     }
 };
 
@@ -4653,19 +3868,15 @@ class InstructionLdFFA : public Instruction
 {
 public:
     InstructionLdFFA( void )
-        : Instruction::Instruction( 2 )
+        : Instruction::Instruction( 0xE0 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        m->rom[0xFF00 | m->rom[r->PC + 1]] = r->A;
+        m->write8( 0xFF00 | m->fetch8( r->PC + 1 ), r->A );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD (%#04x), A", 0xFF00 | mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -4673,19 +3884,15 @@ class InstructionPopHL : public Instruction
 {
 public:
     InstructionPopHL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xE1 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->HL = pop( m, r );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "POP HL" );
+        return cycles;
     }
 };
 
@@ -4693,19 +3900,15 @@ class InstructionLdFFCA : public Instruction
 {
 public:
     InstructionLdFFCA( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xE2 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        m->rom[0xFF00 | r->C] = r->A;
+        m->write8( 0xFF00 | r->C, r->A );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD (0xFF00 + C), A" );
+        return cycles;
     }
 };
 
@@ -4713,39 +3916,31 @@ class InstructionPushHL : public Instruction
 {
 public:
     InstructionPushHL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xE5 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         push( m, r, r->HL );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "PUSH HL" );
+        return cycles;
     }
 };
 
-class InstructionAddAu8 : public Instruction
+class InstructionAndA : public Instruction
 {
 public:
-    InstructionAddAu8( void )
-        : Instruction::Instruction( 2 )
+    InstructionAndA( void )
+        : Instruction::Instruction( 0xE6 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->A = add( r, r->A, m->rom[r->PC + 1] );
+        r->A = _and( r, r->A, m->fetch8( r->PC + 1 ) );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "ADD A, %#02x", mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -4753,19 +3948,15 @@ class InstructionRST20 : public Instruction
 {
 public:
     InstructionRST20( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xE7 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         push( m, r, r->PC + length );
         r->PC = 0x0020;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RST 0x20" );
+        return cycles;
     }
 };
 
@@ -4773,20 +3964,17 @@ class InstructionAddSPi8 : public Instruction
 {
 public:
     InstructionAddSPi8( void )
-        : Instruction::Instruction( 2 )
+        : Instruction::Instruction( 0xE8 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->SP = add< uint16_t >( r, r->SP, (int8_t)m->rom[r->PC + 1] );
+        r->SP = add< uint16_t >( r, r->SP, (int8_t)m->fetch8( r->PC + 1 ) );
+        r->sync_flags();
         r->Flag.Z = 0;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "ADD SP, %#04x", ( uint16_t )(int8_t)mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -4794,18 +3982,14 @@ class InstructionJpHL : public Instruction
 {
 public:
     InstructionJpHL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xE9 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->PC = r->HL;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "JP HL" );
+        return cycles;
     }
 };
 
@@ -4813,19 +3997,15 @@ class InstructionLdu16A : public Instruction
 {
 public:
     InstructionLdu16A( void )
-        : Instruction::Instruction( 3 )
+        : Instruction::Instruction( 0xEA )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        m->rom[*(uint16_t*)&m->rom[r->PC + 1]] = r->A;
+        m->write8( m->fetch16( r->PC + 1 ), r->A );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD (%#04x), A", *(uint16_t*)&mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -4833,19 +4013,15 @@ class InstructionXorA : public Instruction
 {
 public:
     InstructionXorA( void )
-        : Instruction::Instruction( 2 )
+        : Instruction::Instruction( 0xEE )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->A = _xor( r, r->A, m->rom[r->PC + 1] );
+        r->A = _xor( r, r->A, m->fetch8( r->PC + 1 ) );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "XOR A, %#02x", mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -4853,19 +4029,15 @@ class InstructionRST28 : public Instruction
 {
 public:
     InstructionRST28( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xEF )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         push( m, r, r->PC + length );
         r->PC = 0x0028;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RST 0x28" );
+        return cycles;
     }
 };
 
@@ -4873,19 +4045,15 @@ class InstructionLdAFF : public Instruction
 {
 public:
     InstructionLdAFF( void )
-        : Instruction::Instruction( 2 )
+        : Instruction::Instruction( 0xF0 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->A = m->rom[0xFF00 | m->rom[r->PC + 1]];
+        r->A = m->read8( 0xFF00 | m->fetch8( r->PC + 1 ) );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD A, (%#04x)", 0xFF00 | mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -4893,19 +4061,16 @@ class InstructionPopAF : public Instruction
 {
 public:
     InstructionPopAF( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xF1 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->AF = pop( m, r );
+        r->sync_flags();
+        r->AF = pop( m, r ) & 0xFFF0;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "POP AF" );
+        return cycles;
     }
 };
 
@@ -4913,19 +4078,15 @@ class InstructionLdAFFC : public Instruction
 {
 public:
     InstructionLdAFFC( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xF2 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->A = m->rom[0xFF00 | r->C];
+        r->A = m->read8( 0xFF00 | r->C );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD A, (0xFF00 + C)" );
+        return cycles;
     }
 };
 
@@ -4933,19 +4094,15 @@ class InstructionDI : public Instruction
 {
 public:
     InstructionDI( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xF3 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         m->ie = false;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "DI" );
+        return cycles;
     }
 };
 
@@ -4953,19 +4110,16 @@ class InstructionPushAF : public Instruction
 {
 public:
     InstructionPushAF( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xF5 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
+        r->sync_flags();
         push( m, r, r->AF );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "PUSH AF" );
+        return cycles;
     }
 };
 
@@ -4973,19 +4127,15 @@ class InstructionOrA : public Instruction
 {
 public:
     InstructionOrA( void )
-        : Instruction::Instruction( 2 )
+        : Instruction::Instruction( 0xF6 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->A = _or( r, r->A, m->rom[r->PC + 1] );
+        r->A = _or( r, r->A, m->fetch8( r->PC + 1 ) );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "OR A, %#02x", mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -4993,19 +4143,15 @@ class InstructionRST30 : public Instruction
 {
 public:
     InstructionRST30( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xF7 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         push( m, r, r->PC + length );
         r->PC = 0x0030;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RST 0x30" );
+        return cycles;
     }
 };
 
@@ -5013,20 +4159,17 @@ class InstructionLdHLSPi8 : public Instruction
 {
 public:
     InstructionLdHLSPi8( void )
-        : Instruction::Instruction( 2 )
+        : Instruction::Instruction( 0xF8 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->HL = add< uint16_t >( r, r->HL, (int8_t)m->rom[r->PC + 1] );
+        r->HL = add< uint16_t >( r, r->HL, (int8_t)m->fetch8( r->PC + 1 ) );
+        r->sync_flags();
         r->Flag.Z = 0;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD HL, SP + %#04x", ( uint16_t )(int8_t)mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -5034,19 +4177,15 @@ class InstructionLdSPHL : public Instruction
 {
 public:
     InstructionLdSPHL( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xF9 )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         r->SP = r->HL;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD SP, HL" );
+        return cycles;
     }
 };
 
@@ -5054,19 +4193,15 @@ class InstructionLdAu16 : public Instruction
 {
 public:
     InstructionLdAu16( void )
-        : Instruction::Instruction( 3 )
+        : Instruction::Instruction( 0xFA )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        r->A = m->rom[*(uint16_t*)&m->rom[r->PC + 1]];
+        r->A = m->read8( m->fetch16( r->PC + 1 ) );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "LD A, (%#04x)", *(uint16_t*)&mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -5074,19 +4209,15 @@ class InstructionEI : public Instruction
 {
 public:
     InstructionEI( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xFB )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         m->ie = true;
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "EI" );
+        return cycles;
     }
 };
 
@@ -5094,19 +4225,15 @@ class InstructionCpA : public Instruction
 {
 public:
     InstructionCpA( void )
-        : Instruction::Instruction( 2 )
+        : Instruction::Instruction( 0xFE )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
-        sub( r, r->A, m->rom[r->PC + 1] );
+        sub( r, r->A, m->fetch8( r->PC + 1 ) );
         r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "CP A, %#02x", mem->rom[addr + 1] );
+        return cycles;
     }
 };
 
@@ -5114,19 +4241,15 @@ class InstructionRST38 : public Instruction
 {
 public:
     InstructionRST38( void )
-        : Instruction::Instruction( 1 )
+        : Instruction::Instruction( 0xFF )
     {
     }
 
-    virtual void execute( Memory* m, Registers* r )
+    virtual int execute( Memory* m, Registers* r )
     {
         push( m, r, r->PC + length );
         r->PC = 0x0038;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RST 0x38" );
+        return cycles;
     }
 };
 
@@ -5138,24 +4261,22 @@ public:
 
 class InstructionEx : public Instruction
 {
-private:
-    Instruction* opcode[0x100];
-
 public:
-    InstructionEx( void );
-
-    virtual void execute( Memory* m, Registers* r )
+    InstructionEx( void )
+        : Instruction::Instruction( 0xCB )
     {
-        opcode[m->rom[r->PC + 1]]->execute( m, r );
     }
 
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        opcode[mem->rom[addr + 1]]->dis( dst, size, mem, addr );
-    }
+    // Cycles of CB instructions, prefix included, are reported by the second level table
+    virtual int execute( Memory* m, Registers* r );
 
     static uint8_t rlc( Registers* r, uint8_t operand )
     {
+#ifdef GB_LAZY_FLAGS
+        uint8_t result = ( operand << 1 ) | ( operand >> 7 );
+        r->record( LAZY_SHIFT, 0, 0, operand >> 7, result );
+        return result;
+#else
         r->Flag.N = r->Flag.H = 0;
         r->Flag.C = operand >> 7;
 
@@ -5164,10 +4285,16 @@ public:
         r->Flag.Z = result == 0;
 
         return result;
+#endif
     }
 
     static uint8_t rrc( Registers* r, uint8_t operand )
     {
+#ifdef GB_LAZY_FLAGS
+        uint8_t result = ( operand << 7 ) | ( operand >> 1 );
+        r->record( LAZY_SHIFT, 0, 0, operand & 1, result );
+        return result;
+#else
         r->Flag.N = r->Flag.H = 0;
         r->Flag.C = operand & 1;
 
@@ -5175,15 +4302,20 @@ public:
         r->Flag.Z = result == 0;
 
         return result;
+#endif
     }
 
     static uint8_t rl( Registers* r, uint8_t operand )
     {
         uint8_t result = operand << 1;
 
+#ifdef GB_LAZY_FLAGS
+        r->record( LAZY_SHIFT, 0, 0, operand >> 7, result );
+#else
         r->Flag.Z = result == 0;
         r->Flag.N = r->Flag.H = 0;
         r->Flag.C = operand >> 7;
+#endif
 
         return result;
     }
@@ -5192,9 +4324,13 @@ public:
     {
         uint8_t result = operand >> 1;
 
+#ifdef GB_LAZY_FLAGS
+        r->record( LAZY_SHIFT, 0, 0, operand & 1, result );
+#else
         r->Flag.Z = result == 0;
         r->Flag.N = r->Flag.H = 0;
         r->Flag.C = operand & 1;
+#endif
 
         return result;
     }
@@ -5203,9 +4339,13 @@ public:
     {
         uint8_t result = operand << 1;
 
+#ifdef GB_LAZY_FLAGS
+        r->record( LAZY_SHIFT, 0, 0, operand >> 7, result );
+#else
         r->Flag.Z = result == 0;
         r->Flag.N = r->Flag.H = 0;
         r->Flag.C = operand >> 7;
+#endif
 
         return result;
     }
@@ -5214,17 +4354,25 @@ public:
     {
         uint8_t result = operand >> 1;
 
+#ifdef GB_LAZY_FLAGS
+        r->record( LAZY_SHIFT, 0, 0, operand & 1, result | ( operand & 0x80 ) );
+#else
         r->Flag.Z = result == 0;
         r->Flag.N = r->Flag.H = 0;
         r->Flag.C = operand & 1;
+#endif
 
         return ( result | ( operand & 0x80 ) );
     }
 
     static uint8_t swap( Registers* r, uint8_t operand )
     {
+#ifdef GB_LAZY_FLAGS
+        r->record( LAZY_SHIFT, 0, 0, 0, operand );
+#else
         r->Flag.Z = operand == 0;
         r->Flag.C = r->Flag.N = r->Flag.H = 0;
+#endif
 
         return ( ( operand << 4 ) | ( operand >> 4 ) );
     }
@@ -5233,19 +4381,28 @@ public:
     {
         uint8_t result = operand >> 1;
 
+#ifdef GB_LAZY_FLAGS
+        r->record( LAZY_SHIFT, 0, 0, operand & 1, result );
+#else
         r->Flag.Z = result == 0;
         r->Flag.N = r->Flag.H = 0;
         r->Flag.C = operand & 1;
+#endif
 
         return result;
     }
 
     static bool bit( Registers* r, uint8_t reg, uint8_t bit )
     {
+#ifdef GB_LAZY_FLAGS
+        r->record( LAZY_BIT, 0, 0, r->c(), reg & ( 1 << bit ) );
+        return ( reg & ( 1 << bit ) ) != 0;
+#else
         r->Flag.N = 0;
         r->Flag.H = 1;
         r->Flag.Z = reg & ( 1 << bit ) ? 0 : 1;
         return r->Flag.Z == 0;
+#endif
     }
 
     static void res( uint8_t& r, uint8_t bit )
@@ -5259,5401 +4416,367 @@ public:
     }
 };
 
-class InstructionExRLCB : public Instruction
+// Handler of CB opcode OP, decoded at compile time: bits 6-7 select rotate/shift,
+// BIT, RES or SET, bits 3-5 the operation or bit and bits 0-2 the register
+template <uint8_t OP>
+class InstructionCB
 {
-public:
-    InstructionExRLCB( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->B = InstructionEx::rlc( r, r->B );
-        r->PC += length;
+private:
+    static const uint8_t group = OP >> 6;
+    static const uint8_t y = ( OP >> 3 ) & 7;
+    static const uint8_t z = OP & 7;
+
+    static uint8_t& reg( Registers* r )
+    {
+        switch ( z ) {
+        case 0: return r->B;
+        case 1: return r->C;
+        case 2: return r->D;
+        case 3: return r->E;
+        case 4: return r->H;
+        case 5: return r->L;
+        default: return r->A;
+        }
     }
 
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
+    static uint8_t shift( Registers* r, uint8_t value )
     {
-        snprintf( dst, size, "RLC B" );
+        switch ( y ) {
+        case 0: return InstructionEx::rlc( r, value );
+        case 1: return InstructionEx::rrc( r, value );
+        case 2: return InstructionEx::rl( r, value );
+        case 3: return InstructionEx::rr( r, value );
+        case 4: return InstructionEx::sla( r, value );
+        case 5: return InstructionEx::sra( r, value );
+        case 6: return InstructionEx::swap( r, value );
+        default: return InstructionEx::srl( r, value );
+        }
     }
-};
 
-class InstructionExRLCC : public Instruction
-{
 public:
-    InstructionExRLCC( void )
-        : Instruction::Instruction( 2 )
+    static int execute( Memory* m, Registers* r )
     {
-    }
+        // (HL) is read and written back through the bus, BIT only reads it
+        uint8_t value = z == 6 ? m->read8( r->HL ) : reg( r );
 
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->C = InstructionEx::rlc( r, r->C );
-        r->PC += length;
-    }
+        switch ( group ) {
+        case 0:
+            value = shift( r, value );
+            break;
+        case 1:
+            InstructionEx::bit( r, value, y );
+            break;
+        case 2:
+            InstructionEx::res( value, y );
+            break;
+        default:
+            InstructionEx::set( value, y );
+            break;
+        }
 
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RLC C" );
+        if ( group != 1 ) {
+            if ( z == 6 ) {
+                m->write8( r->HL, value );
+            }
+            else {
+                reg( r ) = value;
+            }
+        }
+
+        r->PC += optable[0x100 | OP].length;
+        return optable[0x100 | OP].cycles;
     }
 };
 
-class InstructionExRLCD : public Instruction
+// InstructionCB<0x00>..<0xFF> as a flat table, no allocations and no second virtual call
+struct InstructionCBTable {
+    int ( *execute[0x100] )( Memory* m, Registers* r );
+};
+
+template <size_t... N>
+constexpr InstructionCBTable instruction_cb_table( std::index_sequence<N...> )
 {
-public:
-    InstructionExRLCD( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
+    return InstructionCBTable{ { &InstructionCB<N>::execute... } };
+}
 
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->D = InstructionEx::rlc( r, r->D );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RLC D" );
-    }
-};
-
-class InstructionExRLCE : public Instruction
-{
-public:
-    InstructionExRLCE( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->E = InstructionEx::rlc( r, r->E );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RLC E" );
-    }
-};
-
-class InstructionExRLCH : public Instruction
-{
-public:
-    InstructionExRLCH( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->H = InstructionEx::rlc( r, r->H );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RLC H" );
-    }
-};
-
-class InstructionExRLCL : public Instruction
-{
-public:
-    InstructionExRLCL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->L = InstructionEx::rlc( r, r->L );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RLC H" );
-    }
-};
-
-class InstructionExRLCHL : public Instruction
-{
-public:
-    InstructionExRLCHL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        m->rom[r->HL] = InstructionEx::rlc( r, m->rom[r->HL] );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RLC (HL)" );
-    }
-};
-
-class InstructionExRLCA : public Instruction
-{
-public:
-    InstructionExRLCA( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->A = InstructionEx::rlc( r, r->A );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RLC A" );
-    }
-};
-
-class InstructionExRRCB : public Instruction
-{
-public:
-    InstructionExRRCB( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->B = InstructionEx::rrc( r, r->B );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RRC B" );
-    }
-};
-
-class InstructionExRRCC : public Instruction
-{
-public:
-    InstructionExRRCC( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->C = InstructionEx::rrc( r, r->C );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RRC C" );
-    }
-};
-
-class InstructionExRRCD : public Instruction
-{
-public:
-    InstructionExRRCD( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->D = InstructionEx::rrc( r, r->D );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RRC D" );
-    }
-};
-
-class InstructionExRRCE : public Instruction
-{
-public:
-    InstructionExRRCE( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->E = InstructionEx::rrc( r, r->E );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RRC E" );
-    }
-};
-
-class InstructionExRRCH : public Instruction
-{
-public:
-    InstructionExRRCH( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->H = InstructionEx::rrc( r, r->H );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RRC H" );
-    }
-};
-
-class InstructionExRRCL : public Instruction
-{
-public:
-    InstructionExRRCL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->L = InstructionEx::rrc( r, r->L );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RRC L" );
-    }
-};
-
-class InstructionExRRCHL : public Instruction
-{
-public:
-    InstructionExRRCHL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        m->rom[r->HL] = InstructionEx::rrc( r, m->rom[r->HL] );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RRC (HL)" );
-    }
-};
-
-class InstructionExRRCA : public Instruction
-{
-public:
-    InstructionExRRCA( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->A = InstructionEx::rrc( r, r->A );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RRC A" );
-    }
-};
-
-class InstructionExRLB : public Instruction
-{
-public:
-    InstructionExRLB( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->B = InstructionEx::rl( r, r->B );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RL B" );
-    }
-};
-
-class InstructionExRLC : public Instruction
-{
-public:
-    InstructionExRLC( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->C = InstructionEx::rl( r, r->C );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RL C" );
-    }
-};
-
-class InstructionExRLD : public Instruction
-{
-public:
-    InstructionExRLD( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->D = InstructionEx::rl( r, r->D );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RL D" );
-    }
-};
-
-class InstructionExRLE : public Instruction
-{
-public:
-    InstructionExRLE( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->E = InstructionEx::rl( r, r->E );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RL E" );
-    }
-};
-
-class InstructionExRLH : public Instruction
-{
-public:
-    InstructionExRLH( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->H = InstructionEx::rl( r, r->H );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RL H" );
-    }
-};
-
-class InstructionExRLL : public Instruction
-{
-public:
-    InstructionExRLL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->L = InstructionEx::rl( r, r->L );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RL L" );
-    }
-};
-
-class InstructionExRLHL : public Instruction
-{
-public:
-    InstructionExRLHL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        m->rom[r->HL] = InstructionEx::rl( r, m->rom[r->HL] );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RL (HL)" );
-    }
-};
-
-class InstructionExRLA : public Instruction
-{
-public:
-    InstructionExRLA( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->A = InstructionEx::rl( r, r->A );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RL A" );
-    }
-};
-
-class InstructionExRRB : public Instruction
-{
-public:
-    InstructionExRRB( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->B = InstructionEx::rr( r, r->B );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RR B" );
-    }
-};
-
-class InstructionExRRC : public Instruction
-{
-public:
-    InstructionExRRC( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->C = InstructionEx::rr( r, r->C );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RR C" );
-    }
-};
-
-class InstructionExRRD : public Instruction
-{
-public:
-    InstructionExRRD( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->D = InstructionEx::rr( r, r->D );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RR D" );
-    }
-};
-
-class InstructionExRRE : public Instruction
-{
-public:
-    InstructionExRRE( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->E = InstructionEx::rr( r, r->E );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RR E" );
-    }
-};
-
-class InstructionExRRH : public Instruction
-{
-public:
-    InstructionExRRH( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->H = InstructionEx::rr( r, r->H );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RR H" );
-    }
-};
-
-class InstructionExRRL : public Instruction
-{
-public:
-    InstructionExRRL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->L = InstructionEx::rr( r, r->L );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RR L" );
-    }
-};
-
-class InstructionExRRHL : public Instruction
-{
-public:
-    InstructionExRRHL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        m->rom[r->HL] = InstructionEx::rr( r, m->rom[r->HL] );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RR (HL)" );
-    }
-};
-
-class InstructionExRRA : public Instruction
-{
-public:
-    InstructionExRRA( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->A = InstructionEx::rr( r, r->A );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RR A" );
-    }
-};
-
-class InstructionExSLAB : public Instruction
-{
-public:
-    InstructionExSLAB( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->B = InstructionEx::sla( r, r->B );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SLA B" );
-    }
-};
-
-class InstructionExSLAC : public Instruction
-{
-public:
-    InstructionExSLAC( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->C = InstructionEx::sla( r, r->C );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SLA C" );
-    }
-};
-
-class InstructionExSLAD : public Instruction
-{
-public:
-    InstructionExSLAD( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->D = InstructionEx::sla( r, r->D );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SLA D" );
-    }
-};
-
-class InstructionExSLAE : public Instruction
-{
-public:
-    InstructionExSLAE( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->E = InstructionEx::sla( r, r->E );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SLA E" );
-    }
-};
-
-class InstructionExSLAH : public Instruction
-{
-public:
-    InstructionExSLAH( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->H = InstructionEx::sla( r, r->H );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SLA H" );
-    }
-};
-
-class InstructionExSLAL : public Instruction
-{
-public:
-    InstructionExSLAL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->L = InstructionEx::sla( r, r->L );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SLA L" );
-    }
-};
-
-class InstructionExSLAHL : public Instruction
-{
-public:
-    InstructionExSLAHL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        m->rom[r->HL] = InstructionEx::sla( r, m->rom[r->HL] );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SLA (HL)" );
-    }
-};
-
-class InstructionExSLAA : public Instruction
-{
-public:
-    InstructionExSLAA( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->A = InstructionEx::sla( r, r->A );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SLA A" );
-    }
-};
-
-class InstructionExSRAB : public Instruction
-{
-public:
-    InstructionExSRAB( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->B = InstructionEx::sra( r, r->B );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SRA B" );
-    }
-};
-
-class InstructionExSRAC : public Instruction
-{
-public:
-    InstructionExSRAC( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->C = InstructionEx::sra( r, r->C );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SRA C" );
-    }
-};
-
-class InstructionExSRAD : public Instruction
-{
-public:
-    InstructionExSRAD( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->D = InstructionEx::sra( r, r->D );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SRA D" );
-    }
-};
-
-class InstructionExSRAE : public Instruction
-{
-public:
-    InstructionExSRAE( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->E = InstructionEx::sra( r, r->E );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SRA E" );
-    }
-};
-
-class InstructionExSRAH : public Instruction
-{
-public:
-    InstructionExSRAH( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->H = InstructionEx::sra( r, r->H );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SRA H" );
-    }
-};
-
-class InstructionExSRAL : public Instruction
-{
-public:
-    InstructionExSRAL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->L = InstructionEx::sra( r, r->L );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SRA L" );
-    }
-};
-
-class InstructionExSRAHL : public Instruction
-{
-public:
-    InstructionExSRAHL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        m->rom[r->HL] = InstructionEx::sra( r, m->rom[r->HL] );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SRA (HL)" );
-    }
-};
-
-class InstructionExSRAA : public Instruction
-{
-public:
-    InstructionExSRAA( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->A = InstructionEx::sra( r, r->A );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SRA A" );
-    }
-};
-
-class InstructionExSWAPB : public Instruction
-{
-public:
-    InstructionExSWAPB( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->B = InstructionEx::swap( r, r->B );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SWAP B" );
-    }
-};
-
-class InstructionExSWAPC : public Instruction
-{
-public:
-    InstructionExSWAPC( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->C = InstructionEx::swap( r, r->C );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SWAP C" );
-    }
-};
-
-class InstructionExSWAPD : public Instruction
-{
-public:
-    InstructionExSWAPD( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->D = InstructionEx::swap( r, r->D );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SWAP D" );
-    }
-};
-
-class InstructionExSWAPE : public Instruction
-{
-public:
-    InstructionExSWAPE( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->E = InstructionEx::swap( r, r->E );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SWAP E" );
-    }
-};
-
-class InstructionExSWAPH : public Instruction
-{
-public:
-    InstructionExSWAPH( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->H = InstructionEx::swap( r, r->H );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SWAP H" );
-    }
-};
-
-class InstructionExSWAPL : public Instruction
-{
-public:
-    InstructionExSWAPL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->L = InstructionEx::swap( r, r->L );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SWAP L" );
-    }
-};
-
-class InstructionExSWAPHL : public Instruction
-{
-public:
-    InstructionExSWAPHL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        m->rom[r->HL] = InstructionEx::swap( r, m->rom[r->HL] );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SWAP (HL)" );
-    }
-};
-
-class InstructionExSWAPA : public Instruction
-{
-public:
-    InstructionExSWAPA( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->A = InstructionEx::swap( r, r->A );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SWAP A" );
-    }
-};
-
-class InstructionExSRLB : public Instruction
-{
-public:
-    InstructionExSRLB( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->B = InstructionEx::srl( r, r->B );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SRL B" );
-    }
-};
-
-class InstructionExSRLC : public Instruction
-{
-public:
-    InstructionExSRLC( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->C = InstructionEx::srl( r, r->C );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SRL C" );
-    }
-};
-
-class InstructionExSRLD : public Instruction
-{
-public:
-    InstructionExSRLD( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->D = InstructionEx::srl( r, r->D );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SRL D" );
-    }
-};
-
-class InstructionExSRLE : public Instruction
-{
-public:
-    InstructionExSRLE( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->E = InstructionEx::srl( r, r->E );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SRL E" );
-    }
-};
-
-class InstructionExSRLH : public Instruction
-{
-public:
-    InstructionExSRLH( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->H = InstructionEx::srl( r, r->H );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SRL H" );
-    }
-};
-
-class InstructionExSRLL : public Instruction
-{
-public:
-    InstructionExSRLL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->L = InstructionEx::srl( r, r->L );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SRL L" );
-    }
-};
-
-class InstructionExSRLHL : public Instruction
-{
-public:
-    InstructionExSRLHL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        m->rom[r->HL] = InstructionEx::srl( r, m->rom[r->HL] );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SRL (HL)" );
-    }
-};
-
-class InstructionExSRLA : public Instruction
-{
-public:
-    InstructionExSRLA( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        r->A = InstructionEx::srl( r, r->A );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SRL A" );
-    }
-};
-
-class InstructionExBit0B : public Instruction
-{
-public:
-    InstructionExBit0B( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->B, 0 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 0, B" );
-    }
-};
-
-class InstructionExBit0C : public Instruction
-{
-public:
-    InstructionExBit0C( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->C, 0 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 0, C" );
-    }
-};
-
-class InstructionExBit0D : public Instruction
-{
-public:
-    InstructionExBit0D( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->D, 0 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 0, D" );
-    }
-};
-
-class InstructionExBit0E : public Instruction
-{
-public:
-    InstructionExBit0E( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->E, 0 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 0, E" );
-    }
-};
-
-class InstructionExBit0H : public Instruction
-{
-public:
-    InstructionExBit0H( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->H, 0 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 0, H" );
-    }
-};
-
-class InstructionExBit0L : public Instruction
-{
-public:
-    InstructionExBit0L( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->L, 0 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 0, L" );
-    }
-};
-
-class InstructionExBit0HL : public Instruction
-{
-public:
-    InstructionExBit0HL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, m->rom[r->HL], 0 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 0, (HL)" );
-    }
-};
-
-class InstructionExBit0A : public Instruction
-{
-public:
-    InstructionExBit0A( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->A, 0 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 0, A" );
-    }
-};
-
-class InstructionExBit1B : public Instruction
-{
-public:
-    InstructionExBit1B( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->B, 1 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 1, B" );
-    }
-};
-
-class InstructionExBit1C : public Instruction
-{
-public:
-    InstructionExBit1C( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->C, 1 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 1, C" );
-    }
-};
-
-class InstructionExBit1D : public Instruction
-{
-public:
-    InstructionExBit1D( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->D, 1 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 1, D" );
-    }
-};
-
-class InstructionExBit1E : public Instruction
-{
-public:
-    InstructionExBit1E( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->E, 1 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 1, E" );
-    }
-};
-
-class InstructionExBit1H : public Instruction
-{
-public:
-    InstructionExBit1H( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->H, 1 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 1, H" );
-    }
-};
-
-class InstructionExBit1L : public Instruction
-{
-public:
-    InstructionExBit1L( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->L, 1 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 1, L" );
-    }
-};
-
-class InstructionExBit1HL : public Instruction
-{
-public:
-    InstructionExBit1HL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, m->rom[r->HL], 1 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 1, (HL)" );
-    }
-};
-
-class InstructionExBit1A : public Instruction
-{
-public:
-    InstructionExBit1A( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->A, 1 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 1, A" );
-    }
-};
-
-class InstructionExBit2B : public Instruction
-{
-public:
-    InstructionExBit2B( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->B, 2 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 2, B" );
-    }
-};
-
-class InstructionExBit2C : public Instruction
-{
-public:
-    InstructionExBit2C( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->C, 2 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 2, C" );
-    }
-};
-
-class InstructionExBit2D : public Instruction
-{
-public:
-    InstructionExBit2D( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->D, 2 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 2, D" );
-    }
-};
-
-class InstructionExBit2E : public Instruction
-{
-public:
-    InstructionExBit2E( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->E, 2 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 2, E" );
-    }
-};
-
-class InstructionExBit2H : public Instruction
-{
-public:
-    InstructionExBit2H( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->H, 2 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 2, H" );
-    }
-};
-
-class InstructionExBit2L : public Instruction
-{
-public:
-    InstructionExBit2L( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->L, 2 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 2, L" );
-    }
-};
-
-class InstructionExBit2HL : public Instruction
-{
-public:
-    InstructionExBit2HL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, m->rom[r->HL], 2 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 2, (HL)" );
-    }
-};
-
-class InstructionExBit2A : public Instruction
-{
-public:
-    InstructionExBit2A( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->A, 2 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 2, A" );
-    }
-};
-
-class InstructionExBit3B : public Instruction
-{
-public:
-    InstructionExBit3B( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->B, 3 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 3, B" );
-    }
-};
-
-class InstructionExBit3C : public Instruction
-{
-public:
-    InstructionExBit3C( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->C, 3 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 3, C" );
-    }
-};
-
-class InstructionExBit3D : public Instruction
-{
-public:
-    InstructionExBit3D( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->D, 3 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 3, D" );
-    }
-};
-
-class InstructionExBit3E : public Instruction
-{
-public:
-    InstructionExBit3E( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->E, 3 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 3, E" );
-    }
-};
-
-class InstructionExBit3H : public Instruction
-{
-public:
-    InstructionExBit3H( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->H, 3 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 3, H" );
-    }
-};
-
-class InstructionExBit3L : public Instruction
-{
-public:
-    InstructionExBit3L( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->L, 3 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 3, L" );
-    }
-};
-
-class InstructionExBit3HL : public Instruction
-{
-public:
-    InstructionExBit3HL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, m->rom[r->HL], 3 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 3, (HL)" );
-    }
-};
-
-class InstructionExBit3A : public Instruction
-{
-public:
-    InstructionExBit3A( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->A, 3 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 3, A" );
-    }
-};
-
-class InstructionExBit4B : public Instruction
-{
-public:
-    InstructionExBit4B( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->B, 4 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 4, B" );
-    }
-};
-
-class InstructionExBit4C : public Instruction
-{
-public:
-    InstructionExBit4C( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->C, 4 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 4, C" );
-    }
-};
-
-class InstructionExBit4D : public Instruction
-{
-public:
-    InstructionExBit4D( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->D, 4 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 4, D" );
-    }
-};
-
-class InstructionExBit4E : public Instruction
-{
-public:
-    InstructionExBit4E( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->E, 4 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 4, E" );
-    }
-};
-
-class InstructionExBit4H : public Instruction
-{
-public:
-    InstructionExBit4H( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->H, 4 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 4, H" );
-    }
-};
-
-class InstructionExBit4L : public Instruction
-{
-public:
-    InstructionExBit4L( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->L, 4 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 4, L" );
-    }
-};
-
-class InstructionExBit4HL : public Instruction
-{
-public:
-    InstructionExBit4HL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, m->rom[r->HL], 4 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 4, (HL)" );
-    }
-};
-
-class InstructionExBit4A : public Instruction
-{
-public:
-    InstructionExBit4A( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->A, 4 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 4, A" );
-    }
-};
-
-class InstructionExBit5B : public Instruction
-{
-public:
-    InstructionExBit5B( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->B, 5 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 5, B" );
-    }
-};
-
-class InstructionExBit5C : public Instruction
-{
-public:
-    InstructionExBit5C( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->C, 5 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 5, C" );
-    }
-};
-
-class InstructionExBit5D : public Instruction
-{
-public:
-    InstructionExBit5D( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->D, 5 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 5, D" );
-    }
-};
-
-class InstructionExBit5E : public Instruction
-{
-public:
-    InstructionExBit5E( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->E, 5 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 5, E" );
-    }
-};
-
-class InstructionExBit5H : public Instruction
-{
-public:
-    InstructionExBit5H( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->H, 5 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 5, H" );
-    }
-};
-
-class InstructionExBit5L : public Instruction
-{
-public:
-    InstructionExBit5L( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->L, 5 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 5, L" );
-    }
-};
-
-class InstructionExBit5HL : public Instruction
-{
-public:
-    InstructionExBit5HL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, m->rom[r->HL], 5 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 5, (HL)" );
-    }
-};
-
-class InstructionExBit5A : public Instruction
-{
-public:
-    InstructionExBit5A( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->A, 5 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 5, A" );
-    }
-};
-
-class InstructionExBit6B : public Instruction
-{
-public:
-    InstructionExBit6B( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->B, 6 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 6, B" );
-    }
-};
-
-class InstructionExBit6C : public Instruction
-{
-public:
-    InstructionExBit6C( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->C, 6 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 6, C" );
-    }
-};
-
-class InstructionExBit6D : public Instruction
-{
-public:
-    InstructionExBit6D( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->D, 6 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 6, D" );
-    }
-};
-
-class InstructionExBit6E : public Instruction
-{
-public:
-    InstructionExBit6E( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->E, 6 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 6, E" );
-    }
-};
-
-class InstructionExBit6H : public Instruction
-{
-public:
-    InstructionExBit6H( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->H, 6 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 6, H" );
-    }
-};
-
-class InstructionExBit6L : public Instruction
-{
-public:
-    InstructionExBit6L( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->L, 6 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 6, L" );
-    }
-};
-
-class InstructionExBit6HL : public Instruction
-{
-public:
-    InstructionExBit6HL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, m->rom[r->HL], 6 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 6, (HL)" );
-    }
-};
-
-class InstructionExBit6A : public Instruction
-{
-public:
-    InstructionExBit6A( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->A, 6 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 6, A" );
-    }
-};
-
-class InstructionExBit7B : public Instruction
-{
-public:
-    InstructionExBit7B( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->B, 7 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 7, B" );
-    }
-};
-
-class InstructionExBit7C : public Instruction
-{
-public:
-    InstructionExBit7C( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->C, 7 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 7, C" );
-    }
-};
-
-class InstructionExBit7D : public Instruction
-{
-public:
-    InstructionExBit7D( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->D, 7 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 7, D" );
-    }
-};
-
-class InstructionExBit7E : public Instruction
-{
-public:
-    InstructionExBit7E( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->E, 7 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 7, E" );
-    }
-};
-
-class InstructionExBit7H : public Instruction
-{
-public:
-    InstructionExBit7H( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->H, 7 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 7, H" );
-    }
-};
-
-class InstructionExBit7L : public Instruction
-{
-public:
-    InstructionExBit7L( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->L, 7 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 7, L" );
-    }
-};
-
-class InstructionExBit7HL : public Instruction
-{
-public:
-    InstructionExBit7HL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, m->rom[r->HL], 7 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 7, (HL)" );
-    }
-};
-
-class InstructionExBit7A : public Instruction
-{
-public:
-    InstructionExBit7A( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::bit( r, r->A, 7 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "BIT 7, A" );
-    }
-};
-
-class InstructionExRes0B : public Instruction
-{
-public:
-    InstructionExRes0B( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->B, 0 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 0, B" );
-    }
-};
-
-class InstructionExRes0C : public Instruction
-{
-public:
-    InstructionExRes0C( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->C, 0 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 0, C" );
-    }
-};
-
-class InstructionExRes0D : public Instruction
-{
-public:
-    InstructionExRes0D( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->D, 0 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 0, D" );
-    }
-};
-
-class InstructionExRes0E : public Instruction
-{
-public:
-    InstructionExRes0E( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->E, 0 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 0, E" );
-    }
-};
-
-class InstructionExRes0H : public Instruction
-{
-public:
-    InstructionExRes0H( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->H, 0 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 0, H" );
-    }
-};
-
-class InstructionExRes0L : public Instruction
-{
-public:
-    InstructionExRes0L( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->L, 0 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 0, L" );
-    }
-};
-
-class InstructionExRes0HL : public Instruction
-{
-public:
-    InstructionExRes0HL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( m->rom[r->HL], 0 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 0, (HL)" );
-    }
-};
-
-class InstructionExRes0A : public Instruction
-{
-public:
-    InstructionExRes0A( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->A, 0 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 0, A" );
-    }
-};
-
-class InstructionExRes1B : public Instruction
-{
-public:
-    InstructionExRes1B( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->B, 1 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 1, B" );
-    }
-};
-
-class InstructionExRes1C : public Instruction
-{
-public:
-    InstructionExRes1C( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->C, 1 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 1, C" );
-    }
-};
-
-class InstructionExRes1D : public Instruction
-{
-public:
-    InstructionExRes1D( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->D, 1 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 1, D" );
-    }
-};
-
-class InstructionExRes1E : public Instruction
-{
-public:
-    InstructionExRes1E( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->E, 1 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 1, E" );
-    }
-};
-
-class InstructionExRes1H : public Instruction
-{
-public:
-    InstructionExRes1H( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->H, 1 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 1, H" );
-    }
-};
-
-class InstructionExRes1L : public Instruction
-{
-public:
-    InstructionExRes1L( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->L, 1 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 1, L" );
-    }
-};
-
-class InstructionExRes1HL : public Instruction
-{
-public:
-    InstructionExRes1HL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( m->rom[r->HL], 1 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 1, (HL)" );
-    }
-};
-
-class InstructionExRes1A : public Instruction
-{
-public:
-    InstructionExRes1A( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->A, 1 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 1, A" );
-    }
-};
-
-class InstructionExRes2B : public Instruction
-{
-public:
-    InstructionExRes2B( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->B, 2 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 2, B" );
-    }
-};
-
-class InstructionExRes2C : public Instruction
-{
-public:
-    InstructionExRes2C( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->C, 2 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 2, C" );
-    }
-};
-
-class InstructionExRes2D : public Instruction
-{
-public:
-    InstructionExRes2D( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->D, 2 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 2, D" );
-    }
-};
-
-class InstructionExRes2E : public Instruction
-{
-public:
-    InstructionExRes2E( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->E, 2 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 2, E" );
-    }
-};
-
-class InstructionExRes2H : public Instruction
-{
-public:
-    InstructionExRes2H( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->H, 2 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 2, H" );
-    }
-};
-
-class InstructionExRes2L : public Instruction
-{
-public:
-    InstructionExRes2L( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->L, 2 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 2, L" );
-    }
-};
-
-class InstructionExRes2HL : public Instruction
-{
-public:
-    InstructionExRes2HL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( m->rom[r->HL], 2 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 2, (HL)" );
-    }
-};
-
-class InstructionExRes2A : public Instruction
-{
-public:
-    InstructionExRes2A( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->A, 2 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 2, A" );
-    }
-};
-
-class InstructionExRes3B : public Instruction
-{
-public:
-    InstructionExRes3B( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->B, 3 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 3, B" );
-    }
-};
-
-class InstructionExRes3C : public Instruction
-{
-public:
-    InstructionExRes3C( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->C, 3 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 3, C" );
-    }
-};
-
-class InstructionExRes3D : public Instruction
-{
-public:
-    InstructionExRes3D( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->D, 3 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 3, D" );
-    }
-};
-
-class InstructionExRes3E : public Instruction
-{
-public:
-    InstructionExRes3E( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->E, 3 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 3, E" );
-    }
-};
-
-class InstructionExRes3H : public Instruction
-{
-public:
-    InstructionExRes3H( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->H, 3 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 3, H" );
-    }
-};
-
-class InstructionExRes3L : public Instruction
-{
-public:
-    InstructionExRes3L( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->L, 3 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 3, L" );
-    }
-};
-
-class InstructionExRes3HL : public Instruction
-{
-public:
-    InstructionExRes3HL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( m->rom[r->HL], 3 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 3, (HL)" );
-    }
-};
-
-class InstructionExRes3A : public Instruction
-{
-public:
-    InstructionExRes3A( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->A, 3 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 3, A" );
-    }
-};
-
-class InstructionExRes4B : public Instruction
-{
-public:
-    InstructionExRes4B( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->B, 4 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 4, B" );
-    }
-};
-
-class InstructionExRes4C : public Instruction
-{
-public:
-    InstructionExRes4C( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->C, 4 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 4, C" );
-    }
-};
-
-class InstructionExRes4D : public Instruction
-{
-public:
-    InstructionExRes4D( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->D, 4 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 4, D" );
-    }
-};
-
-class InstructionExRes4E : public Instruction
-{
-public:
-    InstructionExRes4E( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->E, 4 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 4, E" );
-    }
-};
-
-class InstructionExRes4H : public Instruction
-{
-public:
-    InstructionExRes4H( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->H, 4 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 4, H" );
-    }
-};
-
-class InstructionExRes4L : public Instruction
-{
-public:
-    InstructionExRes4L( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->L, 4 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 4, L" );
-    }
-};
-
-class InstructionExRes4HL : public Instruction
-{
-public:
-    InstructionExRes4HL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( m->rom[r->HL], 4 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 4, (HL)" );
-    }
-};
-
-class InstructionExRes4A : public Instruction
-{
-public:
-    InstructionExRes4A( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->A, 4 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 4, A" );
-    }
-};
-
-class InstructionExRes5B : public Instruction
-{
-public:
-    InstructionExRes5B( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->B, 5 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 5, B" );
-    }
-};
-
-class InstructionExRes5C : public Instruction
-{
-public:
-    InstructionExRes5C( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->C, 5 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 5, C" );
-    }
-};
-
-class InstructionExRes5D : public Instruction
-{
-public:
-    InstructionExRes5D( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->D, 5 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 5, D" );
-    }
-};
-
-class InstructionExRes5E : public Instruction
-{
-public:
-    InstructionExRes5E( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->E, 5 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 5, E" );
-    }
-};
-
-class InstructionExRes5H : public Instruction
-{
-public:
-    InstructionExRes5H( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->H, 5 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 5, H" );
-    }
-};
-
-class InstructionExRes5L : public Instruction
-{
-public:
-    InstructionExRes5L( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->L, 5 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 5, L" );
-    }
-};
-
-class InstructionExRes5HL : public Instruction
-{
-public:
-    InstructionExRes5HL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( m->rom[r->HL], 5 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 5, (HL)" );
-    }
-};
-
-class InstructionExRes5A : public Instruction
-{
-public:
-    InstructionExRes5A( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->A, 5 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 5, A" );
-    }
-};
-
-class InstructionExRes6B : public Instruction
-{
-public:
-    InstructionExRes6B( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->B, 6 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 6, B" );
-    }
-};
-
-class InstructionExRes6C : public Instruction
-{
-public:
-    InstructionExRes6C( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->C, 6 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 6, C" );
-    }
-};
-
-class InstructionExRes6D : public Instruction
-{
-public:
-    InstructionExRes6D( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->D, 6 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 6, D" );
-    }
-};
-
-class InstructionExRes6E : public Instruction
-{
-public:
-    InstructionExRes6E( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->E, 6 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 6, E" );
-    }
-};
-
-class InstructionExRes6H : public Instruction
-{
-public:
-    InstructionExRes6H( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->H, 6 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 6, H" );
-    }
-};
-
-class InstructionExRes6L : public Instruction
-{
-public:
-    InstructionExRes6L( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->L, 6 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 6, L" );
-    }
-};
-
-class InstructionExRes6HL : public Instruction
-{
-public:
-    InstructionExRes6HL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( m->rom[r->HL], 6 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 6, (HL)" );
-    }
-};
-
-class InstructionExRes6A : public Instruction
-{
-public:
-    InstructionExRes6A( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->A, 6 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 6, A" );
-    }
-};
-
-class InstructionExRes7B : public Instruction
-{
-public:
-    InstructionExRes7B( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->B, 7 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 7, B" );
-    }
-};
-
-class InstructionExRes7C : public Instruction
-{
-public:
-    InstructionExRes7C( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->C, 7 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 7, C" );
-    }
-};
-
-class InstructionExRes7D : public Instruction
-{
-public:
-    InstructionExRes7D( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->D, 7 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 7, D" );
-    }
-};
-
-class InstructionExRes7E : public Instruction
-{
-public:
-    InstructionExRes7E( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->E, 7 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 7, E" );
-    }
-};
-
-class InstructionExRes7H : public Instruction
-{
-public:
-    InstructionExRes7H( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->H, 7 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 7, H" );
-    }
-};
-
-class InstructionExRes7L : public Instruction
-{
-public:
-    InstructionExRes7L( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->L, 7 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 7, L" );
-    }
-};
-
-class InstructionExRes7HL : public Instruction
-{
-public:
-    InstructionExRes7HL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( m->rom[r->HL], 7 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 7, (HL)" );
-    }
-};
-
-class InstructionExRes7A : public Instruction
-{
-public:
-    InstructionExRes7A( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::res( r->A, 7 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "RES 7, A" );
-    }
-};
-
-class InstructionExSet0B : public Instruction
-{
-public:
-    InstructionExSet0B( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->B, 0 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 0, B" );
-    }
-};
-
-class InstructionExSet0C : public Instruction
-{
-public:
-    InstructionExSet0C( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->C, 0 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 0, C" );
-    }
-};
-
-class InstructionExSet0D : public Instruction
-{
-public:
-    InstructionExSet0D( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->D, 0 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 0, D" );
-    }
-};
-
-class InstructionExSet0E : public Instruction
-{
-public:
-    InstructionExSet0E( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->E, 0 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 0, E" );
-    }
-};
-
-class InstructionExSet0H : public Instruction
-{
-public:
-    InstructionExSet0H( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->H, 0 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 0, H" );
-    }
-};
-
-class InstructionExSet0L : public Instruction
-{
-public:
-    InstructionExSet0L( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->L, 0 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 0, L" );
-    }
-};
-
-class InstructionExSet0HL : public Instruction
-{
-public:
-    InstructionExSet0HL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( m->rom[r->HL], 0 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 0, (HL)" );
-    }
-};
-
-class InstructionExSet0A : public Instruction
-{
-public:
-    InstructionExSet0A( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->A, 0 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 0, A" );
-    }
-};
-
-class InstructionExSet1B : public Instruction
-{
-public:
-    InstructionExSet1B( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->B, 1 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 1, B" );
-    }
-};
-
-class InstructionExSet1C : public Instruction
-{
-public:
-    InstructionExSet1C( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->C, 1 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 1, C" );
-    }
-};
-
-class InstructionExSet1D : public Instruction
-{
-public:
-    InstructionExSet1D( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->D, 1 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 1, D" );
-    }
-};
-
-class InstructionExSet1E : public Instruction
-{
-public:
-    InstructionExSet1E( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->E, 1 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 1, E" );
-    }
-};
-
-class InstructionExSet1H : public Instruction
-{
-public:
-    InstructionExSet1H( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->H, 1 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 1, H" );
-    }
-};
-
-class InstructionExSet1L : public Instruction
-{
-public:
-    InstructionExSet1L( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->L, 1 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 1, L" );
-    }
-};
-
-class InstructionExSet1HL : public Instruction
-{
-public:
-    InstructionExSet1HL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( m->rom[r->HL], 1 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 1, (HL)" );
-    }
-};
-
-class InstructionExSet1A : public Instruction
-{
-public:
-    InstructionExSet1A( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->A, 1 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 1, A" );
-    }
-};
-
-class InstructionExSet2B : public Instruction
-{
-public:
-    InstructionExSet2B( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->B, 2 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 2, B" );
-    }
-};
-
-class InstructionExSet2C : public Instruction
-{
-public:
-    InstructionExSet2C( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->C, 2 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 2, C" );
-    }
-};
-
-class InstructionExSet2D : public Instruction
-{
-public:
-    InstructionExSet2D( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->D, 2 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 2, D" );
-    }
-};
-
-class InstructionExSet2E : public Instruction
-{
-public:
-    InstructionExSet2E( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->E, 2 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 2, E" );
-    }
-};
-
-class InstructionExSet2H : public Instruction
-{
-public:
-    InstructionExSet2H( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->H, 2 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 2, H" );
-    }
-};
-
-class InstructionExSet2L : public Instruction
-{
-public:
-    InstructionExSet2L( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->L, 2 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 2, L" );
-    }
-};
-
-class InstructionExSet2HL : public Instruction
-{
-public:
-    InstructionExSet2HL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( m->rom[r->HL], 2 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 2, (HL)" );
-    }
-};
-
-class InstructionExSet2A : public Instruction
-{
-public:
-    InstructionExSet2A( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->A, 2 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 2, A" );
-    }
-};
-
-class InstructionExSet3B : public Instruction
-{
-public:
-    InstructionExSet3B( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->B, 3 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 3, B" );
-    }
-};
-
-class InstructionExSet3C : public Instruction
-{
-public:
-    InstructionExSet3C( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->C, 3 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 3, C" );
-    }
-};
-
-class InstructionExSet3D : public Instruction
-{
-public:
-    InstructionExSet3D( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->D, 3 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 3, D" );
-    }
-};
-
-class InstructionExSet3E : public Instruction
-{
-public:
-    InstructionExSet3E( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->E, 3 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 3, E" );
-    }
-};
-
-class InstructionExSet3H : public Instruction
-{
-public:
-    InstructionExSet3H( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->H, 3 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 3, H" );
-    }
-};
-
-class InstructionExSet3L : public Instruction
-{
-public:
-    InstructionExSet3L( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->L, 3 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 3, L" );
-    }
-};
-
-class InstructionExSet3HL : public Instruction
-{
-public:
-    InstructionExSet3HL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( m->rom[r->HL], 3 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 3, (HL)" );
-    }
-};
-
-class InstructionExSet3A : public Instruction
-{
-public:
-    InstructionExSet3A( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->A, 3 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 3, A" );
-    }
-};
-
-class InstructionExSet4B : public Instruction
-{
-public:
-    InstructionExSet4B( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->B, 4 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 4, B" );
-    }
-};
-
-class InstructionExSet4C : public Instruction
-{
-public:
-    InstructionExSet4C( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->C, 4 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 4, C" );
-    }
-};
-
-class InstructionExSet4D : public Instruction
-{
-public:
-    InstructionExSet4D( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->D, 4 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 4, D" );
-    }
-};
-
-class InstructionExSet4E : public Instruction
-{
-public:
-    InstructionExSet4E( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->E, 4 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 4, E" );
-    }
-};
-
-class InstructionExSet4H : public Instruction
-{
-public:
-    InstructionExSet4H( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->H, 4 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 4, H" );
-    }
-};
-
-class InstructionExSet4L : public Instruction
-{
-public:
-    InstructionExSet4L( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->L, 4 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 4, L" );
-    }
-};
-
-class InstructionExSet4HL : public Instruction
-{
-public:
-    InstructionExSet4HL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( m->rom[r->HL], 4 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 4, (HL)" );
-    }
-};
-
-class InstructionExSet4A : public Instruction
-{
-public:
-    InstructionExSet4A( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->A, 4 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 4, A" );
-    }
-};
-
-class InstructionExSet5B : public Instruction
-{
-public:
-    InstructionExSet5B( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->B, 5 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 5, B" );
-    }
-};
-
-class InstructionExSet5C : public Instruction
-{
-public:
-    InstructionExSet5C( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->C, 5 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 5, C" );
-    }
-};
-
-class InstructionExSet5D : public Instruction
-{
-public:
-    InstructionExSet5D( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->D, 5 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 5, D" );
-    }
-};
-
-class InstructionExSet5E : public Instruction
-{
-public:
-    InstructionExSet5E( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->E, 5 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 5, E" );
-    }
-};
-
-class InstructionExSet5H : public Instruction
-{
-public:
-    InstructionExSet5H( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->H, 5 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 5, H" );
-    }
-};
-
-class InstructionExSet5L : public Instruction
-{
-public:
-    InstructionExSet5L( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->L, 5 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 5, L" );
-    }
-};
-
-class InstructionExSet5HL : public Instruction
-{
-public:
-    InstructionExSet5HL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( m->rom[r->HL], 5 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 5, (HL)" );
-    }
-};
-
-class InstructionExSet5A : public Instruction
-{
-public:
-    InstructionExSet5A( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->A, 5 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 5, A" );
-    }
-};
-
-class InstructionExSet6B : public Instruction
-{
-public:
-    InstructionExSet6B( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->B, 6 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 6, B" );
-    }
-};
-
-class InstructionExSet6C : public Instruction
-{
-public:
-    InstructionExSet6C( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->C, 6 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 6, C" );
-    }
-};
-
-class InstructionExSet6D : public Instruction
-{
-public:
-    InstructionExSet6D( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->D, 6 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 6, D" );
-    }
-};
-
-class InstructionExSet6E : public Instruction
-{
-public:
-    InstructionExSet6E( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->E, 6 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 6, E" );
-    }
-};
-
-class InstructionExSet6H : public Instruction
-{
-public:
-    InstructionExSet6H( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->H, 6 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 6, H" );
-    }
-};
-
-class InstructionExSet6L : public Instruction
-{
-public:
-    InstructionExSet6L( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->L, 6 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 6, L" );
-    }
-};
-
-class InstructionExSet6HL : public Instruction
-{
-public:
-    InstructionExSet6HL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( m->rom[r->HL], 6 );
-        r->PC += length;
-    }
+static constexpr InstructionCBTable instruction_cb = instruction_cb_table( std::make_index_sequence<0x100>() );
 
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 6, (HL)" );
-    }
-};
-
-class InstructionExSet6A : public Instruction
-{
-public:
-    InstructionExSet6A( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->A, 6 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 6, A" );
-    }
-};
-
-class InstructionExSet7B : public Instruction
-{
-public:
-    InstructionExSet7B( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->B, 7 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 7, B" );
-    }
-};
-
-class InstructionExSet7C : public Instruction
-{
-public:
-    InstructionExSet7C( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->C, 7 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 7, C" );
-    }
-};
-
-class InstructionExSet7D : public Instruction
-{
-public:
-    InstructionExSet7D( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->D, 7 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 7, D" );
-    }
-};
-
-class InstructionExSet7E : public Instruction
-{
-public:
-    InstructionExSet7E( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->E, 7 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 7, E" );
-    }
-};
-
-class InstructionExSet7H : public Instruction
-{
-public:
-    InstructionExSet7H( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->H, 7 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 7, H" );
-    }
-};
-
-class InstructionExSet7L : public Instruction
-{
-public:
-    InstructionExSet7L( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->L, 7 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 7, L" );
-    }
-};
-
-class InstructionExSet7HL : public Instruction
-{
-public:
-    InstructionExSet7HL( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( m->rom[r->HL], 7 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 7, (HL)" );
-    }
-};
-
-class InstructionExSet7A : public Instruction
+inline int InstructionEx::execute( Memory* m, Registers* r )
 {
-public:
-    InstructionExSet7A( void )
-        : Instruction::Instruction( 2 )
-    {
-    }
-
-    virtual void execute( Memory* m, Registers* r )
-    {
-        InstructionEx::set( r->A, 7 );
-        r->PC += length;
-    }
-
-    virtual void dis( char* dst, size_t size, Memory* mem, uint16_t addr )
-    {
-        snprintf( dst, size, "SET 7, A" );
-    }
-};
-
-InstructionEx::InstructionEx( void )
-    : Instruction::Instruction( 2 )
-{
-    memset( opcode, 0, sizeof( opcode ) );
-
-    opcode[0x00] = new InstructionExRLCB();
-    opcode[0x01] = new InstructionExRLCC();
-    opcode[0x02] = new InstructionExRLCD();
-    opcode[0x03] = new InstructionExRLCE();
-    opcode[0x04] = new InstructionExRLCH();
-    opcode[0x05] = new InstructionExRLCL();
-    opcode[0x06] = new InstructionExRLCHL();
-    opcode[0x07] = new InstructionExRLCA();
-    opcode[0x08] = new InstructionExRRCB();
-    opcode[0x09] = new InstructionExRRCC();
-    opcode[0x0A] = new InstructionExRRCD();
-    opcode[0x0B] = new InstructionExRRCE();
-    opcode[0x0C] = new InstructionExRRCH();
-    opcode[0x0D] = new InstructionExRRCL();
-    opcode[0x0E] = new InstructionExRLCHL();
-    opcode[0x0F] = new InstructionExRRCA();
-
-    opcode[0x10] = new InstructionExRLB();
-    opcode[0x11] = new InstructionExRLC();
-    opcode[0x12] = new InstructionExRLD();
-    opcode[0x13] = new InstructionExRLE();
-    opcode[0x14] = new InstructionExRLH();
-    opcode[0x15] = new InstructionExRLL();
-    opcode[0x16] = new InstructionExRLHL();
-    opcode[0x17] = new InstructionExRLA();
-    opcode[0x18] = new InstructionExRRB();
-    opcode[0x19] = new InstructionExRRC();
-    opcode[0x1A] = new InstructionExRRD();
-    opcode[0x1B] = new InstructionExRRE();
-    opcode[0x1C] = new InstructionExRRH();
-    opcode[0x1D] = new InstructionExRRL();
-    opcode[0x1E] = new InstructionExRRHL();
-    opcode[0x1F] = new InstructionExRRA();
-
-    opcode[0x20] = new InstructionExSLAB();
-    opcode[0x21] = new InstructionExSLAC();
-    opcode[0x22] = new InstructionExSLAD();
-    opcode[0x23] = new InstructionExSLAE();
-    opcode[0x24] = new InstructionExSLAH();
-    opcode[0x25] = new InstructionExSLAL();
-    opcode[0x26] = new InstructionExSLAHL();
-    opcode[0x27] = new InstructionExSLAA();
-    opcode[0x28] = new InstructionExSRAB();
-    opcode[0x29] = new InstructionExSRAC();
-    opcode[0x2A] = new InstructionExSRAD();
-    opcode[0x2B] = new InstructionExSRAE();
-    opcode[0x2C] = new InstructionExSRAH();
-    opcode[0x2D] = new InstructionExSRAL();
-    opcode[0x2E] = new InstructionExSRAHL();
-    opcode[0x2F] = new InstructionExSRAA();
-
-    opcode[0x30] = new InstructionExSWAPB();
-    opcode[0x31] = new InstructionExSWAPC();
-    opcode[0x32] = new InstructionExSWAPD();
-    opcode[0x33] = new InstructionExSWAPE();
-    opcode[0x34] = new InstructionExSWAPL();
-    opcode[0x35] = new InstructionExSWAPH();
-    opcode[0x36] = new InstructionExSWAPHL();
-    opcode[0x37] = new InstructionExSWAPA();
-    opcode[0x38] = new InstructionExSRLB();
-    opcode[0x39] = new InstructionExSRLC();
-    opcode[0x3A] = new InstructionExSRLD();
-    opcode[0x3B] = new InstructionExSRLE();
-    opcode[0x3C] = new InstructionExSRLH();
-    opcode[0x3D] = new InstructionExSRLL();
-    opcode[0x3E] = new InstructionExSRLHL();
-    opcode[0x3F] = new InstructionExSRLA();
-
-    opcode[0x40] = new InstructionExBit0B();
-    opcode[0x41] = new InstructionExBit0C();
-    opcode[0x42] = new InstructionExBit0D();
-    opcode[0x43] = new InstructionExBit0E();
-    opcode[0x44] = new InstructionExBit0H();
-    opcode[0x45] = new InstructionExBit0L();
-    opcode[0x46] = new InstructionExBit0HL();
-    opcode[0x47] = new InstructionExBit0A();
-    opcode[0x48] = new InstructionExBit1B();
-    opcode[0x49] = new InstructionExBit1C();
-    opcode[0x4A] = new InstructionExBit1D();
-    opcode[0x4B] = new InstructionExBit1E();
-    opcode[0x4C] = new InstructionExBit1H();
-    opcode[0x4D] = new InstructionExBit1L();
-    opcode[0x4E] = new InstructionExBit1HL();
-    opcode[0x4F] = new InstructionExBit1A();
-
-    opcode[0x50] = new InstructionExBit2B();
-    opcode[0x51] = new InstructionExBit2C();
-    opcode[0x52] = new InstructionExBit2D();
-    opcode[0x53] = new InstructionExBit2E();
-    opcode[0x54] = new InstructionExBit2H();
-    opcode[0x55] = new InstructionExBit2L();
-    opcode[0x56] = new InstructionExBit2HL();
-    opcode[0x57] = new InstructionExBit2A();
-    opcode[0x58] = new InstructionExBit3B();
-    opcode[0x59] = new InstructionExBit3C();
-    opcode[0x5A] = new InstructionExBit3D();
-    opcode[0x5B] = new InstructionExBit3E();
-    opcode[0x5C] = new InstructionExBit3H();
-    opcode[0x5D] = new InstructionExBit3L();
-    opcode[0x5E] = new InstructionExBit3HL();
-    opcode[0x5F] = new InstructionExBit3A();
-
-    opcode[0x60] = new InstructionExBit4B();
-    opcode[0x61] = new InstructionExBit4C();
-    opcode[0x62] = new InstructionExBit4D();
-    opcode[0x63] = new InstructionExBit4E();
-    opcode[0x64] = new InstructionExBit4H();
-    opcode[0x65] = new InstructionExBit4L();
-    opcode[0x66] = new InstructionExBit4HL();
-    opcode[0x67] = new InstructionExBit4A();
-    opcode[0x68] = new InstructionExBit5B();
-    opcode[0x69] = new InstructionExBit5C();
-    opcode[0x6A] = new InstructionExBit5D();
-    opcode[0x6B] = new InstructionExBit5E();
-    opcode[0x6C] = new InstructionExBit5H();
-    opcode[0x6D] = new InstructionExBit5L();
-    opcode[0x6E] = new InstructionExBit5HL();
-    opcode[0x6F] = new InstructionExBit5A();
-
-    opcode[0x70] = new InstructionExBit6B();
-    opcode[0x71] = new InstructionExBit6C();
-    opcode[0x72] = new InstructionExBit6D();
-    opcode[0x73] = new InstructionExBit6E();
-    opcode[0x74] = new InstructionExBit6H();
-    opcode[0x75] = new InstructionExBit6L();
-    opcode[0x76] = new InstructionExBit6HL();
-    opcode[0x77] = new InstructionExBit6A();
-    opcode[0x78] = new InstructionExBit7B();
-    opcode[0x79] = new InstructionExBit7C();
-    opcode[0x7A] = new InstructionExBit7D();
-    opcode[0x7B] = new InstructionExBit7E();
-    opcode[0x7C] = new InstructionExBit7H();
-    opcode[0x7D] = new InstructionExBit7L();
-    opcode[0x7E] = new InstructionExBit7HL();
-    opcode[0x7F] = new InstructionExBit7A();
-
-    opcode[0x80] = new InstructionExRes0B();
-    opcode[0x81] = new InstructionExRes0C();
-    opcode[0x82] = new InstructionExRes0D();
-    opcode[0x83] = new InstructionExRes0E();
-    opcode[0x84] = new InstructionExRes0H();
-    opcode[0x85] = new InstructionExRes0L();
-    opcode[0x86] = new InstructionExRes0HL();
-    opcode[0x87] = new InstructionExRes0A();
-    opcode[0x88] = new InstructionExRes1B();
-    opcode[0x89] = new InstructionExRes1C();
-    opcode[0x8A] = new InstructionExRes1D();
-    opcode[0x8B] = new InstructionExRes1E();
-    opcode[0x8C] = new InstructionExRes1H();
-    opcode[0x8D] = new InstructionExRes1L();
-    opcode[0x8E] = new InstructionExRes1HL();
-    opcode[0x8F] = new InstructionExRes1A();
-
-    opcode[0x90] = new InstructionExRes2B();
-    opcode[0x91] = new InstructionExRes2C();
-    opcode[0x92] = new InstructionExRes2D();
-    opcode[0x93] = new InstructionExRes2E();
-    opcode[0x94] = new InstructionExRes2H();
-    opcode[0x95] = new InstructionExRes2L();
-    opcode[0x96] = new InstructionExRes2HL();
-    opcode[0x97] = new InstructionExRes2A();
-    opcode[0x98] = new InstructionExRes3B();
-    opcode[0x99] = new InstructionExRes3C();
-    opcode[0x9A] = new InstructionExRes3D();
-    opcode[0x9B] = new InstructionExRes3E();
-    opcode[0x9C] = new InstructionExRes3H();
-    opcode[0x9D] = new InstructionExRes3L();
-    opcode[0x9E] = new InstructionExRes3HL();
-    opcode[0x9F] = new InstructionExRes3A();
-
-    opcode[0xA0] = new InstructionExRes4B();
-    opcode[0xA1] = new InstructionExRes4C();
-    opcode[0xA2] = new InstructionExRes4D();
-    opcode[0xA3] = new InstructionExRes4E();
-    opcode[0xA4] = new InstructionExRes4H();
-    opcode[0xA5] = new InstructionExRes4L();
-    opcode[0xA6] = new InstructionExRes4HL();
-    opcode[0xA7] = new InstructionExRes4A();
-    opcode[0xA8] = new InstructionExRes5B();
-    opcode[0xA9] = new InstructionExRes5C();
-    opcode[0xAA] = new InstructionExRes5D();
-    opcode[0xAB] = new InstructionExRes5E();
-    opcode[0xAC] = new InstructionExRes5H();
-    opcode[0xAD] = new InstructionExRes5L();
-    opcode[0xAE] = new InstructionExRes5HL();
-    opcode[0xAF] = new InstructionExRes5A();
-
-    opcode[0xB0] = new InstructionExRes6B();
-    opcode[0xB1] = new InstructionExRes6C();
-    opcode[0xB2] = new InstructionExRes6D();
-    opcode[0xB3] = new InstructionExRes6E();
-    opcode[0xB4] = new InstructionExRes6H();
-    opcode[0xB5] = new InstructionExRes6L();
-    opcode[0xB6] = new InstructionExRes6HL();
-    opcode[0xB7] = new InstructionExRes6A();
-    opcode[0xB8] = new InstructionExRes7B();
-    opcode[0xB9] = new InstructionExRes7C();
-    opcode[0xBA] = new InstructionExRes7D();
-    opcode[0xBB] = new InstructionExRes7E();
-    opcode[0xBC] = new InstructionExRes7H();
-    opcode[0xBD] = new InstructionExRes7L();
-    opcode[0xBE] = new InstructionExRes7HL();
-    opcode[0xBF] = new InstructionExRes7A();
-
-    opcode[0xC0] = new InstructionExSet0B();
-    opcode[0xC1] = new InstructionExSet0C();
-    opcode[0xC2] = new InstructionExSet0D();
-    opcode[0xC3] = new InstructionExSet0E();
-    opcode[0xC4] = new InstructionExSet0H();
-    opcode[0xC5] = new InstructionExSet0L();
-    opcode[0xC6] = new InstructionExSet0HL();
-    opcode[0xC7] = new InstructionExSet0A();
-    opcode[0xC8] = new InstructionExSet1B();
-    opcode[0xC9] = new InstructionExSet1C();
-    opcode[0xCA] = new InstructionExSet1D();
-    opcode[0xCB] = new InstructionExSet1E();
-    opcode[0xCC] = new InstructionExSet1H();
-    opcode[0xCD] = new InstructionExSet1L();
-    opcode[0xCE] = new InstructionExSet1HL();
-    opcode[0xCF] = new InstructionExSet1A();
-
-    opcode[0xD0] = new InstructionExSet2B();
-    opcode[0xD1] = new InstructionExSet2C();
-    opcode[0xD2] = new InstructionExSet2D();
-    opcode[0xD3] = new InstructionExSet2E();
-    opcode[0xD4] = new InstructionExSet2H();
-    opcode[0xD5] = new InstructionExSet2L();
-    opcode[0xD6] = new InstructionExSet2HL();
-    opcode[0xD7] = new InstructionExSet2A();
-    opcode[0xD8] = new InstructionExSet3B();
-    opcode[0xD9] = new InstructionExSet3C();
-    opcode[0xDA] = new InstructionExSet3D();
-    opcode[0xDB] = new InstructionExSet3E();
-    opcode[0xDC] = new InstructionExSet3H();
-    opcode[0xDD] = new InstructionExSet3L();
-    opcode[0xDE] = new InstructionExSet3HL();
-    opcode[0xDF] = new InstructionExSet3A();
-
-    opcode[0xE0] = new InstructionExSet4B();
-    opcode[0xE1] = new InstructionExSet4C();
-    opcode[0xE2] = new InstructionExSet4D();
-    opcode[0xE3] = new InstructionExSet4E();
-    opcode[0xE4] = new InstructionExSet4H();
-    opcode[0xE5] = new InstructionExSet4L();
-    opcode[0xE6] = new InstructionExSet4HL();
-    opcode[0xE7] = new InstructionExSet4A();
-    opcode[0xE8] = new InstructionExSet5B();
-    opcode[0xE9] = new InstructionExSet5C();
-    opcode[0xEA] = new InstructionExSet5D();
-    opcode[0xEB] = new InstructionExSet5E();
-    opcode[0xEC] = new InstructionExSet5H();
-    opcode[0xED] = new InstructionExSet5L();
-    opcode[0xEE] = new InstructionExSet5HL();
-    opcode[0xEF] = new InstructionExSet5A();
-
-    opcode[0xF0] = new InstructionExSet6B();
-    opcode[0xF1] = new InstructionExSet6C();
-    opcode[0xF2] = new InstructionExSet6D();
-    opcode[0xF3] = new InstructionExSet6E();
-    opcode[0xF4] = new InstructionExSet6H();
-    opcode[0xF5] = new InstructionExSet6L();
-    opcode[0xF6] = new InstructionExSet6HL();
-    opcode[0xF7] = new InstructionExSet6A();
-    opcode[0xF8] = new InstructionExSet7B();
-    opcode[0xF9] = new InstructionExSet7C();
-    opcode[0xFA] = new InstructionExSet7D();
-    opcode[0xFB] = new InstructionExSet7E();
-    opcode[0xFC] = new InstructionExSet7H();
-    opcode[0xFD] = new InstructionExSet7L();
-    opcode[0xFE] = new InstructionExSet7HL();
-    opcode[0xFF] = new InstructionExSet7A();
+    return instruction_cb.execute[m->fetch8( r->PC + 1 )]( m, r );
+}
 
+inline void Instruction::create_table( Instruction** opcode, StepState& sstate )
+{
+    opcode[0x00] = new InstructionNop();
+    opcode[0x01] = new InstructionLdBCu16();
+    opcode[0x02] = new InstructionLdBCA();
+    opcode[0x03] = new InstructionIncBC();
+    opcode[0x04] = new InstructionIncB();
+    opcode[0x05] = new InstructionDecB();
+    opcode[0x06] = new InstructionLdB();
+    opcode[0x07] = new InstructionRLCA();
+    opcode[0x08] = new InstructionLdn16SP();
+    opcode[0x09] = new InstructionAddHLBC();
+    opcode[0x0A] = new InstructionLdABC();
+    opcode[0x0B] = new InstructionDecBC();
+    opcode[0x0C] = new InstructionIncC();
+    opcode[0x0D] = new InstructionDecC();
+    opcode[0x0E] = new InstructionLdC();
+    opcode[0x0F] = new InstructionRRCA();
+
+    opcode[0x10] = new InstructionStop( sstate );
+    opcode[0x11] = new InstructionLdDEu16();
+    opcode[0x12] = new InstructionLdDEA();
+    opcode[0x13] = new InstructionIncDE();
+    opcode[0x14] = new InstructionIncD();
+    opcode[0x15] = new InstructionDecD();
+    opcode[0x16] = new InstructionLdD();
+    opcode[0x17] = new InstructionRLA();
+    opcode[0x18] = new InstructionJPe8();
+    opcode[0x19] = new InstructionAddHLDE();
+    opcode[0x1A] = new InstructionLdADE();
+    opcode[0x1B] = new InstructionDecDE();
+    opcode[0x1C] = new InstructionIncE();
+    opcode[0x1D] = new InstructionDecE();
+    opcode[0x1E] = new InstructionLdE();
+    opcode[0x1F] = new InstructionRRA();
+
+    opcode[0x20] = new InstructionJRNZ();
+    opcode[0x21] = new InstructionLdHLu16();
+    opcode[0x22] = new InstructionLdHLIA();
+    opcode[0x23] = new InstructionIncHL();
+    opcode[0x24] = new InstructionIncH();
+    opcode[0x25] = new InstructionDecH();
+    opcode[0x26] = new InstructionLdH();
+    opcode[0x27] = new InstructionDAA();
+    opcode[0x28] = new InstructionJRZ();
+    opcode[0x29] = new InstructionAddHLHL();
+    opcode[0x2A] = new InstructionLdAHLI();
+    opcode[0x2B] = new InstructionDecHL();
+    opcode[0x2C] = new InstructionIncL();
+    opcode[0x2D] = new InstructionDecL();
+    opcode[0x2E] = new InstructionLdL();
+    opcode[0x2F] = new InstructionCPL();
+
+    opcode[0x30] = new InstructionJRNC();
+    opcode[0x31] = new InstructionLdSP();
+    opcode[0x32] = new InstructionLdHLDecA();
+    opcode[0x33] = new InstructionIncSP();
+    opcode[0x34] = new InstructionIncHLderef();
+    opcode[0x35] = new InstructionDecHLderef();
+    opcode[0x36] = new InstructionLdHLderef();
+    opcode[0x37] = new InstructionSCF();
+    opcode[0x38] = new InstructionJRC();
+    opcode[0x39] = new InstructionAddHLSP();
+    opcode[0x3A] = new InstructionLdAHLD();
+    opcode[0x3B] = new InstructionDecSP();
+    opcode[0x3C] = new InstructionIncA();
+    opcode[0x3D] = new InstructionDecA();
+    opcode[0x3E] = new InstructionLdA();
+    opcode[0x3F] = new InstructionCCF();
+
+    opcode[0x40] = new InstructionLdBB();
+    opcode[0x41] = new InstructionLdBC();
+    opcode[0x42] = new InstructionLdBD();
+    opcode[0x43] = new InstructionLdBE();
+    opcode[0x44] = new InstructionLdBH();
+    opcode[0x45] = new InstructionLdBL();
+    opcode[0x46] = new InstructionLdBHL();
+    opcode[0x47] = new InstructionLdBA();
+    opcode[0x48] = new InstructionLdCB();
+    opcode[0x49] = new InstructionLdCC();
+    opcode[0x4A] = new InstructionLdCD();
+    opcode[0x4B] = new InstructionLdCE();
+    opcode[0x4C] = new InstructionLdCH();
+    opcode[0x4D] = new InstructionLdCL();
+    opcode[0x4E] = new InstructionLdCHL();
+    opcode[0x4F] = new InstructionLdCA();
+
+    opcode[0x50] = new InstructionLdDB();
+    opcode[0x51] = new InstructionLdDC();
+    opcode[0x52] = new InstructionLdDD();
+    opcode[0x53] = new InstructionLdDE();
+    opcode[0x54] = new InstructionLdDH();
+    opcode[0x55] = new InstructionLdDL();
+    opcode[0x56] = new InstructionLdDHL();
+    opcode[0x57] = new InstructionLdDA();
+    opcode[0x58] = new InstructionLdEB();
+    opcode[0x59] = new InstructionLdEC();
+    opcode[0x5A] = new InstructionLdED();
+    opcode[0x5B] = new InstructionLdEE();
+    opcode[0x5C] = new InstructionLdEH();
+    opcode[0x5D] = new InstructionLdEL();
+    opcode[0x5E] = new InstructionLdEHL();
+    opcode[0x5F] = new InstructionLdEA();
+
+    opcode[0x60] = new InstructionLdHB();
+    opcode[0x61] = new InstructionLdHC();
+    opcode[0x62] = new InstructionLdHD();
+    opcode[0x63] = new InstructionLdHE();
+    opcode[0x64] = new InstructionLdHH();
+    opcode[0x65] = new InstructionLdHL();
+    opcode[0x66] = new InstructionLdHHL();
+    opcode[0x67] = new InstructionLdHA();
+    opcode[0x68] = new InstructionLdLB();
+    opcode[0x69] = new InstructionLdLC();
+    opcode[0x6A] = new InstructionLdLD();
+    opcode[0x6B] = new InstructionLdLE();
+    opcode[0x6C] = new InstructionLdLH();
+    opcode[0x6D] = new InstructionLdLL();
+    opcode[0x6E] = new InstructionLdLHL();
+    opcode[0x6F] = new InstructionLdLA();
+
+    opcode[0x70] = new InstructionLdHLB();
+    opcode[0x71] = new InstructionLdHLC();
+    opcode[0x72] = new InstructionLdHLD();
+    opcode[0x73] = new InstructionLdHLE();
+    opcode[0x74] = new InstructionLdHLH();
+    opcode[0x75] = new InstructionLdHLL();
+    opcode[0x76] = new InstructionHALT( sstate );
+    opcode[0x77] = new InstructionLdHLA();
+    opcode[0x78] = new InstructionLdAB();
+    opcode[0x79] = new InstructionLdAC();
+    opcode[0x7A] = new InstructionLdAD();
+    opcode[0x7B] = new InstructionLdAE();
+    opcode[0x7C] = new InstructionLdAH();
+    opcode[0x7D] = new InstructionLdAL();
+    opcode[0x7E] = new InstructionLdAHL();
+    opcode[0x7F] = new InstructionLdAA();
+
+    opcode[0x80] = new InstructionAddAB();
+    opcode[0x81] = new InstructionAddAC();
+    opcode[0x82] = new InstructionAddAD();
+    opcode[0x83] = new InstructionAddAE();
+    opcode[0x84] = new InstructionAddAH();
+    opcode[0x85] = new InstructionAddAL();
+    opcode[0x86] = new InstructionAddAHL();
+    opcode[0x87] = new InstructionAddAA();
+    opcode[0x88] = new InstructionAdcAB();
+    opcode[0x89] = new InstructionAdcAC();
+    opcode[0x8A] = new InstructionAdcAD();
+    opcode[0x8B] = new InstructionAdcAE();
+    opcode[0x8C] = new InstructionAdcAH();
+    opcode[0x8D] = new InstructionAdcAL();
+    opcode[0x8E] = new InstructionAdcAHL();
+    opcode[0x8F] = new InstructionAdcAA();
+
+    opcode[0x90] = new InstructionSubAB();
+    opcode[0x91] = new InstructionSubAC();
+    opcode[0x92] = new InstructionSubAD();
+    opcode[0x93] = new InstructionSubAE();
+    opcode[0x94] = new InstructionSubAH();
+    opcode[0x95] = new InstructionSubAL();
+    opcode[0x96] = new InstructionSubAHL();
+    opcode[0x97] = new InstructionSubAA();
+    opcode[0x98] = new InstructionSbcAB();
+    opcode[0x99] = new InstructionSbcAC();
+    opcode[0x9A] = new InstructionSbcAD();
+    opcode[0x9B] = new InstructionSbcAE();
+    opcode[0x9C] = new InstructionSbcAH();
+    opcode[0x9D] = new InstructionSbcAL();
+    opcode[0x9E] = new InstructionSbcAHL();
+    opcode[0x9F] = new InstructionSbcAA();
+
+    opcode[0xA0] = new InstructionAndAB();
+    opcode[0xA1] = new InstructionAndAC();
+    opcode[0xA2] = new InstructionAndAD();
+    opcode[0xA3] = new InstructionAndAE();
+    opcode[0xA4] = new InstructionAndAH();
+    opcode[0xA5] = new InstructionAndAL();
+    opcode[0xA6] = new InstructionAndAHL();
+    opcode[0xA7] = new InstructionAndAA();
+    opcode[0xA8] = new InstructionXorAB();
+    opcode[0xA9] = new InstructionXorAC();
+    opcode[0xAA] = new InstructionXorAD();
+    opcode[0xAB] = new InstructionXorAE();
+    opcode[0xAC] = new InstructionXorAH();
+    opcode[0xAD] = new InstructionXorAL();
+    opcode[0xAE] = new InstructionXorAHL();
+    opcode[0xAF] = new InstructionXorAA();
+
+    opcode[0xB0] = new InstructionOrAB();
+    opcode[0xB1] = new InstructionOrAC();
+    opcode[0xB2] = new InstructionOrAD();
+    opcode[0xB3] = new InstructionOrAE();
+    opcode[0xB4] = new InstructionOrAH();
+    opcode[0xB5] = new InstructionOrAL();
+    opcode[0xB6] = new InstructionOrAHL();
+    opcode[0xB7] = new InstructionOrAA();
+    opcode[0xB8] = new InstructionCpAB();
+    opcode[0xB9] = new InstructionCpAC();
+    opcode[0xBA] = new InstructionCpAD();
+    opcode[0xBB] = new InstructionCpAE();
+    opcode[0xBC] = new InstructionCpAH();
+    opcode[0xBD] = new InstructionCpAL();
+    opcode[0xBE] = new InstructionCpAHL();
+    opcode[0xBF] = new InstructionCpAA();
+
+    opcode[0xC0] = new InstructionRetNZ();
+    opcode[0xC1] = new InstructionPopBC();
+    opcode[0xC2] = new InstructionJpNZu16();
+    opcode[0xC3] = new InstructionJPu16();
+    opcode[0xC4] = new InstructionCallNZ();
+    opcode[0xC5] = new InstructionPushBC();
+    opcode[0xC6] = new InstructionAddA();
+    opcode[0xC7] = new InstructionRST00();
+    opcode[0xC8] = new InstructionRetZ();
+    opcode[0xC9] = new InstructionRet();
+    opcode[0xCA] = new InstructionJpZu16();
+    opcode[0xCB] = new InstructionEx();
+    opcode[0xCC] = new InstructionCallZ();
+    opcode[0xCD] = new InstructionCall();
+    opcode[0xCE] = new InstructionAdcA();
+    opcode[0xCF] = new InstructionRST08();
+
+    opcode[0xD0] = new InstructionRetNC();
+    opcode[0xD1] = new InstructionPopDE();
+    opcode[0xD2] = new InstructionJpNCu16();
+    opcode[0xD3] = new Instruction();
+    opcode[0xD4] = new InstructionCallNC();
+    opcode[0xD5] = new InstructionPushDE();
+    opcode[0xD6] = new InstructionSubAu8();
+    opcode[0xD7] = new InstructionRST10();
+    opcode[0xD8] = new InstructionRetC();
+    opcode[0xD9] = new InstructionRetI();
+    opcode[0xDA] = new InstructionJpCu16();
+    opcode[0xDB] = new Instruction();
+    opcode[0xDC] = new InstructionCallC();
+    opcode[0xDD] = new Instruction();
+    opcode[0xDE] = new InstructionSbcA();
+    opcode[0xDF] = new InstructionRST18();
+
+    opcode[0xE0] = new InstructionLdFFA();
+    opcode[0xE1] = new InstructionPopHL();
+    opcode[0xE2] = new InstructionLdFFCA();
+    opcode[0xE3] = new Instruction();
+    opcode[0xE4] = new Instruction();
+    opcode[0xE5] = new InstructionPushHL();
+    opcode[0xE6] = new InstructionAndA();
+    opcode[0xE7] = new InstructionRST20();
+    opcode[0xE8] = new InstructionAddSPi8();
+    opcode[0xE9] = new InstructionJpHL();
+    opcode[0xEA] = new InstructionLdu16A();
+    opcode[0xEB] = new Instruction();
+    opcode[0xEC] = new Instruction();
+    opcode[0xED] = new Instruction();
+    opcode[0xEE] = new InstructionXorA();
+    opcode[0xEF] = new InstructionRST28();
+
+    opcode[0xF0] = new InstructionLdAFF();
+    opcode[0xF1] = new InstructionPopAF();
+    opcode[0xF2] = new InstructionLdAFFC();
+    opcode[0xF3] = new InstructionDI();
+    opcode[0xF4] = new Instruction();
+    opcode[0xF5] = new InstructionPushAF();
+    opcode[0xF6] = new InstructionOrA();
+    opcode[0xF7] = new InstructionRST30();
+    opcode[0xF8] = new InstructionLdHLSPi8();
+    opcode[0xF9] = new InstructionLdSPHL();
+    opcode[0xFA] = new InstructionLdAu16();
+    opcode[0xFB] = new InstructionEI();
+    opcode[0xFC] = new Instruction();
+    opcode[0xFD] = new Instruction();
+    opcode[0xFE] = new InstructionCpA();
+    opcode[0xFF] = new InstructionRST38();
 }
@@ -0,0 +1,112 @@
+#pragma once
+#include <stdint.h>
+#include "memory.h"
+#include "registers.h"
+#include "instruction.h"
+#include "optable.h"
+#include "shared.h"
+
+// Flat interpreter core: all 512 opcodes (0x000-0x0FF primary, 0x100-0x1FF CB page)
+// are handled inside a single function, so the helpers in Instruction/InstructionEx
+// inline and there is no virtual call per instruction. GCC and Clang get a
+// direct-threaded build using computed goto, everything else a plain switch.
+// Define GB_NO_COMPUTED_GOTO to force the switch on GCC/Clang.
+//
+// Loads and stores go through the Memory bus, opcodes and operands through
+// Memory::fetch8, which keeps the page PC is in at hand.
+
+#if ( defined( __GNUC__ ) || defined( __clang__ ) ) && !defined( GB_NO_COMPUTED_GOTO )
+#define GB_COMPUTED_GOTO 1
+#else
+#define GB_COMPUTED_GOTO 0
+#endif
+
+class Interpreter
+{
+public:
+    // Executes instructions until at least budget T-cycles have been spent and returns
+    // the cycles actually used, which overshoot the budget by at most one instruction.
+    // Stops early when an instruction (HALT, STOP) sets sstate to StepState::STOP.
+    // The number of instructions executed is stored in executed when it is non-null.
+    static int run( Memory* m, Registers* r, StepState& sstate, int budget, int* executed = nullptr )
+    {
+        int spent = 0;
+        int count = 0;
+
+#define IMM8 m->fetch8( r->PC + 1 )
+#define IMM16 m->fetch16( r->PC + 1 )
+#define READ8( a ) m->read8( a )
+#define WRITE8( a, v ) m->write8( a, v )
+#define READ16( a ) m->read16( a )
+#define WRITE16( a, v ) m->write16( a, v )
+
+#if GB_COMPUTED_GOTO
+
+#define OPCODE( n ) op_##n:
+#define NEXT( c )                                         \
+    spent += c;                                           \
+    count++;                                              \
+    if ( spent >= budget || sstate == StepState::STOP ) { \
+        goto done;                                        \
+    }                                                     \
+    goto* dispatch[m->fetch8( r->PC )]
+
+        static void* const dispatch[0x200] = {
+#define OPCODE_LABELS
+#include "opcodes.h"
+#undef OPCODE_LABELS
+        };
+
+        if ( budget <= 0 || sstate == StepState::STOP ) {
+            goto done;
+        }
+
+        goto* dispatch[m->fetch8( r->PC )];
+
+    op_0xCB:
+        goto* dispatch[0x100 | m->fetch8( r->PC + 1 )];
+
+#else
+
+#define OPCODE( n ) case n:
+#define NEXT( c ) \
+    spent += c;   \
+    count++;      \
+    continue
+
+        while ( spent < budget && sstate != StepState::STOP ) {
+            uint16_t op = m->fetch8( r->PC );
+            if ( op == 0xCB ) {
+                op = 0x100 | m->fetch8( r->PC + 1 );
+            }
+
+            switch ( op ) {
+
+#endif
+
+#include "opcodes.h"
+
+#if !GB_COMPUTED_GOTO
+            }
+        }
+#endif
+
+#undef OPCODE
+#undef NEXT
+#undef IMM8
+#undef IMM16
+#undef READ8
+#undef WRITE8
+#undef READ16
+#undef WRITE16
+
+#if GB_COMPUTED_GOTO
+    done:
+#endif
+        if ( executed ) {
+            *executed = count;
+        }
+
+        return spent;
+    }
+};
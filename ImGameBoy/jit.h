@@ -0,0 +1,1051 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+#include "memory.h"
+#include "registers.h"
+#include "instruction.h"
+#include "optable.h"
+#include "shared.h"
+
+// x86-64 dynamic recompiler. Straight-line runs of SM83 instructions (same rules as
+// BlockCache) are translated to machine code in an arena that is never writable and
+// executable at once: translate() makes the pages it writes writable and hands them
+// back executable before anything runs. The SM83 state
+// stays in Registers and Memory the whole time, so any instruction can be handed to
+// the interpreter in the middle of a block:
+//
+//   rbx  Registers*          rbp  Memory* (map and page tables)
+//   r12  Frame*              r13d T-cycles left in the budget
+//   r14d instructions run    r15  Tables* (flag translation and code page map)
+//
+// Loads, stores and ALU operations on registers and plain RAM, 16-bit loads and
+// increments, JR and JP are translated. Everything else is a call to step(), which
+// runs the instruction through the handlers in opcodes.h. Translated loads and stores
+// look the page up in Memory's read_page/write_page tables; pages with a handler
+// (I/O, the MBC registers), stores to echo RAM and stores to pages holding
+// translated code take the same path at run time. HALT, STOP, EI, DI and the stack
+// instructions are never translated.
+//
+// The budget is checked after every instruction, so run() overshoots it by at most
+// one instruction, exactly like Interpreter::run(). Blocks chain into each other
+// without leaving the machine code while the budget lasts.
+//
+// A store into a page holding translated code drops the blocks decoded from it and
+// leaves the running block right after the store, flush() drops everything.
+//
+// Blocks translated from 0x4000-0x7FFF belong to the ROM bank that was mapped in and
+// start by comparing Memory::rom_bank against it. On a mismatch they leave to
+// execute(), which picks the block of the current bank or translates one, so a bank
+// switch costs nothing up front and blocks of every bank stay around. A store that
+// switches banks leaves the running block like a store into code does. The MBC1 low
+// bank at 0x0000-0x3FFF and the cartridge RAM bank change rarely, the blocks of
+// those are dropped when they do.
+
+#if defined( __x86_64__ ) || defined( _M_X64 )
+#define GB_JIT 1
+#else
+#define GB_JIT 0
+#endif
+
+#if GB_JIT
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+class Jit
+{
+private:
+    static const int MAX_BLOCK = 64; // instructions per block
+    static const int PAGE_SHIFT = 7; // same pages as BlockCache
+    static const int PAGES = 0x10000 >> PAGE_SHIFT;
+    static const size_t ARENA_SIZE = 0x400000; // machine code, flushed when full
+    static const size_t MAX_BLOCK_CODE = MAX_BLOCK * 192 + 64; // worst case bytes per block
+
+    // Registers offsets, rbx relative
+    enum : uint8_t {
+        R_F = 0,
+        R_A = 1,
+        R_C = 2,
+        R_B = 3,
+        R_E = 4,
+        R_D = 5,
+        R_L = 6,
+        R_H = 7,
+        R_SP = 8,
+        R_PC = 10,
+    };
+
+    struct Tables {
+        uint8_t flags[0x100]; // AH after LAHF -> Z, H and C of F
+        uint8_t code[PAGES]; // the page holds translated code
+    };
+
+    // Handed to the machine code in r12, the only interface between the two sides
+    struct Frame {
+        Registers* r;
+        Memory* m;
+        Tables* tables;
+        const uint8_t* const* entry; // PC -> translated block, null stops chaining
+        Jit* jit;
+        StepState* sstate;
+        int remaining; // T-cycles, in and out
+        int count; // instructions run, out
+    };
+
+    struct Block {
+        const uint8_t* code;
+        uint16_t pc;
+        uint16_t bank; // ROM bank for blocks in 0x4000-0x7FFF
+        uint32_t end; // address following the last instruction
+        bool valid;
+    };
+
+    // Machine code writer with forward labels
+    class Assembler
+    {
+    private:
+        struct Fixup {
+            size_t at; // rel32 to patch
+            int label;
+        };
+
+        uint8_t* base;
+        std::vector<size_t> labels;
+        std::vector<Fixup> fixups;
+
+    public:
+        size_t pos;
+
+        Assembler( uint8_t* b, size_t p )
+            : base( b ), pos( p )
+        {
+        }
+
+        void u8( uint8_t v )
+        {
+            base[pos++] = v;
+        }
+
+        void u16( uint16_t v )
+        {
+            memcpy( &base[pos], &v, 2 );
+            pos += 2;
+        }
+
+        void u32( uint32_t v )
+        {
+            memcpy( &base[pos], &v, 4 );
+            pos += 4;
+        }
+
+        void u64( uint64_t v )
+        {
+            memcpy( &base[pos], &v, 8 );
+            pos += 8;
+        }
+
+        void bytes( std::initializer_list< uint8_t > b )
+        {
+            for ( uint8_t v : b ) {
+                u8( v );
+            }
+        }
+
+        int label( void )
+        {
+            labels.push_back( SIZE_MAX );
+            return (int)labels.size() - 1;
+        }
+
+        void bind( int l )
+        {
+            labels[l] = pos;
+        }
+
+        // rel32 to a label, bound now or later
+        void rel( int l )
+        {
+            fixups.push_back( { pos, l } );
+            u32( 0 );
+        }
+
+        // rel32 to an arena offset
+        void rel_to( size_t target )
+        {
+            u32( (uint32_t)( (int32_t)target - (int32_t)( pos + 4 ) ) );
+        }
+
+        void jmp( int l )
+        {
+            u8( 0xE9 );
+            rel( l );
+        }
+
+        void jmp_to( size_t target )
+        {
+            u8( 0xE9 );
+            rel_to( target );
+        }
+
+        void jcc_to( uint8_t cc, size_t target )
+        {
+            bytes( { 0x0F, (uint8_t)( 0x80 | cc ) } );
+            rel_to( target );
+        }
+
+        // cc is the low nibble of the Jcc opcode, see JB...JG below
+        void jcc( uint8_t cc, int l )
+        {
+            bytes( { 0x0F, (uint8_t)( 0x80 | cc ) } );
+            rel( l );
+        }
+
+        void resolve( void )
+        {
+            for ( const Fixup& f : fixups ) {
+                int32_t d = (int32_t)labels[f.label] - (int32_t)( f.at + 4 );
+                memcpy( &base[f.at], &d, 4 );
+            }
+            fixups.clear();
+            labels.clear();
+        }
+    };
+
+    static const uint8_t JB = 0x2, JAE = 0x3, JE = 0x4, JNE = 0x5, JS = 0x8, JLE = 0xE, JG = 0xF;
+
+    uint8_t* arena;
+    size_t used;
+    size_t thunk_exit; // leaves the machine code
+    size_t thunk_dispatch; // chains into the block at PC, or leaves
+    size_t thunk_base; // blocks start here
+    void ( *enter )( Frame* f, const uint8_t* code );
+
+    Tables tables;
+    std::vector<const uint8_t*> entry; // PC -> translated block
+    std::vector<uint16_t> entry_bank; // bank of the block in entry, 0x4000-0x7FFF
+    std::unordered_map<uint32_t, uint32_t> banked; // bank << 16 | PC -> block, 0x4000-0x7FFF
+    std::vector<Block> blocks;
+    std::vector<uint32_t> page_blocks[PAGES]; // blocks translated from each page
+    bool leave; // a store dropped translated code, the running block has to stop
+
+    static bool switchable( uint16_t pc )
+    {
+        return pc >= 0x4000 && pc < 0x8000;
+    }
+
+    // Block for PC in the bank that is mapped in, translated if there is none yet
+    const uint8_t* lookup( Memory* m, uint16_t pc )
+    {
+        const uint8_t* code = entry[pc];
+        if ( code && ( !switchable( pc ) || entry_bank[pc] == m->rom_bank ) ) {
+            return code;
+        }
+
+        if ( switchable( pc ) ) {
+            auto it = banked.find( ( (uint32_t)m->rom_bank << 16 ) | pc );
+            if ( it != banked.end() ) {
+                entry[pc] = blocks[it->second].code;
+                entry_bank[pc] = m->rom_bank;
+                return entry[pc];
+            }
+        }
+
+        return translate( m, pc );
+    }
+
+    // Offset of the 8-bit register in bits 0-2 of an opcode, 0xFF for (HL)
+    static uint8_t reg8( uint8_t index )
+    {
+        static const uint8_t offset[8] = { R_B, R_C, R_D, R_E, R_H, R_L, 0xFF, R_A };
+        return offset[index & 7];
+    }
+
+    static uint8_t reg16( uint8_t index )
+    {
+        static const uint8_t offset[4] = { R_C, R_E, R_L, R_SP }; // BC, DE, HL, SP
+        return offset[index & 3];
+    }
+
+    // Runs the instruction at r->PC, called from the machine code through call_step()
+    static int step_thunk( Frame* f )
+    {
+        int spent = f->jit->step( f->m, f->r, *f->sstate );
+
+        // The machine code keeps F up to date itself
+        f->r->sync_flags();
+
+        // Negative tells the block to stop right here
+        if ( f->jit->leave || *f->sstate == StepState::STOP ) {
+            f->jit->leave = false;
+            return -spent;
+        }
+
+        return spent;
+    }
+
+    int step( Memory* m, Registers* r, StepState& sstate )
+    {
+#define IMM8 m->fetch8( r->PC + 1 )
+#define IMM16 m->fetch16( r->PC + 1 )
+#define READ8( a ) m->read8( a )
+#define WRITE8( a, v ) write8( m, a, v )
+#define READ16( a ) m->read16( a )
+#define WRITE16( a, v ) write16( m, a, v )
+#define OPCODE( n ) case n:
+#define NEXT( c ) return c
+
+        uint16_t op = m->fetch8( r->PC );
+        if ( op == 0xCB ) {
+            op = 0x100 | m->fetch8( r->PC + 1 );
+        }
+
+        switch ( op ) {
+#include "opcodes.h"
+        }
+
+#undef OPCODE
+#undef NEXT
+#undef IMM8
+#undef IMM16
+#undef READ8
+#undef WRITE8
+#undef READ16
+#undef WRITE16
+
+        return 4;
+    }
+
+    // Writes below 0x8000 go to the MBC and never change ROM
+    void write8( Memory* m, uint16_t address, uint8_t value )
+    {
+        if ( address < 0x8000 ) {
+            uint16_t bank = m->rom_bank;
+            const uint8_t* low = m->host_page( 0x00 );
+            const uint8_t* ram = m->host_page( 0xA0 );
+            m->write8( address, value );
+
+            if ( m->rom_bank != bank ) {
+                leave = true;
+            }
+            if ( m->host_page( 0x00 ) != low ) {
+                invalidate_range( 0x0000, 0x4000 );
+            }
+            if ( m->host_page( 0xA0 ) != ram ) {
+                invalidate_range( 0xA000, 0x2000 );
+            }
+            return;
+        }
+
+        m->write8( address, value );
+
+        uint16_t page = Memory::canonical( address ) >> PAGE_SHIFT;
+        if ( tables.code[page] ) {
+            invalidate( page );
+        }
+    }
+
+    void write16( Memory* m, uint16_t address, uint16_t value )
+    {
+        write8( m, address, value & 0xFF );
+        write8( m, address + 1, value >> 8 );
+    }
+
+    // Drops every block translated from page. Their code stays in the arena until the
+    // next flush, so the block that is running right now can still return.
+    void invalidate( uint32_t page )
+    {
+        for ( uint32_t index : page_blocks[page] ) {
+            Block& block = blocks[index];
+            if ( !block.valid ) {
+                continue;
+            }
+
+            block.valid = false;
+            if ( entry[block.pc] == block.code ) {
+                entry[block.pc] = nullptr;
+            }
+            if ( switchable( block.pc ) ) {
+                banked.erase( ( (uint32_t)block.bank << 16 ) | block.pc );
+            }
+        }
+
+        page_blocks[page].clear();
+        tables.code[page] = 0;
+        leave = true;
+    }
+
+    // Machine code helpers, see the register assignment at the top
+
+    // mov rdi/rcx, r12; mov rax, step_thunk; call rax
+    void call_step( Assembler& a, uint16_t pc )
+    {
+        a.bytes( { 0x66, 0xC7, 0x43, R_PC } ); // mov word [rbx+PC], pc
+        a.u16( pc );
+#ifdef _WIN32
+        a.bytes( { 0x4C, 0x89, 0xE1 } );
+#else
+        a.bytes( { 0x4C, 0x89, 0xE7 } );
+#endif
+        a.bytes( { 0x48, 0xB8 } );
+        a.u64( (uint64_t)(uintptr_t)&step_thunk );
+        a.bytes( { 0xFF, 0xD0 } );
+    }
+
+    // After call_step: accounts the cycles in eax and leaves when step_thunk says so
+    // or the budget is spent. PC is already past the instruction.
+    void account_step( Assembler& a, int n )
+    {
+        int go_on = a.label();
+        int leave_now = a.label();
+
+        a.bytes( { 0x85, 0xC0 } ); // test eax, eax
+        a.jcc( JS, leave_now );
+        a.bytes( { 0x41, 0x29, 0xC5 } ); // sub r13d, eax
+        a.jcc( JG, go_on );
+        a.bytes( { 0x41, 0x83, 0xC6, (uint8_t)n } ); // add r14d, n
+        a.jmp_to( thunk_exit );
+        a.bind( leave_now );
+        a.bytes( { 0xF7, 0xD8 } ); // neg eax
+        a.bytes( { 0x41, 0x29, 0xC5 } ); // sub r13d, eax
+        a.bytes( { 0x41, 0x83, 0xC6, (uint8_t)n } ); // add r14d, n
+        a.jmp_to( thunk_exit );
+        a.bind( go_on );
+    }
+
+    // Cycles of a translated instruction, leaves with PC at next when the budget is spent
+    void account( Assembler& a, int cycles, int n, uint16_t next, std::vector<std::pair<int, uint32_t>>& stubs )
+    {
+        int out = a.label();
+
+        a.bytes( { 0x41, 0x83, 0xED, (uint8_t)cycles } ); // sub r13d, cycles
+        a.jcc( JLE, out );
+        stubs.push_back( { out, ( (uint32_t)n << 16 ) | next } );
+    }
+
+    // Ends the block: PC, cycles, count, then on to the next block
+    void finish( Assembler& a, uint16_t pc, int cycles, int n )
+    {
+        a.bytes( { 0x66, 0xC7, 0x43, R_PC } ); // mov word [rbx+PC], pc
+        a.u16( pc );
+        if ( cycles ) {
+            a.bytes( { 0x41, 0x83, 0xED, (uint8_t)cycles } ); // sub r13d, cycles
+        }
+        a.bytes( { 0x41, 0x83, 0xC6, (uint8_t)n } ); // add r14d, n
+        a.jmp_to( thunk_dispatch );
+    }
+
+    // rdx = Memory::read_page or write_page entry of the page at eax
+    void bus_page( Assembler& a, size_t table )
+    {
+        a.bytes( { 0x89, 0xC2 } ); // mov edx, eax
+        a.bytes( { 0xC1, 0xEA, 0x08 } ); // shr edx, 8
+        a.bytes( { 0x48, 0x8B, 0x94, 0xD5 } ); // mov rdx, [rbp+rdx*8+table]
+        a.u32( (uint32_t)table );
+        a.bytes( { 0x48, 0x85, 0xD2 } ); // test rdx, rdx
+    }
+
+    // ecx = byte at eax, or slow when the page has a read handler (I/O)
+    void load( Assembler& a, int slow )
+    {
+        bus_page( a, offsetof( Memory, read_page ) );
+        a.jcc( JE, slow );
+        a.bytes( { 0x0F, 0xB6, 0xC8 } ); // movzx ecx, al
+        a.bytes( { 0x0F, 0xB6, 0x0C, 0x0A } ); // movzx ecx, byte [rdx+rcx]
+    }
+
+    // byte at eax = cl, or slow for echo RAM, translated code and pages with a write
+    // handler (MBC registers, I/O)
+    void store( Assembler& a, int slow )
+    {
+        a.bytes( { 0x3D, 0x00, 0xE0, 0x00, 0x00 } ); // cmp eax, 0xE000
+        a.jcc( JAE, slow );
+        a.bytes( { 0x89, 0xC2 } ); // mov edx, eax
+        a.bytes( { 0xC1, 0xEA, PAGE_SHIFT } ); // shr edx, PAGE_SHIFT
+        a.bytes( { 0x41, 0x80, 0xBC, 0x17 } ); // cmp byte [r15+rdx+code], 0
+        a.u32( (uint32_t)offsetof( Tables, code ) );
+        a.u8( 0 );
+        a.jcc( JNE, slow );
+        bus_page( a, offsetof( Memory, write_page ) );
+        a.jcc( JE, slow );
+        a.bytes( { 0x0F, 0xB6, 0xC0 } ); // movzx eax, al
+        a.bytes( { 0x88, 0x0C, 0x02 } ); // mov [rdx+rax], cl
+    }
+
+    void address16( Assembler& a, uint8_t reg )
+    {
+        a.bytes( { 0x0F, 0xB7, 0x43, reg } ); // movzx eax, word [rbx+reg]
+    }
+
+    void address_imm( Assembler& a, uint16_t address )
+    {
+        a.u8( 0xB8 ); // mov eax, address
+        a.u32( address );
+    }
+
+    // F from the x86 flags in AH: keep masks the translated Z, H and C, set is ORed in
+    void flags( Assembler& a, uint8_t keep, uint8_t set )
+    {
+        a.bytes( { 0x0F, 0xB6, 0xCC } ); // movzx ecx, ah
+        a.bytes( { 0x41, 0x0F, 0xB6, 0x0C, 0x0F } ); // movzx ecx, byte [r15+rcx]
+        if ( keep != 0xB0 ) {
+            a.bytes( { 0x80, 0xE1, keep } ); // and cl, keep
+        }
+        if ( set ) {
+            a.bytes( { 0x80, 0xC9, set } ); // or cl, set
+        }
+        a.bytes( { 0x88, 0x4B, R_F } ); // mov [rbx+F], cl
+    }
+
+    // A = A op cl for ADD ADC SUB SBC AND XOR OR CP (0-7)
+    void alu( Assembler& a, int kind )
+    {
+        static const uint8_t opcode[8] = { 0x00, 0x10, 0x28, 0x18, 0x20, 0x30, 0x08, 0x38 };
+
+        a.bytes( { 0x0F, 0xB6, 0x43, R_A } ); // movzx eax, byte [rbx+A]
+        if ( kind == 1 || kind == 3 ) {
+            a.bytes( { 0x0F, 0xBA, 0x63, R_F, 4 } ); // bt dword [rbx+F], 4 (CF = C)
+        }
+        a.bytes( { opcode[kind], 0xC8 } ); // op al, cl
+        a.u8( 0x9F ); // lahf
+        if ( kind != 7 ) {
+            a.bytes( { 0x88, 0x43, R_A } ); // mov [rbx+A], al
+        }
+
+        switch ( kind ) {
+        case 0: case 1: flags( a, 0xB0, 0 ); break; // Z H C
+        case 2: case 3: case 7: flags( a, 0xB0, 0x40 ); break; // Z N H C
+        case 4: flags( a, 0x80, 0x20 ); break; // Z, H set
+        default: flags( a, 0x80, 0 ); break; // Z
+        }
+    }
+
+    // INC r / DEC r, C is left alone
+    void incdec( Assembler& a, uint8_t reg, bool dec )
+    {
+        a.bytes( { 0x0F, 0xB6, 0x43, reg } ); // movzx eax, byte [rbx+reg]
+        a.bytes( { 0xFE, (uint8_t)( dec ? 0xC8 : 0xC0 ) } ); // inc/dec al
+        a.u8( 0x9F ); // lahf
+        a.bytes( { 0x88, 0x43, reg } ); // mov [rbx+reg], al
+        a.bytes( { 0x0F, 0xB6, 0xCC } ); // movzx ecx, ah
+        a.bytes( { 0x41, 0x0F, 0xB6, 0x0C, 0x0F } ); // movzx ecx, byte [r15+rcx]
+        a.bytes( { 0x80, 0xE1, 0xA0 } ); // and cl, Z|H
+        a.bytes( { 0x0F, 0xB6, 0x53, R_F } ); // movzx edx, byte [rbx+F]
+        a.bytes( { 0x80, 0xE2, 0x10 } ); // and dl, C
+        a.bytes( { 0x08, 0xD1 } ); // or cl, dl
+        if ( dec ) {
+            a.bytes( { 0x80, 0xC9, 0x40 } ); // or cl, N
+        }
+        a.bytes( { 0x88, 0x4B, R_F } ); // mov [rbx+F], cl
+    }
+
+    // Branch at the end of a block: cc 0 always, else the F mask and whether the bit
+    // has to be set to take it
+    void branch( Assembler& a, uint8_t mask, bool set, uint16_t target, int taken, uint16_t next, int not_taken, int n )
+    {
+        if ( mask ) {
+            int skip = a.label();
+            a.bytes( { 0xF6, 0x43, R_F, mask } ); // test byte [rbx+F], mask
+            a.jcc( set ? JE : JNE, skip );
+            finish( a, target, taken, n );
+            a.bind( skip );
+            finish( a, next, not_taken, n );
+        }
+        else {
+            finish( a, target, taken, n );
+        }
+    }
+
+    // Translates one instruction. Returns false for the ones left to step().
+    // slow is bound to the out of line fallback when a memory access is translated.
+    bool translate_op( Assembler& a, Memory* m, uint16_t pc, uint8_t op, int n, bool& branched, int& slow, int& cycles )
+    {
+        uint16_t imm16 = m->peek( pc + 1 ) | ( m->peek( pc + 2 ) << 8 );
+        uint8_t imm8 = m->peek( pc + 1 );
+        const OpInfo& info = optable[op];
+        uint16_t next = (uint16_t)( pc + info.length );
+
+        branched = false;
+        slow = -1;
+        cycles = info.cycles;
+
+        // LD r,r' and LD r,(HL) / LD (HL),r
+        if ( op >= 0x40 && op < 0x80 && op != 0x76 ) {
+            uint8_t dst = reg8( op >> 3 ), src = reg8( op );
+            if ( dst != 0xFF && src != 0xFF ) {
+                a.bytes( { 0x0F, 0xB6, 0x43, src } ); // movzx eax, byte [rbx+src]
+                a.bytes( { 0x88, 0x43, dst } ); // mov [rbx+dst], al
+            }
+            else if ( src == 0xFF ) {
+                slow = a.label();
+                address16( a, R_L );
+                load( a, slow );
+                a.bytes( { 0x88, 0x4B, dst } ); // mov [rbx+dst], cl
+            }
+            else {
+                slow = a.label();
+                a.bytes( { 0x0F, 0xB6, 0x4B, src } ); // movzx ecx, byte [rbx+src]
+                address16( a, R_L );
+                store( a, slow );
+            }
+            return true;
+        }
+
+        // ALU A,r and A,(HL)
+        if ( op >= 0x80 && op < 0xC0 ) {
+            uint8_t src = reg8( op );
+            if ( src == 0xFF ) {
+                slow = a.label();
+                address16( a, R_L );
+                load( a, slow );
+            }
+            else {
+                a.bytes( { 0x0F, 0xB6, 0x4B, src } ); // movzx ecx, byte [rbx+src]
+            }
+            alu( a, ( op >> 3 ) & 7 );
+            return true;
+        }
+
+        switch ( op ) {
+        case 0x00: // NOP
+            return true;
+
+        case 0x01: case 0x11: case 0x21: case 0x31: // LD rr,nn
+            a.bytes( { 0x66, 0xC7, 0x43, reg16( op >> 4 ) } );
+            a.u16( imm16 );
+            return true;
+
+        case 0x03: case 0x13: case 0x23: case 0x33: // INC rr
+            a.bytes( { 0x66, 0xFF, 0x43, reg16( op >> 4 ) } );
+            return true;
+
+        case 0x0B: case 0x1B: case 0x2B: case 0x3B: // DEC rr
+            a.bytes( { 0x66, 0xFF, 0x4B, reg16( op >> 4 ) } );
+            return true;
+
+        case 0x04: case 0x0C: case 0x14: case 0x1C: case 0x24: case 0x2C: case 0x3C: // INC r
+            incdec( a, reg8( op >> 3 ), false );
+            return true;
+
+        case 0x05: case 0x0D: case 0x15: case 0x1D: case 0x25: case 0x2D: case 0x3D: // DEC r
+            incdec( a, reg8( op >> 3 ), true );
+            return true;
+
+        case 0x06: case 0x0E: case 0x16: case 0x1E: case 0x26: case 0x2E: case 0x3E: // LD r,n
+            a.bytes( { 0xC6, 0x43, reg8( op >> 3 ), imm8 } );
+            return true;
+
+        case 0x02: case 0x12: // LD (BC),A / LD (DE),A
+        case 0x22: case 0x32: // LD (HL+),A / LD (HL-),A
+            slow = a.label();
+            a.bytes( { 0x0F, 0xB6, 0x4B, R_A } ); // movzx ecx, byte [rbx+A]
+            address16( a, op < 0x20 ? reg16( op >> 4 ) : (uint8_t)R_L );
+            store( a, slow );
+            if ( op >= 0x20 ) {
+                a.bytes( { 0x66, 0xFF, (uint8_t)( op == 0x22 ? 0x43 : 0x4B ), R_L } ); // inc/dec word [rbx+HL]
+            }
+            return true;
+
+        case 0x0A: case 0x1A: // LD A,(BC) / LD A,(DE)
+        case 0x2A: case 0x3A: // LD A,(HL+) / LD A,(HL-)
+            slow = a.label();
+            address16( a, op < 0x20 ? reg16( op >> 4 ) : (uint8_t)R_L );
+            load( a, slow );
+            a.bytes( { 0x88, 0x4B, R_A } ); // mov [rbx+A], cl
+            if ( op >= 0x20 ) {
+                a.bytes( { 0x66, 0xFF, (uint8_t)( op == 0x2A ? 0x43 : 0x4B ), R_L } ); // inc/dec word [rbx+HL]
+            }
+            return true;
+
+        case 0x36: // LD (HL),n
+            slow = a.label();
+            a.bytes( { 0xB1, imm8 } ); // mov cl, n
+            address16( a, R_L );
+            store( a, slow );
+            return true;
+
+        case 0xEA: // LD (nn),A
+            if ( imm16 >= 0xFF00 ) {
+                return false;
+            }
+            slow = a.label();
+            a.bytes( { 0x0F, 0xB6, 0x4B, R_A } ); // movzx ecx, byte [rbx+A]
+            address_imm( a, imm16 );
+            store( a, slow );
+            return true;
+
+        case 0xFA: // LD A,(nn)
+            if ( imm16 >= 0xFF00 ) {
+                return false;
+            }
+            slow = a.label();
+            address_imm( a, imm16 );
+            load( a, slow );
+            a.bytes( { 0x88, 0x4B, R_A } ); // mov [rbx+A], cl
+            return true;
+
+        case 0xC6: case 0xCE: case 0xD6: case 0xDE: case 0xE6: case 0xEE: case 0xF6: case 0xFE: // ALU A,n
+            a.bytes( { 0xB1, imm8 } ); // mov cl, n
+            alu( a, ( op >> 3 ) & 7 );
+            return true;
+
+        case 0x18: // JR e
+            branched = true;
+            branch( a, 0, false, (uint16_t)( next + (int8_t)imm8 ), info.cycles_taken, next, info.cycles, n );
+            return true;
+
+        case 0x20: case 0x28: case 0x30: case 0x38: // JR cc,e
+            branched = true;
+            branch( a, op < 0x30 ? 0x80 : 0x10, op & 0x08, (uint16_t)( next + (int8_t)imm8 ), info.cycles_taken, next, info.cycles, n );
+            return true;
+
+        case 0xC3: // JP nn
+            branched = true;
+            branch( a, 0, false, imm16, info.cycles_taken, next, info.cycles, n );
+            return true;
+
+        case 0xC2: case 0xCA: case 0xD2: case 0xDA: // JP cc,nn
+            branched = true;
+            branch( a, op < 0xD0 ? 0x80 : 0x10, op & 0x08, imm16, info.cycles_taken, next, info.cycles, n );
+            return true;
+
+        case 0xE9: // JP (HL)
+            branched = true;
+            a.bytes( { 0x0F, 0xB7, 0x43, R_L } ); // movzx eax, word [rbx+HL]
+            a.bytes( { 0x66, 0x89, 0x43, R_PC } ); // mov word [rbx+PC], ax
+            a.bytes( { 0x41, 0x83, 0xED, info.cycles } ); // sub r13d, cycles
+            a.bytes( { 0x41, 0x83, 0xC6, (uint8_t)n } ); // add r14d, n
+            a.jmp_to( thunk_dispatch );
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+    // Makes the arena pages holding bytes from to to writable, or executable again.
+    // False when the system refuses.
+    bool protect( size_t from, size_t to, bool writable )
+    {
+        const size_t PAGE = 0x1000;
+        from &= ~( PAGE - 1 );
+        to = ( to + PAGE - 1 ) & ~( PAGE - 1 );
+#ifdef _WIN32
+        DWORD old;
+        return VirtualProtect( arena + from, to - from, writable ? PAGE_READWRITE : PAGE_EXECUTE_READ, &old ) != 0;
+#else
+        return mprotect( arena + from, to - from, writable ? PROT_READ | PROT_WRITE : PROT_READ | PROT_EXEC ) == 0;
+#endif
+    }
+
+    void unmap( void )
+    {
+        if ( arena ) {
+#ifdef _WIN32
+            VirtualFree( arena, 0, MEM_RELEASE );
+#else
+            munmap( arena, ARENA_SIZE );
+#endif
+            arena = nullptr;
+        }
+    }
+
+    // Translates the block starting at pc and returns its code. Null when there is no
+    // arena, or when it couldn't be made writable or executable again, which gives the
+    // arena up for good.
+    const uint8_t* translate( Memory* m, uint16_t pc )
+    {
+        if ( !arena ) {
+            return nullptr;
+        }
+        if ( used + MAX_BLOCK_CODE > ARENA_SIZE || blocks.size() >= 0xFFFFFF ) {
+            flush();
+        }
+        size_t start = used;
+        if ( !protect( start, start + MAX_BLOCK_CODE, true ) ) {
+            unmap();
+            flush();
+            return nullptr;
+        }
+
+        Assembler a( arena, used );
+        std::vector<std::pair<int, uint32_t>> stubs; // label, count << 16 | PC to leave with
+        std::vector<std::pair<int, uint32_t>> slows; // label, count << 16 | PC of the instruction, continue label in conts
+        std::vector<int> conts;
+
+        Block block;
+        block.code = &arena[used];
+        block.pc = pc;
+        block.bank = switchable( pc ) ? m->rom_bank : 0;
+        block.valid = true;
+
+        // Leaves with PC untouched when another bank is mapped in
+        if ( switchable( pc ) ) {
+            a.bytes( { 0x66, 0x81, 0xBD } ); // cmp word [rbp+rom_bank], bank
+            a.u32( (uint32_t)offsetof( Memory, rom_bank ) );
+            a.u16( block.bank );
+            a.jcc_to( JNE, thunk_exit );
+        }
+
+        // A block stays inside one bank region and never wraps around 0xFFFF
+        uint32_t limit = pc < 0x4000 ? 0x4000 : pc < 0x8000 ? 0x8000 : 0x10000;
+        uint32_t addr = pc;
+        bool branched = false;
+        int n = 0;
+
+        while ( n < MAX_BLOCK && addr < limit && !branched ) {
+            uint8_t op = m->peek( (uint16_t)addr );
+            uint16_t next = (uint16_t)( addr + optable[op].length );
+            int slow, cycles;
+
+            // Operands wrapping around 0xFFFF are left to step() as well
+            n++;
+            if ( op != 0xCB && addr + optable[op].length <= 0x10000 && translate_op( a, m, (uint16_t)addr, op, n, branched, slow, cycles ) ) {
+                if ( !branched ) {
+                    account( a, cycles, n, next, stubs );
+                }
+                if ( slow >= 0 ) {
+                    int cont = a.label();
+                    a.bind( cont );
+                    slows.push_back( { slow, ( (uint32_t)n << 16 ) | (uint16_t)addr } );
+                    conts.push_back( cont );
+                }
+            }
+            else {
+                branched = optable[op].ends_block();
+                call_step( a, (uint16_t)addr );
+                account_step( a, n );
+                if ( branched ) {
+                    a.bytes( { 0x41, 0x83, 0xC6, (uint8_t)n } ); // add r14d, n
+                    a.jmp_to( thunk_dispatch );
+                }
+            }
+
+            addr += optable[op].length;
+        }
+
+        if ( !branched ) {
+            finish( a, (uint16_t)addr, 0, n );
+        }
+        block.end = addr < 0x10000 ? addr : 0x10000;
+
+        // Out of line: budget spent after an instruction
+        for ( auto& stub : stubs ) {
+            a.bind( stub.first );
+            a.bytes( { 0x66, 0xC7, 0x43, R_PC } ); // mov word [rbx+PC], next
+            a.u16( (uint16_t)stub.second );
+            a.bytes( { 0x41, 0x83, 0xC6, (uint8_t)( stub.second >> 16 ) } ); // add r14d, n
+            a.jmp_to( thunk_exit );
+        }
+
+        // Out of line: memory access the translated code does not handle
+        for ( size_t i = 0; i < slows.size(); i++ ) {
+            a.bind( slows[i].first );
+            call_step( a, (uint16_t)slows[i].second );
+            account_step( a, slows[i].second >> 16 );
+            a.jmp( conts[i] );
+        }
+
+        a.resolve();
+        used = a.pos;
+        if ( !protect( start, start + MAX_BLOCK_CODE, false ) ) {
+            unmap();
+            flush();
+            return nullptr;
+        }
+
+        blocks.push_back( block );
+        entry[pc] = block.code;
+        if ( switchable( pc ) ) {
+            entry_bank[pc] = block.bank;
+            banked[( (uint32_t)block.bank << 16 ) | pc] = (uint32_t)blocks.size() - 1;
+        }
+
+        // Filed under the page writes land on, code run from echo RAM under work RAM
+        for ( uint32_t i = pc >> PAGE_SHIFT; i <= ( block.end - 1 ) >> PAGE_SHIFT; i++ ) {
+            uint16_t page = Memory::canonical( (uint16_t)( i << PAGE_SHIFT ) ) >> PAGE_SHIFT;
+            page_blocks[page].push_back( (uint32_t)blocks.size() - 1 );
+            tables.code[page] = 1;
+        }
+
+        return block.code;
+    }
+
+    // enter( Frame* f, const uint8_t* code ), shared exit and dispatch
+    void emit_thunk( void )
+    {
+        Assembler a( arena, 0 );
+
+        a.bytes( { 0x53, 0x55, 0x41, 0x54, 0x41, 0x55, 0x41, 0x56, 0x41, 0x57 } ); // push rbx, rbp, r12-r15
+#ifdef _WIN32
+        a.bytes( { 0x48, 0x83, 0xEC, 40 } ); // sub rsp, 40 (shadow space, alignment)
+        a.bytes( { 0x49, 0x89, 0xCC } ); // mov r12, rcx
+        a.bytes( { 0x48, 0x89, 0xD0 } ); // mov rax, rdx
+#else
+        a.bytes( { 0x48, 0x83, 0xEC, 8 } ); // sub rsp, 8 (alignment)
+        a.bytes( { 0x49, 0x89, 0xFC } ); // mov r12, rdi
+        a.bytes( { 0x48, 0x89, 0xF0 } ); // mov rax, rsi
+#endif
+        a.bytes( { 0x49, 0x8B, 0x5C, 0x24, (uint8_t)offsetof( Frame, r ) } ); // mov rbx, [r12+r]
+        a.bytes( { 0x49, 0x8B, 0x6C, 0x24, (uint8_t)offsetof( Frame, m ) } ); // mov rbp, [r12+m]
+        a.bytes( { 0x4D, 0x8B, 0x7C, 0x24, (uint8_t)offsetof( Frame, tables ) } ); // mov r15, [r12+tables]
+        a.bytes( { 0x45, 0x8B, 0x6C, 0x24, (uint8_t)offsetof( Frame, remaining ) } ); // mov r13d, [r12+remaining]
+        a.bytes( { 0x45, 0x31, 0xF6 } ); // xor r14d, r14d
+        a.bytes( { 0xFF, 0xE0 } ); // jmp rax
+
+        int exit = a.label();
+
+        thunk_dispatch = a.pos;
+        a.bytes( { 0x45, 0x85, 0xED } ); // test r13d, r13d
+        a.jcc( JLE, exit );
+        a.bytes( { 0x49, 0x8B, 0x54, 0x24, (uint8_t)offsetof( Frame, entry ) } ); // mov rdx, [r12+entry]
+        a.bytes( { 0x48, 0x85, 0xD2 } ); // test rdx, rdx
+        a.jcc( JE, exit );
+        a.bytes( { 0x0F, 0xB7, 0x43, R_PC } ); // movzx eax, word [rbx+PC]
+        a.bytes( { 0x48, 0x8B, 0x04, 0xC2 } ); // mov rax, [rdx+rax*8]
+        a.bytes( { 0x48, 0x85, 0xC0 } ); // test rax, rax
+        a.jcc( JE, exit );
+        a.bytes( { 0xFF, 0xE0 } ); // jmp rax
+
+        a.bind( exit );
+        thunk_exit = a.pos;
+        a.bytes( { 0x45, 0x89, 0x6C, 0x24, (uint8_t)offsetof( Frame, remaining ) } ); // mov [r12+remaining], r13d
+        a.bytes( { 0x45, 0x89, 0x74, 0x24, (uint8_t)offsetof( Frame, count ) } ); // mov [r12+count], r14d
+#ifdef _WIN32
+        a.bytes( { 0x48, 0x83, 0xC4, 40 } ); // add rsp, 40
+#else
+        a.bytes( { 0x48, 0x83, 0xC4, 8 } ); // add rsp, 8
+#endif
+        a.bytes( { 0x41, 0x5F, 0x41, 0x5E, 0x41, 0x5D, 0x41, 0x5C, 0x5D, 0x5B } ); // pop r15-r12, rbp, rbx
+        a.u8( 0xC3 ); // ret
+        a.resolve();
+
+        used = thunk_base = ( a.pos + 63 ) & ~(size_t)63;
+        enter = ( void ( * )( Frame*, const uint8_t* ) )arena;
+    }
+
+    // Enters the machine code once, chaining blocks while chain is set. Without an
+    // arena, one instruction through step() instead.
+    int execute( Memory* m, Registers* r, StepState& sstate, int remaining, int* executed, bool chain )
+    {
+        const uint8_t* code = lookup( m, r->PC );
+        if ( !code ) {
+            *executed = 1;
+            return step( m, r, sstate );
+        }
+
+        Frame f = { r, m, &tables, chain ? entry.data() : nullptr, this, &sstate, remaining, 0 };
+        r->sync_flags();
+        leave = false;
+        enter( &f, code );
+
+        *executed = f.count;
+        return remaining - f.remaining;
+    }
+
+public:
+    Jit( void )
+        : arena( nullptr ), used( 0 ), thunk_exit( 0 ), thunk_dispatch( 0 ), thunk_base( 0 ), enter( nullptr ), entry( 0x10000 ), entry_bank( 0x10000 ), leave( false )
+    {
+#ifdef _WIN32
+        arena = (uint8_t*)VirtualAlloc( nullptr, ARENA_SIZE, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE );
+#else
+        void* p = mmap( nullptr, ARENA_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+        arena = p == MAP_FAILED ? nullptr : (uint8_t*)p;
+#endif
+
+        for ( int ah = 0; ah < 0x100; ah++ ) {
+            tables.flags[ah] = ( ah & 0x40 ? 0x80 : 0 ) | ( ah & 0x10 ? 0x20 : 0 ) | ( ah & 0x01 ? 0x10 : 0 );
+        }
+        memset( tables.code, 0, sizeof( tables.code ) );
+
+        if ( arena ) {
+            emit_thunk();
+            // A system that doesn't allow executable pages at all says so here
+            if ( !protect( 0, ARENA_SIZE, false ) ) {
+                unmap();
+            }
+        }
+    }
+
+    ~Jit( void )
+    {
+        unmap();
+    }
+
+    Jit( const Jit& ) = delete;
+    Jit& operator=( const Jit& ) = delete;
+
+    // False when the arena could not be allocated or made executable
+    bool available( void )
+    {
+        return arena != nullptr;
+    }
+
+    // Drops the blocks decoded from length bytes at address, for memory changed
+    // behind the cache's back when only a few pages did, instead of flush()
+    void invalidate_range( uint16_t address, uint32_t length )
+    {
+        uint32_t last = ( address + length - 1 ) >> PAGE_SHIFT;
+        for ( uint32_t i = address >> PAGE_SHIFT; i <= last && i < PAGES; i++ ) {
+            uint32_t page = Memory::canonical( (uint16_t)( i << PAGE_SHIFT ) ) >> PAGE_SHIFT;
+            if ( tables.code[page] ) {
+                invalidate( page );
+            }
+        }
+    }
+
+    // Forgets every translated block
+    void flush( void )
+    {
+        used = thunk_base;
+        blocks.clear();
+        banked.clear();
+        std::fill( entry.begin(), entry.end(), nullptr );
+        for ( int page = 0; page < PAGES; page++ ) {
+            page_blocks[page].clear();
+        }
+        memset( tables.code, 0, sizeof( tables.code ) );
+    }
+
+    // Same contract as Interpreter::run: at least budget T-cycles, overshooting by at
+    // most one instruction, stopping early when HALT or STOP set sstate to STOP.
+    int run( Memory* m, Registers* r, StepState& sstate, int budget, int* executed = nullptr )
+    {
+        int spent = 0;
+        int count = 0;
+
+        while ( spent < budget && sstate != StepState::STOP ) {
+            int n = 0;
+            spent += execute( m, r, sstate, budget - spent, &n, true );
+            count += n;
+        }
+
+        if ( executed ) {
+            *executed = count;
+        }
+
+        return spent;
+    }
+
+    // Runs a single block without chaining, for lockstep testing against the interpreter
+    int run_block( Memory* m, Registers* r, StepState& sstate, int budget, int* executed )
+    {
+        return execute( m, r, sstate, budget, executed, false );
+    }
+};
+
+static_assert( offsetof( Registers, AF ) == 0, "JIT register offsets" );
+static_assert( offsetof( Registers, BC ) == 2, "JIT register offsets" );
+static_assert( offsetof( Registers, DE ) == 4, "JIT register offsets" );
+static_assert( offsetof( Registers, HL ) == 6, "JIT register offsets" );
+static_assert( offsetof( Registers, SP ) == 8, "JIT register offsets" );
+static_assert( offsetof( Registers, PC ) == 10, "JIT register offsets" );
+
+#endif
@@ -0,0 +1,802 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <bitset>
+#include <vector>
+#include "memory.h"
+#include "registers.h"
+#include "cartridge.h"
+#include "interpreter.h"
+#include "optable.h"
+#include "shared.h"
+
+#if defined( __AVX2__ )
+#include <immintrin.h>
+#define GB_LOCKSTEP_AVX2 1
+#else
+#define GB_LOCKSTEP_AVX2 0
+#endif
+
+#if !GB_LOCKSTEP_AVX2 && ( defined( __SSE2__ ) || defined( _M_X64 ) )
+#include <emmintrin.h>
+#define GB_LOCKSTEP_SSE2 1
+#else
+#define GB_LOCKSTEP_SSE2 0
+#endif
+
+// Experimental: many instances of one ROM stepped together, for searches and
+// training runs that play the same game thousands of times with different input.
+//
+// The CPU registers of all instances are kept in structure-of-arrays form, one
+// 16-bit slot per instance ("lane"), so one vector instruction works on 16 lanes.
+// Each step takes the first lane still running (the leader) and every lane at the
+// same PC with the same ROM banks mapped. Those are running the same instruction
+// from the same bytes, and the step executes it for all of them at once:
+//
+//   vector    register-only instructions: loads, 8-bit ALU, INC/DEC, JR/JP,
+//             with conditional jumps and their cycles resolved per lane
+//   gathered  loads and stores, the register side in vector form and the memory
+//             access lane by lane through each instance's own Memory
+//   scalar    everything else, including code run from RAM, goes lane by lane
+//             through Interpreter::run in a Registers copy
+//
+// Lanes that branched elsewhere wait at their PC and join the group again when the
+// leader comes by. Every instance has its own Memory and Cartridge over the shared
+// ROM image, and ends up exactly where Interpreter::run would have taken it.
+//
+// Build with AVX2 enabled (-mavx2, /arch:AVX2) for 256-bit vectors. Other x86-64
+// builds take two SSE2 halves, anything else plain loops.
+
+// 16 lanes of 16 bits. Masks have all bits of a lane set or clear.
+struct LaneVec {
+    static const int WIDTH = 16;
+
+#if GB_LOCKSTEP_AVX2
+    __m256i v;
+
+    static LaneVec load( const uint16_t* p )
+    {
+        return { _mm256_loadu_si256( (const __m256i*)p ) };
+    }
+
+    void store( uint16_t* p ) const
+    {
+        _mm256_storeu_si256( (__m256i*)p, v );
+    }
+
+    static LaneVec splat( uint16_t x )
+    {
+        return { _mm256_set1_epi16( (short)x ) };
+    }
+
+    LaneVec operator+( LaneVec b ) const
+    {
+        return { _mm256_add_epi16( v, b.v ) };
+    }
+
+    LaneVec operator-( LaneVec b ) const
+    {
+        return { _mm256_sub_epi16( v, b.v ) };
+    }
+
+    LaneVec operator&( LaneVec b ) const
+    {
+        return { _mm256_and_si256( v, b.v ) };
+    }
+
+    LaneVec operator|( LaneVec b ) const
+    {
+        return { _mm256_or_si256( v, b.v ) };
+    }
+
+    LaneVec operator^( LaneVec b ) const
+    {
+        return { _mm256_xor_si256( v, b.v ) };
+    }
+
+    LaneVec operator>>( int n ) const
+    {
+        return { _mm256_srl_epi16( v, _mm_cvtsi32_si128( n ) ) };
+    }
+
+    LaneVec operator<<( int n ) const
+    {
+        return { _mm256_sll_epi16( v, _mm_cvtsi32_si128( n ) ) };
+    }
+
+    LaneVec eq( LaneVec b ) const
+    {
+        return { _mm256_cmpeq_epi16( v, b.v ) };
+    }
+
+    // Signed
+    LaneVec gt( LaneVec b ) const
+    {
+        return { _mm256_cmpgt_epi16( v, b.v ) };
+    }
+
+    // a where mask is set, b elsewhere
+    static LaneVec select( LaneVec mask, LaneVec a, LaneVec b )
+    {
+        return { _mm256_blendv_epi8( b.v, a.v, mask.v ) };
+    }
+
+    // Two bits per lane, lane i at bits 2i and 2i+1
+    uint32_t bits( void ) const
+    {
+        return (uint32_t)_mm256_movemask_epi8( v );
+    }
+#elif GB_LOCKSTEP_SSE2
+    __m128i lo, hi;
+
+    template <typename F>
+    LaneVec both( LaneVec b, F f ) const
+    {
+        return { f( lo, b.lo ), f( hi, b.hi ) };
+    }
+
+    static LaneVec load( const uint16_t* p )
+    {
+        return { _mm_loadu_si128( (const __m128i*)p ), _mm_loadu_si128( (const __m128i*)( p + 8 ) ) };
+    }
+
+    void store( uint16_t* p ) const
+    {
+        _mm_storeu_si128( (__m128i*)p, lo );
+        _mm_storeu_si128( (__m128i*)( p + 8 ), hi );
+    }
+
+    static LaneVec splat( uint16_t x )
+    {
+        __m128i v = _mm_set1_epi16( (short)x );
+        return { v, v };
+    }
+
+    LaneVec operator+( LaneVec b ) const
+    {
+        return both( b, []( __m128i x, __m128i y ) { return _mm_add_epi16( x, y ); } );
+    }
+
+    LaneVec operator-( LaneVec b ) const
+    {
+        return both( b, []( __m128i x, __m128i y ) { return _mm_sub_epi16( x, y ); } );
+    }
+
+    LaneVec operator&( LaneVec b ) const
+    {
+        return both( b, []( __m128i x, __m128i y ) { return _mm_and_si128( x, y ); } );
+    }
+
+    LaneVec operator|( LaneVec b ) const
+    {
+        return both( b, []( __m128i x, __m128i y ) { return _mm_or_si128( x, y ); } );
+    }
+
+    LaneVec operator^( LaneVec b ) const
+    {
+        return both( b, []( __m128i x, __m128i y ) { return _mm_xor_si128( x, y ); } );
+    }
+
+    LaneVec operator>>( int n ) const
+    {
+        __m128i count = _mm_cvtsi32_si128( n );
+        return { _mm_srl_epi16( lo, count ), _mm_srl_epi16( hi, count ) };
+    }
+
+    LaneVec operator<<( int n ) const
+    {
+        __m128i count = _mm_cvtsi32_si128( n );
+        return { _mm_sll_epi16( lo, count ), _mm_sll_epi16( hi, count ) };
+    }
+
+    LaneVec eq( LaneVec b ) const
+    {
+        return both( b, []( __m128i x, __m128i y ) { return _mm_cmpeq_epi16( x, y ); } );
+    }
+
+    LaneVec gt( LaneVec b ) const
+    {
+        return both( b, []( __m128i x, __m128i y ) { return _mm_cmpgt_epi16( x, y ); } );
+    }
+
+    static LaneVec select( LaneVec mask, LaneVec a, LaneVec b )
+    {
+        return { _mm_or_si128( _mm_and_si128( mask.lo, a.lo ), _mm_andnot_si128( mask.lo, b.lo ) ),
+                 _mm_or_si128( _mm_and_si128( mask.hi, a.hi ), _mm_andnot_si128( mask.hi, b.hi ) ) };
+    }
+
+    uint32_t bits( void ) const
+    {
+        return (uint32_t)_mm_movemask_epi8( lo ) | ( (uint32_t)_mm_movemask_epi8( hi ) << 16 );
+    }
+#else
+    uint16_t v[WIDTH];
+
+    template <typename F>
+    static LaneVec map( F f )
+    {
+        LaneVec r;
+        for ( int i = 0; i < WIDTH; i++ ) {
+            r.v[i] = (uint16_t)f( i );
+        }
+        return r;
+    }
+
+    static LaneVec load( const uint16_t* p )
+    {
+        LaneVec r;
+        memcpy( r.v, p, sizeof( r.v ) );
+        return r;
+    }
+
+    void store( uint16_t* p ) const
+    {
+        memcpy( p, v, sizeof( v ) );
+    }
+
+    static LaneVec splat( uint16_t x )
+    {
+        return map( [x]( int ) { return x; } );
+    }
+
+    LaneVec operator+( LaneVec b ) const
+    {
+        return map( [&]( int i ) { return v[i] + b.v[i]; } );
+    }
+
+    LaneVec operator-( LaneVec b ) const
+    {
+        return map( [&]( int i ) { return v[i] - b.v[i]; } );
+    }
+
+    LaneVec operator&( LaneVec b ) const
+    {
+        return map( [&]( int i ) { return v[i] & b.v[i]; } );
+    }
+
+    LaneVec operator|( LaneVec b ) const
+    {
+        return map( [&]( int i ) { return v[i] | b.v[i]; } );
+    }
+
+    LaneVec operator^( LaneVec b ) const
+    {
+        return map( [&]( int i ) { return v[i] ^ b.v[i]; } );
+    }
+
+    LaneVec operator>>( int n ) const
+    {
+        return map( [&]( int i ) { return v[i] >> n; } );
+    }
+
+    LaneVec operator<<( int n ) const
+    {
+        return map( [&]( int i ) { return v[i] << n; } );
+    }
+
+    LaneVec eq( LaneVec b ) const
+    {
+        return map( [&]( int i ) { return v[i] == b.v[i] ? 0xFFFF : 0; } );
+    }
+
+    LaneVec gt( LaneVec b ) const
+    {
+        return map( [&]( int i ) { return (int16_t)v[i] > (int16_t)b.v[i] ? 0xFFFF : 0; } );
+    }
+
+    static LaneVec select( LaneVec mask, LaneVec a, LaneVec b )
+    {
+        return map( [&]( int i ) { return ( a.v[i] & mask.v[i] ) | ( b.v[i] & ~mask.v[i] ); } );
+    }
+
+    uint32_t bits( void ) const
+    {
+        uint32_t r = 0;
+        for ( int i = 0; i < WIDTH; i++ ) {
+            r |= ( v[i] ? 3u : 0u ) << ( i * 2 );
+        }
+        return r;
+    }
+#endif
+};
+
+class Lockstep
+{
+private:
+    enum Reg { R_B, R_C, R_D, R_E, R_H, R_L, R_HL_IND, R_A, R_F, R_SP, R_PC, REGS };
+
+    const uint8_t* rom;
+    size_t lanes; // instances
+    size_t padded; // lanes rounded up to whole LaneVecs
+
+    // SoA state, padded lanes are never live
+    std::vector<uint16_t> reg[REGS]; // 8-bit registers hold 0-255
+    std::vector<uint16_t> left; // M-cycles left in this run, signed, overshoot goes negative
+    std::vector<uint16_t> halted; // mask, stopped by HALT or STOP
+    std::vector<uint16_t> bank_low; // ROM banks mapped at 0x0000 and 0x4000, mirrored from Memory
+    std::vector<uint16_t> bank_high;
+    std::vector<uint16_t> group; // mask of the lanes the current step runs
+    std::vector<uint16_t> operand; // gathered ALU operands
+
+    std::vector<Memory*> mems;
+    std::vector<Cartridge*> carts;
+
+    static int ctz( uint32_t x )
+    {
+#ifdef _MSC_VER
+        unsigned long i;
+        _BitScanForward( &i, x );
+        return (int)i;
+#else
+        return __builtin_ctz( x );
+#endif
+    }
+
+    uint16_t* r( int index )
+    {
+        return reg[index].data();
+    }
+
+    // Calls f( lane ) for every lane set in a bits() mask of the LaneVec at first
+    template <typename F>
+    static void each_lane( size_t first, uint32_t bits, F f )
+    {
+        while ( bits ) {
+            int bit = ctz( bits );
+            f( first + bit / 2 );
+            bits &= ~( 3u << bit );
+        }
+    }
+
+    // Calls f( first, mask ) for every LaneVec with a lane in the group
+    template <typename F>
+    void each_group( size_t from, F f )
+    {
+        for ( size_t c = from; c < padded; c += LaneVec::WIDTH ) {
+            LaneVec sel = LaneVec::load( &group[c] );
+            if ( sel.bits() ) {
+                f( c, sel );
+            }
+        }
+    }
+
+    void sync_banks( size_t lane )
+    {
+        bank_low[lane] = (uint16_t)( ( mems[lane]->read_page[0x00] - rom ) / 0x4000 );
+        bank_high[lane] = mems[lane]->rom_bank;
+    }
+
+    // Every lane in the group moves on by length and spends cycles
+    void retire( size_t c, LaneVec sel, uint16_t pc, int length, int cycles )
+    {
+        LaneVec::select( sel, LaneVec::splat( (uint16_t)( pc + length ) ), LaneVec::load( &r( R_PC )[c] ) )
+            .store( &r( R_PC )[c] );
+        LaneVec::select( sel, LaneVec::load( &left[c] ) - LaneVec::splat( (uint16_t)( cycles / 4 ) ),
+                         LaneVec::load( &left[c] ) )
+            .store( &left[c] );
+    }
+
+    static LaneVec flag_bits( LaneVec z, LaneVec n, LaneVec h, LaneVec c )
+    {
+        return ( z & LaneVec::splat( 0x80 ) ) | ( n & LaneVec::splat( 0x40 ) ) | ( h & LaneVec::splat( 0x20 ) ) |
+               ( c & LaneVec::splat( 0x10 ) );
+    }
+
+    // ADD ADC SUB SBC AND XOR OR CP of A and b, as Instruction does them with eager flags
+    void alu( size_t c, LaneVec sel, int op, LaneVec b )
+    {
+        const LaneVec zero = LaneVec::splat( 0 ), ones = LaneVec::splat( 0xFFFF );
+        const LaneVec nibble = LaneVec::splat( 0xF ), byte = LaneVec::splat( 0xFF );
+        LaneVec a = LaneVec::load( &r( R_A )[c] );
+        LaneVec f = LaneVec::load( &r( R_F )[c] );
+        LaneVec carry = ( f >> 4 ) & LaneVec::splat( 1 );
+        LaneVec result, n = zero, h = zero, cy = zero;
+
+        switch ( op ) {
+        case 0: // ADD
+        case 1: // ADC
+            if ( op == 0 ) {
+                carry = zero;
+            }
+            result = a + b + carry;
+            h = ( ( a & nibble ) + ( b & nibble ) + carry ).gt( nibble );
+            cy = result.gt( byte );
+            break;
+        case 2: // SUB
+        case 3: // SBC
+        case 7: // CP
+            if ( op != 3 ) {
+                carry = zero;
+            }
+            result = a - b - carry;
+            n = ones;
+            h = ( ( b & nibble ) + carry ).gt( a & nibble );
+            cy = ( b + carry ).gt( a );
+            break;
+        case 4: // AND
+            result = a & b;
+            h = ones;
+            break;
+        case 5: // XOR
+            result = a ^ b;
+            break;
+        default: // OR
+            result = a | b;
+            break;
+        }
+
+        result = result & byte;
+        f = ( f & nibble ) | flag_bits( result.eq( zero ), n, h, cy );
+        LaneVec::select( sel, f, LaneVec::load( &r( R_F )[c] ) ).store( &r( R_F )[c] );
+        if ( op != 7 ) {
+            LaneVec::select( sel, result, a ).store( &r( R_A )[c] );
+        }
+    }
+
+    // Condition cc of JR/JP cc per lane: NZ, Z, NC, C
+    static LaneVec condition( LaneVec f, int cc )
+    {
+        LaneVec bit = f & LaneVec::splat( cc < 2 ? 0x80 : 0x10 );
+        LaneVec clear = bit.eq( LaneVec::splat( 0 ) );
+        return ( cc & 1 ) ? clear ^ LaneVec::splat( 0xFFFF ) : clear;
+    }
+
+    void jump( uint16_t op, uint16_t pc, uint16_t target, int cc )
+    {
+        const OpInfo& info = optable[op];
+        each_group( 0, [&]( size_t c, LaneVec sel ) {
+            LaneVec taken = cc < 0 ? sel : sel & condition( LaneVec::load( &r( R_F )[c] ), cc );
+            LaneVec pcs = LaneVec::select( sel, LaneVec::splat( (uint16_t)( pc + info.length ) ),
+                                           LaneVec::load( &r( R_PC )[c] ) );
+            LaneVec::select( taken, LaneVec::splat( target ), pcs ).store( &r( R_PC )[c] );
+
+            LaneVec spent = LaneVec::select( taken, LaneVec::splat( info.cycles_taken / 4 ),
+                                             LaneVec::splat( info.cycles / 4 ) );
+            LaneVec::select( sel, LaneVec::load( &left[c] ) - spent, LaneVec::load( &left[c] ) ).store( &left[c] );
+        } );
+    }
+
+    // One instruction of lane i in a Registers copy
+    void scalar( size_t i )
+    {
+        Registers regs;
+        regs.A = (uint8_t)r( R_A )[i];
+        regs.F = (uint8_t)r( R_F )[i];
+        regs.B = (uint8_t)r( R_B )[i];
+        regs.C = (uint8_t)r( R_C )[i];
+        regs.D = (uint8_t)r( R_D )[i];
+        regs.E = (uint8_t)r( R_E )[i];
+        regs.H = (uint8_t)r( R_H )[i];
+        regs.L = (uint8_t)r( R_L )[i];
+        regs.SP = r( R_SP )[i];
+        regs.PC = r( R_PC )[i];
+
+        StepState sstate = StepState::RUN;
+        int spent = Interpreter::run( mems[i], &regs, sstate, 1 );
+        set_registers( i, regs );
+
+        left[i] = (uint16_t)( left[i] - spent / 4 );
+        if ( sstate == StepState::STOP ) {
+            halted[i] = 0xFFFF;
+        }
+        sync_banks( i );
+    }
+
+    // Loads and stores: address and value per lane, in lane order
+    template <typename F>
+    void gathered( uint16_t pc, int length, int cycles, F access )
+    {
+        each_group( 0, [&]( size_t c, LaneVec sel ) {
+            each_lane( c, sel.bits(), access );
+            retire( c, sel, pc, length, cycles );
+        } );
+    }
+
+    void write( size_t i, uint16_t address, uint8_t value )
+    {
+        mems[i]->write8( address, value );
+        if ( address < 0x8000 ) {
+            sync_banks( i );
+        }
+    }
+
+    uint16_t pair( size_t i, int hi )
+    {
+        return (uint16_t)( ( r( hi )[i] << 8 ) | r( hi + 1 )[i] );
+    }
+
+    void set_pair( size_t i, int hi, uint16_t value )
+    {
+        r( hi )[i] = value >> 8;
+        r( hi + 1 )[i] = value & 0xFF;
+    }
+
+    // Runs the instruction at the leader's PC for every lane in the group, true when
+    // it took the vector or gathered path
+    bool step( size_t lead )
+    {
+        uint16_t pc = r( R_PC )[lead];
+        bool shared = pc < 0x8000; // the bytes come from the ROM image all lanes share
+        const std::vector<uint16_t>& bank = pc < 0x4000 ? bank_low : bank_high;
+        const LaneVec zero = LaneVec::splat( 0 ), ones = LaneVec::splat( 0xFFFF );
+        const LaneVec vpc = LaneVec::splat( pc ), vbank = LaneVec::splat( bank[lead] );
+
+        // Nothing before the leader is live
+        size_t from = lead & ~(size_t)( LaneVec::WIDTH - 1 );
+        std::fill( group.begin(), group.begin() + from, 0 );
+        for ( size_t c = from; c < padded; c += LaneVec::WIDTH ) {
+            LaneVec live = LaneVec::load( &left[c] ).gt( zero ) & ( LaneVec::load( &halted[c] ) ^ ones );
+            LaneVec sel = live & LaneVec::load( &r( R_PC )[c] ).eq( vpc );
+            if ( shared ) {
+                sel = sel & LaneVec::load( &bank[c] ).eq( vbank );
+            }
+            sel.store( &group[c] );
+        }
+
+        uint16_t op = mems[lead]->peek( pc );
+        uint8_t imm8 = mems[lead]->peek( (uint16_t)( pc + 1 ) );
+        uint16_t imm16 = (uint16_t)( imm8 | ( mems[lead]->peek( (uint16_t)( pc + 2 ) ) << 8 ) );
+        const OpInfo& info = optable[op];
+        int dst = ( op >> 3 ) & 7, src = op & 7;
+        int hi = ( op >> 4 ) * 2; // R_B, R_D, R_H of BC, DE, HL
+
+        if ( !shared ) {
+            op = 0x100; // scalar
+        }
+
+        if ( op == 0x00 ) { // NOP
+            each_group( from, [&]( size_t c, LaneVec sel ) { retire( c, sel, pc, info.length, info.cycles ); } );
+        } else if ( ( op & 0xCF ) == 0x01 ) { // LD rr,nn
+            each_group( from, [&]( size_t c, LaneVec sel ) {
+                if ( hi == 6 ) {
+                    LaneVec::select( sel, LaneVec::splat( imm16 ), LaneVec::load( &r( R_SP )[c] ) ).store( &r( R_SP )[c] );
+                } else {
+                    LaneVec::select( sel, LaneVec::splat( imm16 >> 8 ), LaneVec::load( &r( hi )[c] ) ).store( &r( hi )[c] );
+                    LaneVec::select( sel, LaneVec::splat( imm16 & 0xFF ), LaneVec::load( &r( hi + 1 )[c] ) )
+                        .store( &r( hi + 1 )[c] );
+                }
+                retire( c, sel, pc, info.length, info.cycles );
+            } );
+        } else if ( ( op & 0xC7 ) == 0x03 ) { // INC rr, DEC rr
+            LaneVec delta = LaneVec::splat( ( op & 0x08 ) ? 0xFFFF : 1 );
+            each_group( from, [&]( size_t c, LaneVec sel ) {
+                if ( hi == 6 ) {
+                    LaneVec sp = LaneVec::load( &r( R_SP )[c] );
+                    LaneVec::select( sel, sp + delta, sp ).store( &r( R_SP )[c] );
+                } else {
+                    LaneVec h = LaneVec::load( &r( hi )[c] ), l = LaneVec::load( &r( hi + 1 )[c] );
+                    LaneVec value = ( ( h << 8 ) | l ) + delta;
+                    LaneVec::select( sel, value >> 8, h ).store( &r( hi )[c] );
+                    LaneVec::select( sel, value & LaneVec::splat( 0xFF ), l ).store( &r( hi + 1 )[c] );
+                }
+                retire( c, sel, pc, info.length, info.cycles );
+            } );
+        } else if ( op < 0x40 && ( op & 0x06 ) == 0x04 && dst != R_HL_IND ) { // INC r, DEC r
+            bool dec = op & 1;
+            each_group( from, [&]( size_t c, LaneVec sel ) {
+                LaneVec x = LaneVec::load( &r( dst )[c] );
+                LaneVec f = LaneVec::load( &r( R_F )[c] );
+                LaneVec result = ( x + LaneVec::splat( dec ? 0xFFFF : 1 ) ) & LaneVec::splat( 0xFF );
+                LaneVec z = dec ? x.eq( LaneVec::splat( 1 ) ) : x.eq( LaneVec::splat( 0xFF ) );
+                LaneVec h = ( x & LaneVec::splat( 0xF ) ).eq( LaneVec::splat( dec ? 0 : 0xF ) );
+                f = ( f & LaneVec::splat( 0x1F ) ) | flag_bits( z, dec ? ones : zero, h, zero );
+                LaneVec::select( sel, result, x ).store( &r( dst )[c] );
+                LaneVec::select( sel, f, LaneVec::load( &r( R_F )[c] ) ).store( &r( R_F )[c] );
+                retire( c, sel, pc, info.length, info.cycles );
+            } );
+        } else if ( op < 0x40 && ( op & 0x07 ) == 0x06 && dst != R_HL_IND ) { // LD r,n
+            each_group( from, [&]( size_t c, LaneVec sel ) {
+                LaneVec::select( sel, LaneVec::splat( imm8 ), LaneVec::load( &r( dst )[c] ) ).store( &r( dst )[c] );
+                retire( c, sel, pc, info.length, info.cycles );
+            } );
+        } else if ( op == 0x18 || ( op & 0xE7 ) == 0x20 ) { // JR e, JR cc,e
+            jump( op, pc, (uint16_t)( pc + info.length + (int8_t)imm8 ), op == 0x18 ? -1 : dst & 3 );
+        } else if ( op == 0xC3 || ( op & 0xE7 ) == 0xC2 ) { // JP nn, JP cc,nn
+            jump( op, pc, imm16, op == 0xC3 ? -1 : dst & 3 );
+        } else if ( op == 0x2F || op == 0x37 || op == 0x3F ) { // CPL, SCF, CCF
+            each_group( from, [&]( size_t c, LaneVec sel ) {
+                LaneVec a = LaneVec::load( &r( R_A )[c] );
+                LaneVec f = LaneVec::load( &r( R_F )[c] );
+                if ( op == 0x2F ) {
+                    LaneVec::select( sel, a ^ LaneVec::splat( 0xFF ), a ).store( &r( R_A )[c] );
+                    f = f | LaneVec::splat( 0x60 );
+                } else if ( op == 0x37 ) {
+                    f = ( f & LaneVec::splat( 0x8F ) ) | LaneVec::splat( 0x10 );
+                } else {
+                    f = ( f & LaneVec::splat( 0x9F ) ) ^ LaneVec::splat( 0x10 );
+                }
+                LaneVec::select( sel, f, LaneVec::load( &r( R_F )[c] ) ).store( &r( R_F )[c] );
+                retire( c, sel, pc, info.length, info.cycles );
+            } );
+        } else if ( op >= 0x40 && op < 0x80 && op != 0x76 ) { // LD r,r' LD r,(HL) LD (HL),r
+            if ( dst == R_HL_IND ) {
+                gathered( pc, info.length, info.cycles,
+                          [&]( size_t i ) { write( i, pair( i, R_H ), (uint8_t)r( src )[i] ); } );
+            } else if ( src == R_HL_IND ) {
+                gathered( pc, info.length, info.cycles,
+                          [&]( size_t i ) { r( dst )[i] = mems[i]->read8( pair( i, R_H ) ); } );
+            } else {
+                each_group( from, [&]( size_t c, LaneVec sel ) {
+                    LaneVec::select( sel, LaneVec::load( &r( src )[c] ), LaneVec::load( &r( dst )[c] ) )
+                        .store( &r( dst )[c] );
+                    retire( c, sel, pc, info.length, info.cycles );
+                } );
+            }
+        } else if ( op >= 0x80 && op < 0xC0 ) { // ALU A,r and A,(HL)
+            if ( src == R_HL_IND ) {
+                each_group( from, [&]( size_t c, LaneVec sel ) {
+                    each_lane( c, sel.bits(), [&]( size_t i ) { operand[i] = mems[i]->read8( pair( i, R_H ) ); } );
+                    alu( c, sel, dst, LaneVec::load( &operand[c] ) );
+                    retire( c, sel, pc, info.length, info.cycles );
+                } );
+            } else {
+                each_group( from, [&]( size_t c, LaneVec sel ) {
+                    alu( c, sel, dst, LaneVec::load( &r( src )[c] ) );
+                    retire( c, sel, pc, info.length, info.cycles );
+                } );
+            }
+        } else if ( op >= 0xC0 && ( op & 0x07 ) == 0x06 ) { // ALU A,n
+            each_group( from, [&]( size_t c, LaneVec sel ) {
+                alu( c, sel, dst, LaneVec::splat( imm8 ) );
+                retire( c, sel, pc, info.length, info.cycles );
+            } );
+        } else if ( op == 0xE0 ) { // LDH (n),A
+            gathered( pc, info.length, info.cycles,
+                      [&]( size_t i ) { write( i, (uint16_t)( 0xFF00 | imm8 ), (uint8_t)r( R_A )[i] ); } );
+        } else if ( op == 0xF0 ) { // LDH A,(n)
+            gathered( pc, info.length, info.cycles,
+                      [&]( size_t i ) { r( R_A )[i] = mems[i]->read8( (uint16_t)( 0xFF00 | imm8 ) ); } );
+        } else if ( op == 0xEA ) { // LD (nn),A
+            gathered( pc, info.length, info.cycles, [&]( size_t i ) { write( i, imm16, (uint8_t)r( R_A )[i] ); } );
+        } else if ( op == 0xFA ) { // LD A,(nn)
+            gathered( pc, info.length, info.cycles, [&]( size_t i ) { r( R_A )[i] = mems[i]->read8( imm16 ); } );
+        } else if ( op == 0x02 || op == 0x12 ) { // LD (BC),A LD (DE),A
+            gathered( pc, info.length, info.cycles,
+                      [&]( size_t i ) { write( i, pair( i, hi ), (uint8_t)r( R_A )[i] ); } );
+        } else if ( op == 0x0A || op == 0x1A ) { // LD A,(BC) LD A,(DE)
+            gathered( pc, info.length, info.cycles, [&]( size_t i ) { r( R_A )[i] = mems[i]->read8( pair( i, hi ) ); } );
+        } else if ( op == 0x22 || op == 0x32 ) { // LD (HL+),A LD (HL-),A
+            gathered( pc, info.length, info.cycles, [&]( size_t i ) {
+                uint16_t hl = pair( i, R_H );
+                write( i, hl, (uint8_t)r( R_A )[i] );
+                set_pair( i, R_H, (uint16_t)( op == 0x22 ? hl + 1 : hl - 1 ) );
+            } );
+        } else if ( op == 0x2A || op == 0x3A ) { // LD A,(HL+) LD A,(HL-)
+            gathered( pc, info.length, info.cycles, [&]( size_t i ) {
+                uint16_t hl = pair( i, R_H );
+                r( R_A )[i] = mems[i]->read8( hl );
+                set_pair( i, R_H, (uint16_t)( op == 0x2A ? hl + 1 : hl - 1 ) );
+            } );
+        } else {
+            each_group( from, [&]( size_t c, LaneVec sel ) { each_lane( c, sel.bits(), [&]( size_t i ) { scalar( i ); } ); } );
+            return false;
+        }
+
+        return true;
+    }
+
+public:
+    // Lane-instructions by path, since construction
+    uint64_t vector_steps;
+    uint64_t scalar_steps;
+
+    // count instances of a cartridge with rom_image, which has to outlive the
+    // Lockstep, started where the DMG boot ROM hands over like Emulator::load
+    Lockstep( const uint8_t* rom_image, size_t rom_size, Mbc mbc, size_t ram_size, size_t count )
+        : rom( rom_image ), lanes( count ), padded( ( count + LaneVec::WIDTH - 1 ) & ~(size_t)( LaneVec::WIDTH - 1 ) ),
+          vector_steps( 0 ), scalar_steps( 0 )
+    {
+        for ( std::vector<uint16_t>& v : reg ) {
+            v.assign( padded, 0 );
+        }
+        left.assign( padded, 0 );
+        halted.assign( padded, 0 );
+        bank_low.assign( padded, 0 );
+        bank_high.assign( padded, 0 );
+        group.assign( padded, 0 );
+        operand.assign( padded, 0 );
+
+        Registers start;
+        start.AF = 0x01B0;
+        start.BC = 0x0013;
+        start.DE = 0x00D8;
+        start.HL = 0x014D;
+        start.SP = 0xFFFE;
+        start.PC = 0x0100;
+
+        for ( size_t i = 0; i < lanes; i++ ) {
+            mems.push_back( new Memory() );
+            carts.push_back( new Cartridge( rom_image, rom_size, mbc, ram_size ) );
+            carts[i]->attach( mems[i] );
+            set_registers( i, start );
+            sync_banks( i );
+        }
+    }
+
+    ~Lockstep( void )
+    {
+        for ( size_t i = 0; i < lanes; i++ ) {
+            delete carts[i];
+            delete mems[i];
+        }
+    }
+
+    Lockstep( const Lockstep& ) = delete;
+    Lockstep& operator=( const Lockstep& ) = delete;
+
+    size_t count( void ) const
+    {
+        return lanes;
+    }
+
+    // Instance memory, for input and inspection. Writes to the MBC go through
+    // write8, or the bank mirror falls behind.
+    Memory* memory( size_t lane )
+    {
+        return mems[lane];
+    }
+
+    Registers registers( size_t lane )
+    {
+        Registers regs;
+        regs.A = (uint8_t)r( R_A )[lane];
+        regs.F = (uint8_t)r( R_F )[lane];
+        regs.B = (uint8_t)r( R_B )[lane];
+        regs.C = (uint8_t)r( R_C )[lane];
+        regs.D = (uint8_t)r( R_D )[lane];
+        regs.E = (uint8_t)r( R_E )[lane];
+        regs.H = (uint8_t)r( R_H )[lane];
+        regs.L = (uint8_t)r( R_L )[lane];
+        regs.SP = r( R_SP )[lane];
+        regs.PC = r( R_PC )[lane];
+        return regs;
+    }
+
+    void set_registers( size_t lane, Registers regs )
+    {
+        regs.sync_flags();
+        r( R_A )[lane] = regs.A;
+        r( R_F )[lane] = regs.F;
+        r( R_B )[lane] = regs.B;
+        r( R_C )[lane] = regs.C;
+        r( R_D )[lane] = regs.D;
+        r( R_E )[lane] = regs.E;
+        r( R_H )[lane] = regs.H;
+        r( R_L )[lane] = regs.L;
+        r( R_SP )[lane] = regs.SP;
+        r( R_PC )[lane] = regs.PC;
+    }
+
+    bool halted_lane( size_t lane ) const
+    {
+        return halted[lane] != 0;
+    }
+
+    // Runs every instance for n T-cycles, n a multiple of 4 below 0x1FF00. What an
+    // instance runs past the end is taken from its next run, as in
+    // Emulator::run_cycles, so each ends on the instruction Interpreter::run would.
+    void run_cycles( int n )
+    {
+        for ( size_t i = 0; i < lanes; i++ ) {
+            left[i] = (uint16_t)( left[i] + n / 4 );
+        }
+
+        size_t lead = 0;
+        for ( ;; ) {
+            while ( lead < lanes && ( (int16_t)left[lead] <= 0 || halted[lead] ) ) {
+                lead++;
+            }
+            if ( lead == lanes ) {
+                break;
+            }
+
+            bool vector = step( lead );
+            uint64_t stepped = 0;
+            for ( size_t c = lead & ~(size_t)( LaneVec::WIDTH - 1 ); c < padded; c += LaneVec::WIDTH ) {
+                stepped += std::bitset<32>( LaneVec::load( &group[c] ).bits() ).count() / 2;
+            }
+            ( vector ? vector_steps : scalar_steps ) += stepped;
+        }
+    }
+};
@@ -1,18 +1,15 @@
 #pragma once
-#include <Windows.h>
+#include <stddef.h>
 #include <stdint.h>
 
+// No constructor, Vram sits in the union that makes up Memory::map and is cleared
+// with it
 class Vram
 {
 private:
     uint8_t _ram[0x2000];
 
 public:
-    Vram( void )
-        : _ram{ 0 }
-    {
-    }
-
     uint8_t* ram( void )
     {
         return _ram;
@@ -39,6 +36,41 @@ public:
     }
 };
 
+#ifdef _MSC_VER
+#define GB_NOINLINE __declspec( noinline )
+#define GB_LIKELY( x ) ( x )
+#else
+#define GB_NOINLINE __attribute__( ( noinline ) )
+#define GB_LIKELY( x ) __builtin_expect( !!( x ), 1 )
+#endif
+
+struct Memory;
+class Cartridge;
+
+// Handlers of the bus pages that are not plain memory
+typedef uint8_t ( *BusRead )( Memory* m, uint16_t address );
+typedef void ( *BusWrite )( Memory* m, uint16_t address, uint8_t value );
+
+// Receives every byte sent out of the serial port, see write_io
+typedef void ( *SerialOut )( void* user, uint8_t value );
+
+// Something that takes bus pages over, the watchpoints of watchpoints.h. It points
+// them at its own handlers and keeps the entries they replaced. Every change of the
+// page table ends in flush_fetch(), which hands the table to remap() so the overlay
+// can take back the pages an MBC pointed somewhere else.
+class BusOverlay
+{
+public:
+    virtual ~BusOverlay( void )
+    {
+    }
+
+    virtual void remap( Memory* m ) = 0;
+
+    // Host memory read page page has under the overlay, null for a handler
+    virtual uint8_t* read_host( int page ) const = 0;
+};
+
 struct Memory {
     union {
         uint8_t map[0x10000]; // full memory map
@@ -66,15 +98,241 @@ struct Memory {
         };
     };
 
+    // Bus page table, one entry per 256 bytes. A page with a host pointer is accessed
+    // straight through it, a null pointer hands the access to the page's handler. The
+    // CPU cores only touch memory through read8/write8 and the 16-bit versions.
+    // Whatever changes the table afterwards has to call flush_fetch().
+    uint8_t* read_page[0x100];
+    uint8_t* write_page[0x100];
+    BusRead read_handler[0x100];
+    BusWrite write_handler[0x100];
+
+    // Page the instruction stream was last fetched from, see fetch8
+    const uint8_t* fetch_base;
+    uint32_t fetch_page; // 0x100 when nothing is cached
+
+    Cartridge* cart; // MBC behind the ROM and external RAM pages, null for plain 32kB
+    uint16_t rom_bank; // ROM bank at 0x4000-0x7FFF, the caching cores key blocks on it
+
+    SerialOut serial_out; // null drops serial output
+    void* serial_user;
+
+    BusOverlay* overlay; // null when no page is taken over
+
     Memory( void )
-        : map{ 0 }
+        : map{ 0 }, fetch_base( nullptr ), fetch_page( 0x100 ), cart( nullptr ), rom_bank( 1 ), serial_out( nullptr ),
+          serial_user( nullptr ), overlay( nullptr )
+    {
+        map_pages();
+    }
+
+    // The page table points into map, a copy would point into the original
+    Memory( const Memory& ) = delete;
+    Memory& operator=( const Memory& ) = delete;
+
+    // ROM and RAM straight through to map, echo RAM onto work RAM, handlers for
+    // ROM writes and I/O writes. No register has read side effects yet, so I/O
+    // reads stay on the fast path. Detaches the cartridge, if any.
+    void map_pages( void )
+    {
+        cart = nullptr;
+        rom_bank = 1;
+
+        for ( int page = 0; page < 0x100; page++ ) {
+            read_page[page] = &map[page << 8];
+            write_page[page] = &map[page << 8];
+            read_handler[page] = nullptr;
+            write_handler[page] = nullptr;
+        }
+
+        for ( int page = 0x00; page < 0x80; page++ ) {
+            write_page[page] = nullptr;
+            write_handler[page] = write_rom;
+        }
+
+        for ( int page = 0xE0; page < 0xFE; page++ ) {
+            read_page[page] = write_page[page] = &map[( page - 0x20 ) << 8];
+        }
+
+        write_page[0xFF] = nullptr;
+        write_handler[0xFF] = write_io;
+
+        flush_fetch();
+    }
+
+    void flush_fetch( void )
+    {
+        fetch_page = 0x100;
+        if ( overlay ) {
+            overlay->remap( this );
+        }
+    }
+
+    // Most pages are plain memory at their own address in map. The byte is read from
+    // there straight away and the page table only confirms it, a predicted branch, so
+    // the table load stays out of the chain of whatever waits for the value. Reading
+    // map under a handler page has no side effects, the value is just dropped.
+    uint8_t read8( uint16_t address )
+    {
+        size_t page = address >> 8;
+        uint8_t value = map[address];
+        if ( GB_LIKELY( read_page[page] == &map[page << 8] ) ) {
+            return value;
+        }
+        return read_other( address );
+    }
+
+    // Pages somewhere else than their own address: banked ROM and RAM, echo RAM, and
+    // the ones with handlers
+    uint8_t read_other( uint16_t address )
     {
+        uint8_t* page = read_page[address >> 8];
+        if ( page ) {
+            return page[address & 0xFF];
+        }
+        return read_handler[address >> 8]( this, address );
+    }
+
+    // Nothing waits on a store, the page pointer is all it takes
+    void write8( uint16_t address, uint8_t value )
+    {
+        uint8_t* page = write_page[address >> 8];
+        if ( GB_LIKELY( page ) ) {
+            page[address & 0xFF] = value;
+        }
+        else {
+            write_handler[address >> 8]( this, address, value );
+        }
+    }
+
+    // Opcode and operand fetches. Code runs from the same page for a while, so the
+    // page pointer is kept aside and the check against it is a predictable compare
+    // instead of a page table load in the PC dependency chain. Pages with a read
+    // handler are never cached. Fetches go under an overlay, they are not the reads
+    // a watchpoint is after.
+    uint8_t fetch8( uint16_t address )
+    {
+        if ( ( address >> 8 ) == fetch_page ) {
+            return fetch_base[address & 0xFF];
+        }
+        return fetch_miss( address );
+    }
+
+    // Out of line, so the fetch in every handler of the interpreter stays small
+    GB_NOINLINE uint8_t fetch_miss( uint16_t address )
+    {
+        uint8_t* page = host_page( address >> 8 );
+        if ( page ) {
+            fetch_base = page;
+            fetch_page = address >> 8;
+            return page[address & 0xFF];
+        }
+        return read_handler[address >> 8]( this, address );
+    }
+
+    uint16_t fetch16( uint16_t address )
+    {
+        return fetch8( address ) | ( fetch8( address + 1 ) << 8 );
+    }
+
+    // Little endian, wrapping around 0xFFFF. Both bytes in one page of map at its own
+    // address is the common case, read ahead of the check like read8.
+    uint16_t read16( uint16_t address )
+    {
+        size_t page = address >> 8;
+        uint16_t value = map[address] | ( map[(uint16_t)( address + 1 )] << 8 );
+        if ( GB_LIKELY( read_page[page] == &map[page << 8] && ( address & 0xFF ) != 0xFF ) ) {
+            return value;
+        }
+        return read8( address ) | ( read8( address + 1 ) << 8 );
+    }
+
+    void write16( uint16_t address, uint16_t value )
+    {
+        write8( address, value & 0xFF );
+        write8( address + 1, value >> 8 );
+    }
+
+    // Host memory reads of page go to, the entry under the overlay when one took the
+    // page over, null for a handler
+    uint8_t* host_page( int page ) const
+    {
+        uint8_t* host = read_page[page];
+        if ( !host && overlay ) {
+            host = overlay->read_host( page );
+        }
+        return host;
+    }
+
+    // The byte a read would return, without side effects, for the debugger and the
+    // decoders of the caching cores
+    uint8_t peek( uint16_t address ) const
+    {
+        const uint8_t* page = host_page( address >> 8 );
+        return page ? page[address & 0xFF] : map[address];
+    }
+
+    // Changes the byte peek returns, ROM included, without side effects. A cartridge's
+    // ROM image is left alone, it may be read-only.
+    void poke( uint16_t address, uint8_t value )
+    {
+        if ( cart && address < 0x8000 ) {
+            return;
+        }
+
+        uint8_t* page = host_page( address >> 8 );
+        if ( page ) {
+            page[address & 0xFF] = value;
+        }
+        else {
+            map[address] = value;
+        }
+    }
+
+    // Address in map an access to address lands on, echo RAM being the only alias
+    static uint16_t canonical( uint16_t address )
+    {
+        return ( address >= 0xE000 && address < 0xFE00 ) ? address - 0x2000 : address;
+    }
+
+    // ROM writes select MBC banks, without an MBC they are dropped
+    static void write_rom( Memory* m, uint16_t address, uint8_t value )
+    {
+    }
+
+    // I/O registers, HRAM and IE
+    static void write_io( Memory* m, uint16_t address, uint8_t value )
+    {
+        switch ( address ) {
+        case 0xFF04: // DIV, any write clears it
+            value = 0;
+            break;
+        case 0xFF02: // SC, a transfer on the internal clock completes at once
+            if ( ( value & 0x81 ) == 0x81 ) {
+                if ( m->serial_out ) {
+                    m->serial_out( m->serial_user, m->map[0xFF01] );
+                }
+                // Nothing on the other end of the cable shifts in ones
+                m->map[0xFF01] = 0xFF;
+                value &= 0x7F;
+            }
+            break;
+        case 0xFF46: // OAM DMA, copied at once
+            for ( int i = 0; i < 0xA0; i++ ) {
+                m->sat[i] = m->read8( ( value << 8 ) | i );
+            }
+            break;
+        default:
+            break;
+        }
+
+        m->map[address] = value;
     }
 };
 
 static_assert( sizeof( Vram ) == 0x2000, "VRAM incorrect size" );
 
-static_assert( sizeof( Memory ) == 0x10000, "Memory not 32kB" );
+static_assert( offsetof( Memory, read_page ) == 0x10000, "Memory map not 64kB" );
 static_assert( offsetof( Memory, map ) == 0, "Invalid memory map start" );
 static_assert( offsetof( Memory, rom ) == 0, "ROM Bank 00" );
 static_assert( offsetof( Memory, bank[1] ) == 0x4000, "ROM Bank 01" );
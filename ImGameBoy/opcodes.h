@@ -0,0 +1,3255 @@
+// Handler bodies of all 512 opcodes (0x000-0x0FF primary, 0x100-0x1FF CB page),
+// shared by Interpreter and BlockCache. This is not a standalone header: it is
+// included from inside the dispatch function of each core, which defines
+//
+//   OPCODE( n )                     label or case of opcode n
+//   NEXT( c )                       finish an instruction that took c T-cycles
+//   IMM8, IMM16                     operand following the opcode
+//   READ8( a ), WRITE8( a, v )      memory access
+//   READ16( a ), WRITE16( a, v )
+//
+// With OPCODE_LABELS defined it expands to the 512 computed goto targets instead,
+// to initialize the dispatch table.
+//
+// Lengths and T-cycles are read from optable.h with constant opcodes, so they fold
+// into the same immediates a hand-written handler would use.
+
+#ifdef OPCODE_LABELS
+
+    &&op_0x00, &&op_0x01, &&op_0x02, &&op_0x03, &&op_0x04, &&op_0x05, &&op_0x06, &&op_0x07,
+    &&op_0x08, &&op_0x09, &&op_0x0A, &&op_0x0B, &&op_0x0C, &&op_0x0D, &&op_0x0E, &&op_0x0F,
+    &&op_0x10, &&op_0x11, &&op_0x12, &&op_0x13, &&op_0x14, &&op_0x15, &&op_0x16, &&op_0x17,
+    &&op_0x18, &&op_0x19, &&op_0x1A, &&op_0x1B, &&op_0x1C, &&op_0x1D, &&op_0x1E, &&op_0x1F,
+    &&op_0x20, &&op_0x21, &&op_0x22, &&op_0x23, &&op_0x24, &&op_0x25, &&op_0x26, &&op_0x27,
+    &&op_0x28, &&op_0x29, &&op_0x2A, &&op_0x2B, &&op_0x2C, &&op_0x2D, &&op_0x2E, &&op_0x2F,
+    &&op_0x30, &&op_0x31, &&op_0x32, &&op_0x33, &&op_0x34, &&op_0x35, &&op_0x36, &&op_0x37,
+    &&op_0x38, &&op_0x39, &&op_0x3A, &&op_0x3B, &&op_0x3C, &&op_0x3D, &&op_0x3E, &&op_0x3F,
+    &&op_0x40, &&op_0x41, &&op_0x42, &&op_0x43, &&op_0x44, &&op_0x45, &&op_0x46, &&op_0x47,
+    &&op_0x48, &&op_0x49, &&op_0x4A, &&op_0x4B, &&op_0x4C, &&op_0x4D, &&op_0x4E, &&op_0x4F,
+    &&op_0x50, &&op_0x51, &&op_0x52, &&op_0x53, &&op_0x54, &&op_0x55, &&op_0x56, &&op_0x57,
+    &&op_0x58, &&op_0x59, &&op_0x5A, &&op_0x5B, &&op_0x5C, &&op_0x5D, &&op_0x5E, &&op_0x5F,
+    &&op_0x60, &&op_0x61, &&op_0x62, &&op_0x63, &&op_0x64, &&op_0x65, &&op_0x66, &&op_0x67,
+    &&op_0x68, &&op_0x69, &&op_0x6A, &&op_0x6B, &&op_0x6C, &&op_0x6D, &&op_0x6E, &&op_0x6F,
+    &&op_0x70, &&op_0x71, &&op_0x72, &&op_0x73, &&op_0x74, &&op_0x75, &&op_0x76, &&op_0x77,
+    &&op_0x78, &&op_0x79, &&op_0x7A, &&op_0x7B, &&op_0x7C, &&op_0x7D, &&op_0x7E, &&op_0x7F,
+    &&op_0x80, &&op_0x81, &&op_0x82, &&op_0x83, &&op_0x84, &&op_0x85, &&op_0x86, &&op_0x87,
+    &&op_0x88, &&op_0x89, &&op_0x8A, &&op_0x8B, &&op_0x8C, &&op_0x8D, &&op_0x8E, &&op_0x8F,
+    &&op_0x90, &&op_0x91, &&op_0x92, &&op_0x93, &&op_0x94, &&op_0x95, &&op_0x96, &&op_0x97,
+    &&op_0x98, &&op_0x99, &&op_0x9A, &&op_0x9B, &&op_0x9C, &&op_0x9D, &&op_0x9E, &&op_0x9F,
+    &&op_0xA0, &&op_0xA1, &&op_0xA2, &&op_0xA3, &&op_0xA4, &&op_0xA5, &&op_0xA6, &&op_0xA7,
+    &&op_0xA8, &&op_0xA9, &&op_0xAA, &&op_0xAB, &&op_0xAC, &&op_0xAD, &&op_0xAE, &&op_0xAF,
+    &&op_0xB0, &&op_0xB1, &&op_0xB2, &&op_0xB3, &&op_0xB4, &&op_0xB5, &&op_0xB6, &&op_0xB7,
+    &&op_0xB8, &&op_0xB9, &&op_0xBA, &&op_0xBB, &&op_0xBC, &&op_0xBD, &&op_0xBE, &&op_0xBF,
+    &&op_0xC0, &&op_0xC1, &&op_0xC2, &&op_0xC3, &&op_0xC4, &&op_0xC5, &&op_0xC6, &&op_0xC7,
+    &&op_0xC8, &&op_0xC9, &&op_0xCA, &&op_0xCB, &&op_0xCC, &&op_0xCD, &&op_0xCE, &&op_0xCF,
+    &&op_0xD0, &&op_0xD1, &&op_0xD2, &&op_0xD3, &&op_0xD4, &&op_0xD5, &&op_0xD6, &&op_0xD7,
+    &&op_0xD8, &&op_0xD9, &&op_0xDA, &&op_0xDB, &&op_0xDC, &&op_0xDD, &&op_0xDE, &&op_0xDF,
+    &&op_0xE0, &&op_0xE1, &&op_0xE2, &&op_0xE3, &&op_0xE4, &&op_0xE5, &&op_0xE6, &&op_0xE7,
+    &&op_0xE8, &&op_0xE9, &&op_0xEA, &&op_0xEB, &&op_0xEC, &&op_0xED, &&op_0xEE, &&op_0xEF,
+    &&op_0xF0, &&op_0xF1, &&op_0xF2, &&op_0xF3, &&op_0xF4, &&op_0xF5, &&op_0xF6, &&op_0xF7,
+    &&op_0xF8, &&op_0xF9, &&op_0xFA, &&op_0xFB, &&op_0xFC, &&op_0xFD, &&op_0xFE, &&op_0xFF,
+    &&op_0x100, &&op_0x101, &&op_0x102, &&op_0x103, &&op_0x104, &&op_0x105, &&op_0x106, &&op_0x107,
+    &&op_0x108, &&op_0x109, &&op_0x10A, &&op_0x10B, &&op_0x10C, &&op_0x10D, &&op_0x10E, &&op_0x10F,
+    &&op_0x110, &&op_0x111, &&op_0x112, &&op_0x113, &&op_0x114, &&op_0x115, &&op_0x116, &&op_0x117,
+    &&op_0x118, &&op_0x119, &&op_0x11A, &&op_0x11B, &&op_0x11C, &&op_0x11D, &&op_0x11E, &&op_0x11F,
+    &&op_0x120, &&op_0x121, &&op_0x122, &&op_0x123, &&op_0x124, &&op_0x125, &&op_0x126, &&op_0x127,
+    &&op_0x128, &&op_0x129, &&op_0x12A, &&op_0x12B, &&op_0x12C, &&op_0x12D, &&op_0x12E, &&op_0x12F,
+    &&op_0x130, &&op_0x131, &&op_0x132, &&op_0x133, &&op_0x134, &&op_0x135, &&op_0x136, &&op_0x137,
+    &&op_0x138, &&op_0x139, &&op_0x13A, &&op_0x13B, &&op_0x13C, &&op_0x13D, &&op_0x13E, &&op_0x13F,
+    &&op_0x140, &&op_0x141, &&op_0x142, &&op_0x143, &&op_0x144, &&op_0x145, &&op_0x146, &&op_0x147,
+    &&op_0x148, &&op_0x149, &&op_0x14A, &&op_0x14B, &&op_0x14C, &&op_0x14D, &&op_0x14E, &&op_0x14F,
+    &&op_0x150, &&op_0x151, &&op_0x152, &&op_0x153, &&op_0x154, &&op_0x155, &&op_0x156, &&op_0x157,
+    &&op_0x158, &&op_0x159, &&op_0x15A, &&op_0x15B, &&op_0x15C, &&op_0x15D, &&op_0x15E, &&op_0x15F,
+    &&op_0x160, &&op_0x161, &&op_0x162, &&op_0x163, &&op_0x164, &&op_0x165, &&op_0x166, &&op_0x167,
+    &&op_0x168, &&op_0x169, &&op_0x16A, &&op_0x16B, &&op_0x16C, &&op_0x16D, &&op_0x16E, &&op_0x16F,
+    &&op_0x170, &&op_0x171, &&op_0x172, &&op_0x173, &&op_0x174, &&op_0x175, &&op_0x176, &&op_0x177,
+    &&op_0x178, &&op_0x179, &&op_0x17A, &&op_0x17B, &&op_0x17C, &&op_0x17D, &&op_0x17E, &&op_0x17F,
+    &&op_0x180, &&op_0x181, &&op_0x182, &&op_0x183, &&op_0x184, &&op_0x185, &&op_0x186, &&op_0x187,
+    &&op_0x188, &&op_0x189, &&op_0x18A, &&op_0x18B, &&op_0x18C, &&op_0x18D, &&op_0x18E, &&op_0x18F,
+    &&op_0x190, &&op_0x191, &&op_0x192, &&op_0x193, &&op_0x194, &&op_0x195, &&op_0x196, &&op_0x197,
+    &&op_0x198, &&op_0x199, &&op_0x19A, &&op_0x19B, &&op_0x19C, &&op_0x19D, &&op_0x19E, &&op_0x19F,
+    &&op_0x1A0, &&op_0x1A1, &&op_0x1A2, &&op_0x1A3, &&op_0x1A4, &&op_0x1A5, &&op_0x1A6, &&op_0x1A7,
+    &&op_0x1A8, &&op_0x1A9, &&op_0x1AA, &&op_0x1AB, &&op_0x1AC, &&op_0x1AD, &&op_0x1AE, &&op_0x1AF,
+    &&op_0x1B0, &&op_0x1B1, &&op_0x1B2, &&op_0x1B3, &&op_0x1B4, &&op_0x1B5, &&op_0x1B6, &&op_0x1B7,
+    &&op_0x1B8, &&op_0x1B9, &&op_0x1BA, &&op_0x1BB, &&op_0x1BC, &&op_0x1BD, &&op_0x1BE, &&op_0x1BF,
+    &&op_0x1C0, &&op_0x1C1, &&op_0x1C2, &&op_0x1C3, &&op_0x1C4, &&op_0x1C5, &&op_0x1C6, &&op_0x1C7,
+    &&op_0x1C8, &&op_0x1C9, &&op_0x1CA, &&op_0x1CB, &&op_0x1CC, &&op_0x1CD, &&op_0x1CE, &&op_0x1CF,
+    &&op_0x1D0, &&op_0x1D1, &&op_0x1D2, &&op_0x1D3, &&op_0x1D4, &&op_0x1D5, &&op_0x1D6, &&op_0x1D7,
+    &&op_0x1D8, &&op_0x1D9, &&op_0x1DA, &&op_0x1DB, &&op_0x1DC, &&op_0x1DD, &&op_0x1DE, &&op_0x1DF,
+    &&op_0x1E0, &&op_0x1E1, &&op_0x1E2, &&op_0x1E3, &&op_0x1E4, &&op_0x1E5, &&op_0x1E6, &&op_0x1E7,
+    &&op_0x1E8, &&op_0x1E9, &&op_0x1EA, &&op_0x1EB, &&op_0x1EC, &&op_0x1ED, &&op_0x1EE, &&op_0x1EF,
+    &&op_0x1F0, &&op_0x1F1, &&op_0x1F2, &&op_0x1F3, &&op_0x1F4, &&op_0x1F5, &&op_0x1F6, &&op_0x1F7,
+    &&op_0x1F8, &&op_0x1F9, &&op_0x1FA, &&op_0x1FB, &&op_0x1FC, &&op_0x1FD, &&op_0x1FE, &&op_0x1FF,
+
+#else
+
+#define LENGTH( n ) ( optable[n].length )
+#define CYCLES( n ) ( optable[n].cycles )
+#define TAKEN( n ) ( optable[n].cycles_taken )
+
+        OPCODE( 0x00 ) {
+            r->PC += LENGTH( 0x00 );
+            NEXT( CYCLES( 0x00 ) );
+        }
+
+        OPCODE( 0x01 ) {
+            r->BC = IMM16;
+            r->PC += LENGTH( 0x01 );
+            NEXT( CYCLES( 0x01 ) );
+        }
+
+        OPCODE( 0x02 ) {
+            WRITE8( r->BC, r->A );
+            r->PC += LENGTH( 0x02 );
+            NEXT( CYCLES( 0x02 ) );
+        }
+
+        OPCODE( 0x03 ) {
+            r->BC++;
+            r->PC += LENGTH( 0x03 );
+            NEXT( CYCLES( 0x03 ) );
+        }
+
+        OPCODE( 0x04 ) {
+            r->B = Instruction::increment( r, r->B );
+            r->PC += LENGTH( 0x04 );
+            NEXT( CYCLES( 0x04 ) );
+        }
+
+        OPCODE( 0x05 ) {
+            r->B = Instruction::decrement( r, r->B );
+            r->PC += LENGTH( 0x05 );
+            NEXT( CYCLES( 0x05 ) );
+        }
+
+        OPCODE( 0x06 ) {
+            r->B = IMM8;
+            r->PC += LENGTH( 0x06 );
+            NEXT( CYCLES( 0x06 ) );
+        }
+
+        OPCODE( 0x07 ) {
+            r->A = Instruction::rlca( r, r->A );
+            r->PC += LENGTH( 0x07 );
+            NEXT( CYCLES( 0x07 ) );
+        }
+
+        OPCODE( 0x08 ) {
+            uint16_t addr = IMM16;
+            WRITE16( addr, r->SP );
+            r->PC += LENGTH( 0x08 );
+            NEXT( CYCLES( 0x08 ) );
+        }
+
+        OPCODE( 0x09 ) {
+            Instruction::add_hl_r16( r, r->BC );
+            r->PC += LENGTH( 0x09 );
+            NEXT( CYCLES( 0x09 ) );
+        }
+
+        OPCODE( 0x0A ) {
+            r->A = READ8( r->BC );
+            r->PC += LENGTH( 0x0A );
+            NEXT( CYCLES( 0x0A ) );
+        }
+
+        OPCODE( 0x0B ) {
+            r->BC--;
+            r->PC += LENGTH( 0x0B );
+            NEXT( CYCLES( 0x0B ) );
+        }
+
+        OPCODE( 0x0C ) {
+            r->C = Instruction::increment( r, r->C );
+            r->PC += LENGTH( 0x0C );
+            NEXT( CYCLES( 0x0C ) );
+        }
+
+        OPCODE( 0x0D ) {
+            r->C = Instruction::decrement( r, r->C );
+            r->PC += LENGTH( 0x0D );
+            NEXT( CYCLES( 0x0D ) );
+        }
+
+        OPCODE( 0x0E ) {
+            r->C = IMM8;
+            r->PC += LENGTH( 0x0E );
+            NEXT( CYCLES( 0x0E ) );
+        }
+
+        OPCODE( 0x0F ) {
+            r->A = Instruction::rrca( r, r->A );
+            r->PC += LENGTH( 0x0F );
+            NEXT( CYCLES( 0x0F ) );
+        }
+
+        OPCODE( 0x10 ) {
+            if ( IMM8 == 0 ) {
+                sstate = StepState::STOP;
+            }
+            r->PC += LENGTH( 0x10 );
+            NEXT( CYCLES( 0x10 ) );
+        }
+
+        OPCODE( 0x11 ) {
+            r->DE = IMM16;
+            r->PC += LENGTH( 0x11 );
+            NEXT( CYCLES( 0x11 ) );
+        }
+
+        OPCODE( 0x12 ) {
+            WRITE8( r->DE, r->A );
+            r->PC += LENGTH( 0x12 );
+            NEXT( CYCLES( 0x12 ) );
+        }
+
+        OPCODE( 0x13 ) {
+            r->DE++;
+            r->PC += LENGTH( 0x13 );
+            NEXT( CYCLES( 0x13 ) );
+        }
+
+        OPCODE( 0x14 ) {
+            r->D = Instruction::increment( r, r->D );
+            r->PC += LENGTH( 0x14 );
+            NEXT( CYCLES( 0x14 ) );
+        }
+
+        OPCODE( 0x15 ) {
+            r->D = Instruction::decrement( r, r->D );
+            r->PC += LENGTH( 0x15 );
+            NEXT( CYCLES( 0x15 ) );
+        }
+
+        OPCODE( 0x16 ) {
+            r->D = IMM8;
+            r->PC += LENGTH( 0x16 );
+            NEXT( CYCLES( 0x16 ) );
+        }
+
+        OPCODE( 0x17 ) {
+            r->A = Instruction::rla( r, r->A );
+            r->PC += LENGTH( 0x17 );
+            NEXT( CYCLES( 0x17 ) );
+        }
+
+        OPCODE( 0x18 ) {
+            r->PC += (int8_t)IMM8;
+            r->PC += LENGTH( 0x18 );
+            NEXT( CYCLES( 0x18 ) );
+        }
+
+        OPCODE( 0x19 ) {
+            Instruction::add_hl_r16( r, r->DE );
+            r->PC += LENGTH( 0x19 );
+            NEXT( CYCLES( 0x19 ) );
+        }
+
+        OPCODE( 0x1A ) {
+            r->A = READ8( r->DE );
+            r->PC += LENGTH( 0x1A );
+            NEXT( CYCLES( 0x1A ) );
+        }
+
+        OPCODE( 0x1B ) {
+            r->DE--;
+            r->PC += LENGTH( 0x1B );
+            NEXT( CYCLES( 0x1B ) );
+        }
+
+        OPCODE( 0x1C ) {
+            r->E = Instruction::increment( r, r->E );
+            r->PC += LENGTH( 0x1C );
+            NEXT( CYCLES( 0x1C ) );
+        }
+
+        OPCODE( 0x1D ) {
+            r->E = Instruction::decrement( r, r->E );
+            r->PC += LENGTH( 0x1D );
+            NEXT( CYCLES( 0x1D ) );
+        }
+
+        OPCODE( 0x1E ) {
+            r->E = IMM8;
+            r->PC += LENGTH( 0x1E );
+            NEXT( CYCLES( 0x1E ) );
+        }
+
+        OPCODE( 0x1F ) {
+            r->A = Instruction::rr( r, r->A );
+            r->PC += LENGTH( 0x1F );
+            NEXT( CYCLES( 0x1F ) );
+        }
+
+        OPCODE( 0x20 ) {
+            if ( !r->z() ) {
+                r->PC += (int8_t)IMM8;
+                r->PC += LENGTH( 0x20 );
+                NEXT( TAKEN( 0x20 ) );
+            }
+            r->PC += LENGTH( 0x20 );
+            NEXT( CYCLES( 0x20 ) );
+        }
+
+        OPCODE( 0x21 ) {
+            r->HL = IMM16;
+            r->PC += LENGTH( 0x21 );
+            NEXT( CYCLES( 0x21 ) );
+        }
+
+        OPCODE( 0x22 ) {
+            WRITE8( r->HL++, r->A );
+            r->PC += LENGTH( 0x22 );
+            NEXT( CYCLES( 0x22 ) );
+        }
+
+        OPCODE( 0x23 ) {
+            r->HL++;
+            r->PC += LENGTH( 0x23 );
+            NEXT( CYCLES( 0x23 ) );
+        }
+
+        OPCODE( 0x24 ) {
+            r->H = Instruction::increment( r, r->H );
+            r->PC += LENGTH( 0x24 );
+            NEXT( CYCLES( 0x24 ) );
+        }
+
+        OPCODE( 0x25 ) {
+            r->H = Instruction::decrement( r, r->H );
+            r->PC += LENGTH( 0x25 );
+            NEXT( CYCLES( 0x25 ) );
+        }
+
+        OPCODE( 0x26 ) {
+            r->H = IMM8;
+            r->PC += LENGTH( 0x26 );
+            NEXT( CYCLES( 0x26 ) );
+        }
+
+        OPCODE( 0x27 ) {
+            r->sync_flags();
+            if ( !r->Flag.N ) { // after an addition
+                if ( r->Flag.C || r->A > 0x99 ) {
+                    r->A += 0x60;
+                    r->Flag.C = 1;
+                }
+                if ( r->Flag.H || ( r->A & 0x0f ) > 0x09 ) {
+                    r->A += 0x6;
+                }
+            } else { // after a subtraction
+                if ( r->Flag.C ) {
+                    r->A -= 0x60;
+                }
+                if ( r->Flag.H ) {
+                    r->A -= 0x6;
+                }
+            }
+
+            r->Flag.Z = ( r->A == 0 );
+            r->Flag.H = 0;
+
+            r->PC += LENGTH( 0x27 );
+            NEXT( CYCLES( 0x27 ) );
+        }
+
+        OPCODE( 0x28 ) {
+            if ( r->z() ) {
+                r->PC += (int8_t)IMM8;
+                r->PC += LENGTH( 0x28 );
+                NEXT( TAKEN( 0x28 ) );
+            }
+            r->PC += LENGTH( 0x28 );
+            NEXT( CYCLES( 0x28 ) );
+        }
+
+        OPCODE( 0x29 ) {
+            Instruction::add_hl_r16( r, r->HL );
+            r->PC += LENGTH( 0x29 );
+            NEXT( CYCLES( 0x29 ) );
+        }
+
+        OPCODE( 0x2A ) {
+            r->A = READ8( r->HL++ );
+            r->PC += LENGTH( 0x2A );
+            NEXT( CYCLES( 0x2A ) );
+        }
+
+        OPCODE( 0x2B ) {
+            r->HL--;
+            r->PC += LENGTH( 0x2B );
+            NEXT( CYCLES( 0x2B ) );
+        }
+
+        OPCODE( 0x2C ) {
+            r->L = Instruction::increment( r, r->L );
+            r->PC += LENGTH( 0x2C );
+            NEXT( CYCLES( 0x2C ) );
+        }
+
+        OPCODE( 0x2D ) {
+            r->L = Instruction::decrement( r, r->L );
+            r->PC += LENGTH( 0x2D );
+            NEXT( CYCLES( 0x2D ) );
+        }
+
+        OPCODE( 0x2E ) {
+            r->L = IMM8;
+            r->PC += LENGTH( 0x2E );
+            NEXT( CYCLES( 0x2E ) );
+        }
+
+        OPCODE( 0x2F ) {
+            r->sync_flags();
+            r->Flag.N = r->Flag.H = 1;
+            r->A = ~r->A;
+            r->PC += LENGTH( 0x2F );
+            NEXT( CYCLES( 0x2F ) );
+        }
+
+        OPCODE( 0x30 ) {
+            if ( !r->c() ) {
+                r->PC += (int8_t)IMM8;
+                r->PC += LENGTH( 0x30 );
+                NEXT( TAKEN( 0x30 ) );
+            }
+            r->PC += LENGTH( 0x30 );
+            NEXT( CYCLES( 0x30 ) );
+        }
+
+        OPCODE( 0x31 ) {
+            r->SP = IMM16;
+            r->PC += LENGTH( 0x31 );
+            NEXT( CYCLES( 0x31 ) );
+        }
+
+        OPCODE( 0x32 ) {
+            WRITE8( r->HL--, r->A );
+            r->PC += LENGTH( 0x32 );
+            NEXT( CYCLES( 0x32 ) );
+        }
+
+        OPCODE( 0x33 ) {
+            r->SP++;
+            r->PC += LENGTH( 0x33 );
+            NEXT( CYCLES( 0x33 ) );
+        }
+
+        OPCODE( 0x34 ) {
+            WRITE8( r->HL, Instruction::increment( r, READ8( r->HL ) ) );
+            r->PC += LENGTH( 0x34 );
+            NEXT( CYCLES( 0x34 ) );
+        }
+
+        OPCODE( 0x35 ) {
+            WRITE8( r->HL, Instruction::decrement( r, READ8( r->HL ) ) );
+            r->PC += LENGTH( 0x35 );
+            NEXT( CYCLES( 0x35 ) );
+        }
+
+        OPCODE( 0x36 ) {
+            WRITE8( r->HL, IMM8 );
+            r->PC += LENGTH( 0x36 );
+            NEXT( CYCLES( 0x36 ) );
+        }
+
+        OPCODE( 0x37 ) {
+            r->sync_flags();
+            r->Flag.N = r->Flag.H = 0;
+            r->Flag.C = 1;
+            r->PC += LENGTH( 0x37 );
+            NEXT( CYCLES( 0x37 ) );
+        }
+
+        OPCODE( 0x38 ) {
+            if ( r->c() ) {
+                r->PC += (int8_t)IMM8;
+                r->PC += LENGTH( 0x38 );
+                NEXT( TAKEN( 0x38 ) );
+            }
+            r->PC += LENGTH( 0x38 );
+            NEXT( CYCLES( 0x38 ) );
+        }
+
+        OPCODE( 0x39 ) {
+            Instruction::add_hl_r16( r, r->SP );
+            r->PC += LENGTH( 0x39 );
+            NEXT( CYCLES( 0x39 ) );
+        }
+
+        OPCODE( 0x3A ) {
+            r->A = READ8( r->HL-- );
+            r->PC += LENGTH( 0x3A );
+            NEXT( CYCLES( 0x3A ) );
+        }
+
+        OPCODE( 0x3B ) {
+            r->SP--;
+            r->PC += LENGTH( 0x3B );
+            NEXT( CYCLES( 0x3B ) );
+        }
+
+        OPCODE( 0x3C ) {
+            r->A = Instruction::increment( r, r->A );
+            r->PC += LENGTH( 0x3C );
+            NEXT( CYCLES( 0x3C ) );
+        }
+
+        OPCODE( 0x3D ) {
+            r->A = Instruction::decrement( r, r->A );
+            r->PC += LENGTH( 0x3D );
+            NEXT( CYCLES( 0x3D ) );
+        }
+
+        OPCODE( 0x3E ) {
+            r->A = IMM8;
+            r->PC += LENGTH( 0x3E );
+            NEXT( CYCLES( 0x3E ) );
+        }
+
+        OPCODE( 0x3F ) {
+            r->sync_flags();
+            r->Flag.N = r->Flag.H = 0;
+            r->Flag.C ^= 1;
+            r->PC += LENGTH( 0x3F );
+            NEXT( CYCLES( 0x3F ) );
+        }
+
+        OPCODE( 0x40 ) {
+            r->PC += LENGTH( 0x40 );
+            NEXT( CYCLES( 0x40 ) );
+        }
+
+        OPCODE( 0x41 ) {
+            r->B = r->C;
+            r->PC += LENGTH( 0x41 );
+            NEXT( CYCLES( 0x41 ) );
+        }
+
+        OPCODE( 0x42 ) {
+            r->B = r->D;
+            r->PC += LENGTH( 0x42 );
+            NEXT( CYCLES( 0x42 ) );
+        }
+
+        OPCODE( 0x43 ) {
+            r->B = r->E;
+            r->PC += LENGTH( 0x43 );
+            NEXT( CYCLES( 0x43 ) );
+        }
+
+        OPCODE( 0x44 ) {
+            r->B = r->H;
+            r->PC += LENGTH( 0x44 );
+            NEXT( CYCLES( 0x44 ) );
+        }
+
+        OPCODE( 0x45 ) {
+            r->B = r->L;
+            r->PC += LENGTH( 0x45 );
+            NEXT( CYCLES( 0x45 ) );
+        }
+
+        OPCODE( 0x46 ) {
+            r->B = READ8( r->HL );
+            r->PC += LENGTH( 0x46 );
+            NEXT( CYCLES( 0x46 ) );
+        }
+
+        OPCODE( 0x47 ) {
+            r->B = r->A;
+            r->PC += LENGTH( 0x47 );
+            NEXT( CYCLES( 0x47 ) );
+        }
+
+        OPCODE( 0x48 ) {
+            r->C = r->B;
+            r->PC += LENGTH( 0x48 );
+            NEXT( CYCLES( 0x48 ) );
+        }
+
+        OPCODE( 0x49 ) {
+            r->PC += LENGTH( 0x49 );
+            NEXT( CYCLES( 0x49 ) );
+        }
+
+        OPCODE( 0x4A ) {
+            r->C = r->D;
+            r->PC += LENGTH( 0x4A );
+            NEXT( CYCLES( 0x4A ) );
+        }
+
+        OPCODE( 0x4B ) {
+            r->C = r->E;
+            r->PC += LENGTH( 0x4B );
+            NEXT( CYCLES( 0x4B ) );
+        }
+
+        OPCODE( 0x4C ) {
+            r->C = r->H;
+            r->PC += LENGTH( 0x4C );
+            NEXT( CYCLES( 0x4C ) );
+        }
+
+        OPCODE( 0x4D ) {
+            r->C = r->L;
+            r->PC += LENGTH( 0x4D );
+            NEXT( CYCLES( 0x4D ) );
+        }
+
+        OPCODE( 0x4E ) {
+            r->C = READ8( r->HL );
+            r->PC += LENGTH( 0x4E );
+            NEXT( CYCLES( 0x4E ) );
+        }
+
+        OPCODE( 0x4F ) {
+            r->C = r->A;
+            r->PC += LENGTH( 0x4F );
+            NEXT( CYCLES( 0x4F ) );
+        }
+
+        OPCODE( 0x50 ) {
+            r->D = r->B;
+            r->PC += LENGTH( 0x50 );
+            NEXT( CYCLES( 0x50 ) );
+        }
+
+        OPCODE( 0x51 ) {
+            r->D = r->C;
+            r->PC += LENGTH( 0x51 );
+            NEXT( CYCLES( 0x51 ) );
+        }
+
+        OPCODE( 0x52 ) {
+            r->PC += LENGTH( 0x52 );
+            NEXT( CYCLES( 0x52 ) );
+        }
+
+        OPCODE( 0x53 ) {
+            r->D = r->E;
+            r->PC += LENGTH( 0x53 );
+            NEXT( CYCLES( 0x53 ) );
+        }
+
+        OPCODE( 0x54 ) {
+            r->D = r->H;
+            r->PC += LENGTH( 0x54 );
+            NEXT( CYCLES( 0x54 ) );
+        }
+
+        OPCODE( 0x55 ) {
+            r->D = r->L;
+            r->PC += LENGTH( 0x55 );
+            NEXT( CYCLES( 0x55 ) );
+        }
+
+        OPCODE( 0x56 ) {
+            r->D = READ8( r->HL );
+            r->PC += LENGTH( 0x56 );
+            NEXT( CYCLES( 0x56 ) );
+        }
+
+        OPCODE( 0x57 ) {
+            r->D = r->A;
+            r->PC += LENGTH( 0x57 );
+            NEXT( CYCLES( 0x57 ) );
+        }
+
+        OPCODE( 0x58 ) {
+            r->E = r->B;
+            r->PC += LENGTH( 0x58 );
+            NEXT( CYCLES( 0x58 ) );
+        }
+
+        OPCODE( 0x59 ) {
+            r->E = r->C;
+            r->PC += LENGTH( 0x59 );
+            NEXT( CYCLES( 0x59 ) );
+        }
+
+        OPCODE( 0x5A ) {
+            r->E = r->D;
+            r->PC += LENGTH( 0x5A );
+            NEXT( CYCLES( 0x5A ) );
+        }
+
+        OPCODE( 0x5B ) {
+            r->PC += LENGTH( 0x5B );
+            NEXT( CYCLES( 0x5B ) );
+        }
+
+        OPCODE( 0x5C ) {
+            r->E = r->H;
+            r->PC += LENGTH( 0x5C );
+            NEXT( CYCLES( 0x5C ) );
+        }
+
+        OPCODE( 0x5D ) {
+            r->E = r->L;
+            r->PC += LENGTH( 0x5D );
+            NEXT( CYCLES( 0x5D ) );
+        }
+
+        OPCODE( 0x5E ) {
+            r->E = READ8( r->HL );
+            r->PC += LENGTH( 0x5E );
+            NEXT( CYCLES( 0x5E ) );
+        }
+
+        OPCODE( 0x5F ) {
+            r->E = r->A;
+            r->PC += LENGTH( 0x5F );
+            NEXT( CYCLES( 0x5F ) );
+        }
+
+        OPCODE( 0x60 ) {
+            r->H = r->B;
+            r->PC += LENGTH( 0x60 );
+            NEXT( CYCLES( 0x60 ) );
+        }
+
+        OPCODE( 0x61 ) {
+            r->H = r->C;
+            r->PC += LENGTH( 0x61 );
+            NEXT( CYCLES( 0x61 ) );
+        }
+
+        OPCODE( 0x62 ) {
+            r->H = r->D;
+            r->PC += LENGTH( 0x62 );
+            NEXT( CYCLES( 0x62 ) );
+        }
+
+        OPCODE( 0x63 ) {
+            r->H = r->E;
+            r->PC += LENGTH( 0x63 );
+            NEXT( CYCLES( 0x63 ) );
+        }
+
+        OPCODE( 0x64 ) {
+            r->PC += LENGTH( 0x64 );
+            NEXT( CYCLES( 0x64 ) );
+        }
+
+        OPCODE( 0x65 ) {
+            r->H = r->L;
+            r->PC += LENGTH( 0x65 );
+            NEXT( CYCLES( 0x65 ) );
+        }
+
+        OPCODE( 0x66 ) {
+            r->H = READ8( r->HL );
+            r->PC += LENGTH( 0x66 );
+            NEXT( CYCLES( 0x66 ) );
+        }
+
+        OPCODE( 0x67 ) {
+            r->H = r->A;
+            r->PC += LENGTH( 0x67 );
+            NEXT( CYCLES( 0x67 ) );
+        }
+
+        OPCODE( 0x68 ) {
+            r->L = r->B;
+            r->PC += LENGTH( 0x68 );
+            NEXT( CYCLES( 0x68 ) );
+        }
+
+        OPCODE( 0x69 ) {
+            r->L = r->C;
+            r->PC += LENGTH( 0x69 );
+            NEXT( CYCLES( 0x69 ) );
+        }
+
+        OPCODE( 0x6A ) {
+            r->L = r->D;
+            r->PC += LENGTH( 0x6A );
+            NEXT( CYCLES( 0x6A ) );
+        }
+
+        OPCODE( 0x6B ) {
+            r->L = r->E;
+            r->PC += LENGTH( 0x6B );
+            NEXT( CYCLES( 0x6B ) );
+        }
+
+        OPCODE( 0x6C ) {
+            r->L = r->H;
+            r->PC += LENGTH( 0x6C );
+            NEXT( CYCLES( 0x6C ) );
+        }
+
+        OPCODE( 0x6D ) {
+            r->PC += LENGTH( 0x6D );
+            NEXT( CYCLES( 0x6D ) );
+        }
+
+        OPCODE( 0x6E ) {
+            r->L = READ8( r->HL );
+            r->PC += LENGTH( 0x6E );
+            NEXT( CYCLES( 0x6E ) );
+        }
+
+        OPCODE( 0x6F ) {
+            r->L = r->A;
+            r->PC += LENGTH( 0x6F );
+            NEXT( CYCLES( 0x6F ) );
+        }
+
+        OPCODE( 0x70 ) {
+            WRITE8( r->HL, r->B );
+            r->PC += LENGTH( 0x70 );
+            NEXT( CYCLES( 0x70 ) );
+        }
+
+        OPCODE( 0x71 ) {
+            WRITE8( r->HL, r->C );
+            r->PC += LENGTH( 0x71 );
+            NEXT( CYCLES( 0x71 ) );
+        }
+
+        OPCODE( 0x72 ) {
+            WRITE8( r->HL, r->D );
+            r->PC += LENGTH( 0x72 );
+            NEXT( CYCLES( 0x72 ) );
+        }
+
+        OPCODE( 0x73 ) {
+            WRITE8( r->HL, r->E );
+            r->PC += LENGTH( 0x73 );
+            NEXT( CYCLES( 0x73 ) );
+        }
+
+        OPCODE( 0x74 ) {
+            WRITE8( r->HL, r->H );
+            r->PC += LENGTH( 0x74 );
+            NEXT( CYCLES( 0x74 ) );
+        }
+
+        OPCODE( 0x75 ) {
+            WRITE8( r->HL, r->L );
+            r->PC += LENGTH( 0x75 );
+            NEXT( CYCLES( 0x75 ) );
+        }
+
+        OPCODE( 0x76 ) {
+            sstate = StepState::STOP;
+            r->PC += LENGTH( 0x76 );
+            NEXT( CYCLES( 0x76 ) );
+        }
+
+        OPCODE( 0x77 ) {
+            WRITE8( r->HL, r->A );
+            r->PC += LENGTH( 0x77 );
+            NEXT( CYCLES( 0x77 ) );
+        }
+
+        OPCODE( 0x78 ) {
+            r->A = r->B;
+            r->PC += LENGTH( 0x78 );
+            NEXT( CYCLES( 0x78 ) );
+        }
+
+        OPCODE( 0x79 ) {
+            r->A = r->C;
+            r->PC += LENGTH( 0x79 );
+            NEXT( CYCLES( 0x79 ) );
+        }
+
+        OPCODE( 0x7A ) {
+            r->A = r->D;
+            r->PC += LENGTH( 0x7A );
+            NEXT( CYCLES( 0x7A ) );
+        }
+
+        OPCODE( 0x7B ) {
+            r->A = r->E;
+            r->PC += LENGTH( 0x7B );
+            NEXT( CYCLES( 0x7B ) );
+        }
+
+        OPCODE( 0x7C ) {
+            r->A = r->H;
+            r->PC += LENGTH( 0x7C );
+            NEXT( CYCLES( 0x7C ) );
+        }
+
+        OPCODE( 0x7D ) {
+            r->A = r->L;
+            r->PC += LENGTH( 0x7D );
+            NEXT( CYCLES( 0x7D ) );
+        }
+
+        OPCODE( 0x7E ) {
+            r->A = READ8( r->HL );
+            r->PC += LENGTH( 0x7E );
+            NEXT( CYCLES( 0x7E ) );
+        }
+
+        OPCODE( 0x7F ) {
+            r->PC += LENGTH( 0x7F );
+            NEXT( CYCLES( 0x7F ) );
+        }
+
+        OPCODE( 0x80 ) {
+            r->A = Instruction::add( r, r->A, r->B );
+            r->PC += LENGTH( 0x80 );
+            NEXT( CYCLES( 0x80 ) );
+        }
+
+        OPCODE( 0x81 ) {
+            r->A = Instruction::add( r, r->A, r->C );
+            r->PC += LENGTH( 0x81 );
+            NEXT( CYCLES( 0x81 ) );
+        }
+
+        OPCODE( 0x82 ) {
+            r->A = Instruction::add( r, r->A, r->D );
+            r->PC += LENGTH( 0x82 );
+            NEXT( CYCLES( 0x82 ) );
+        }
+
+        OPCODE( 0x83 ) {
+            r->A = Instruction::add( r, r->A, r->E );
+            r->PC += LENGTH( 0x83 );
+            NEXT( CYCLES( 0x83 ) );
+        }
+
+        OPCODE( 0x84 ) {
+            r->A = Instruction::add( r, r->A, r->H );
+            r->PC += LENGTH( 0x84 );
+            NEXT( CYCLES( 0x84 ) );
+        }
+
+        OPCODE( 0x85 ) {
+            r->A = Instruction::add( r, r->A, r->L );
+            r->PC += LENGTH( 0x85 );
+            NEXT( CYCLES( 0x85 ) );
+        }
+
+        OPCODE( 0x86 ) {
+            r->A = Instruction::add( r, r->A, READ8( r->HL ) );
+            r->PC += LENGTH( 0x86 );
+            NEXT( CYCLES( 0x86 ) );
+        }
+
+        OPCODE( 0x87 ) {
+            r->A = Instruction::add( r, r->A, r->A );
+            r->PC += LENGTH( 0x87 );
+            NEXT( CYCLES( 0x87 ) );
+        }
+
+        OPCODE( 0x88 ) {
+            r->A = Instruction::adc( r, r->A, r->B );
+            r->PC += LENGTH( 0x88 );
+            NEXT( CYCLES( 0x88 ) );
+        }
+
+        OPCODE( 0x89 ) {
+            r->A = Instruction::adc( r, r->A, r->C );
+            r->PC += LENGTH( 0x89 );
+            NEXT( CYCLES( 0x89 ) );
+        }
+
+        OPCODE( 0x8A ) {
+            r->A = Instruction::adc( r, r->A, r->D );
+            r->PC += LENGTH( 0x8A );
+            NEXT( CYCLES( 0x8A ) );
+        }
+
+        OPCODE( 0x8B ) {
+            r->A = Instruction::adc( r, r->A, r->E );
+            r->PC += LENGTH( 0x8B );
+            NEXT( CYCLES( 0x8B ) );
+        }
+
+        OPCODE( 0x8C ) {
+            r->A = Instruction::adc( r, r->A, r->H );
+            r->PC += LENGTH( 0x8C );
+            NEXT( CYCLES( 0x8C ) );
+        }
+
+        OPCODE( 0x8D ) {
+            r->A = Instruction::adc( r, r->A, r->L );
+            r->PC += LENGTH( 0x8D );
+            NEXT( CYCLES( 0x8D ) );
+        }
+
+        OPCODE( 0x8E ) {
+            r->A = Instruction::adc( r, r->A, READ8( r->HL ) );
+            r->PC += LENGTH( 0x8E );
+            NEXT( CYCLES( 0x8E ) );
+        }
+
+        OPCODE( 0x8F ) {
+            r->A = Instruction::adc( r, r->A, r->A );
+            r->PC += LENGTH( 0x8F );
+            NEXT( CYCLES( 0x8F ) );
+        }
+
+        OPCODE( 0x90 ) {
+            r->A = Instruction::sub( r, r->A, r->B );
+            r->PC += LENGTH( 0x90 );
+            NEXT( CYCLES( 0x90 ) );
+        }
+
+        OPCODE( 0x91 ) {
+            r->A = Instruction::sub( r, r->A, r->C );
+            r->PC += LENGTH( 0x91 );
+            NEXT( CYCLES( 0x91 ) );
+        }
+
+        OPCODE( 0x92 ) {
+            r->A = Instruction::sub( r, r->A, r->D );
+            r->PC += LENGTH( 0x92 );
+            NEXT( CYCLES( 0x92 ) );
+        }
+
+        OPCODE( 0x93 ) {
+            r->A = Instruction::sub( r, r->A, r->E );
+            r->PC += LENGTH( 0x93 );
+            NEXT( CYCLES( 0x93 ) );
+        }
+
+        OPCODE( 0x94 ) {
+            r->A = Instruction::sub( r, r->A, r->H );
+            r->PC += LENGTH( 0x94 );
+            NEXT( CYCLES( 0x94 ) );
+        }
+
+        OPCODE( 0x95 ) {
+            r->A = Instruction::sub( r, r->A, r->L );
+            r->PC += LENGTH( 0x95 );
+            NEXT( CYCLES( 0x95 ) );
+        }
+
+        OPCODE( 0x96 ) {
+            r->A = Instruction::sub( r, r->A, READ8( r->HL ) );
+            r->PC += LENGTH( 0x96 );
+            NEXT( CYCLES( 0x96 ) );
+        }
+
+        OPCODE( 0x97 ) {
+            r->A = Instruction::sub( r, r->A, r->A );
+            r->PC += LENGTH( 0x97 );
+            NEXT( CYCLES( 0x97 ) );
+        }
+
+        OPCODE( 0x98 ) {
+            r->A = Instruction::sbc( r, r->A, r->B );
+            r->PC += LENGTH( 0x98 );
+            NEXT( CYCLES( 0x98 ) );
+        }
+
+        OPCODE( 0x99 ) {
+            r->A = Instruction::sbc( r, r->A, r->C );
+            r->PC += LENGTH( 0x99 );
+            NEXT( CYCLES( 0x99 ) );
+        }
+
+        OPCODE( 0x9A ) {
+            r->A = Instruction::sbc( r, r->A, r->D );
+            r->PC += LENGTH( 0x9A );
+            NEXT( CYCLES( 0x9A ) );
+        }
+
+        OPCODE( 0x9B ) {
+            r->A = Instruction::sbc( r, r->A, r->E );
+            r->PC += LENGTH( 0x9B );
+            NEXT( CYCLES( 0x9B ) );
+        }
+
+        OPCODE( 0x9C ) {
+            r->A = Instruction::sbc( r, r->A, r->H );
+            r->PC += LENGTH( 0x9C );
+            NEXT( CYCLES( 0x9C ) );
+        }
+
+        OPCODE( 0x9D ) {
+            r->A = Instruction::sbc( r, r->A, r->L );
+            r->PC += LENGTH( 0x9D );
+            NEXT( CYCLES( 0x9D ) );
+        }
+
+        OPCODE( 0x9E ) {
+            r->A = Instruction::sbc( r, r->A, READ8( r->HL ) );
+            r->PC += LENGTH( 0x9E );
+            NEXT( CYCLES( 0x9E ) );
+        }
+
+        OPCODE( 0x9F ) {
+            r->A = Instruction::sbc( r, r->A, r->A );
+            r->PC += LENGTH( 0x9F );
+            NEXT( CYCLES( 0x9F ) );
+        }
+
+        OPCODE( 0xA0 ) {
+            r->A = Instruction::_and( r, r->A, r->B );
+            r->PC += LENGTH( 0xA0 );
+            NEXT( CYCLES( 0xA0 ) );
+        }
+
+        OPCODE( 0xA1 ) {
+            r->A = Instruction::_and( r, r->A, r->C );
+            r->PC += LENGTH( 0xA1 );
+            NEXT( CYCLES( 0xA1 ) );
+        }
+
+        OPCODE( 0xA2 ) {
+            r->A = Instruction::_and( r, r->A, r->D );
+            r->PC += LENGTH( 0xA2 );
+            NEXT( CYCLES( 0xA2 ) );
+        }
+
+        OPCODE( 0xA3 ) {
+            r->A = Instruction::_and( r, r->A, r->E );
+            r->PC += LENGTH( 0xA3 );
+            NEXT( CYCLES( 0xA3 ) );
+        }
+
+        OPCODE( 0xA4 ) {
+            r->A = Instruction::_and( r, r->A, r->H );
+            r->PC += LENGTH( 0xA4 );
+            NEXT( CYCLES( 0xA4 ) );
+        }
+
+        OPCODE( 0xA5 ) {
+            r->A = Instruction::_and( r, r->A, r->L );
+            r->PC += LENGTH( 0xA5 );
+            NEXT( CYCLES( 0xA5 ) );
+        }
+
+        OPCODE( 0xA6 ) {
+            r->A = Instruction::_and( r, r->A, READ8( r->HL ) );
+            r->PC += LENGTH( 0xA6 );
+            NEXT( CYCLES( 0xA6 ) );
+        }
+
+        OPCODE( 0xA7 ) {
+            r->A = Instruction::_and( r, r->A, r->A );
+            r->PC += LENGTH( 0xA7 );
+            NEXT( CYCLES( 0xA7 ) );
+        }
+
+        OPCODE( 0xA8 ) {
+            r->A = Instruction::_xor( r, r->A, r->B );
+            r->PC += LENGTH( 0xA8 );
+            NEXT( CYCLES( 0xA8 ) );
+        }
+
+        OPCODE( 0xA9 ) {
+            r->A = Instruction::_xor( r, r->A, r->C );
+            r->PC += LENGTH( 0xA9 );
+            NEXT( CYCLES( 0xA9 ) );
+        }
+
+        OPCODE( 0xAA ) {
+            r->A = Instruction::_xor( r, r->A, r->D );
+            r->PC += LENGTH( 0xAA );
+            NEXT( CYCLES( 0xAA ) );
+        }
+
+        OPCODE( 0xAB ) {
+            r->A = Instruction::_xor( r, r->A, r->E );
+            r->PC += LENGTH( 0xAB );
+            NEXT( CYCLES( 0xAB ) );
+        }
+
+        OPCODE( 0xAC ) {
+            r->A = Instruction::_xor( r, r->A, r->H );
+            r->PC += LENGTH( 0xAC );
+            NEXT( CYCLES( 0xAC ) );
+        }
+
+        OPCODE( 0xAD ) {
+            r->A = Instruction::_xor( r, r->A, r->L );
+            r->PC += LENGTH( 0xAD );
+            NEXT( CYCLES( 0xAD ) );
+        }
+
+        OPCODE( 0xAE ) {
+            r->A = Instruction::_xor( r, r->A, READ8( r->HL ) );
+            r->PC += LENGTH( 0xAE );
+            NEXT( CYCLES( 0xAE ) );
+        }
+
+        OPCODE( 0xAF ) {
+            r->A = Instruction::_xor( r, r->A, r->A );
+            r->PC += LENGTH( 0xAF );
+            NEXT( CYCLES( 0xAF ) );
+        }
+
+        OPCODE( 0xB0 ) {
+            r->A = Instruction::_or( r, r->A, r->B );
+            r->PC += LENGTH( 0xB0 );
+            NEXT( CYCLES( 0xB0 ) );
+        }
+
+        OPCODE( 0xB1 ) {
+            r->A = Instruction::_or( r, r->A, r->C );
+            r->PC += LENGTH( 0xB1 );
+            NEXT( CYCLES( 0xB1 ) );
+        }
+
+        OPCODE( 0xB2 ) {
+            r->A = Instruction::_or( r, r->A, r->D );
+            r->PC += LENGTH( 0xB2 );
+            NEXT( CYCLES( 0xB2 ) );
+        }
+
+        OPCODE( 0xB3 ) {
+            r->A = Instruction::_or( r, r->A, r->E );
+            r->PC += LENGTH( 0xB3 );
+            NEXT( CYCLES( 0xB3 ) );
+        }
+
+        OPCODE( 0xB4 ) {
+            r->A = Instruction::_or( r, r->A, r->H );
+            r->PC += LENGTH( 0xB4 );
+            NEXT( CYCLES( 0xB4 ) );
+        }
+
+        OPCODE( 0xB5 ) {
+            r->A = Instruction::_or( r, r->A, r->L );
+            r->PC += LENGTH( 0xB5 );
+            NEXT( CYCLES( 0xB5 ) );
+        }
+
+        OPCODE( 0xB6 ) {
+            r->A = Instruction::_or( r, r->A, READ8( r->HL ) );
+            r->PC += LENGTH( 0xB6 );
+            NEXT( CYCLES( 0xB6 ) );
+        }
+
+        OPCODE( 0xB7 ) {
+            r->A = Instruction::_or( r, r->A, r->A );
+            r->PC += LENGTH( 0xB7 );
+            NEXT( CYCLES( 0xB7 ) );
+        }
+
+        OPCODE( 0xB8 ) {
+            Instruction::sub( r, r->A, r->B );
+            r->PC += LENGTH( 0xB8 );
+            NEXT( CYCLES( 0xB8 ) );
+        }
+
+        OPCODE( 0xB9 ) {
+            Instruction::sub( r, r->A, r->C );
+            r->PC += LENGTH( 0xB9 );
+            NEXT( CYCLES( 0xB9 ) );
+        }
+
+        OPCODE( 0xBA ) {
+            Instruction::sub( r, r->A, r->D );
+            r->PC += LENGTH( 0xBA );
+            NEXT( CYCLES( 0xBA ) );
+        }
+
+        OPCODE( 0xBB ) {
+            Instruction::sub( r, r->A, r->E );
+            r->PC += LENGTH( 0xBB );
+            NEXT( CYCLES( 0xBB ) );
+        }
+
+        OPCODE( 0xBC ) {
+            Instruction::sub( r, r->A, r->H );
+            r->PC += LENGTH( 0xBC );
+            NEXT( CYCLES( 0xBC ) );
+        }
+
+        OPCODE( 0xBD ) {
+            Instruction::sub( r, r->A, r->L );
+            r->PC += LENGTH( 0xBD );
+            NEXT( CYCLES( 0xBD ) );
+        }
+
+        OPCODE( 0xBE ) {
+            Instruction::sub( r, r->A, READ8( r->HL ) );
+            r->PC += LENGTH( 0xBE );
+            NEXT( CYCLES( 0xBE ) );
+        }
+
+        OPCODE( 0xBF ) {
+            Instruction::sub( r, r->A, r->A );
+            r->PC += LENGTH( 0xBF );
+            NEXT( CYCLES( 0xBF ) );
+        }
+
+        OPCODE( 0xC0 ) {
+            if ( !r->z() ) {
+                r->PC = READ16( r->SP );
+                r->SP += 2;
+                NEXT( TAKEN( 0xC0 ) );
+            }
+            r->PC += LENGTH( 0xC0 );
+            NEXT( CYCLES( 0xC0 ) );
+        }
+
+        OPCODE( 0xC1 ) {
+            r->C = READ8( r->SP++ );
+            r->B = READ8( r->SP++ );
+            r->PC += LENGTH( 0xC1 );
+            NEXT( CYCLES( 0xC1 ) );
+        }
+
+        OPCODE( 0xC2 ) {
+            if ( !r->z() ) {
+                r->PC = IMM16;
+                NEXT( TAKEN( 0xC2 ) );
+            }
+            r->PC += LENGTH( 0xC2 );
+            NEXT( CYCLES( 0xC2 ) );
+        }
+
+        OPCODE( 0xC3 ) {
+            r->PC = IMM16;
+            NEXT( CYCLES( 0xC3 ) );
+        }
+
+        OPCODE( 0xC4 ) {
+            if ( !r->z() ) {
+                r->SP -= 2;
+                WRITE16( r->SP, r->PC + 3 );
+                r->PC = IMM16;
+                NEXT( TAKEN( 0xC4 ) );
+            }
+            r->PC += LENGTH( 0xC4 );
+            NEXT( CYCLES( 0xC4 ) );
+        }
+
+        OPCODE( 0xC5 ) {
+            r->SP -= 2;
+            WRITE16( r->SP, r->BC );
+            r->PC += LENGTH( 0xC5 );
+            NEXT( CYCLES( 0xC5 ) );
+        }
+
+        OPCODE( 0xC6 ) {
+            r->A = Instruction::add( r, r->A, IMM8 );
+            r->PC += LENGTH( 0xC6 );
+            NEXT( CYCLES( 0xC6 ) );
+        }
+
+        OPCODE( 0xC7 ) {
+            r->SP -= 2;
+            WRITE16( r->SP, r->PC + 1 );
+            r->PC = 0x0000;
+            NEXT( CYCLES( 0xC7 ) );
+        }
+
+        OPCODE( 0xC8 ) {
+            if ( r->z() ) {
+                r->PC = READ16( r->SP );
+                r->SP += 2;
+                NEXT( TAKEN( 0xC8 ) );
+            }
+            r->PC += LENGTH( 0xC8 );
+            NEXT( CYCLES( 0xC8 ) );
+        }
+
+        OPCODE( 0xC9 ) {
+            r->PC = READ16( r->SP );
+            r->SP += 2;
+            NEXT( CYCLES( 0xC9 ) );
+        }
+
+        OPCODE( 0xCA ) {
+            if ( r->z() ) {
+                r->PC = IMM16;
+                NEXT( TAKEN( 0xCA ) );
+            }
+            r->PC += LENGTH( 0xCA );
+            NEXT( CYCLES( 0xCA ) );
+        }
+
+        OPCODE( 0xCC ) {
+            if ( r->z() ) {
+                r->SP -= 2;
+                WRITE16( r->SP, r->PC + 3 );
+                r->PC = IMM16;
+                NEXT( TAKEN( 0xCC ) );
+            }
+            r->PC += LENGTH( 0xCC );
+            NEXT( CYCLES( 0xCC ) );
+        }
+
+        OPCODE( 0xCD ) {
+            r->SP -= 2;
+            WRITE16( r->SP, r->PC + LENGTH( 0xCD ) );
+            r->PC = IMM16;
+            NEXT( CYCLES( 0xCD ) );
+        }
+
+        OPCODE( 0xCE ) {
+            r->A = Instruction::adc( r, r->A, IMM8 );
+            r->PC += LENGTH( 0xCE );
+            NEXT( CYCLES( 0xCE ) );
+        }
+
+        OPCODE( 0xCF ) {
+            r->SP -= 2;
+            WRITE16( r->SP, r->PC + 1 );
+            r->PC = 0x0008;
+            NEXT( CYCLES( 0xCF ) );
+        }
+
+        OPCODE( 0xD0 ) {
+            if ( !r->c() ) {
+                r->PC = READ16( r->SP );
+                r->SP += 2;
+                NEXT( TAKEN( 0xD0 ) );
+            }
+            r->PC += LENGTH( 0xD0 );
+            NEXT( CYCLES( 0xD0 ) );
+        }
+
+        OPCODE( 0xD1 ) {
+            r->DE = READ16( r->SP );
+            r->SP += 2;
+            r->PC += LENGTH( 0xD1 );
+            NEXT( CYCLES( 0xD1 ) );
+        }
+
+        OPCODE( 0xD2 ) {
+            if ( !r->c() ) {
+                r->PC = IMM16;
+                NEXT( TAKEN( 0xD2 ) );
+            }
+            r->PC += LENGTH( 0xD2 );
+            NEXT( CYCLES( 0xD2 ) );
+        }
+
+        OPCODE( 0xD4 ) {
+            if ( !r->c() ) {
+                r->SP -= 2;
+                WRITE16( r->SP, r->PC + 3 );
+                r->PC = IMM16;
+                NEXT( TAKEN( 0xD4 ) );
+            }
+            r->PC += LENGTH( 0xD4 );
+            NEXT( CYCLES( 0xD4 ) );
+        }
+
+        OPCODE( 0xD5 ) {
+            r->SP -= 2;
+            WRITE16( r->SP, r->DE );
+            r->PC += LENGTH( 0xD5 );
+            NEXT( CYCLES( 0xD5 ) );
+        }
+
+        OPCODE( 0xD6 ) {
+            r->A = Instruction::sub( r, r->A, IMM8 );
+            r->PC += LENGTH( 0xD6 );
+            NEXT( CYCLES( 0xD6 ) );
+        }
+
+        OPCODE( 0xD7 ) {
+            r->SP -= 2;
+            WRITE16( r->SP, r->PC + 1 );
+            r->PC = 0x0010;
+            NEXT( CYCLES( 0xD7 ) );
+        }
+
+        OPCODE( 0xD8 ) {
+            if ( r->c() ) {
+                r->PC = READ16( r->SP );
+                r->SP += 2;
+                NEXT( TAKEN( 0xD8 ) );
+            }
+            r->PC += LENGTH( 0xD8 );
+            NEXT( CYCLES( 0xD8 ) );
+        }
+
+        OPCODE( 0xD9 ) {
+            r->PC = READ16( r->SP );
+            r->SP += 2;
+            WRITE8( 0xFFFF, 1 );
+            NEXT( CYCLES( 0xD9 ) );
+        }
+
+        OPCODE( 0xDA ) {
+            if ( r->c() ) {
+                r->PC = IMM16;
+                NEXT( TAKEN( 0xDA ) );
+            }
+            r->PC += LENGTH( 0xDA );
+            NEXT( CYCLES( 0xDA ) );
+        }
+
+        OPCODE( 0xDC ) {
+            if ( r->c() ) {
+                uint16_t addr = IMM16;
+                r->SP -= 2;
+                WRITE16( r->SP, addr );
+                r->PC = addr;
+                NEXT( TAKEN( 0xDC ) );
+            }
+            r->PC += LENGTH( 0xDC );
+            NEXT( CYCLES( 0xDC ) );
+        }
+
+        OPCODE( 0xDE ) {
+            r->A = Instruction::sbc( r, r->A, IMM8 );
+            r->PC += LENGTH( 0xDE );
+            NEXT( CYCLES( 0xDE ) );
+        }
+
+        OPCODE( 0xDF ) {
+            r->SP -= 2;
+            WRITE16( r->SP, r->PC + 1 );
+            r->PC = 0x0018;
+            NEXT( CYCLES( 0xDF ) );
+        }
+
+        OPCODE( 0xE0 ) {
+            WRITE8( 0xFF00 | IMM8, r->A );
+            r->PC += LENGTH( 0xE0 );
+            NEXT( CYCLES( 0xE0 ) );
+        }
+
+        OPCODE( 0xE1 ) {
+            r->HL = READ16( r->SP );
+            r->SP += 2;
+            r->PC += LENGTH( 0xE1 );
+            NEXT( CYCLES( 0xE1 ) );
+        }
+
+        OPCODE( 0xE2 ) {
+            WRITE8( 0xFF00 | r->C, r->A );
+            r->PC += LENGTH( 0xE2 );
+            NEXT( CYCLES( 0xE2 ) );
+        }
+
+        OPCODE( 0xE5 ) {
+            r->SP -= 2;
+            WRITE16( r->SP, r->HL );
+            r->PC += LENGTH( 0xE5 );
+            NEXT( CYCLES( 0xE5 ) );
+        }
+
+        OPCODE( 0xE6 ) {
+            r->A = Instruction::_and( r, r->A, IMM8 );
+            r->PC += LENGTH( 0xE6 );
+            NEXT( CYCLES( 0xE6 ) );
+        }
+
+        OPCODE( 0xE7 ) {
+            r->SP -= 2;
+            WRITE16( r->SP, r->PC + 1 );
+            r->PC = 0x0020;
+            NEXT( CYCLES( 0xE7 ) );
+        }
+
+        OPCODE( 0xE8 ) {
+            r->SP = Instruction::add< uint16_t >( r, r->SP, (int8_t)IMM8 );
+            r->sync_flags();
+            r->Flag.Z = 0;
+            r->PC += LENGTH( 0xE8 );
+            NEXT( CYCLES( 0xE8 ) );
+        }
+
+        OPCODE( 0xE9 ) {
+            r->PC = r->HL;
+            NEXT( CYCLES( 0xE9 ) );
+        }
+
+        OPCODE( 0xEA ) {
+            WRITE8( IMM16, r->A );
+            r->PC += LENGTH( 0xEA );
+            NEXT( CYCLES( 0xEA ) );
+        }
+
+        OPCODE( 0xEE ) {
+            r->A = Instruction::_xor( r, r->A, IMM8 );
+            r->PC += LENGTH( 0xEE );
+            NEXT( CYCLES( 0xEE ) );
+        }
+
+        OPCODE( 0xEF ) {
+            r->SP -= 2;
+            WRITE16( r->SP, r->PC + 1 );
+            r->PC = 0x0028;
+            NEXT( CYCLES( 0xEF ) );
+        }
+
+        OPCODE( 0xF0 ) {
+            r->A = READ8( 0xFF00 | IMM8 );
+            r->PC += LENGTH( 0xF0 );
+            NEXT( CYCLES( 0xF0 ) );
+        }
+
+        OPCODE( 0xF1 ) {
+            r->sync_flags();
+            r->AF = READ16( r->SP ) & 0xFFF0;
+            r->SP += 2;
+            r->PC += LENGTH( 0xF1 );
+            NEXT( CYCLES( 0xF1 ) );
+        }
+
+        OPCODE( 0xF2 ) {
+            r->A = READ8( 0xFF00 | r->C );
+            r->PC += LENGTH( 0xF2 );
+            NEXT( CYCLES( 0xF2 ) );
+        }
+
+        OPCODE( 0xF3 ) {
+            WRITE8( 0xFFFF, 0 );
+            r->PC += LENGTH( 0xF3 );
+            NEXT( CYCLES( 0xF3 ) );
+        }
+
+        OPCODE( 0xF5 ) {
+            r->sync_flags();
+            r->SP -= 2;
+            WRITE16( r->SP, r->AF );
+            r->PC += LENGTH( 0xF5 );
+            NEXT( CYCLES( 0xF5 ) );
+        }
+
+        OPCODE( 0xF6 ) {
+            r->A = Instruction::_or( r, r->A, IMM8 );
+            r->PC += LENGTH( 0xF6 );
+            NEXT( CYCLES( 0xF6 ) );
+        }
+
+        OPCODE( 0xF7 ) {
+            r->SP -= 2;
+            WRITE16( r->SP, r->PC + 1 );
+            r->PC = 0x0030;
+            NEXT( CYCLES( 0xF7 ) );
+        }
+
+        OPCODE( 0xF8 ) {
+            r->HL = Instruction::add< uint16_t >( r, r->HL, (int8_t)IMM8 );
+            r->sync_flags();
+            r->Flag.Z = 0;
+            r->PC += LENGTH( 0xF8 );
+            NEXT( CYCLES( 0xF8 ) );
+        }
+
+        OPCODE( 0xF9 ) {
+            r->SP = r->HL;
+            r->PC += LENGTH( 0xF9 );
+            NEXT( CYCLES( 0xF9 ) );
+        }
+
+        OPCODE( 0xFA ) {
+            r->A = READ8( IMM16 );
+            r->PC += LENGTH( 0xFA );
+            NEXT( CYCLES( 0xFA ) );
+        }
+
+        OPCODE( 0xFB ) {
+            WRITE8( 0xFFFF, 1 );
+            r->PC += LENGTH( 0xFB );
+            NEXT( CYCLES( 0xFB ) );
+        }
+
+        OPCODE( 0xFE ) {
+            Instruction::sub( r, r->A, IMM8 );
+            r->PC += LENGTH( 0xFE );
+            NEXT( CYCLES( 0xFE ) );
+        }
+
+        OPCODE( 0xFF ) {
+            r->SP -= 2;
+            WRITE16( r->SP, r->PC + 1 );
+            r->PC = 0x0038;
+            NEXT( CYCLES( 0xFF ) );
+        }
+
+        OPCODE( 0xD3 )
+        OPCODE( 0xDB )
+        OPCODE( 0xDD )
+        OPCODE( 0xE3 )
+        OPCODE( 0xE4 )
+        OPCODE( 0xEB )
+        OPCODE( 0xEC )
+        OPCODE( 0xED )
+        OPCODE( 0xF4 )
+        OPCODE( 0xFC )
+        OPCODE( 0xFD ) {
+            r->PC += LENGTH( 0xFD );
+            NEXT( CYCLES( 0xFD ) );
+        }
+
+        /* ===================================================================
+
+                          Extended Instructions (0xCB)
+
+           ================================================================ */
+
+        OPCODE( 0x100 ) {
+            r->B = InstructionEx::rlc( r, r->B );
+            r->PC += LENGTH( 0x100 );
+            NEXT( CYCLES( 0x100 ) );
+        }
+
+        OPCODE( 0x101 ) {
+            r->C = InstructionEx::rlc( r, r->C );
+            r->PC += LENGTH( 0x101 );
+            NEXT( CYCLES( 0x101 ) );
+        }
+
+        OPCODE( 0x102 ) {
+            r->D = InstructionEx::rlc( r, r->D );
+            r->PC += LENGTH( 0x102 );
+            NEXT( CYCLES( 0x102 ) );
+        }
+
+        OPCODE( 0x103 ) {
+            r->E = InstructionEx::rlc( r, r->E );
+            r->PC += LENGTH( 0x103 );
+            NEXT( CYCLES( 0x103 ) );
+        }
+
+        OPCODE( 0x104 ) {
+            r->H = InstructionEx::rlc( r, r->H );
+            r->PC += LENGTH( 0x104 );
+            NEXT( CYCLES( 0x104 ) );
+        }
+
+        OPCODE( 0x105 ) {
+            r->L = InstructionEx::rlc( r, r->L );
+            r->PC += LENGTH( 0x105 );
+            NEXT( CYCLES( 0x105 ) );
+        }
+
+        OPCODE( 0x106 ) {
+            WRITE8( r->HL, InstructionEx::rlc( r, READ8( r->HL ) ) );
+            r->PC += LENGTH( 0x106 );
+            NEXT( CYCLES( 0x106 ) );
+        }
+
+        OPCODE( 0x107 ) {
+            r->A = InstructionEx::rlc( r, r->A );
+            r->PC += LENGTH( 0x107 );
+            NEXT( CYCLES( 0x107 ) );
+        }
+
+        OPCODE( 0x108 ) {
+            r->B = InstructionEx::rrc( r, r->B );
+            r->PC += LENGTH( 0x108 );
+            NEXT( CYCLES( 0x108 ) );
+        }
+
+        OPCODE( 0x109 ) {
+            r->C = InstructionEx::rrc( r, r->C );
+            r->PC += LENGTH( 0x109 );
+            NEXT( CYCLES( 0x109 ) );
+        }
+
+        OPCODE( 0x10A ) {
+            r->D = InstructionEx::rrc( r, r->D );
+            r->PC += LENGTH( 0x10A );
+            NEXT( CYCLES( 0x10A ) );
+        }
+
+        OPCODE( 0x10B ) {
+            r->E = InstructionEx::rrc( r, r->E );
+            r->PC += LENGTH( 0x10B );
+            NEXT( CYCLES( 0x10B ) );
+        }
+
+        OPCODE( 0x10C ) {
+            r->H = InstructionEx::rrc( r, r->H );
+            r->PC += LENGTH( 0x10C );
+            NEXT( CYCLES( 0x10C ) );
+        }
+
+        OPCODE( 0x10D ) {
+            r->L = InstructionEx::rrc( r, r->L );
+            r->PC += LENGTH( 0x10D );
+            NEXT( CYCLES( 0x10D ) );
+        }
+
+        OPCODE( 0x10E ) {
+            WRITE8( r->HL, InstructionEx::rrc( r, READ8( r->HL ) ) );
+            r->PC += LENGTH( 0x10E );
+            NEXT( CYCLES( 0x10E ) );
+        }
+
+        OPCODE( 0x10F ) {
+            r->A = InstructionEx::rrc( r, r->A );
+            r->PC += LENGTH( 0x10F );
+            NEXT( CYCLES( 0x10F ) );
+        }
+
+        OPCODE( 0x110 ) {
+            r->B = InstructionEx::rl( r, r->B );
+            r->PC += LENGTH( 0x110 );
+            NEXT( CYCLES( 0x110 ) );
+        }
+
+        OPCODE( 0x111 ) {
+            r->C = InstructionEx::rl( r, r->C );
+            r->PC += LENGTH( 0x111 );
+            NEXT( CYCLES( 0x111 ) );
+        }
+
+        OPCODE( 0x112 ) {
+            r->D = InstructionEx::rl( r, r->D );
+            r->PC += LENGTH( 0x112 );
+            NEXT( CYCLES( 0x112 ) );
+        }
+
+        OPCODE( 0x113 ) {
+            r->E = InstructionEx::rl( r, r->E );
+            r->PC += LENGTH( 0x113 );
+            NEXT( CYCLES( 0x113 ) );
+        }
+
+        OPCODE( 0x114 ) {
+            r->H = InstructionEx::rl( r, r->H );
+            r->PC += LENGTH( 0x114 );
+            NEXT( CYCLES( 0x114 ) );
+        }
+
+        OPCODE( 0x115 ) {
+            r->L = InstructionEx::rl( r, r->L );
+            r->PC += LENGTH( 0x115 );
+            NEXT( CYCLES( 0x115 ) );
+        }
+
+        OPCODE( 0x116 ) {
+            WRITE8( r->HL, InstructionEx::rl( r, READ8( r->HL ) ) );
+            r->PC += LENGTH( 0x116 );
+            NEXT( CYCLES( 0x116 ) );
+        }
+
+        OPCODE( 0x117 ) {
+            r->A = InstructionEx::rl( r, r->A );
+            r->PC += LENGTH( 0x117 );
+            NEXT( CYCLES( 0x117 ) );
+        }
+
+        OPCODE( 0x118 ) {
+            r->B = InstructionEx::rr( r, r->B );
+            r->PC += LENGTH( 0x118 );
+            NEXT( CYCLES( 0x118 ) );
+        }
+
+        OPCODE( 0x119 ) {
+            r->C = InstructionEx::rr( r, r->C );
+            r->PC += LENGTH( 0x119 );
+            NEXT( CYCLES( 0x119 ) );
+        }
+
+        OPCODE( 0x11A ) {
+            r->D = InstructionEx::rr( r, r->D );
+            r->PC += LENGTH( 0x11A );
+            NEXT( CYCLES( 0x11A ) );
+        }
+
+        OPCODE( 0x11B ) {
+            r->E = InstructionEx::rr( r, r->E );
+            r->PC += LENGTH( 0x11B );
+            NEXT( CYCLES( 0x11B ) );
+        }
+
+        OPCODE( 0x11C ) {
+            r->H = InstructionEx::rr( r, r->H );
+            r->PC += LENGTH( 0x11C );
+            NEXT( CYCLES( 0x11C ) );
+        }
+
+        OPCODE( 0x11D ) {
+            r->L = InstructionEx::rr( r, r->L );
+            r->PC += LENGTH( 0x11D );
+            NEXT( CYCLES( 0x11D ) );
+        }
+
+        OPCODE( 0x11E ) {
+            WRITE8( r->HL, InstructionEx::rr( r, READ8( r->HL ) ) );
+            r->PC += LENGTH( 0x11E );
+            NEXT( CYCLES( 0x11E ) );
+        }
+
+        OPCODE( 0x11F ) {
+            r->A = InstructionEx::rr( r, r->A );
+            r->PC += LENGTH( 0x11F );
+            NEXT( CYCLES( 0x11F ) );
+        }
+
+        OPCODE( 0x120 ) {
+            r->B = InstructionEx::sla( r, r->B );
+            r->PC += LENGTH( 0x120 );
+            NEXT( CYCLES( 0x120 ) );
+        }
+
+        OPCODE( 0x121 ) {
+            r->C = InstructionEx::sla( r, r->C );
+            r->PC += LENGTH( 0x121 );
+            NEXT( CYCLES( 0x121 ) );
+        }
+
+        OPCODE( 0x122 ) {
+            r->D = InstructionEx::sla( r, r->D );
+            r->PC += LENGTH( 0x122 );
+            NEXT( CYCLES( 0x122 ) );
+        }
+
+        OPCODE( 0x123 ) {
+            r->E = InstructionEx::sla( r, r->E );
+            r->PC += LENGTH( 0x123 );
+            NEXT( CYCLES( 0x123 ) );
+        }
+
+        OPCODE( 0x124 ) {
+            r->H = InstructionEx::sla( r, r->H );
+            r->PC += LENGTH( 0x124 );
+            NEXT( CYCLES( 0x124 ) );
+        }
+
+        OPCODE( 0x125 ) {
+            r->L = InstructionEx::sla( r, r->L );
+            r->PC += LENGTH( 0x125 );
+            NEXT( CYCLES( 0x125 ) );
+        }
+
+        OPCODE( 0x126 ) {
+            WRITE8( r->HL, InstructionEx::sla( r, READ8( r->HL ) ) );
+            r->PC += LENGTH( 0x126 );
+            NEXT( CYCLES( 0x126 ) );
+        }
+
+        OPCODE( 0x127 ) {
+            r->A = InstructionEx::sla( r, r->A );
+            r->PC += LENGTH( 0x127 );
+            NEXT( CYCLES( 0x127 ) );
+        }
+
+        OPCODE( 0x128 ) {
+            r->B = InstructionEx::sra( r, r->B );
+            r->PC += LENGTH( 0x128 );
+            NEXT( CYCLES( 0x128 ) );
+        }
+
+        OPCODE( 0x129 ) {
+            r->C = InstructionEx::sra( r, r->C );
+            r->PC += LENGTH( 0x129 );
+            NEXT( CYCLES( 0x129 ) );
+        }
+
+        OPCODE( 0x12A ) {
+            r->D = InstructionEx::sra( r, r->D );
+            r->PC += LENGTH( 0x12A );
+            NEXT( CYCLES( 0x12A ) );
+        }
+
+        OPCODE( 0x12B ) {
+            r->E = InstructionEx::sra( r, r->E );
+            r->PC += LENGTH( 0x12B );
+            NEXT( CYCLES( 0x12B ) );
+        }
+
+        OPCODE( 0x12C ) {
+            r->H = InstructionEx::sra( r, r->H );
+            r->PC += LENGTH( 0x12C );
+            NEXT( CYCLES( 0x12C ) );
+        }
+
+        OPCODE( 0x12D ) {
+            r->L = InstructionEx::sra( r, r->L );
+            r->PC += LENGTH( 0x12D );
+            NEXT( CYCLES( 0x12D ) );
+        }
+
+        OPCODE( 0x12E ) {
+            WRITE8( r->HL, InstructionEx::sra( r, READ8( r->HL ) ) );
+            r->PC += LENGTH( 0x12E );
+            NEXT( CYCLES( 0x12E ) );
+        }
+
+        OPCODE( 0x12F ) {
+            r->A = InstructionEx::sra( r, r->A );
+            r->PC += LENGTH( 0x12F );
+            NEXT( CYCLES( 0x12F ) );
+        }
+
+        OPCODE( 0x130 ) {
+            r->B = InstructionEx::swap( r, r->B );
+            r->PC += LENGTH( 0x130 );
+            NEXT( CYCLES( 0x130 ) );
+        }
+
+        OPCODE( 0x131 ) {
+            r->C = InstructionEx::swap( r, r->C );
+            r->PC += LENGTH( 0x131 );
+            NEXT( CYCLES( 0x131 ) );
+        }
+
+        OPCODE( 0x132 ) {
+            r->D = InstructionEx::swap( r, r->D );
+            r->PC += LENGTH( 0x132 );
+            NEXT( CYCLES( 0x132 ) );
+        }
+
+        OPCODE( 0x133 ) {
+            r->E = InstructionEx::swap( r, r->E );
+            r->PC += LENGTH( 0x133 );
+            NEXT( CYCLES( 0x133 ) );
+        }
+
+        OPCODE( 0x134 ) {
+            r->H = InstructionEx::swap( r, r->H );
+            r->PC += LENGTH( 0x134 );
+            NEXT( CYCLES( 0x134 ) );
+        }
+
+        OPCODE( 0x135 ) {
+            r->L = InstructionEx::swap( r, r->L );
+            r->PC += LENGTH( 0x135 );
+            NEXT( CYCLES( 0x135 ) );
+        }
+
+        OPCODE( 0x136 ) {
+            WRITE8( r->HL, InstructionEx::swap( r, READ8( r->HL ) ) );
+            r->PC += LENGTH( 0x136 );
+            NEXT( CYCLES( 0x136 ) );
+        }
+
+        OPCODE( 0x137 ) {
+            r->A = InstructionEx::swap( r, r->A );
+            r->PC += LENGTH( 0x137 );
+            NEXT( CYCLES( 0x137 ) );
+        }
+
+        OPCODE( 0x138 ) {
+            r->B = InstructionEx::srl( r, r->B );
+            r->PC += LENGTH( 0x138 );
+            NEXT( CYCLES( 0x138 ) );
+        }
+
+        OPCODE( 0x139 ) {
+            r->C = InstructionEx::srl( r, r->C );
+            r->PC += LENGTH( 0x139 );
+            NEXT( CYCLES( 0x139 ) );
+        }
+
+        OPCODE( 0x13A ) {
+            r->D = InstructionEx::srl( r, r->D );
+            r->PC += LENGTH( 0x13A );
+            NEXT( CYCLES( 0x13A ) );
+        }
+
+        OPCODE( 0x13B ) {
+            r->E = InstructionEx::srl( r, r->E );
+            r->PC += LENGTH( 0x13B );
+            NEXT( CYCLES( 0x13B ) );
+        }
+
+        OPCODE( 0x13C ) {
+            r->H = InstructionEx::srl( r, r->H );
+            r->PC += LENGTH( 0x13C );
+            NEXT( CYCLES( 0x13C ) );
+        }
+
+        OPCODE( 0x13D ) {
+            r->L = InstructionEx::srl( r, r->L );
+            r->PC += LENGTH( 0x13D );
+            NEXT( CYCLES( 0x13D ) );
+        }
+
+        OPCODE( 0x13E ) {
+            WRITE8( r->HL, InstructionEx::srl( r, READ8( r->HL ) ) );
+            r->PC += LENGTH( 0x13E );
+            NEXT( CYCLES( 0x13E ) );
+        }
+
+        OPCODE( 0x13F ) {
+            r->A = InstructionEx::srl( r, r->A );
+            r->PC += LENGTH( 0x13F );
+            NEXT( CYCLES( 0x13F ) );
+        }
+
+        OPCODE( 0x140 ) {
+            InstructionEx::bit( r, r->B, 0 );
+            r->PC += LENGTH( 0x140 );
+            NEXT( CYCLES( 0x140 ) );
+        }
+
+        OPCODE( 0x141 ) {
+            InstructionEx::bit( r, r->C, 0 );
+            r->PC += LENGTH( 0x141 );
+            NEXT( CYCLES( 0x141 ) );
+        }
+
+        OPCODE( 0x142 ) {
+            InstructionEx::bit( r, r->D, 0 );
+            r->PC += LENGTH( 0x142 );
+            NEXT( CYCLES( 0x142 ) );
+        }
+
+        OPCODE( 0x143 ) {
+            InstructionEx::bit( r, r->E, 0 );
+            r->PC += LENGTH( 0x143 );
+            NEXT( CYCLES( 0x143 ) );
+        }
+
+        OPCODE( 0x144 ) {
+            InstructionEx::bit( r, r->H, 0 );
+            r->PC += LENGTH( 0x144 );
+            NEXT( CYCLES( 0x144 ) );
+        }
+
+        OPCODE( 0x145 ) {
+            InstructionEx::bit( r, r->L, 0 );
+            r->PC += LENGTH( 0x145 );
+            NEXT( CYCLES( 0x145 ) );
+        }
+
+        OPCODE( 0x146 ) {
+            InstructionEx::bit( r, READ8( r->HL ), 0 );
+            r->PC += LENGTH( 0x146 );
+            NEXT( CYCLES( 0x146 ) );
+        }
+
+        OPCODE( 0x147 ) {
+            InstructionEx::bit( r, r->A, 0 );
+            r->PC += LENGTH( 0x147 );
+            NEXT( CYCLES( 0x147 ) );
+        }
+
+        OPCODE( 0x148 ) {
+            InstructionEx::bit( r, r->B, 1 );
+            r->PC += LENGTH( 0x148 );
+            NEXT( CYCLES( 0x148 ) );
+        }
+
+        OPCODE( 0x149 ) {
+            InstructionEx::bit( r, r->C, 1 );
+            r->PC += LENGTH( 0x149 );
+            NEXT( CYCLES( 0x149 ) );
+        }
+
+        OPCODE( 0x14A ) {
+            InstructionEx::bit( r, r->D, 1 );
+            r->PC += LENGTH( 0x14A );
+            NEXT( CYCLES( 0x14A ) );
+        }
+
+        OPCODE( 0x14B ) {
+            InstructionEx::bit( r, r->E, 1 );
+            r->PC += LENGTH( 0x14B );
+            NEXT( CYCLES( 0x14B ) );
+        }
+
+        OPCODE( 0x14C ) {
+            InstructionEx::bit( r, r->H, 1 );
+            r->PC += LENGTH( 0x14C );
+            NEXT( CYCLES( 0x14C ) );
+        }
+
+        OPCODE( 0x14D ) {
+            InstructionEx::bit( r, r->L, 1 );
+            r->PC += LENGTH( 0x14D );
+            NEXT( CYCLES( 0x14D ) );
+        }
+
+        OPCODE( 0x14E ) {
+            InstructionEx::bit( r, READ8( r->HL ), 1 );
+            r->PC += LENGTH( 0x14E );
+            NEXT( CYCLES( 0x14E ) );
+        }
+
+        OPCODE( 0x14F ) {
+            InstructionEx::bit( r, r->A, 1 );
+            r->PC += LENGTH( 0x14F );
+            NEXT( CYCLES( 0x14F ) );
+        }
+
+        OPCODE( 0x150 ) {
+            InstructionEx::bit( r, r->B, 2 );
+            r->PC += LENGTH( 0x150 );
+            NEXT( CYCLES( 0x150 ) );
+        }
+
+        OPCODE( 0x151 ) {
+            InstructionEx::bit( r, r->C, 2 );
+            r->PC += LENGTH( 0x151 );
+            NEXT( CYCLES( 0x151 ) );
+        }
+
+        OPCODE( 0x152 ) {
+            InstructionEx::bit( r, r->D, 2 );
+            r->PC += LENGTH( 0x152 );
+            NEXT( CYCLES( 0x152 ) );
+        }
+
+        OPCODE( 0x153 ) {
+            InstructionEx::bit( r, r->E, 2 );
+            r->PC += LENGTH( 0x153 );
+            NEXT( CYCLES( 0x153 ) );
+        }
+
+        OPCODE( 0x154 ) {
+            InstructionEx::bit( r, r->H, 2 );
+            r->PC += LENGTH( 0x154 );
+            NEXT( CYCLES( 0x154 ) );
+        }
+
+        OPCODE( 0x155 ) {
+            InstructionEx::bit( r, r->L, 2 );
+            r->PC += LENGTH( 0x155 );
+            NEXT( CYCLES( 0x155 ) );
+        }
+
+        OPCODE( 0x156 ) {
+            InstructionEx::bit( r, READ8( r->HL ), 2 );
+            r->PC += LENGTH( 0x156 );
+            NEXT( CYCLES( 0x156 ) );
+        }
+
+        OPCODE( 0x157 ) {
+            InstructionEx::bit( r, r->A, 2 );
+            r->PC += LENGTH( 0x157 );
+            NEXT( CYCLES( 0x157 ) );
+        }
+
+        OPCODE( 0x158 ) {
+            InstructionEx::bit( r, r->B, 3 );
+            r->PC += LENGTH( 0x158 );
+            NEXT( CYCLES( 0x158 ) );
+        }
+
+        OPCODE( 0x159 ) {
+            InstructionEx::bit( r, r->C, 3 );
+            r->PC += LENGTH( 0x159 );
+            NEXT( CYCLES( 0x159 ) );
+        }
+
+        OPCODE( 0x15A ) {
+            InstructionEx::bit( r, r->D, 3 );
+            r->PC += LENGTH( 0x15A );
+            NEXT( CYCLES( 0x15A ) );
+        }
+
+        OPCODE( 0x15B ) {
+            InstructionEx::bit( r, r->E, 3 );
+            r->PC += LENGTH( 0x15B );
+            NEXT( CYCLES( 0x15B ) );
+        }
+
+        OPCODE( 0x15C ) {
+            InstructionEx::bit( r, r->H, 3 );
+            r->PC += LENGTH( 0x15C );
+            NEXT( CYCLES( 0x15C ) );
+        }
+
+        OPCODE( 0x15D ) {
+            InstructionEx::bit( r, r->L, 3 );
+            r->PC += LENGTH( 0x15D );
+            NEXT( CYCLES( 0x15D ) );
+        }
+
+        OPCODE( 0x15E ) {
+            InstructionEx::bit( r, READ8( r->HL ), 3 );
+            r->PC += LENGTH( 0x15E );
+            NEXT( CYCLES( 0x15E ) );
+        }
+
+        OPCODE( 0x15F ) {
+            InstructionEx::bit( r, r->A, 3 );
+            r->PC += LENGTH( 0x15F );
+            NEXT( CYCLES( 0x15F ) );
+        }
+
+        OPCODE( 0x160 ) {
+            InstructionEx::bit( r, r->B, 4 );
+            r->PC += LENGTH( 0x160 );
+            NEXT( CYCLES( 0x160 ) );
+        }
+
+        OPCODE( 0x161 ) {
+            InstructionEx::bit( r, r->C, 4 );
+            r->PC += LENGTH( 0x161 );
+            NEXT( CYCLES( 0x161 ) );
+        }
+
+        OPCODE( 0x162 ) {
+            InstructionEx::bit( r, r->D, 4 );
+            r->PC += LENGTH( 0x162 );
+            NEXT( CYCLES( 0x162 ) );
+        }
+
+        OPCODE( 0x163 ) {
+            InstructionEx::bit( r, r->E, 4 );
+            r->PC += LENGTH( 0x163 );
+            NEXT( CYCLES( 0x163 ) );
+        }
+
+        OPCODE( 0x164 ) {
+            InstructionEx::bit( r, r->H, 4 );
+            r->PC += LENGTH( 0x164 );
+            NEXT( CYCLES( 0x164 ) );
+        }
+
+        OPCODE( 0x165 ) {
+            InstructionEx::bit( r, r->L, 4 );
+            r->PC += LENGTH( 0x165 );
+            NEXT( CYCLES( 0x165 ) );
+        }
+
+        OPCODE( 0x166 ) {
+            InstructionEx::bit( r, READ8( r->HL ), 4 );
+            r->PC += LENGTH( 0x166 );
+            NEXT( CYCLES( 0x166 ) );
+        }
+
+        OPCODE( 0x167 ) {
+            InstructionEx::bit( r, r->A, 4 );
+            r->PC += LENGTH( 0x167 );
+            NEXT( CYCLES( 0x167 ) );
+        }
+
+        OPCODE( 0x168 ) {
+            InstructionEx::bit( r, r->B, 5 );
+            r->PC += LENGTH( 0x168 );
+            NEXT( CYCLES( 0x168 ) );
+        }
+
+        OPCODE( 0x169 ) {
+            InstructionEx::bit( r, r->C, 5 );
+            r->PC += LENGTH( 0x169 );
+            NEXT( CYCLES( 0x169 ) );
+        }
+
+        OPCODE( 0x16A ) {
+            InstructionEx::bit( r, r->D, 5 );
+            r->PC += LENGTH( 0x16A );
+            NEXT( CYCLES( 0x16A ) );
+        }
+
+        OPCODE( 0x16B ) {
+            InstructionEx::bit( r, r->E, 5 );
+            r->PC += LENGTH( 0x16B );
+            NEXT( CYCLES( 0x16B ) );
+        }
+
+        OPCODE( 0x16C ) {
+            InstructionEx::bit( r, r->H, 5 );
+            r->PC += LENGTH( 0x16C );
+            NEXT( CYCLES( 0x16C ) );
+        }
+
+        OPCODE( 0x16D ) {
+            InstructionEx::bit( r, r->L, 5 );
+            r->PC += LENGTH( 0x16D );
+            NEXT( CYCLES( 0x16D ) );
+        }
+
+        OPCODE( 0x16E ) {
+            InstructionEx::bit( r, READ8( r->HL ), 5 );
+            r->PC += LENGTH( 0x16E );
+            NEXT( CYCLES( 0x16E ) );
+        }
+
+        OPCODE( 0x16F ) {
+            InstructionEx::bit( r, r->A, 5 );
+            r->PC += LENGTH( 0x16F );
+            NEXT( CYCLES( 0x16F ) );
+        }
+
+        OPCODE( 0x170 ) {
+            InstructionEx::bit( r, r->B, 6 );
+            r->PC += LENGTH( 0x170 );
+            NEXT( CYCLES( 0x170 ) );
+        }
+
+        OPCODE( 0x171 ) {
+            InstructionEx::bit( r, r->C, 6 );
+            r->PC += LENGTH( 0x171 );
+            NEXT( CYCLES( 0x171 ) );
+        }
+
+        OPCODE( 0x172 ) {
+            InstructionEx::bit( r, r->D, 6 );
+            r->PC += LENGTH( 0x172 );
+            NEXT( CYCLES( 0x172 ) );
+        }
+
+        OPCODE( 0x173 ) {
+            InstructionEx::bit( r, r->E, 6 );
+            r->PC += LENGTH( 0x173 );
+            NEXT( CYCLES( 0x173 ) );
+        }
+
+        OPCODE( 0x174 ) {
+            InstructionEx::bit( r, r->H, 6 );
+            r->PC += LENGTH( 0x174 );
+            NEXT( CYCLES( 0x174 ) );
+        }
+
+        OPCODE( 0x175 ) {
+            InstructionEx::bit( r, r->L, 6 );
+            r->PC += LENGTH( 0x175 );
+            NEXT( CYCLES( 0x175 ) );
+        }
+
+        OPCODE( 0x176 ) {
+            InstructionEx::bit( r, READ8( r->HL ), 6 );
+            r->PC += LENGTH( 0x176 );
+            NEXT( CYCLES( 0x176 ) );
+        }
+
+        OPCODE( 0x177 ) {
+            InstructionEx::bit( r, r->A, 6 );
+            r->PC += LENGTH( 0x177 );
+            NEXT( CYCLES( 0x177 ) );
+        }
+
+        OPCODE( 0x178 ) {
+            InstructionEx::bit( r, r->B, 7 );
+            r->PC += LENGTH( 0x178 );
+            NEXT( CYCLES( 0x178 ) );
+        }
+
+        OPCODE( 0x179 ) {
+            InstructionEx::bit( r, r->C, 7 );
+            r->PC += LENGTH( 0x179 );
+            NEXT( CYCLES( 0x179 ) );
+        }
+
+        OPCODE( 0x17A ) {
+            InstructionEx::bit( r, r->D, 7 );
+            r->PC += LENGTH( 0x17A );
+            NEXT( CYCLES( 0x17A ) );
+        }
+
+        OPCODE( 0x17B ) {
+            InstructionEx::bit( r, r->E, 7 );
+            r->PC += LENGTH( 0x17B );
+            NEXT( CYCLES( 0x17B ) );
+        }
+
+        OPCODE( 0x17C ) {
+            InstructionEx::bit( r, r->H, 7 );
+            r->PC += LENGTH( 0x17C );
+            NEXT( CYCLES( 0x17C ) );
+        }
+
+        OPCODE( 0x17D ) {
+            InstructionEx::bit( r, r->L, 7 );
+            r->PC += LENGTH( 0x17D );
+            NEXT( CYCLES( 0x17D ) );
+        }
+
+        OPCODE( 0x17E ) {
+            InstructionEx::bit( r, READ8( r->HL ), 7 );
+            r->PC += LENGTH( 0x17E );
+            NEXT( CYCLES( 0x17E ) );
+        }
+
+        OPCODE( 0x17F ) {
+            InstructionEx::bit( r, r->A, 7 );
+            r->PC += LENGTH( 0x17F );
+            NEXT( CYCLES( 0x17F ) );
+        }
+
+        OPCODE( 0x180 ) {
+            InstructionEx::res( r->B, 0 );
+            r->PC += LENGTH( 0x180 );
+            NEXT( CYCLES( 0x180 ) );
+        }
+
+        OPCODE( 0x181 ) {
+            InstructionEx::res( r->C, 0 );
+            r->PC += LENGTH( 0x181 );
+            NEXT( CYCLES( 0x181 ) );
+        }
+
+        OPCODE( 0x182 ) {
+            InstructionEx::res( r->D, 0 );
+            r->PC += LENGTH( 0x182 );
+            NEXT( CYCLES( 0x182 ) );
+        }
+
+        OPCODE( 0x183 ) {
+            InstructionEx::res( r->E, 0 );
+            r->PC += LENGTH( 0x183 );
+            NEXT( CYCLES( 0x183 ) );
+        }
+
+        OPCODE( 0x184 ) {
+            InstructionEx::res( r->H, 0 );
+            r->PC += LENGTH( 0x184 );
+            NEXT( CYCLES( 0x184 ) );
+        }
+
+        OPCODE( 0x185 ) {
+            InstructionEx::res( r->L, 0 );
+            r->PC += LENGTH( 0x185 );
+            NEXT( CYCLES( 0x185 ) );
+        }
+
+        OPCODE( 0x186 ) {
+            uint8_t value = READ8( r->HL );
+            InstructionEx::res( value, 0 );
+            WRITE8( r->HL, value );
+            r->PC += LENGTH( 0x186 );
+            NEXT( CYCLES( 0x186 ) );
+        }
+
+        OPCODE( 0x187 ) {
+            InstructionEx::res( r->A, 0 );
+            r->PC += LENGTH( 0x187 );
+            NEXT( CYCLES( 0x187 ) );
+        }
+
+        OPCODE( 0x188 ) {
+            InstructionEx::res( r->B, 1 );
+            r->PC += LENGTH( 0x188 );
+            NEXT( CYCLES( 0x188 ) );
+        }
+
+        OPCODE( 0x189 ) {
+            InstructionEx::res( r->C, 1 );
+            r->PC += LENGTH( 0x189 );
+            NEXT( CYCLES( 0x189 ) );
+        }
+
+        OPCODE( 0x18A ) {
+            InstructionEx::res( r->D, 1 );
+            r->PC += LENGTH( 0x18A );
+            NEXT( CYCLES( 0x18A ) );
+        }
+
+        OPCODE( 0x18B ) {
+            InstructionEx::res( r->E, 1 );
+            r->PC += LENGTH( 0x18B );
+            NEXT( CYCLES( 0x18B ) );
+        }
+
+        OPCODE( 0x18C ) {
+            InstructionEx::res( r->H, 1 );
+            r->PC += LENGTH( 0x18C );
+            NEXT( CYCLES( 0x18C ) );
+        }
+
+        OPCODE( 0x18D ) {
+            InstructionEx::res( r->L, 1 );
+            r->PC += LENGTH( 0x18D );
+            NEXT( CYCLES( 0x18D ) );
+        }
+
+        OPCODE( 0x18E ) {
+            uint8_t value = READ8( r->HL );
+            InstructionEx::res( value, 1 );
+            WRITE8( r->HL, value );
+            r->PC += LENGTH( 0x18E );
+            NEXT( CYCLES( 0x18E ) );
+        }
+
+        OPCODE( 0x18F ) {
+            InstructionEx::res( r->A, 1 );
+            r->PC += LENGTH( 0x18F );
+            NEXT( CYCLES( 0x18F ) );
+        }
+
+        OPCODE( 0x190 ) {
+            InstructionEx::res( r->B, 2 );
+            r->PC += LENGTH( 0x190 );
+            NEXT( CYCLES( 0x190 ) );
+        }
+
+        OPCODE( 0x191 ) {
+            InstructionEx::res( r->C, 2 );
+            r->PC += LENGTH( 0x191 );
+            NEXT( CYCLES( 0x191 ) );
+        }
+
+        OPCODE( 0x192 ) {
+            InstructionEx::res( r->D, 2 );
+            r->PC += LENGTH( 0x192 );
+            NEXT( CYCLES( 0x192 ) );
+        }
+
+        OPCODE( 0x193 ) {
+            InstructionEx::res( r->E, 2 );
+            r->PC += LENGTH( 0x193 );
+            NEXT( CYCLES( 0x193 ) );
+        }
+
+        OPCODE( 0x194 ) {
+            InstructionEx::res( r->H, 2 );
+            r->PC += LENGTH( 0x194 );
+            NEXT( CYCLES( 0x194 ) );
+        }
+
+        OPCODE( 0x195 ) {
+            InstructionEx::res( r->L, 2 );
+            r->PC += LENGTH( 0x195 );
+            NEXT( CYCLES( 0x195 ) );
+        }
+
+        OPCODE( 0x196 ) {
+            uint8_t value = READ8( r->HL );
+            InstructionEx::res( value, 2 );
+            WRITE8( r->HL, value );
+            r->PC += LENGTH( 0x196 );
+            NEXT( CYCLES( 0x196 ) );
+        }
+
+        OPCODE( 0x197 ) {
+            InstructionEx::res( r->A, 2 );
+            r->PC += LENGTH( 0x197 );
+            NEXT( CYCLES( 0x197 ) );
+        }
+
+        OPCODE( 0x198 ) {
+            InstructionEx::res( r->B, 3 );
+            r->PC += LENGTH( 0x198 );
+            NEXT( CYCLES( 0x198 ) );
+        }
+
+        OPCODE( 0x199 ) {
+            InstructionEx::res( r->C, 3 );
+            r->PC += LENGTH( 0x199 );
+            NEXT( CYCLES( 0x199 ) );
+        }
+
+        OPCODE( 0x19A ) {
+            InstructionEx::res( r->D, 3 );
+            r->PC += LENGTH( 0x19A );
+            NEXT( CYCLES( 0x19A ) );
+        }
+
+        OPCODE( 0x19B ) {
+            InstructionEx::res( r->E, 3 );
+            r->PC += LENGTH( 0x19B );
+            NEXT( CYCLES( 0x19B ) );
+        }
+
+        OPCODE( 0x19C ) {
+            InstructionEx::res( r->H, 3 );
+            r->PC += LENGTH( 0x19C );
+            NEXT( CYCLES( 0x19C ) );
+        }
+
+        OPCODE( 0x19D ) {
+            InstructionEx::res( r->L, 3 );
+            r->PC += LENGTH( 0x19D );
+            NEXT( CYCLES( 0x19D ) );
+        }
+
+        OPCODE( 0x19E ) {
+            uint8_t value = READ8( r->HL );
+            InstructionEx::res( value, 3 );
+            WRITE8( r->HL, value );
+            r->PC += LENGTH( 0x19E );
+            NEXT( CYCLES( 0x19E ) );
+        }
+
+        OPCODE( 0x19F ) {
+            InstructionEx::res( r->A, 3 );
+            r->PC += LENGTH( 0x19F );
+            NEXT( CYCLES( 0x19F ) );
+        }
+
+        OPCODE( 0x1A0 ) {
+            InstructionEx::res( r->B, 4 );
+            r->PC += LENGTH( 0x1A0 );
+            NEXT( CYCLES( 0x1A0 ) );
+        }
+
+        OPCODE( 0x1A1 ) {
+            InstructionEx::res( r->C, 4 );
+            r->PC += LENGTH( 0x1A1 );
+            NEXT( CYCLES( 0x1A1 ) );
+        }
+
+        OPCODE( 0x1A2 ) {
+            InstructionEx::res( r->D, 4 );
+            r->PC += LENGTH( 0x1A2 );
+            NEXT( CYCLES( 0x1A2 ) );
+        }
+
+        OPCODE( 0x1A3 ) {
+            InstructionEx::res( r->E, 4 );
+            r->PC += LENGTH( 0x1A3 );
+            NEXT( CYCLES( 0x1A3 ) );
+        }
+
+        OPCODE( 0x1A4 ) {
+            InstructionEx::res( r->H, 4 );
+            r->PC += LENGTH( 0x1A4 );
+            NEXT( CYCLES( 0x1A4 ) );
+        }
+
+        OPCODE( 0x1A5 ) {
+            InstructionEx::res( r->L, 4 );
+            r->PC += LENGTH( 0x1A5 );
+            NEXT( CYCLES( 0x1A5 ) );
+        }
+
+        OPCODE( 0x1A6 ) {
+            uint8_t value = READ8( r->HL );
+            InstructionEx::res( value, 4 );
+            WRITE8( r->HL, value );
+            r->PC += LENGTH( 0x1A6 );
+            NEXT( CYCLES( 0x1A6 ) );
+        }
+
+        OPCODE( 0x1A7 ) {
+            InstructionEx::res( r->A, 4 );
+            r->PC += LENGTH( 0x1A7 );
+            NEXT( CYCLES( 0x1A7 ) );
+        }
+
+        OPCODE( 0x1A8 ) {
+            InstructionEx::res( r->B, 5 );
+            r->PC += LENGTH( 0x1A8 );
+            NEXT( CYCLES( 0x1A8 ) );
+        }
+
+        OPCODE( 0x1A9 ) {
+            InstructionEx::res( r->C, 5 );
+            r->PC += LENGTH( 0x1A9 );
+            NEXT( CYCLES( 0x1A9 ) );
+        }
+
+        OPCODE( 0x1AA ) {
+            InstructionEx::res( r->D, 5 );
+            r->PC += LENGTH( 0x1AA );
+            NEXT( CYCLES( 0x1AA ) );
+        }
+
+        OPCODE( 0x1AB ) {
+            InstructionEx::res( r->E, 5 );
+            r->PC += LENGTH( 0x1AB );
+            NEXT( CYCLES( 0x1AB ) );
+        }
+
+        OPCODE( 0x1AC ) {
+            InstructionEx::res( r->H, 5 );
+            r->PC += LENGTH( 0x1AC );
+            NEXT( CYCLES( 0x1AC ) );
+        }
+
+        OPCODE( 0x1AD ) {
+            InstructionEx::res( r->L, 5 );
+            r->PC += LENGTH( 0x1AD );
+            NEXT( CYCLES( 0x1AD ) );
+        }
+
+        OPCODE( 0x1AE ) {
+            uint8_t value = READ8( r->HL );
+            InstructionEx::res( value, 5 );
+            WRITE8( r->HL, value );
+            r->PC += LENGTH( 0x1AE );
+            NEXT( CYCLES( 0x1AE ) );
+        }
+
+        OPCODE( 0x1AF ) {
+            InstructionEx::res( r->A, 5 );
+            r->PC += LENGTH( 0x1AF );
+            NEXT( CYCLES( 0x1AF ) );
+        }
+
+        OPCODE( 0x1B0 ) {
+            InstructionEx::res( r->B, 6 );
+            r->PC += LENGTH( 0x1B0 );
+            NEXT( CYCLES( 0x1B0 ) );
+        }
+
+        OPCODE( 0x1B1 ) {
+            InstructionEx::res( r->C, 6 );
+            r->PC += LENGTH( 0x1B1 );
+            NEXT( CYCLES( 0x1B1 ) );
+        }
+
+        OPCODE( 0x1B2 ) {
+            InstructionEx::res( r->D, 6 );
+            r->PC += LENGTH( 0x1B2 );
+            NEXT( CYCLES( 0x1B2 ) );
+        }
+
+        OPCODE( 0x1B3 ) {
+            InstructionEx::res( r->E, 6 );
+            r->PC += LENGTH( 0x1B3 );
+            NEXT( CYCLES( 0x1B3 ) );
+        }
+
+        OPCODE( 0x1B4 ) {
+            InstructionEx::res( r->H, 6 );
+            r->PC += LENGTH( 0x1B4 );
+            NEXT( CYCLES( 0x1B4 ) );
+        }
+
+        OPCODE( 0x1B5 ) {
+            InstructionEx::res( r->L, 6 );
+            r->PC += LENGTH( 0x1B5 );
+            NEXT( CYCLES( 0x1B5 ) );
+        }
+
+        OPCODE( 0x1B6 ) {
+            uint8_t value = READ8( r->HL );
+            InstructionEx::res( value, 6 );
+            WRITE8( r->HL, value );
+            r->PC += LENGTH( 0x1B6 );
+            NEXT( CYCLES( 0x1B6 ) );
+        }
+
+        OPCODE( 0x1B7 ) {
+            InstructionEx::res( r->A, 6 );
+            r->PC += LENGTH( 0x1B7 );
+            NEXT( CYCLES( 0x1B7 ) );
+        }
+
+        OPCODE( 0x1B8 ) {
+            InstructionEx::res( r->B, 7 );
+            r->PC += LENGTH( 0x1B8 );
+            NEXT( CYCLES( 0x1B8 ) );
+        }
+
+        OPCODE( 0x1B9 ) {
+            InstructionEx::res( r->C, 7 );
+            r->PC += LENGTH( 0x1B9 );
+            NEXT( CYCLES( 0x1B9 ) );
+        }
+
+        OPCODE( 0x1BA ) {
+            InstructionEx::res( r->D, 7 );
+            r->PC += LENGTH( 0x1BA );
+            NEXT( CYCLES( 0x1BA ) );
+        }
+
+        OPCODE( 0x1BB ) {
+            InstructionEx::res( r->E, 7 );
+            r->PC += LENGTH( 0x1BB );
+            NEXT( CYCLES( 0x1BB ) );
+        }
+
+        OPCODE( 0x1BC ) {
+            InstructionEx::res( r->H, 7 );
+            r->PC += LENGTH( 0x1BC );
+            NEXT( CYCLES( 0x1BC ) );
+        }
+
+        OPCODE( 0x1BD ) {
+            InstructionEx::res( r->L, 7 );
+            r->PC += LENGTH( 0x1BD );
+            NEXT( CYCLES( 0x1BD ) );
+        }
+
+        OPCODE( 0x1BE ) {
+            uint8_t value = READ8( r->HL );
+            InstructionEx::res( value, 7 );
+            WRITE8( r->HL, value );
+            r->PC += LENGTH( 0x1BE );
+            NEXT( CYCLES( 0x1BE ) );
+        }
+
+        OPCODE( 0x1BF ) {
+            InstructionEx::res( r->A, 7 );
+            r->PC += LENGTH( 0x1BF );
+            NEXT( CYCLES( 0x1BF ) );
+        }
+
+        OPCODE( 0x1C0 ) {
+            InstructionEx::set( r->B, 0 );
+            r->PC += LENGTH( 0x1C0 );
+            NEXT( CYCLES( 0x1C0 ) );
+        }
+
+        OPCODE( 0x1C1 ) {
+            InstructionEx::set( r->C, 0 );
+            r->PC += LENGTH( 0x1C1 );
+            NEXT( CYCLES( 0x1C1 ) );
+        }
+
+        OPCODE( 0x1C2 ) {
+            InstructionEx::set( r->D, 0 );
+            r->PC += LENGTH( 0x1C2 );
+            NEXT( CYCLES( 0x1C2 ) );
+        }
+
+        OPCODE( 0x1C3 ) {
+            InstructionEx::set( r->E, 0 );
+            r->PC += LENGTH( 0x1C3 );
+            NEXT( CYCLES( 0x1C3 ) );
+        }
+
+        OPCODE( 0x1C4 ) {
+            InstructionEx::set( r->H, 0 );
+            r->PC += LENGTH( 0x1C4 );
+            NEXT( CYCLES( 0x1C4 ) );
+        }
+
+        OPCODE( 0x1C5 ) {
+            InstructionEx::set( r->L, 0 );
+            r->PC += LENGTH( 0x1C5 );
+            NEXT( CYCLES( 0x1C5 ) );
+        }
+
+        OPCODE( 0x1C6 ) {
+            uint8_t value = READ8( r->HL );
+            InstructionEx::set( value, 0 );
+            WRITE8( r->HL, value );
+            r->PC += LENGTH( 0x1C6 );
+            NEXT( CYCLES( 0x1C6 ) );
+        }
+
+        OPCODE( 0x1C7 ) {
+            InstructionEx::set( r->A, 0 );
+            r->PC += LENGTH( 0x1C7 );
+            NEXT( CYCLES( 0x1C7 ) );
+        }
+
+        OPCODE( 0x1C8 ) {
+            InstructionEx::set( r->B, 1 );
+            r->PC += LENGTH( 0x1C8 );
+            NEXT( CYCLES( 0x1C8 ) );
+        }
+
+        OPCODE( 0x1C9 ) {
+            InstructionEx::set( r->C, 1 );
+            r->PC += LENGTH( 0x1C9 );
+            NEXT( CYCLES( 0x1C9 ) );
+        }
+
+        OPCODE( 0x1CA ) {
+            InstructionEx::set( r->D, 1 );
+            r->PC += LENGTH( 0x1CA );
+            NEXT( CYCLES( 0x1CA ) );
+        }
+
+        OPCODE( 0x1CB ) {
+            InstructionEx::set( r->E, 1 );
+            r->PC += LENGTH( 0x1CB );
+            NEXT( CYCLES( 0x1CB ) );
+        }
+
+        OPCODE( 0x1CC ) {
+            InstructionEx::set( r->H, 1 );
+            r->PC += LENGTH( 0x1CC );
+            NEXT( CYCLES( 0x1CC ) );
+        }
+
+        OPCODE( 0x1CD ) {
+            InstructionEx::set( r->L, 1 );
+            r->PC += LENGTH( 0x1CD );
+            NEXT( CYCLES( 0x1CD ) );
+        }
+
+        OPCODE( 0x1CE ) {
+            uint8_t value = READ8( r->HL );
+            InstructionEx::set( value, 1 );
+            WRITE8( r->HL, value );
+            r->PC += LENGTH( 0x1CE );
+            NEXT( CYCLES( 0x1CE ) );
+        }
+
+        OPCODE( 0x1CF ) {
+            InstructionEx::set( r->A, 1 );
+            r->PC += LENGTH( 0x1CF );
+            NEXT( CYCLES( 0x1CF ) );
+        }
+
+        OPCODE( 0x1D0 ) {
+            InstructionEx::set( r->B, 2 );
+            r->PC += LENGTH( 0x1D0 );
+            NEXT( CYCLES( 0x1D0 ) );
+        }
+
+        OPCODE( 0x1D1 ) {
+            InstructionEx::set( r->C, 2 );
+            r->PC += LENGTH( 0x1D1 );
+            NEXT( CYCLES( 0x1D1 ) );
+        }
+
+        OPCODE( 0x1D2 ) {
+            InstructionEx::set( r->D, 2 );
+            r->PC += LENGTH( 0x1D2 );
+            NEXT( CYCLES( 0x1D2 ) );
+        }
+
+        OPCODE( 0x1D3 ) {
+            InstructionEx::set( r->E, 2 );
+            r->PC += LENGTH( 0x1D3 );
+            NEXT( CYCLES( 0x1D3 ) );
+        }
+
+        OPCODE( 0x1D4 ) {
+            InstructionEx::set( r->H, 2 );
+            r->PC += LENGTH( 0x1D4 );
+            NEXT( CYCLES( 0x1D4 ) );
+        }
+
+        OPCODE( 0x1D5 ) {
+            InstructionEx::set( r->L, 2 );
+            r->PC += LENGTH( 0x1D5 );
+            NEXT( CYCLES( 0x1D5 ) );
+        }
+
+        OPCODE( 0x1D6 ) {
+            uint8_t value = READ8( r->HL );
+            InstructionEx::set( value, 2 );
+            WRITE8( r->HL, value );
+            r->PC += LENGTH( 0x1D6 );
+            NEXT( CYCLES( 0x1D6 ) );
+        }
+
+        OPCODE( 0x1D7 ) {
+            InstructionEx::set( r->A, 2 );
+            r->PC += LENGTH( 0x1D7 );
+            NEXT( CYCLES( 0x1D7 ) );
+        }
+
+        OPCODE( 0x1D8 ) {
+            InstructionEx::set( r->B, 3 );
+            r->PC += LENGTH( 0x1D8 );
+            NEXT( CYCLES( 0x1D8 ) );
+        }
+
+        OPCODE( 0x1D9 ) {
+            InstructionEx::set( r->C, 3 );
+            r->PC += LENGTH( 0x1D9 );
+            NEXT( CYCLES( 0x1D9 ) );
+        }
+
+        OPCODE( 0x1DA ) {
+            InstructionEx::set( r->D, 3 );
+            r->PC += LENGTH( 0x1DA );
+            NEXT( CYCLES( 0x1DA ) );
+        }
+
+        OPCODE( 0x1DB ) {
+            InstructionEx::set( r->E, 3 );
+            r->PC += LENGTH( 0x1DB );
+            NEXT( CYCLES( 0x1DB ) );
+        }
+
+        OPCODE( 0x1DC ) {
+            InstructionEx::set( r->H, 3 );
+            r->PC += LENGTH( 0x1DC );
+            NEXT( CYCLES( 0x1DC ) );
+        }
+
+        OPCODE( 0x1DD ) {
+            InstructionEx::set( r->L, 3 );
+            r->PC += LENGTH( 0x1DD );
+            NEXT( CYCLES( 0x1DD ) );
+        }
+
+        OPCODE( 0x1DE ) {
+            uint8_t value = READ8( r->HL );
+            InstructionEx::set( value, 3 );
+            WRITE8( r->HL, value );
+            r->PC += LENGTH( 0x1DE );
+            NEXT( CYCLES( 0x1DE ) );
+        }
+
+        OPCODE( 0x1DF ) {
+            InstructionEx::set( r->A, 3 );
+            r->PC += LENGTH( 0x1DF );
+            NEXT( CYCLES( 0x1DF ) );
+        }
+
+        OPCODE( 0x1E0 ) {
+            InstructionEx::set( r->B, 4 );
+            r->PC += LENGTH( 0x1E0 );
+            NEXT( CYCLES( 0x1E0 ) );
+        }
+
+        OPCODE( 0x1E1 ) {
+            InstructionEx::set( r->C, 4 );
+            r->PC += LENGTH( 0x1E1 );
+            NEXT( CYCLES( 0x1E1 ) );
+        }
+
+        OPCODE( 0x1E2 ) {
+            InstructionEx::set( r->D, 4 );
+            r->PC += LENGTH( 0x1E2 );
+            NEXT( CYCLES( 0x1E2 ) );
+        }
+
+        OPCODE( 0x1E3 ) {
+            InstructionEx::set( r->E, 4 );
+            r->PC += LENGTH( 0x1E3 );
+            NEXT( CYCLES( 0x1E3 ) );
+        }
+
+        OPCODE( 0x1E4 ) {
+            InstructionEx::set( r->H, 4 );
+            r->PC += LENGTH( 0x1E4 );
+            NEXT( CYCLES( 0x1E4 ) );
+        }
+
+        OPCODE( 0x1E5 ) {
+            InstructionEx::set( r->L, 4 );
+            r->PC += LENGTH( 0x1E5 );
+            NEXT( CYCLES( 0x1E5 ) );
+        }
+
+        OPCODE( 0x1E6 ) {
+            uint8_t value = READ8( r->HL );
+            InstructionEx::set( value, 4 );
+            WRITE8( r->HL, value );
+            r->PC += LENGTH( 0x1E6 );
+            NEXT( CYCLES( 0x1E6 ) );
+        }
+
+        OPCODE( 0x1E7 ) {
+            InstructionEx::set( r->A, 4 );
+            r->PC += LENGTH( 0x1E7 );
+            NEXT( CYCLES( 0x1E7 ) );
+        }
+
+        OPCODE( 0x1E8 ) {
+            InstructionEx::set( r->B, 5 );
+            r->PC += LENGTH( 0x1E8 );
+            NEXT( CYCLES( 0x1E8 ) );
+        }
+
+        OPCODE( 0x1E9 ) {
+            InstructionEx::set( r->C, 5 );
+            r->PC += LENGTH( 0x1E9 );
+            NEXT( CYCLES( 0x1E9 ) );
+        }
+
+        OPCODE( 0x1EA ) {
+            InstructionEx::set( r->D, 5 );
+            r->PC += LENGTH( 0x1EA );
+            NEXT( CYCLES( 0x1EA ) );
+        }
+
+        OPCODE( 0x1EB ) {
+            InstructionEx::set( r->E, 5 );
+            r->PC += LENGTH( 0x1EB );
+            NEXT( CYCLES( 0x1EB ) );
+        }
+
+        OPCODE( 0x1EC ) {
+            InstructionEx::set( r->H, 5 );
+            r->PC += LENGTH( 0x1EC );
+            NEXT( CYCLES( 0x1EC ) );
+        }
+
+        OPCODE( 0x1ED ) {
+            InstructionEx::set( r->L, 5 );
+            r->PC += LENGTH( 0x1ED );
+            NEXT( CYCLES( 0x1ED ) );
+        }
+
+        OPCODE( 0x1EE ) {
+            uint8_t value = READ8( r->HL );
+            InstructionEx::set( value, 5 );
+            WRITE8( r->HL, value );
+            r->PC += LENGTH( 0x1EE );
+            NEXT( CYCLES( 0x1EE ) );
+        }
+
+        OPCODE( 0x1EF ) {
+            InstructionEx::set( r->A, 5 );
+            r->PC += LENGTH( 0x1EF );
+            NEXT( CYCLES( 0x1EF ) );
+        }
+
+        OPCODE( 0x1F0 ) {
+            InstructionEx::set( r->B, 6 );
+            r->PC += LENGTH( 0x1F0 );
+            NEXT( CYCLES( 0x1F0 ) );
+        }
+
+        OPCODE( 0x1F1 ) {
+            InstructionEx::set( r->C, 6 );
+            r->PC += LENGTH( 0x1F1 );
+            NEXT( CYCLES( 0x1F1 ) );
+        }
+
+        OPCODE( 0x1F2 ) {
+            InstructionEx::set( r->D, 6 );
+            r->PC += LENGTH( 0x1F2 );
+            NEXT( CYCLES( 0x1F2 ) );
+        }
+
+        OPCODE( 0x1F3 ) {
+            InstructionEx::set( r->E, 6 );
+            r->PC += LENGTH( 0x1F3 );
+            NEXT( CYCLES( 0x1F3 ) );
+        }
+
+        OPCODE( 0x1F4 ) {
+            InstructionEx::set( r->H, 6 );
+            r->PC += LENGTH( 0x1F4 );
+            NEXT( CYCLES( 0x1F4 ) );
+        }
+
+        OPCODE( 0x1F5 ) {
+            InstructionEx::set( r->L, 6 );
+            r->PC += LENGTH( 0x1F5 );
+            NEXT( CYCLES( 0x1F5 ) );
+        }
+
+        OPCODE( 0x1F6 ) {
+            uint8_t value = READ8( r->HL );
+            InstructionEx::set( value, 6 );
+            WRITE8( r->HL, value );
+            r->PC += LENGTH( 0x1F6 );
+            NEXT( CYCLES( 0x1F6 ) );
+        }
+
+        OPCODE( 0x1F7 ) {
+            InstructionEx::set( r->A, 6 );
+            r->PC += LENGTH( 0x1F7 );
+            NEXT( CYCLES( 0x1F7 ) );
+        }
+
+        OPCODE( 0x1F8 ) {
+            InstructionEx::set( r->B, 7 );
+            r->PC += LENGTH( 0x1F8 );
+            NEXT( CYCLES( 0x1F8 ) );
+        }
+
+        OPCODE( 0x1F9 ) {
+            InstructionEx::set( r->C, 7 );
+            r->PC += LENGTH( 0x1F9 );
+            NEXT( CYCLES( 0x1F9 ) );
+        }
+
+        OPCODE( 0x1FA ) {
+            InstructionEx::set( r->D, 7 );
+            r->PC += LENGTH( 0x1FA );
+            NEXT( CYCLES( 0x1FA ) );
+        }
+
+        OPCODE( 0x1FB ) {
+            InstructionEx::set( r->E, 7 );
+            r->PC += LENGTH( 0x1FB );
+            NEXT( CYCLES( 0x1FB ) );
+        }
+
+        OPCODE( 0x1FC ) {
+            InstructionEx::set( r->H, 7 );
+            r->PC += LENGTH( 0x1FC );
+            NEXT( CYCLES( 0x1FC ) );
+        }
+
+        OPCODE( 0x1FD ) {
+            InstructionEx::set( r->L, 7 );
+            r->PC += LENGTH( 0x1FD );
+            NEXT( CYCLES( 0x1FD ) );
+        }
+
+        OPCODE( 0x1FE ) {
+            uint8_t value = READ8( r->HL );
+            InstructionEx::set( value, 7 );
+            WRITE8( r->HL, value );
+            r->PC += LENGTH( 0x1FE );
+            NEXT( CYCLES( 0x1FE ) );
+        }
+
+        OPCODE( 0x1FF ) {
+            InstructionEx::set( r->A, 7 );
+            r->PC += LENGTH( 0x1FF );
+            NEXT( CYCLES( 0x1FF ) );
+        }
+
+#undef LENGTH
+#undef CYCLES
+#undef TAKEN
+
+#endif
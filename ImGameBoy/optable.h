@@ -0,0 +1,347 @@
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include "memory.h"
+
+// Metadata of all 512 opcodes (0x000-0x0FF primary, 0x100-0x1FF CB page): length,
+// T-cycles, operands, flag effects and mnemonic. The table is built at compile time
+// from the opcode bits, so the cores, the disassembler and the tools all read the same
+// 4kB array instead of keeping their own copies.
+
+enum OpName : uint8_t {
+    OPN_ILLEGAL = 0,
+    OPN_NOP, OPN_LD, OPN_INC, OPN_DEC, OPN_RLCA, OPN_RRCA, OPN_RLA, OPN_RRA, OPN_STOP,
+    OPN_JR, OPN_DAA, OPN_CPL, OPN_SCF, OPN_CCF, OPN_HALT,
+    OPN_ADD, OPN_ADC, OPN_SUB, OPN_SBC, OPN_AND, OPN_XOR, OPN_OR, OPN_CP,
+    OPN_RET, OPN_RETI, OPN_POP, OPN_PUSH, OPN_JP, OPN_CALL, OPN_RST, OPN_PREFIX, OPN_DI, OPN_EI,
+    OPN_RLC, OPN_RRC, OPN_RL, OPN_RR, OPN_SLA, OPN_SRA, OPN_SWAP, OPN_SRL, OPN_BIT, OPN_RES, OPN_SET,
+    OPN_COUNT
+};
+
+static const char* const op_names[OPN_COUNT] = {
+    "ILLEGAL",
+    "NOP", "LD", "INC", "DEC", "RLCA", "RRCA", "RLA", "RRA", "STOP",
+    "JR", "DAA", "CPL", "SCF", "CCF", "HALT",
+    "ADD", "ADC", "SUB", "SBC", "AND", "XOR", "OR", "CP",
+    "RET", "RETI", "POP", "PUSH", "JP", "CALL", "RST", "PREFIX", "DI", "EI",
+    "RLC", "RRC", "RL", "RR", "SLA", "SRA", "SWAP", "SRL", "BIT", "RES", "SET",
+};
+
+enum OpOperand : uint8_t {
+    OPD_NONE = 0,
+    OPD_B, OPD_C, OPD_D, OPD_E, OPD_H, OPD_L, OPD_HL_IND, OPD_A, // bits 0-2 order
+    OPD_BC, OPD_DE, OPD_HL, OPD_SP, OPD_AF,
+    OPD_BC_IND, OPD_DE_IND, OPD_HLI_IND, OPD_HLD_IND, OPD_C_IND, // (C) is 0xFF00 + C
+    OPD_NZ, OPD_Z, OPD_NC, OPD_CY, // conditions
+    OPD_D8, OPD_D16, // immediates
+    OPD_A8_IND, OPD_A16_IND, // (0xFF00 + n), (nn)
+    OPD_R8, // JR target
+    OPD_E8, // signed immediate of ADD SP,e8
+    OPD_SP_E8, // SP + e8 of LD HL,SP+e8
+    OPD_BIT0, // OPD_BIT0 + n is bit n of BIT/RES/SET
+    OPD_RST = OPD_BIT0 + 8, // vector in bits 3-5 of the opcode
+    OPD_COUNT
+};
+
+// How an opcode changes PC and the CPU state, beyond falling through by its length
+enum OpControl : uint8_t {
+    OPC_JUMP = 1 << 0, // JR, JP
+    OPC_CALL = 1 << 1, // CALL, RST
+    OPC_RETURN = 1 << 2, // RET, RETI
+    OPC_CONDITIONAL = 1 << 3, // cycles_taken applies when the condition holds
+    OPC_STOP = 1 << 4, // HALT, STOP
+    OPC_ILLEGAL = 1 << 5, // locks up real hardware
+    OPC_BRANCH = OPC_JUMP | OPC_CALL | OPC_RETURN,
+};
+
+// Flag effects, two bits per flag (Z 7-6, N 5-4, H 3-2, C 1-0)
+enum OpFlag : uint8_t {
+    OPF_KEEP = 0, // -
+    OPF_RESET = 1, // 0
+    OPF_SET = 2, // 1
+    OPF_CHANGE = 3, // depends on the result
+};
+
+struct OpInfo {
+    uint8_t name; // OpName
+    uint8_t length; // bytes, including the 0xCB prefix
+    uint8_t cycles; // T-cycles, branch not taken for conditional instructions
+    uint8_t cycles_taken; // T-cycles when a conditional branch is taken
+    uint8_t dst; // OpOperand
+    uint8_t src;
+    uint8_t flags; // OpFlag per flag
+    uint8_t control; // OpControl
+
+    // Effect on flag shift (6 Z, 4 N, 2 H, 0 C)
+    constexpr uint8_t effect( int shift ) const
+    {
+        return ( flags >> shift ) & 3;
+    }
+
+    constexpr bool ends_block( void ) const
+    {
+        return ( control & ( OPC_BRANCH | OPC_STOP ) ) != 0;
+    }
+};
+
+class OpTable
+{
+private:
+    // Flag effects written the usual way, "Z0H-": letter changes, 0 and 1 force, - keeps
+    static constexpr uint8_t fx( const char* s )
+    {
+        uint8_t f = 0;
+        for ( int i = 0; i < 4; i++ ) {
+            uint8_t e = s[i] == '-' ? OPF_KEEP : s[i] == '0' ? OPF_RESET : s[i] == '1' ? OPF_SET : OPF_CHANGE;
+            f = ( f << 2 ) | e;
+        }
+        return f;
+    }
+
+    static constexpr OpInfo make( uint8_t name, uint8_t length, uint8_t cycles, uint8_t dst = OPD_NONE, uint8_t src = OPD_NONE,
+                                  const char* flags = "----", uint8_t control = 0, uint8_t taken = 0 )
+    {
+        return OpInfo{ name, length, cycles, (uint8_t)( taken ? taken : cycles ), dst, src, fx( flags ), control };
+    }
+
+    static constexpr uint8_t r8( int index )
+    {
+        return OPD_B + ( index & 7 );
+    }
+
+    static constexpr uint8_t r16( int index ) // BC DE HL SP
+    {
+        return OPD_BC + ( index & 3 );
+    }
+
+    static constexpr uint8_t r16_stack( int index ) // BC DE HL AF
+    {
+        return ( index & 3 ) == 3 ? OPD_AF : OPD_BC + ( index & 3 );
+    }
+
+    static constexpr uint8_t cond( int index )
+    {
+        return OPD_NZ + ( index & 3 );
+    }
+
+    static constexpr OpInfo alu( int op, uint8_t src, uint8_t cycles, uint8_t length )
+    {
+        return make( (uint8_t)( OPN_ADD + op ), length, cycles, OPD_A, src, op < 2 ? "Z0HC" : op < 4 ? "Z1HC" : op == 4 ? "Z010" : op < 7 ? "Z000" : "Z1HC" );
+    }
+
+    static constexpr OpInfo cb( uint8_t op )
+    {
+        uint8_t reg = r8( op );
+        uint8_t hl = ( op & 7 ) == 6;
+        uint8_t y = ( op >> 3 ) & 7;
+
+        switch ( op >> 6 ) {
+        case 0:
+            return make( OPN_RLC + y, 2, hl ? 16 : 8, reg, OPD_NONE, y == 6 ? "Z000" : "Z00C" );
+        case 1:
+            return make( OPN_BIT, 2, hl ? 12 : 8, OPD_BIT0 + y, reg, "Z01-" );
+        case 2:
+            return make( OPN_RES, 2, hl ? 16 : 8, OPD_BIT0 + y, reg );
+        default:
+            return make( OPN_SET, 2, hl ? 16 : 8, OPD_BIT0 + y, reg );
+        }
+    }
+
+    static constexpr OpInfo primary( uint8_t op )
+    {
+        uint8_t x = op >> 6, y = ( op >> 3 ) & 7, z = op & 7;
+
+        // LD r,r' and the ALU block follow the register order in bits 0-5
+        if ( op == 0x76 ) {
+            return make( OPN_HALT, 1, 4, OPD_NONE, OPD_NONE, "----", OPC_STOP );
+        }
+        if ( x == 1 ) {
+            return make( OPN_LD, 1, ( y == 6 || z == 6 ) ? 8 : 4, r8( y ), r8( z ) );
+        }
+        if ( x == 2 ) {
+            return alu( y, r8( z ), z == 6 ? 8 : 4, 1 );
+        }
+
+        if ( x == 0 ) {
+            switch ( z ) {
+            case 3:
+                return make( op & 8 ? OPN_DEC : OPN_INC, 1, 8, r16( y >> 1 ) );
+            case 4:
+                return make( OPN_INC, 1, y == 6 ? 12 : 4, r8( y ), OPD_NONE, "Z0H-" );
+            case 5:
+                return make( OPN_DEC, 1, y == 6 ? 12 : 4, r8( y ), OPD_NONE, "Z1H-" );
+            case 6:
+                return make( OPN_LD, 2, y == 6 ? 12 : 8, r8( y ), OPD_D8 );
+            case 1:
+                if ( op & 8 ) {
+                    return make( OPN_ADD, 1, 8, OPD_HL, r16( y >> 1 ), "-0HC" );
+                }
+                return make( OPN_LD, 3, 12, r16( y >> 1 ), OPD_D16 );
+            case 2: {
+                // (BC) (DE) (HL+) (HL-)
+                uint8_t ind = OPD_BC_IND + ( y >> 1 );
+                return op & 8 ? make( OPN_LD, 1, 8, OPD_A, ind ) : make( OPN_LD, 1, 8, ind, OPD_A );
+            }
+            default:
+                break;
+            }
+        }
+
+        if ( x == 3 ) {
+            switch ( z ) {
+            case 0:
+                if ( y < 4 ) {
+                    return make( OPN_RET, 1, 8, cond( y ), OPD_NONE, "----", OPC_RETURN | OPC_CONDITIONAL, 20 );
+                }
+                break;
+            case 1:
+                if ( !( y & 1 ) ) {
+                    return make( OPN_POP, 1, 12, r16_stack( y >> 1 ), OPD_NONE, y == 6 ? "ZNHC" : "----" );
+                }
+                break;
+            case 2:
+                if ( y < 4 ) {
+                    return make( OPN_JP, 3, 12, cond( y ), OPD_D16, "----", OPC_JUMP | OPC_CONDITIONAL, 16 );
+                }
+                break;
+            case 4:
+                if ( y < 4 ) {
+                    return make( OPN_CALL, 3, 12, cond( y ), OPD_D16, "----", OPC_CALL | OPC_CONDITIONAL, 24 );
+                }
+                return make( OPN_ILLEGAL, 1, 4, OPD_NONE, OPD_NONE, "----", OPC_ILLEGAL );
+            case 5:
+                if ( !( y & 1 ) ) {
+                    return make( OPN_PUSH, 1, 16, r16_stack( y >> 1 ) );
+                }
+                if ( y == 1 ) {
+                    return make( OPN_CALL, 3, 24, OPD_D16, OPD_NONE, "----", OPC_CALL );
+                }
+                return make( OPN_ILLEGAL, 1, 4, OPD_NONE, OPD_NONE, "----", OPC_ILLEGAL );
+            case 6:
+                return alu( y, OPD_D8, 8, 2 );
+            case 7:
+                return make( OPN_RST, 1, 16, OPD_RST, OPD_NONE, "----", OPC_CALL );
+            default:
+                break;
+            }
+        }
+
+        switch ( op ) {
+        case 0x00: return make( OPN_NOP, 1, 4 );
+        case 0x07: return make( OPN_RLCA, 1, 4, OPD_NONE, OPD_NONE, "000C" );
+        case 0x08: return make( OPN_LD, 3, 20, OPD_A16_IND, OPD_SP );
+        case 0x0F: return make( OPN_RRCA, 1, 4, OPD_NONE, OPD_NONE, "000C" );
+        case 0x10: return make( OPN_STOP, 2, 4, OPD_NONE, OPD_NONE, "----", OPC_STOP );
+        case 0x17: return make( OPN_RLA, 1, 4, OPD_NONE, OPD_NONE, "000C" );
+        case 0x18: return make( OPN_JR, 2, 12, OPD_R8, OPD_NONE, "----", OPC_JUMP );
+        case 0x1F: return make( OPN_RRA, 1, 4, OPD_NONE, OPD_NONE, "000C" );
+        case 0x20: case 0x28: case 0x30: case 0x38:
+            return make( OPN_JR, 2, 8, cond( y - 4 ), OPD_R8, "----", OPC_JUMP | OPC_CONDITIONAL, 12 );
+        case 0x27: return make( OPN_DAA, 1, 4, OPD_NONE, OPD_NONE, "Z-0C" );
+        case 0x2F: return make( OPN_CPL, 1, 4, OPD_NONE, OPD_NONE, "-11-" );
+        case 0x37: return make( OPN_SCF, 1, 4, OPD_NONE, OPD_NONE, "-001" );
+        case 0x3F: return make( OPN_CCF, 1, 4, OPD_NONE, OPD_NONE, "-00C" );
+        case 0xC3: return make( OPN_JP, 3, 16, OPD_D16, OPD_NONE, "----", OPC_JUMP );
+        case 0xC9: return make( OPN_RET, 1, 16, OPD_NONE, OPD_NONE, "----", OPC_RETURN );
+        case 0xCB: return make( OPN_PREFIX, 2, 4 ); // whole CB instruction is in 0x100-0x1FF
+        case 0xD9: return make( OPN_RETI, 1, 16, OPD_NONE, OPD_NONE, "----", OPC_RETURN );
+        case 0xE0: return make( OPN_LD, 2, 12, OPD_A8_IND, OPD_A );
+        case 0xE2: return make( OPN_LD, 1, 8, OPD_C_IND, OPD_A );
+        case 0xE8: return make( OPN_ADD, 2, 16, OPD_SP, OPD_E8, "00HC" );
+        case 0xE9: return make( OPN_JP, 1, 4, OPD_HL, OPD_NONE, "----", OPC_JUMP );
+        case 0xEA: return make( OPN_LD, 3, 16, OPD_A16_IND, OPD_A );
+        case 0xF0: return make( OPN_LD, 2, 12, OPD_A, OPD_A8_IND );
+        case 0xF2: return make( OPN_LD, 1, 8, OPD_A, OPD_C_IND );
+        case 0xF3: return make( OPN_DI, 1, 4 );
+        case 0xF8: return make( OPN_LD, 2, 12, OPD_HL, OPD_SP_E8, "00HC" );
+        case 0xF9: return make( OPN_LD, 1, 8, OPD_SP, OPD_HL );
+        case 0xFA: return make( OPN_LD, 3, 16, OPD_A, OPD_A16_IND );
+        case 0xFB: return make( OPN_EI, 1, 4 );
+        default:
+            return make( OPN_ILLEGAL, 1, 4, OPD_NONE, OPD_NONE, "----", OPC_ILLEGAL );
+        }
+    }
+
+public:
+    OpInfo op[0x200];
+
+    constexpr OpTable( void )
+        : op()
+    {
+        for ( int i = 0; i < 0x100; i++ ) {
+            op[i] = primary( (uint8_t)i );
+            op[0x100 | i] = cb( (uint8_t)i );
+        }
+    }
+
+    constexpr const OpInfo& operator[]( uint16_t opcode ) const
+    {
+        return op[opcode];
+    }
+
+    // Opcode at addr, CB instructions as 0x100-0x1FF
+    static uint16_t fetch( Memory* m, uint16_t addr )
+    {
+        uint16_t opcode = m->peek( addr );
+        return opcode == 0xCB ? 0x100 | m->peek( addr + 1 ) : opcode;
+    }
+
+    // Writes the instruction at addr to dst and returns its length
+    int dis( char* dst, size_t size, Memory* m, uint16_t addr ) const;
+};
+
+static constexpr OpTable optable;
+
+static_assert( sizeof( OpInfo ) == 8, "OpInfo is packed 8 to a cache line" );
+static_assert( optable[0x01].length == 3 && optable[0xCB].length == 2 && optable[0x1C6].cycles == 16, "OpTable" );
+
+inline int OpTable::dis( char* dst, size_t size, Memory* m, uint16_t addr ) const
+{
+    uint16_t opcode = fetch( m, addr );
+    const OpInfo& info = op[opcode];
+
+    uint8_t imm8 = m->peek( addr + info.length - 1 );
+    uint16_t imm16 = m->peek( addr + 1 ) | ( m->peek( addr + 2 ) << 8 );
+
+    static const char* const names[] = {
+        "", "B", "C", "D", "E", "H", "L", "(HL)", "A", "BC", "DE", "HL", "SP", "AF",
+        "(BC)", "(DE)", "(HL+)", "(HL-)", "(0xFF00 + C)", "NZ", "Z", "NC", "C",
+    };
+
+    char operand[2][24];
+    for ( int i = 0; i < 2; i++ ) {
+        uint8_t kind = i ? info.src : info.dst;
+
+        if ( kind < sizeof( names ) / sizeof( names[0] ) ) {
+            snprintf( operand[i], sizeof( operand[i] ), "%s", names[kind] );
+        } else if ( kind == OPD_D8 ) {
+            snprintf( operand[i], sizeof( operand[i] ), "%#02x", imm8 );
+        } else if ( kind == OPD_D16 ) {
+            snprintf( operand[i], sizeof( operand[i] ), "%#04x", imm16 );
+        } else if ( kind == OPD_A8_IND ) {
+            snprintf( operand[i], sizeof( operand[i] ), "(%#04x)", 0xFF00 | imm8 );
+        } else if ( kind == OPD_A16_IND ) {
+            snprintf( operand[i], sizeof( operand[i] ), "(%#04x)", imm16 );
+        } else if ( kind == OPD_R8 ) {
+            snprintf( operand[i], sizeof( operand[i] ), "%#04x", ( uint16_t )( addr + 2 + (int8_t)imm8 ) );
+        } else if ( kind == OPD_E8 ) {
+            snprintf( operand[i], sizeof( operand[i] ), "%+d", (int8_t)imm8 );
+        } else if ( kind == OPD_SP_E8 ) {
+            snprintf( operand[i], sizeof( operand[i] ), "SP%+d", (int8_t)imm8 );
+        } else if ( kind == OPD_RST ) {
+            snprintf( operand[i], sizeof( operand[i] ), "0x%02X", opcode & 0x38 );
+        } else {
+            snprintf( operand[i], sizeof( operand[i] ), "%d", kind - OPD_BIT0 );
+        }
+    }
+
+    if ( info.src ) {
+        snprintf( dst, size, "%s %s, %s", op_names[info.name], operand[0], operand[1] );
+    } else if ( info.dst ) {
+        snprintf( dst, size, "%s %s", op_names[info.name], operand[0] );
+    } else {
+        snprintf( dst, size, "%s", op_names[info.name] );
+    }
+
+    return info.length;
+}
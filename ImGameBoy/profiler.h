@@ -0,0 +1,134 @@
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <algorithm>
+#include <vector>
+#include "memory.h"
+#include "slots.h"
+
+// Where the CPU spends its time: executions and T-cycles per instruction address,
+// with banked ROM told apart. The counters are flat arrays indexed by CodeSlots slot.
+//
+// Emulator only records while enabled and then takes its one instruction at a time
+// path, so a disabled profiler costs nothing.
+
+struct ProfileEntry {
+    int bank; // ROM bank, -1 outside the cartridge ROM
+    uint16_t address;
+    uint64_t count;
+    uint64_t cycles;
+};
+
+class Profiler
+{
+private:
+    CodeSlots slots;
+    std::vector<uint64_t> counts; // allocated on the first start()
+    std::vector<uint64_t> cycles;
+    uint64_t total;
+
+public:
+    bool enabled;
+
+    Profiler( void )
+        : total( 0 ), enabled( false )
+    {
+    }
+
+    // Sizes the counters for the cartridge ROM at image, null for none, and drops
+    // what was recorded. Keeps the profiler running if it was.
+    void reset( const uint8_t* image, size_t size )
+    {
+        slots.reset( image, size );
+        counts.clear();
+        cycles.clear();
+        total = 0;
+        if ( enabled ) {
+            start();
+        }
+    }
+
+    void start( void )
+    {
+        if ( counts.empty() ) {
+            counts.assign( slots.count(), 0 );
+            cycles.assign( slots.count(), 0 );
+        }
+        enabled = true;
+    }
+
+    void stop( void )
+    {
+        enabled = false;
+    }
+
+    void clear( void )
+    {
+        std::fill( counts.begin(), counts.end(), 0 );
+        std::fill( cycles.begin(), cycles.end(), 0 );
+        total = 0;
+    }
+
+    // Counter of the instruction at pc as m maps it now, taken before it runs since
+    // it may switch banks
+    size_t slot( const Memory* m, uint16_t pc ) const
+    {
+        return slots.slot( m, pc );
+    }
+
+    void add( size_t slot, int spent )
+    {
+        counts[slot]++;
+        cycles[slot] += spent;
+        total += spent;
+    }
+
+    uint64_t total_cycles( void ) const
+    {
+        return total;
+    }
+
+    // Every address that ran, most cycles first
+    std::vector<ProfileEntry> entries( void ) const
+    {
+        std::vector<ProfileEntry> out;
+        for ( size_t i = 0; i < counts.size(); i++ ) {
+            if ( !counts[i] ) {
+                continue;
+            }
+            ProfileEntry e;
+            e.bank = slots.bank( i );
+            e.address = slots.address( i );
+            e.count = counts[i];
+            e.cycles = cycles[i];
+            out.push_back( e );
+        }
+
+        std::sort( out.begin(), out.end(),
+                   []( const ProfileEntry& a, const ProfileEntry& b ) { return a.cycles > b.cycles; } );
+        return out;
+    }
+
+    // bank,address,count,cycles,share with the bank empty outside the ROM, false
+    // when path can't be written
+    bool export_csv( const char* path ) const
+    {
+        FILE* hFile = fopen( path, "w" );
+        if ( !hFile ) {
+            return false;
+        }
+
+        fprintf( hFile, "bank,address,count,cycles,share\n" );
+        for ( const ProfileEntry& e : entries() ) {
+            if ( e.bank >= 0 ) {
+                fprintf( hFile, "%d,", e.bank );
+            } else {
+                fprintf( hFile, "," );
+            }
+            fprintf( hFile, "%04X,%llu,%llu,%.6f\n", e.address, (unsigned long long)e.count,
+                     (unsigned long long)e.cycles, total ? (double)e.cycles / total : 0.0 );
+        }
+
+        return fclose( hFile ) == 0;
+    }
+};
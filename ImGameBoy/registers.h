@@ -1,6 +1,28 @@
 #pragma once
 #include <stdint.h>
 
+// Build with GB_LAZY_FLAGS defined to have the ALU helpers record the last operation
+// instead of writing Z, N, H and C one bit at a time. F is computed from the record
+// only when something reads it: conditional jumps, calls and returns, PUSH AF, DAA,
+// ADC/SBC, the instructions that keep some flags and the debugger. Code that reads a
+// flag uses z()/n()/h()/c(), code that reads F or changes single flags calls
+// sync_flags() first. Without GB_LAZY_FLAGS both are plain bitfield accesses.
+
+enum LazyOp : uint8_t {
+    LAZY_NONE = 0, // F is up to date
+    LAZY_ADD, // Z N H C from a + b
+    LAZY_ADC, // Z N H C from a + b + carry
+    LAZY_SUB, // Z N H C from a - b, also CP
+    LAZY_SBC, // Z N H C from a - b - carry
+    LAZY_AND, // Z, H set
+    LAZY_LOGIC, // Z, XOR and OR
+    LAZY_INC, // Z N H from a + 1, C kept in carry
+    LAZY_DEC, // Z N H from a - 1, C kept in carry
+    LAZY_ROTA, // RLCA RLA RRCA RRA: Z N H clear, C from carry
+    LAZY_SHIFT, // CB rotates, shifts and SWAP: Z, C from carry
+    LAZY_BIT, // BIT: Z, H set, C kept in carry
+};
+
 struct Registers {
     union {
         struct {
@@ -42,8 +64,136 @@ struct Registers {
     uint16_t SP;
     uint16_t PC;
 
+#ifdef GB_LAZY_FLAGS
+    uint8_t lazy; // LazyOp of the last ALU operation
+    uint8_t lazy_a; // operands
+    uint8_t lazy_b;
+    uint8_t lazy_carry; // carry in, C kept or C out, depending on lazy
+    uint8_t lazy_result;
+#endif
+
     Registers( void )
         : AF( 0 ), BC( 0 ), DE( 0 ), HL( 0 ), SP( 0 ), PC( 0 )
+#ifdef GB_LAZY_FLAGS
+        , lazy( LAZY_NONE ), lazy_a( 0 ), lazy_b( 0 ), lazy_carry( 0 ), lazy_result( 0 )
+#endif
+    {
+    }
+
+#ifdef GB_LAZY_FLAGS
+    void record( LazyOp op, uint8_t a, uint8_t b, uint8_t carry, uint8_t result )
+    {
+        lazy = op;
+        lazy_a = a;
+        lazy_b = b;
+        lazy_carry = carry;
+        lazy_result = result;
+    }
+
+    // F as the recorded operation left it
+    uint8_t flags( void ) const
+    {
+        uint8_t z = lazy_result == 0 ? 0x80 : 0;
+        uint8_t a = lazy_a, b = lazy_b, carry = lazy_carry;
+
+        switch ( lazy ) {
+        case LAZY_ADD:
+        case LAZY_ADC:
+            return z | ( ( a & 0xf ) + ( b & 0xf ) + carry > 0xf ? 0x20 : 0 ) | ( a + b + carry > 0xff ? 0x10 : 0 );
+        case LAZY_SUB:
+        case LAZY_SBC:
+            return z | 0x40 | ( ( b & 0xf ) + carry > ( a & 0xf ) ? 0x20 : 0 ) | ( b + carry > a ? 0x10 : 0 );
+        case LAZY_AND:
+            return z | 0x20;
+        case LAZY_LOGIC:
+            return z;
+        case LAZY_INC:
+            return z | ( ( a & 0xf ) == 0xf ? 0x20 : 0 ) | ( carry << 4 );
+        case LAZY_DEC:
+            return z | 0x40 | ( ( a & 0xf ) == 0 ? 0x20 : 0 ) | ( carry << 4 );
+        case LAZY_ROTA:
+            return carry << 4;
+        case LAZY_SHIFT:
+            return z | ( carry << 4 );
+        case LAZY_BIT:
+            return z | 0x20 | ( carry << 4 );
+        default:
+            return F;
+        }
+    }
+
+    void sync_flags( void )
+    {
+        if ( lazy != LAZY_NONE ) {
+            F = flags();
+            lazy = LAZY_NONE;
+        }
+    }
+
+    // Z and C are what conditional jumps test, so they skip the full evaluation
+    bool z( void ) const
+    {
+        switch ( lazy ) {
+        case LAZY_NONE:
+            return Flag.Z;
+        case LAZY_ROTA:
+            return false;
+        default:
+            return lazy_result == 0;
+        }
+    }
+
+    bool c( void ) const
+    {
+        switch ( lazy ) {
+        case LAZY_NONE:
+            return Flag.C;
+        case LAZY_ADD:
+        case LAZY_ADC:
+            return lazy_a + lazy_b + lazy_carry > 0xff;
+        case LAZY_SUB:
+        case LAZY_SBC:
+            return lazy_b + lazy_carry > lazy_a;
+        case LAZY_AND:
+        case LAZY_LOGIC:
+            return false;
+        default:
+            return lazy_carry;
+        }
+    }
+
+    bool n( void ) const
+    {
+        return flags() & 0x40;
+    }
+
+    bool h( void ) const
+    {
+        return flags() & 0x20;
+    }
+#else
+    void sync_flags( void )
+    {
+    }
+
+    bool z( void ) const
+    {
+        return Flag.Z;
+    }
+
+    bool c( void ) const
+    {
+        return Flag.C;
+    }
+
+    bool n( void ) const
+    {
+        return Flag.N;
+    }
+
+    bool h( void ) const
     {
+        return Flag.H;
     }
-};
\ No newline at end of file
+#endif
+};
@@ -0,0 +1,277 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <vector>
+
+// Rewind buffer: one save state per frame, stored as the XOR against the last
+// keyframe, run length encoded. A frame changes a few hundred bytes of a ~100kB
+// state, so the XOR is almost all zeros and encodes to a few kB. Every KEY_INTERVAL
+// frames a keyframe is stored, encoded against zeros, so a delta never depends on
+// more than one other entry.
+//
+// reset() allocates everything up front, the arena, the ring of entries, the keyframe
+// a new delta is taken against and scratch space, so push() and pop() allocate
+// nothing. A machine that doesn't rewind never calls it, or gives it all back with
+// release().
+// When the arena or the entry ring is full, push() drops the oldest entries, and a
+// keyframe takes the deltas taken against it along.
+//
+// Encoding, a sequence of
+//   uint16_t zeros      bytes equal to the keyframe
+//   uint16_t literals   bytes that differ, followed by their XOR
+// covering the whole state.
+
+class Rewind
+{
+private:
+    struct Entry {
+        size_t offset; // in arena
+        size_t length;
+        bool key;
+    };
+
+    std::vector<uint8_t> arena;
+    std::vector<Entry> entries; // ring, oldest at tail
+    size_t arena_bytes;
+    size_t max_frames;
+    size_t tail;
+    size_t count;
+    size_t write_pos; // arena offset right after the newest entry
+
+    size_t state_size;
+    std::vector<uint8_t> key; // raw keyframe the newest entry was taken against
+    std::vector<uint8_t> zero; // keyframes are encoded against this
+    std::vector<uint8_t> scratch; // encoder output, worst case size
+    int since_key; // deltas pushed since key
+
+    Entry& entry( size_t i )
+    {
+        return entries[( tail + i ) % entries.size()];
+    }
+
+    static uint64_t word( const uint8_t* p )
+    {
+        uint64_t w;
+        memcpy( &w, p, sizeof( w ) );
+        return w;
+    }
+
+    // Encodes state against base into out and returns the length
+    static size_t encode( uint8_t* out, const uint8_t* state, const uint8_t* base, size_t size )
+    {
+        uint8_t* o = out;
+        size_t i = 0;
+
+        while ( i < size ) {
+            // Equal bytes, a word at a time while possible
+            size_t start = i;
+            while ( i + 8 <= size && i - start + 8 <= 0xFFFF && word( &state[i] ) == word( &base[i] ) ) {
+                i += 8;
+            }
+            while ( i < size && i - start < 0xFFFF && state[i] == base[i] ) {
+                i++;
+            }
+            uint16_t zeros = (uint16_t)( i - start );
+
+            // Differing bytes, up to a run of 4 equal ones, which is what a token costs
+            size_t lit = i;
+            while ( i < size && i - lit < 0xFFFF ) {
+                if ( state[i] != base[i] ) {
+                    i++;
+                    continue;
+                }
+
+                size_t same = i;
+                while ( same < size && same - i < 4 && state[same] == base[same] ) {
+                    same++;
+                }
+                if ( same - i >= 4 || same == size ) {
+                    break;
+                }
+                i = same;
+            }
+            if ( i - lit > 0xFFFF ) {
+                i = lit + 0xFFFF;
+            }
+            uint16_t literals = (uint16_t)( i - lit );
+
+            memcpy( o, &zeros, 2 );
+            memcpy( o + 2, &literals, 2 );
+            o += 4;
+            for ( size_t k = 0; k < literals; k++ ) {
+                o[k] = state[lit + k] ^ base[lit + k];
+            }
+            o += literals;
+        }
+
+        return o - out;
+    }
+
+    static void decode( uint8_t* state, const uint8_t* in, size_t length, const uint8_t* base, size_t size )
+    {
+        const uint8_t* end = in + length;
+        size_t pos = 0;
+
+        memcpy( state, base, size );
+        while ( in < end ) {
+            uint16_t zeros, literals;
+            memcpy( &zeros, in, 2 );
+            memcpy( &literals, in + 2, 2 );
+            in += 4;
+            pos += zeros;
+            for ( size_t k = 0; k < literals; k++ ) {
+                state[pos + k] ^= in[k];
+            }
+            in += literals;
+            pos += literals;
+        }
+    }
+
+    void drop_oldest( void )
+    {
+        tail = ( tail + 1 ) % entries.size();
+        count--;
+
+        // Deltas without their keyframe are useless
+        while ( count && !entry( 0 ).key ) {
+            tail = ( tail + 1 ) % entries.size();
+            count--;
+        }
+    }
+
+    // Arena offset for length bytes, dropping the oldest entries in the way. Past the
+    // end of the arena it starts over at 0, and the entries between write_pos and
+    // the end are older than any at the start.
+    size_t reserve( size_t length )
+    {
+        bool wrap = write_pos + length > arena.size();
+        size_t pos = wrap ? 0 : write_pos;
+
+        while ( count ) {
+            const Entry& oldest = entry( 0 );
+            bool overlaps = oldest.offset < pos + length && pos < oldest.offset + oldest.length;
+            bool behind = wrap && oldest.offset >= write_pos;
+            if ( !overlaps && !behind && count < entries.size() ) {
+                break;
+            }
+            drop_oldest();
+        }
+
+        return pos;
+    }
+
+public:
+    static const int KEY_INTERVAL = 60; // frames, one keyframe a second
+
+    // arena_bytes of compressed states, at most max_frames of them
+    Rewind( size_t arena_bytes = 64 << 20, size_t max_frames = 60 * 60 * 5 )
+        : arena_bytes( arena_bytes ), max_frames( max_frames ), tail( 0 ), count( 0 ), write_pos( 0 ),
+          state_size( 0 ), since_key( 0 )
+    {
+    }
+
+    // Drops every frame and takes states of size bytes from now on
+    void reset( size_t size )
+    {
+        arena.resize( arena_bytes );
+        entries.resize( max_frames );
+        tail = count = write_pos = 0;
+        since_key = 0;
+        state_size = size;
+        key.assign( size, 0 );
+        zero.assign( size, 0 );
+        // Worst case, a token every 0xFFFF bytes plus one per 4 byte gap
+        scratch.resize( size + ( size / 4 + 2 ) * 4 );
+    }
+
+    // Frees what reset() allocated, push() needs another reset() afterwards
+    void release( void )
+    {
+        tail = count = write_pos = 0;
+        since_key = 0;
+        state_size = 0;
+        std::vector<uint8_t>().swap( arena );
+        std::vector<Entry>().swap( entries );
+        std::vector<uint8_t>().swap( key );
+        std::vector<uint8_t>().swap( zero );
+        std::vector<uint8_t>().swap( scratch );
+    }
+
+    // Stores the state of the frame that just ran
+    void push( const uint8_t* state )
+    {
+        bool keyframe = !count || since_key >= KEY_INTERVAL;
+        size_t length = encode( scratch.data(), state, keyframe ? zero.data() : key.data(), state_size );
+        if ( length > arena.size() ) {
+            return;
+        }
+
+        size_t pos = reserve( length );
+        if ( keyframe || !count ) {
+            // reserve may have dropped the keyframe this delta was going against
+            if ( !keyframe ) {
+                length = encode( scratch.data(), state, zero.data(), state_size );
+                pos = reserve( length );
+            }
+            memcpy( key.data(), state, state_size );
+            keyframe = true;
+            since_key = 0;
+        }
+        else {
+            since_key++;
+        }
+
+        memcpy( &arena[pos], scratch.data(), length );
+        entry( count ) = Entry{ pos, length, keyframe };
+        count++;
+        write_pos = pos + length;
+    }
+
+    // Takes the newest frame off into state, or just drops it when state is null.
+    // False when there is none.
+    bool pop( uint8_t* state )
+    {
+        if ( !count ) {
+            return false;
+        }
+
+        Entry last = entry( count - 1 );
+        if ( state ) {
+            decode( state, &arena[last.offset], last.length, last.key ? zero.data() : key.data(), state_size );
+        }
+        count--;
+        write_pos = last.offset;
+
+        if ( last.key && count ) {
+            // The frames before go against the keyframe before this one
+            size_t i = count - 1;
+            while ( !entry( i ).key ) {
+                i--;
+            }
+            const Entry& prev = entry( i );
+            decode( key.data(), &arena[prev.offset], prev.length, zero.data(), state_size );
+            since_key = (int)( count - 1 - i );
+        }
+        else if ( !last.key ) {
+            since_key--;
+        }
+
+        return true;
+    }
+
+    size_t frames( void ) const
+    {
+        return count;
+    }
+
+    // Arena bytes the stored frames take
+    size_t used( void )
+    {
+        size_t bytes = 0;
+        for ( size_t i = 0; i < count; i++ ) {
+            bytes += entry( i ).length;
+        }
+        return bytes;
+    }
+};
@@ -0,0 +1,305 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "cartridge.h"
+
+// Cartridge images, mapped read-only from the file. The Cartridge made from a Rom
+// points its ROM pages straight into the mapping, so the OS pages banks in as the
+// game touches them and nothing is ever copied. Works without the front end:
+//
+//     Rom rom;
+//     if ( !rom.open( path ) ) { puts( rom.error ); }
+//     Cartridge* cart = rom.cartridge();
+//     cart->attach( mem );
+//
+// The Rom has to outlive the Cartridge.
+
+// Decoded 0x0100-0x014F
+struct RomHeader {
+    char title[17]; // 0x0134, NUL terminated, 11 bytes on later cartridges
+    uint8_t cgb; // 0x0143, 0x80 CGB enhanced, 0xC0 CGB only
+    uint8_t type; // 0x0147 cartridge type
+    Mbc mbc;
+    bool battery; // RAM, and the MBC3 clock, survive power off
+    bool timer; // MBC3 RTC
+    uint32_t rom_size; // from 0x0148
+    uint32_t ram_size; // from 0x0149
+    uint8_t header_checksum; // 0x014D, over 0x0134-0x014C
+    uint16_t global_checksum; // 0x014E big endian, over the whole image but itself
+};
+
+class Rom
+{
+private:
+    const uint8_t* image;
+    size_t image_size;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#endif
+
+    // Cartridge types the MBCs of cartridge.h cover
+    static bool decode_type( uint8_t type, RomHeader* header )
+    {
+        header->battery = false;
+        header->timer = false;
+
+        switch ( type ) {
+        case 0x00: // ROM ONLY
+        case 0x08: // ROM+RAM
+            header->mbc = Mbc::NONE;
+            return true;
+        case 0x09: // ROM+RAM+BATTERY
+            header->mbc = Mbc::NONE;
+            header->battery = true;
+            return true;
+        case 0x01: // MBC1
+        case 0x02: // MBC1+RAM
+            header->mbc = Mbc::MBC1;
+            return true;
+        case 0x03: // MBC1+RAM+BATTERY
+            header->mbc = Mbc::MBC1;
+            header->battery = true;
+            return true;
+        case 0x0F: // MBC3+TIMER+BATTERY
+        case 0x10: // MBC3+TIMER+RAM+BATTERY
+            header->mbc = Mbc::MBC3;
+            header->battery = true;
+            header->timer = true;
+            return true;
+        case 0x11: // MBC3
+        case 0x12: // MBC3+RAM
+            header->mbc = Mbc::MBC3;
+            return true;
+        case 0x13: // MBC3+RAM+BATTERY
+            header->mbc = Mbc::MBC3;
+            header->battery = true;
+            return true;
+        case 0x19: // MBC5
+        case 0x1A: // MBC5+RAM
+        case 0x1C: // MBC5+RUMBLE
+        case 0x1D: // MBC5+RUMBLE+RAM
+            header->mbc = Mbc::MBC5;
+            return true;
+        case 0x1B: // MBC5+RAM+BATTERY
+        case 0x1E: // MBC5+RUMBLE+RAM+BATTERY
+            header->mbc = Mbc::MBC5;
+            header->battery = true;
+            return true;
+        default:
+            return false;
+        }
+    }
+
+public:
+    RomHeader header;
+    const char* error; // why open or parse failed, null otherwise
+
+    Rom( void )
+        : image( nullptr ), image_size( 0 ),
+#ifdef _WIN32
+          file( INVALID_HANDLE_VALUE ), mapping( nullptr ),
+#endif
+          header{}, error( nullptr )
+    {
+    }
+
+    ~Rom( void )
+    {
+        close();
+    }
+
+    Rom( const Rom& ) = delete;
+    Rom& operator=( const Rom& ) = delete;
+
+    // Maps the file at path and parses its header. Returns false and sets error
+    // when the file can't be mapped or is not a cartridge this emulator can run.
+    bool open( const char* path )
+    {
+        close();
+
+#ifdef _WIN32
+        file = CreateFileA( path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+        if ( file == INVALID_HANDLE_VALUE ) {
+            error = "Unable to open the file";
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        if ( !GetFileSizeEx( file, &size ) || size.QuadPart > 0x800000 || size.QuadPart < 0x8000 ) {
+            close();
+            error = "Not a cartridge image, the size has to be 32kB to 8MB";
+            return false;
+        }
+        image_size = (size_t)size.QuadPart;
+
+        mapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+        image = mapping ? (const uint8_t*)MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 ) : nullptr;
+#else
+        int fd = ::open( path, O_RDONLY );
+        if ( fd < 0 ) {
+            error = "Unable to open the file";
+            return false;
+        }
+
+        struct stat st;
+        if ( fstat( fd, &st ) || st.st_size > 0x800000 || st.st_size < 0x8000 ) {
+            ::close( fd );
+            error = "Not a cartridge image, the size has to be 32kB to 8MB";
+            return false;
+        }
+        image_size = (size_t)st.st_size;
+
+        // The mapping stays valid after the descriptor is closed
+        void* view = mmap( nullptr, image_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+        ::close( fd );
+        image = view != MAP_FAILED ? (const uint8_t*)view : nullptr;
+#endif
+
+        if ( !image ) {
+            close();
+            error = "Unable to map the file";
+            return false;
+        }
+
+        if ( !parse( image, image_size, &header, &error ) ) {
+            const char* reason = error;
+            close();
+            error = reason;
+            return false;
+        }
+
+        return true;
+    }
+
+    void close( void )
+    {
+#ifdef _WIN32
+        if ( image ) {
+            UnmapViewOfFile( image );
+        }
+        if ( mapping ) {
+            CloseHandle( mapping );
+        }
+        if ( file != INVALID_HANDLE_VALUE ) {
+            CloseHandle( file );
+        }
+        file = INVALID_HANDLE_VALUE;
+        mapping = nullptr;
+#else
+        if ( image ) {
+            munmap( const_cast<uint8_t*>( image ), image_size );
+        }
+#endif
+        image = nullptr;
+        image_size = 0;
+        header = RomHeader{};
+        error = nullptr;
+    }
+
+    bool is_open( void ) const
+    {
+        return image != nullptr;
+    }
+
+    const uint8_t* data( void ) const
+    {
+        return image;
+    }
+
+    size_t size( void ) const
+    {
+        return image_size;
+    }
+
+    // The boot ROM never checks the global checksum and some releases get it wrong,
+    // so open doesn't either. Reads the whole image.
+    bool global_checksum_ok( void ) const
+    {
+        if ( !image ) {
+            return false;
+        }
+
+        uint16_t sum = 0;
+        for ( size_t i = 0; i < image_size; i++ ) {
+            sum += image[i];
+        }
+        sum -= image[0x14E] + image[0x14F];
+        return sum == header.global_checksum;
+    }
+
+    // A Cartridge over the mapping, with the MBC and RAM the header asks for. The RAM
+    // is allocated unless ram points at header.ram_size bytes to use instead. The
+    // caller deletes it, before closing the Rom.
+    Cartridge* cartridge( uint8_t* ram = nullptr ) const
+    {
+        return new Cartridge( image, header.rom_size, header.mbc, header.ram_size, ram );
+    }
+
+    // Decodes and checks the header of any image, mapped or not. Fails on what
+    // the hardware would refuse or this emulator can't run: a header checksum
+    // mismatch, an unknown size, an MBC that isn't implemented, or an image
+    // shorter than its header says.
+    static bool parse( const uint8_t* data, size_t size, RomHeader* header, const char** error )
+    {
+        static const uint32_t ram_sizes[] = { 0, 0x800, 0x2000, 0x8000, 0x20000, 0x10000 };
+
+        *header = RomHeader{};
+        if ( size < 0x8000 ) {
+            *error = "Not a cartridge image, shorter than 32kB";
+            return false;
+        }
+
+        uint8_t checksum = 0;
+        for ( int i = 0x134; i <= 0x14C; i++ ) {
+            checksum = checksum - data[i] - 1;
+        }
+        header->header_checksum = data[0x14D];
+        header->global_checksum = ( data[0x14E] << 8 ) | data[0x14F];
+        if ( checksum != header->header_checksum ) {
+            *error = "Header checksum mismatch";
+            return false;
+        }
+
+        // The CGB flag takes the last byte of the title
+        memcpy( header->title, &data[0x134], 16 );
+        header->cgb = data[0x143];
+        if ( header->cgb & 0x80 ) {
+            header->title[15] = 0;
+        }
+
+        header->type = data[0x147];
+        if ( !decode_type( header->type, header ) ) {
+            *error = "Unsupported cartridge type";
+            return false;
+        }
+
+        if ( data[0x148] > 8 ) {
+            *error = "Unknown ROM size";
+            return false;
+        }
+        header->rom_size = 0x8000 << data[0x148];
+        if ( size < header->rom_size ) {
+            *error = "Image shorter than the ROM size in its header";
+            return false;
+        }
+
+        if ( data[0x149] >= sizeof( ram_sizes ) / sizeof( ram_sizes[0] ) ) {
+            *error = "Unknown RAM size";
+            return false;
+        }
+        header->ram_size = ram_sizes[data[0x149]];
+
+        *error = nullptr;
+        return true;
+    }
+};
@@ -0,0 +1,145 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "memory.h"
+#include "registers.h"
+#include "cartridge.h"
+
+// Save states, one fixed-layout block written and read with a few memcpys:
+//
+//   SaveState     magic, version, sizes, CPU registers, cycle counters, the
+//                 cartridge's bank registers and clock, then the 64kB map
+//   RAM           ram_size bytes of cartridge RAM, none without a cartridge
+//
+// The page tables are not saved, they follow from the cartridge registers. Fields
+// are only ever appended to SaveState, and VERSION goes up with every change so an
+// old state is refused rather than misread. There is no PPU, APU, timer or IME yet,
+// their state goes into SaveState when they arrive.
+
+struct SaveState {
+    static const uint32_t MAGIC = 0x53534247; // "GBSS"
+    static const uint32_t VERSION = 1;
+
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size; // of the whole state, RAM included
+    uint32_t ram_size;
+
+    uint16_t AF, BC, DE, HL, SP, PC;
+    uint8_t cart; // a Cartridge was attached
+    uint8_t pad[3];
+    uint64_t cycles; // T-cycles since power on
+    int32_t overrun; // Emulator::run_cycles carry-over
+    uint32_t reserved;
+
+    CartState mbc;
+
+    uint8_t map[0x10000];
+};
+
+static_assert( offsetof( SaveState, map ) == 80, "SaveState layout" );
+
+// Bytes save_state writes for this cartridge, which may be null
+static size_t state_size( const Cartridge* cart )
+{
+    return sizeof( SaveState ) + ( cart ? cart->ram_size() : 0 );
+}
+
+static void save_state( void* out, Registers* r, const Memory* m, const Cartridge* cart, uint64_t cycles, int overrun )
+{
+    SaveState* s = (SaveState*)out;
+    uint32_t ram_size = cart ? (uint32_t)cart->ram_size() : 0;
+
+    r->sync_flags();
+
+    s->magic = SaveState::MAGIC;
+    s->version = SaveState::VERSION;
+    s->size = (uint32_t)( sizeof( SaveState ) + ram_size );
+    s->ram_size = ram_size;
+    s->AF = r->AF;
+    s->BC = r->BC;
+    s->DE = r->DE;
+    s->HL = r->HL;
+    s->SP = r->SP;
+    s->PC = r->PC;
+    s->cart = cart != nullptr;
+    memset( s->pad, 0, sizeof( s->pad ) );
+    s->cycles = cycles;
+    s->overrun = overrun;
+    s->reserved = 0;
+    s->mbc = CartState{};
+    if ( cart ) {
+        cart->save( &s->mbc );
+    }
+
+    memcpy( s->map, m->map, sizeof( s->map ) );
+    if ( ram_size ) {
+        memcpy( (uint8_t*)out + sizeof( SaveState ), cart->ram_data(), ram_size );
+    }
+}
+
+// Restores a state save_state wrote for the same kind of cartridge. Returns false,
+// changing nothing, when it is from another version or doesn't fit the cartridge.
+// With dirty set, only the 256-byte pages of map that differ are copied and get
+// their dirty[page] set, for cores that cache decoded code. Any change to cartridge
+// RAM marks all of 0xA000-0xBFFF, and so does another RAM bank, another bank at
+// 0x0000-0x3FFF all of it.
+static bool load_state( const void* in, size_t size, Registers* r, Memory* m, Cartridge* cart, uint64_t* cycles,
+                        int* overrun, bool* dirty = nullptr )
+{
+    const SaveState* s = (const SaveState*)in;
+    uint32_t ram_size = cart ? (uint32_t)cart->ram_size() : 0;
+
+    if ( size < sizeof( SaveState ) || s->magic != SaveState::MAGIC || s->version != SaveState::VERSION ||
+         s->size != size || s->ram_size != ram_size || s->cart != ( cart != nullptr ) ||
+         ( cart && s->mbc.type != (uint8_t)cart->type ) ) {
+        return false;
+    }
+
+    *r = Registers();
+    r->AF = s->AF;
+    r->BC = s->BC;
+    r->DE = s->DE;
+    r->HL = s->HL;
+    r->SP = s->SP;
+    r->PC = s->PC;
+    *overrun = s->overrun;
+    *cycles = s->cycles;
+
+    if ( dirty ) {
+        for ( int page = 0; page < 0x100; page++ ) {
+            dirty[page] = memcmp( &m->map[page << 8], &s->map[page << 8], 0x100 ) != 0;
+            if ( dirty[page] ) {
+                memcpy( &m->map[page << 8], &s->map[page << 8], 0x100 );
+            }
+        }
+    }
+    else {
+        memcpy( m->map, s->map, sizeof( m->map ) );
+    }
+
+    if ( cart ) {
+        const uint8_t* ram = (const uint8_t*)in + sizeof( SaveState );
+
+        // Code run from cartridge RAM shows up at 0xA000-0xBFFF. A cartridge without
+        // RAM has no ram_data() to compare or copy.
+        if ( ram_size ) {
+            if ( dirty && memcmp( cart->ram_data(), ram, ram_size ) ) {
+                memset( &dirty[0xA0], true, 0x20 );
+            }
+            memcpy( cart->ram_data(), ram, ram_size );
+        }
+        const uint8_t* low = m->host_page( 0x00 );
+        const uint8_t* banked = m->host_page( 0xA0 );
+        cart->load( m, &s->mbc );
+        if ( dirty && m->host_page( 0x00 ) != low ) {
+            memset( &dirty[0x00], true, 0x40 );
+        }
+        if ( dirty && m->host_page( 0xA0 ) != banked ) {
+            memset( &dirty[0xA0], true, 0x20 );
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <stdint.h>
+#include "memory.h"
+
+// The 160x144 picture the LCD would show for the current VRAM and LCD registers,
+// drawn in one go. There is no PPU yet, so this is what the front ends take as the
+// frame: background and window, no sprites, no mid-frame register changes.
+//
+// Each pixel is a shade from 0 (white) to 3 (black), after the BGP palette.
+
+static const int SCREEN_WIDTH = 160;
+static const int SCREEN_HEIGHT = 144;
+
+// Color number 0-3 of pixel x, y of the 256x256 tile map at map_base
+static int screen_map_pixel( const Memory* m, uint16_t map_base, bool signed_tiles, int x, int y )
+{
+    uint8_t index = m->map[map_base + ( y >> 3 ) * 32 + ( x >> 3 )];
+    uint16_t tile = signed_tiles ? (uint16_t)( 0x9000 + (int8_t)index * 16 ) : (uint16_t)( 0x8000 + index * 16 );
+    uint8_t lo = m->map[tile + ( y & 7 ) * 2];
+    uint8_t hi = m->map[tile + ( y & 7 ) * 2 + 1];
+    int bit = 7 - ( x & 7 );
+
+    return ( ( lo >> bit ) & 1 ) | ( ( ( hi >> bit ) & 1 ) << 1 );
+}
+
+// Fills out with SCREEN_WIDTH * SCREEN_HEIGHT shades, row by row
+static void render_screen( const Memory* m, uint8_t* out )
+{
+    uint8_t lcdc = m->map[0xFF40];
+    uint8_t scy = m->map[0xFF42];
+    uint8_t scx = m->map[0xFF43];
+    uint8_t bgp = m->map[0xFF47];
+    int wy = m->map[0xFF4A];
+    int wx = m->map[0xFF4B] - 7;
+
+    bool signed_tiles = !( lcdc & 0x10 );
+    uint16_t bg_map = ( lcdc & 0x08 ) ? 0x9C00 : 0x9800;
+    uint16_t win_map = ( lcdc & 0x40 ) ? 0x9C00 : 0x9800;
+    bool window = ( lcdc & 0x20 ) && wy < SCREEN_HEIGHT && wx < SCREEN_WIDTH;
+
+    for ( int y = 0; y < SCREEN_HEIGHT; y++ ) {
+        for ( int x = 0; x < SCREEN_WIDTH; x++ ) {
+            // LCD off and BG off, which hides the window too, are both white
+            if ( ( lcdc & 0x81 ) != 0x81 ) {
+                out[y * SCREEN_WIDTH + x] = 0;
+                continue;
+            }
+
+            int color;
+            if ( window && y >= wy && x >= wx ) {
+                color = screen_map_pixel( m, win_map, signed_tiles, x - wx, y - wy );
+            }
+            else {
+                color = screen_map_pixel( m, bg_map, signed_tiles, ( x + scx ) & 0xFF, ( y + scy ) & 0xFF );
+            }
+
+            out[y * SCREEN_WIDTH + x] = ( bgp >> ( color * 2 ) ) & 3;
+        }
+    }
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <chrono>
 
 
 enum class StepState {
@@ -7,3 +8,20 @@ enum class StepState {
     STEP,
 };
 
+// Wall time since construction, for the benchmarks and gbrun
+class Timer
+{
+private:
+    std::chrono::steady_clock::time_point start;
+
+public:
+    Timer( void )
+        : start( std::chrono::steady_clock::now() )
+    {
+    }
+
+    double seconds( void )
+    {
+        return std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+    }
+};
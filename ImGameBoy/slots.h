@@ -0,0 +1,86 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "memory.h"
+
+// Per-address debugger data that tells ROM banks apart: a slot for every byte of the
+// cartridge ROM, bank 5:4123 being slot 5 * 0x4000 + 0x0123, and after those one for
+// every address of the 64kB bus, for code anywhere else: the boot ROM, RAM, HRAM.
+// The slot of an address comes from the page table, under a watchpoint's overlay
+// too, so it is whatever bank is mapped there right now.
+
+struct CodeSlots {
+    static constexpr size_t NONE = ~(size_t)0; // a bank and address that can't meet
+
+    const uint8_t* rom;
+    size_t rom_size;
+    bool mbc1; // banks 20, 40 and 60 can be mapped at 0x0000-0x3FFF too
+
+    CodeSlots( void )
+        : rom( nullptr ), rom_size( 0 ), mbc1( false )
+    {
+    }
+
+    // The cartridge ROM at image, null for none
+    void reset( const uint8_t* image, size_t size, bool mbc1_rom = false )
+    {
+        rom = image;
+        rom_size = image ? size : 0;
+        mbc1 = mbc1_rom;
+    }
+
+    // Whether bank can be mapped at the ROM address address: bank 0 and the MBC1
+    // mode 1 banks below 0x4000, any other bank above
+    bool maps( int bank, uint16_t address ) const
+    {
+        if ( bank < 0 || address >= 0x8000 || (size_t)bank * 0x4000 >= rom_size ) {
+            return false;
+        }
+        if ( address < 0x4000 ) {
+            return bank == 0 || ( mbc1 && bank % 0x20 == 0 );
+        }
+        return bank != 0;
+    }
+
+    size_t count( void ) const
+    {
+        return rom_size + 0x10000;
+    }
+
+    size_t slot( const Memory* m, uint16_t address ) const
+    {
+        const uint8_t* host = m->host_page( address >> 8 );
+        if ( host && host >= rom && host < rom + rom_size ) {
+            return (size_t)( host - rom ) + ( address & 0xFF );
+        }
+        return rom_size + address;
+    }
+
+    // Slot of address in bank, which only matters for ROM addresses, -1 for the bus.
+    // NONE for a ROM address in a bank that is never mapped there.
+    size_t slot( int bank, uint16_t address ) const
+    {
+        if ( bank < 0 || address >= 0x8000 ) {
+            return rom_size + address;
+        }
+        if ( !maps( bank, address ) ) {
+            return NONE;
+        }
+        return (size_t)bank * 0x4000 + ( address & 0x3FFF );
+    }
+
+    // ROM bank of slot, -1 outside the cartridge ROM
+    int bank( size_t slot ) const
+    {
+        return slot < rom_size ? (int)( slot / 0x4000 ) : -1;
+    }
+
+    // Where slot's bank maps it, banks other than 0 at 0x4000-0x7FFF
+    uint16_t address( size_t slot ) const
+    {
+        if ( slot >= rom_size ) {
+            return (uint16_t)( slot - rom_size );
+        }
+        return (uint16_t)( slot < 0x4000 ? slot : 0x4000 | ( slot & 0x3FFF ) );
+    }
+};
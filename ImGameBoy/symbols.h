@@ -0,0 +1,219 @@
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Labels from an RGBDS .sym file, "BB:AAAA Name" a line and ';' comments. Every ROM
+// bank has its own array sorted by address and the rest of the bus one more, so a
+// lookup is a binary search in the array of the bank the address is in. Names go
+// the other way through a hash map, for goto.
+//
+// A bank argument is the ROM bank for 0x0000-0x7FFF, bank 0 under 0x4000, and is
+// ignored above. -1 for 0x4000-0x7FFF searches every bank at once, for records that
+// don't know theirs, and takes the closest label of any of them.
+
+struct SymbolRef {
+    uint16_t address;
+    uint32_t name; // index in Symbols::names
+};
+
+class Symbols
+{
+private:
+    std::vector<std::string> names;
+    std::vector<std::vector<SymbolRef>> banks; // 0x0000-0x7FFF by ROM bank
+    std::vector<SymbolRef> bus; // 0x8000-0xFFFF
+    std::vector<SymbolRef> any; // 0x4000-0x7FFF of every bank
+    std::unordered_map<std::string, uint32_t> by_name;
+    std::vector<int> name_bank; // bank each name was given, -1 on the bus
+    std::vector<uint16_t> name_address;
+
+    const std::vector<SymbolRef>* table( int bank, uint16_t address ) const
+    {
+        if ( address >= 0x8000 ) {
+            return &bus;
+        }
+        if ( address >= 0x4000 && bank < 0 ) {
+            return &any;
+        }
+        if ( address < 0x4000 ) {
+            bank = 0;
+        }
+        return (size_t)bank < banks.size() ? &banks[bank] : nullptr;
+    }
+
+    // Last label at or below address in its table, null for none. 0x0000-0x3FFF and
+    // 0x4000-0x7FFF are told apart, a label of bank 0 doesn't run on into bank 1.
+    const SymbolRef* below( int bank, uint16_t address ) const
+    {
+        const std::vector<SymbolRef>* t = table( bank, address );
+        if ( !t || t->empty() ) {
+            return nullptr;
+        }
+        auto it = std::upper_bound( t->begin(), t->end(), address,
+                                    []( uint16_t a, const SymbolRef& s ) { return a < s.address; } );
+        if ( it == t->begin() ) {
+            return nullptr;
+        }
+        --it;
+        if ( address < 0x8000 && ( it->address & 0x4000 ) != ( address & 0x4000 ) ) {
+            return nullptr;
+        }
+        return &*it;
+    }
+
+    static void sort( std::vector<SymbolRef>* t )
+    {
+        std::stable_sort( t->begin(), t->end(),
+                          []( const SymbolRef& a, const SymbolRef& b ) { return a.address < b.address; } );
+    }
+
+public:
+    uint32_t version; // goes up with every load, for what caches labels
+
+    Symbols( void )
+        : version( 0 )
+    {
+    }
+
+    void clear( void )
+    {
+        names.clear();
+        banks.clear();
+        bus.clear();
+        any.clear();
+        by_name.clear();
+        name_bank.clear();
+        name_address.clear();
+        version++;
+    }
+
+    // Replaces the labels with the ones in path, false when it can't be read. Lines
+    // that don't parse are skipped, the first of two labels at an address is shown.
+    bool load( const char* path )
+    {
+        clear();
+        FILE* hFile = fopen( path, "r" );
+        if ( !hFile ) {
+            return false;
+        }
+
+        char line[512];
+        while ( fgets( line, sizeof( line ), hFile ) ) {
+            char* comment = strchr( line, ';' );
+            if ( comment ) {
+                *comment = 0;
+            }
+
+            char* end;
+            unsigned long bank = strtoul( line, &end, 16 );
+            if ( end == line || *end != ':' ) {
+                continue;
+            }
+            char* at = end + 1;
+            unsigned long address = strtoul( at, &end, 16 );
+            if ( end == at || address > 0xFFFF || ( *end != ' ' && *end != '\t' ) ) {
+                continue;
+            }
+            char* name = end + strspn( end, " \t" );
+            name[strcspn( name, " \t\r\n" )] = 0;
+            if ( !*name ) {
+                continue;
+            }
+
+            SymbolRef ref = { (uint16_t)address, (uint32_t)names.size() };
+            names.push_back( name );
+            name_bank.push_back( address >= 0x8000 ? -1 : address < 0x4000 ? 0 : (int)bank );
+            name_address.push_back( (uint16_t)address );
+            by_name.emplace( name, ref.name );
+            if ( address >= 0x8000 ) {
+                bus.push_back( ref );
+            } else {
+                int b = address < 0x4000 ? 0 : (int)bank;
+                if ( banks.size() <= (size_t)b ) {
+                    banks.resize( b + 1 );
+                }
+                banks[b].push_back( ref );
+                if ( address >= 0x4000 ) {
+                    any.push_back( ref );
+                }
+            }
+        }
+        fclose( hFile );
+
+        for ( std::vector<SymbolRef>& t : banks ) {
+            sort( &t );
+        }
+        sort( &bus );
+        sort( &any );
+        return true;
+    }
+
+    size_t count( void ) const
+    {
+        return names.size();
+    }
+
+    // Label exactly at address, null for none
+    const char* at( int bank, uint16_t address ) const
+    {
+        const SymbolRef* s = below( bank, address );
+        if ( !s || s->address != address ) {
+            return nullptr;
+        }
+        // Several labels at one address, the sort kept the first of the file first
+        const std::vector<SymbolRef>* t = table( bank, address );
+        while ( s != &t->front() && ( s - 1 )->address == address ) {
+            s--;
+        }
+        return names[s->name].c_str();
+    }
+
+    // address as "Label" or "Label+0x12" into dst, returns the length written, 0 when
+    // no label comes before it
+    int format( char* dst, size_t size, int bank, uint16_t address ) const
+    {
+        const SymbolRef* s = below( bank, address );
+        if ( !s ) {
+            return 0;
+        }
+        const char* name = at( bank, s->address );
+        int n = address == s->address ? snprintf( dst, size, "%s", name )
+                                      : snprintf( dst, size, "%s+0x%X", name, address - s->address );
+        return n < 0 ? 0 : n;
+    }
+
+    // Where name is, as "Label", "Label+n" or "Label-n" with n in decimal or 0x hex.
+    // bank is -1 on the bus. False for names that aren't loaded.
+    bool find( const char* text, int* bank, uint16_t* address ) const
+    {
+        std::string name( text );
+        long offset = 0;
+        size_t sign = name.find_first_of( "+-" );
+        if ( sign != std::string::npos ) {
+            char* end;
+            offset = strtol( name.c_str() + sign + 1, &end, 0 );
+            if ( *end ) {
+                return false;
+            }
+            if ( name[sign] == '-' ) {
+                offset = -offset;
+            }
+            name.erase( sign );
+        }
+        name.erase( name.find_last_not_of( " \t" ) + 1 );
+
+        auto it = by_name.find( name );
+        if ( it == by_name.end() ) {
+            return false;
+        }
+        *bank = name_bank[it->second];
+        *address = (uint16_t)( name_address[it->second] + offset );
+        return true;
+    }
+};
@@ -0,0 +1,389 @@
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "memory.h"
+#include "registers.h"
+#include "symbols.h"
+
+// Instruction traces of long sessions. The emulation thread fills a fixed-size
+// TraceRecord per instruction into a single producer, single consumer ring and
+// carries on; a writer thread drains the ring, delta-encodes each record against
+// the one before it and streams them to disk. Only a full ring makes the emulation
+// wait, which counts as a stall.
+//
+// File: "GBTRACE1", then one record after another, each
+//
+//     mask0     bit n: register n of A F B C D E H L changed, its new value follows
+//     mask1     bit 0: SP follows
+//               bit 1: PC follows, otherwise its change from the last PC as int8
+//               bit 2: the 4 bytes at PC follow, otherwise PC moved on by d = 0-3,
+//                      the first 4 - d bytes are the last ones of the record before
+//                      and the d new ones follow
+//     ...       the fields in that order
+//     varint    cycles since the record before, 7 bits a byte, low first
+//
+// The boot ROM comes to under 7 bytes an instruction. trace_to_text() turns a
+// trace into the log format of gameboy-doctor.
+
+struct TraceRecord {
+    uint64_t cycle; // T-cycles since load when the instruction started
+    uint16_t pc;
+    uint16_t sp;
+    uint8_t regs[8]; // A F B C D E H L before the instruction
+    uint8_t mem[4]; // the bytes at PC
+};
+
+static const char TRACE_MAGIC[8] = { 'G', 'B', 'T', 'R', 'A', 'C', 'E', '1' };
+static const int TRACE_MAX_ENCODED = 2 + 8 + 2 + 2 + 4 + 10;
+
+// cur as a change of prev, returns the bytes written to out
+static int trace_encode( const TraceRecord& prev, const TraceRecord& cur, uint8_t* out )
+{
+    uint8_t* p = out + 2;
+    uint8_t mask0 = 0, mask1 = 0;
+
+    for ( int i = 0; i < 8; i++ ) {
+        if ( cur.regs[i] != prev.regs[i] ) {
+            mask0 |= 1 << i;
+            *p++ = cur.regs[i];
+        }
+    }
+
+    if ( cur.sp != prev.sp ) {
+        mask1 |= 1;
+        *p++ = (uint8_t)cur.sp;
+        *p++ = (uint8_t)( cur.sp >> 8 );
+    }
+
+    int delta = (int16_t)( cur.pc - prev.pc );
+    if ( delta < -128 || delta > 127 ) {
+        mask1 |= 2;
+        *p++ = (uint8_t)cur.pc;
+        *p++ = (uint8_t)( cur.pc >> 8 );
+    } else {
+        *p++ = (uint8_t)(int8_t)delta;
+    }
+
+    if ( delta >= 0 && delta <= 3 && !memcmp( prev.mem + delta, cur.mem, 4 - delta ) ) {
+        memcpy( p, cur.mem + 4 - delta, delta );
+        p += delta;
+    } else {
+        mask1 |= 4;
+        memcpy( p, cur.mem, 4 );
+        p += 4;
+    }
+
+    uint64_t cycles = cur.cycle - prev.cycle;
+    do {
+        *p++ = (uint8_t)( ( cycles & 0x7F ) | ( cycles > 0x7F ? 0x80 : 0 ) );
+        cycles >>= 7;
+    } while ( cycles );
+
+    out[0] = mask0;
+    out[1] = mask1;
+    return (int)( p - out );
+}
+
+// Applies the record at in to rec, which holds the one before. Returns the bytes
+// read, 0 when the record runs past end.
+static int trace_decode( const uint8_t* in, const uint8_t* end, TraceRecord* rec )
+{
+    const uint8_t* p = in;
+    if ( end - p < 2 ) {
+        return 0;
+    }
+    uint8_t mask0 = *p++, mask1 = *p++;
+    TraceRecord cur = *rec;
+
+    // Every field but the varint has its length in the masks
+    int fixed = ( mask1 & 1 ? 2 : 0 ) + ( mask1 & 2 ? 2 : 1 );
+    for ( int i = 0; i < 8; i++ ) {
+        fixed += ( mask0 >> i ) & 1;
+    }
+    if ( end - p < fixed ) {
+        return 0;
+    }
+
+    for ( int i = 0; i < 8; i++ ) {
+        if ( mask0 & ( 1 << i ) ) {
+            cur.regs[i] = *p++;
+        }
+    }
+    if ( mask1 & 1 ) {
+        cur.sp = (uint16_t)( p[0] | ( p[1] << 8 ) );
+        p += 2;
+    }
+    int delta;
+    if ( mask1 & 2 ) {
+        cur.pc = (uint16_t)( p[0] | ( p[1] << 8 ) );
+        delta = 0;
+        p += 2;
+    } else {
+        delta = (int8_t)*p++;
+        cur.pc = (uint16_t)( cur.pc + delta );
+    }
+
+    int bytes = mask1 & 4 ? 4 : delta;
+    if ( !( mask1 & 4 ) && ( delta < 0 || delta > 3 ) ) {
+        return 0; // not something trace_encode writes
+    }
+    if ( end - p < bytes ) {
+        return 0;
+    }
+    if ( mask1 & 4 ) {
+        memcpy( cur.mem, p, 4 );
+    } else {
+        memmove( cur.mem, cur.mem + delta, 4 - delta );
+        memcpy( cur.mem + 4 - delta, p, delta );
+    }
+    p += bytes;
+
+    uint64_t cycles = 0;
+    for ( int shift = 0;; shift += 7 ) {
+        if ( p == end || shift > 63 ) {
+            return 0;
+        }
+        uint8_t byte = *p++;
+        cycles |= (uint64_t)( byte & 0x7F ) << shift;
+        if ( !( byte & 0x80 ) ) {
+            break;
+        }
+    }
+    cur.cycle += cycles;
+
+    *rec = cur;
+    return (int)( p - in );
+}
+
+class TraceWriter
+{
+private:
+    std::vector<TraceRecord> ring;
+    size_t mask;
+    alignas( 64 ) std::atomic<size_t> head; // next record the emulation fills
+    size_t tail_seen; // tail as the emulation last read it
+    alignas( 64 ) std::atomic<size_t> tail; // next record the writer drains
+    std::atomic<bool> closing;
+    std::thread writer;
+    FILE* hFile;
+    bool failed;
+
+    void drain( void )
+    {
+        std::vector<uint8_t> out( 1 << 16 );
+        size_t used = 0;
+        TraceRecord prev;
+        memset( &prev, 0, sizeof( prev ) );
+
+        for ( ;; ) {
+            bool last = closing.load( std::memory_order_acquire );
+            size_t t = tail.load( std::memory_order_relaxed );
+            size_t h = head.load( std::memory_order_acquire );
+
+            if ( t == h ) {
+                if ( last ) {
+                    break;
+                }
+                std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+                continue;
+            }
+
+            for ( ; t != h; t++ ) {
+                const TraceRecord& cur = ring[t & mask];
+                used += trace_encode( prev, cur, &out[used] );
+                prev = cur;
+                if ( used > out.size() - TRACE_MAX_ENCODED ) {
+                    failed |= fwrite( out.data(), 1, used, hFile ) != used;
+                    bytes += used;
+                    used = 0;
+                }
+                // Hands back the slots a bit at a time, the emulation may be waiting on them
+                if ( ( t & 0xFFF ) == 0xFFF ) {
+                    tail.store( t + 1, std::memory_order_release );
+                }
+            }
+            tail.store( t, std::memory_order_release );
+        }
+
+        failed |= fwrite( out.data(), 1, used, hFile ) != used;
+        bytes += used;
+    }
+
+public:
+    uint64_t records; // since open
+    uint64_t stalls; // records that waited for room in the ring
+    uint64_t bytes; // written to the file, without the magic
+
+    // capacity is in records and a power of two
+    explicit TraceWriter( size_t capacity = 1 << 18 )
+        : ring( capacity ), mask( capacity - 1 ), head( 0 ), tail_seen( 0 ), tail( 0 ), closing( false ),
+          hFile( nullptr ), failed( false ), records( 0 ), stalls( 0 ), bytes( 0 )
+    {
+    }
+
+    ~TraceWriter( void )
+    {
+        close();
+    }
+
+    TraceWriter( const TraceWriter& ) = delete;
+    TraceWriter& operator=( const TraceWriter& ) = delete;
+
+    // Starts a trace at path, false when it can't be created
+    bool open( const char* path )
+    {
+        close();
+        hFile = fopen( path, "wb" );
+        if ( !hFile ) {
+            return false;
+        }
+
+        failed = fwrite( TRACE_MAGIC, 1, sizeof( TRACE_MAGIC ), hFile ) != sizeof( TRACE_MAGIC );
+        head.store( 0 );
+        tail.store( 0 );
+        tail_seen = 0;
+        closing.store( false );
+        records = stalls = bytes = 0;
+        writer = std::thread( [this]() { drain(); } );
+        return true;
+    }
+
+    bool is_open( void ) const
+    {
+        return hFile != nullptr;
+    }
+
+    // The instruction about to run at r->PC, with F synced
+    void record( const Registers* r, const Memory* m, uint64_t cycle )
+    {
+        size_t h = head.load( std::memory_order_relaxed );
+        if ( h - tail_seen == ring.size() ) {
+            tail_seen = tail.load( std::memory_order_acquire );
+            while ( h - tail_seen == ring.size() ) {
+                stalls++;
+                std::this_thread::yield();
+                tail_seen = tail.load( std::memory_order_acquire );
+            }
+        }
+
+        TraceRecord& rec = ring[h & mask];
+        rec.cycle = cycle;
+        rec.pc = r->PC;
+        rec.sp = r->SP;
+        rec.regs[0] = r->A;
+        rec.regs[1] = r->F;
+        rec.regs[2] = r->B;
+        rec.regs[3] = r->C;
+        rec.regs[4] = r->D;
+        rec.regs[5] = r->E;
+        rec.regs[6] = r->H;
+        rec.regs[7] = r->L;
+        for ( int i = 0; i < 4; i++ ) {
+            rec.mem[i] = m->peek( (uint16_t)( r->PC + i ) );
+        }
+
+        head.store( h + 1, std::memory_order_release );
+        records++;
+    }
+
+    // Writes out what is left and closes the file, false when any write failed
+    bool close( void )
+    {
+        if ( !hFile ) {
+            return true;
+        }
+
+        closing.store( true, std::memory_order_release );
+        writer.join();
+        bool ok = fclose( hFile ) == 0 && !failed;
+        hFile = nullptr;
+        return ok;
+    }
+};
+
+// Reads the records of a trace one at a time
+class TraceReader
+{
+private:
+    FILE* hFile;
+    std::vector<uint8_t> buffer;
+    size_t pos, end;
+    TraceRecord rec;
+
+public:
+    TraceReader( void )
+        : hFile( nullptr ), buffer( 1 << 16 ), pos( 0 ), end( 0 )
+    {
+        memset( &rec, 0, sizeof( rec ) );
+    }
+
+    ~TraceReader( void )
+    {
+        if ( hFile ) {
+            fclose( hFile );
+        }
+    }
+
+    TraceReader( const TraceReader& ) = delete;
+    TraceReader& operator=( const TraceReader& ) = delete;
+
+    // False when path can't be read or isn't a trace
+    bool open( const char* path )
+    {
+        hFile = fopen( path, "rb" );
+        char magic[sizeof( TRACE_MAGIC )];
+        return hFile && fread( magic, 1, sizeof( magic ), hFile ) == sizeof( magic ) &&
+               !memcmp( magic, TRACE_MAGIC, sizeof( magic ) );
+    }
+
+    // The next record, false at the end of the trace or on a truncated record
+    bool next( TraceRecord* out )
+    {
+        if ( end - pos < (size_t)TRACE_MAX_ENCODED ) {
+            memmove( buffer.data(), &buffer[pos], end - pos );
+            end -= pos;
+            pos = 0;
+            end += fread( &buffer[end], 1, buffer.size() - end, hFile );
+        }
+
+        int used = trace_decode( &buffer[pos], &buffer[end], &rec );
+        if ( !used ) {
+            return false;
+        }
+        pos += used;
+        *out = rec;
+        return true;
+    }
+};
+
+// Writes the trace at path to out in the gameboy-doctor format, a line per
+// instruction, and with symbols the label of PC after it as "  ; Label+0x12". A
+// record doesn't know its ROM bank, 0x4000-0x7FFF take the closest label of any.
+// Returns the records converted, -1 when path isn't a trace.
+inline int64_t trace_to_text( const char* path, FILE* out, const Symbols* symbols = nullptr )
+{
+    TraceReader reader;
+    if ( !reader.open( path ) ) {
+        return -1;
+    }
+
+    TraceRecord rec;
+    int64_t count = 0;
+    while ( reader.next( &rec ) ) {
+        fprintf( out, "A:%02X F:%02X B:%02X C:%02X D:%02X E:%02X H:%02X L:%02X SP:%04X PC:%04X PCMEM:%02X,%02X,%02X,%02X",
+                 rec.regs[0], rec.regs[1], rec.regs[2], rec.regs[3], rec.regs[4], rec.regs[5], rec.regs[6],
+                 rec.regs[7], rec.sp, rec.pc, rec.mem[0], rec.mem[1], rec.mem[2], rec.mem[3] );
+        char label[128];
+        if ( symbols && symbols->format( label, sizeof( label ), -1, rec.pc ) ) {
+            fprintf( out, "  ; %s", label );
+        }
+        fputc( '\n', out );
+        count++;
+    }
+    return count;
+}
@@ -0,0 +1,244 @@
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include "memory.h"
+
+// Read, write and value change watchpoints on address ranges, MMIO included. Only
+// the pages a range touches are taken over, through Memory's overlay: their table
+// entries are kept here and the page points at watch_read/watch_write, which check
+// the ranges and pass the access on to the entry they replaced. Every other page
+// keeps its host pointer, and with no range set Memory has no overlay at all.
+//
+// An access in a range records a WatchHit. The handlers don't know the PC, Emulator
+// fills it in and stops once the instruction is done. Echo RAM counts as the work
+// RAM it mirrors, instruction fetches are not reads.
+
+enum WatchKind : uint8_t {
+    WATCH_READ = 1,
+    WATCH_WRITE = 2,
+    WATCH_CHANGE = 4, // a write that left the byte different
+};
+
+struct Watchpoint {
+    uint16_t first;
+    uint16_t last; // inclusive
+    uint8_t kinds; // WatchKind bits
+};
+
+struct WatchHit {
+    uint16_t pc; // of the instruction that made the access
+    uint16_t address;
+    uint8_t kind; // one WatchKind
+    uint8_t before; // the byte before a write, the byte read for a read
+    uint8_t after;
+};
+
+class Watchpoints : public BusOverlay
+{
+private:
+    std::vector<Watchpoint> points;
+
+    // What the watched pages pointed at before, as the MBC keeps changing it
+    uint8_t* under_read[0x100];
+    uint8_t* under_write[0x100];
+    BusRead under_read_handler[0x100];
+    BusWrite under_write_handler[0x100];
+    uint8_t taken[0x100]; // WATCH_READ for the read entry, WATCH_WRITE for the write one
+    uint8_t wanted[0x100]; // what the ranges need taken
+
+    // Kinds any range watches in page, echo RAM pages as work RAM ones too
+    uint8_t kinds_in( int page ) const
+    {
+        uint8_t kinds = 0;
+        for ( const Watchpoint& w : points ) {
+            for ( int p = page; ; p -= 0x20 ) {
+                if ( w.first <= ( p << 8 | 0xFF ) && w.last >= ( p << 8 ) ) {
+                    kinds |= w.kinds;
+                }
+                if ( p < 0xE0 || p >= 0xFE ) {
+                    break;
+                }
+            }
+        }
+        return kinds;
+    }
+
+    void check( uint16_t address, uint8_t kind, uint8_t before, uint8_t after )
+    {
+        if ( pending ) {
+            return;
+        }
+
+        uint16_t mirror = Memory::canonical( address );
+        for ( const Watchpoint& w : points ) {
+            bool inside = ( address >= w.first && address <= w.last ) || ( mirror >= w.first && mirror <= w.last );
+            if ( !inside ) {
+                continue;
+            }
+            uint8_t k = kind & w.kinds;
+            if ( kind == WATCH_WRITE && ( w.kinds & WATCH_CHANGE ) && before != after ) {
+                k |= WATCH_CHANGE;
+            }
+            if ( k ) {
+                hit.address = address;
+                hit.kind = ( k & WATCH_CHANGE ) ? WATCH_CHANGE : k;
+                hit.before = before;
+                hit.after = after;
+                pending = true;
+                hits++;
+                return;
+            }
+        }
+    }
+
+    static uint8_t watch_read( Memory* m, uint16_t address )
+    {
+        Watchpoints* w = static_cast<Watchpoints*>( m->overlay );
+        int page = address >> 8;
+        uint8_t value = w->under_read[page] ? w->under_read[page][address & 0xFF]
+                                            : w->under_read_handler[page]( m, address );
+        w->check( address, WATCH_READ, value, value );
+        return value;
+    }
+
+    static void watch_write( Memory* m, uint16_t address, uint8_t value )
+    {
+        Watchpoints* w = static_cast<Watchpoints*>( m->overlay );
+        int page = address >> 8;
+        uint8_t before = m->peek( address );
+        if ( w->under_write[page] ) {
+            w->under_write[page][address & 0xFF] = value;
+        }
+        else {
+            // May switch banks and remap, w's entries are current again afterwards
+            w->under_write_handler[page]( m, address, value );
+        }
+        w->check( address, WATCH_WRITE, before, m->peek( address ) );
+    }
+
+    // Points m back at what the overlay took over and forgets it
+    void release( Memory* m )
+    {
+        for ( int page = 0; page < 0x100; page++ ) {
+            if ( taken[page] & WATCH_READ ) {
+                m->read_page[page] = under_read[page];
+                m->read_handler[page] = under_read_handler[page];
+            }
+            if ( taken[page] & WATCH_WRITE ) {
+                m->write_page[page] = under_write[page];
+                m->write_handler[page] = under_write_handler[page];
+            }
+            taken[page] = 0;
+        }
+    }
+
+    // Takes m over when there is something to watch, then brings the pages up to date
+    void update( Memory* m )
+    {
+        if ( points.empty() ) {
+            if ( m->overlay == this ) {
+                release( m );
+                m->overlay = nullptr;
+                m->flush_fetch();
+            }
+            return;
+        }
+
+        for ( int page = 0; page < 0x100; page++ ) {
+            uint8_t kinds = kinds_in( page );
+            wanted[page] = kinds & WATCH_READ;
+            if ( kinds & ( WATCH_WRITE | WATCH_CHANGE ) ) {
+                wanted[page] |= WATCH_WRITE;
+            }
+        }
+        m->overlay = this;
+        m->flush_fetch();
+    }
+
+public:
+    bool pending; // an access hit a range since Emulator last looked
+    WatchHit hit; // the last one
+    uint64_t hits;
+
+    Watchpoints( void )
+        : under_read{}, under_write{}, under_read_handler{}, under_write_handler{}, taken{}, wanted{}, pending( false ), hit{}, hits( 0 )
+    {
+    }
+
+    // Whether any range is set
+    bool armed( void ) const
+    {
+        return !points.empty();
+    }
+
+    const std::vector<Watchpoint>& list( void ) const
+    {
+        return points;
+    }
+
+    void add( Memory* m, uint16_t first, uint16_t last, uint8_t kinds )
+    {
+        if ( first > last || !kinds ) {
+            return;
+        }
+        points.push_back( { first, last, kinds } );
+        update( m );
+    }
+
+    void remove( Memory* m, size_t index )
+    {
+        if ( index < points.size() ) {
+            points.erase( points.begin() + index );
+            update( m );
+        }
+    }
+
+    void clear( Memory* m )
+    {
+        points.clear();
+        update( m );
+    }
+
+    // Keeps what changed in m's table since the last call as the entries under the
+    // overlay, and points the pages the ranges need at the handlers. A read watch
+    // takes the read entry, a write or change watch the write one.
+    void remap( Memory* m ) override
+    {
+        for ( int page = 0; page < 0x100; page++ ) {
+            if ( !( taken[page] & WATCH_READ ) || m->read_page[page] || m->read_handler[page] != watch_read ) {
+                under_read[page] = m->read_page[page];
+                under_read_handler[page] = m->read_handler[page];
+                taken[page] &= ~WATCH_READ;
+            }
+            if ( !( taken[page] & WATCH_WRITE ) || m->write_page[page] || m->write_handler[page] != watch_write ) {
+                under_write[page] = m->write_page[page];
+                under_write_handler[page] = m->write_handler[page];
+                taken[page] &= ~WATCH_WRITE;
+            }
+
+            uint8_t want = wanted[page];
+            if ( want & WATCH_READ ) {
+                m->read_page[page] = nullptr;
+                m->read_handler[page] = watch_read;
+            }
+            else {
+                m->read_page[page] = under_read[page];
+                m->read_handler[page] = under_read_handler[page];
+            }
+            if ( want & WATCH_WRITE ) {
+                m->write_page[page] = nullptr;
+                m->write_handler[page] = watch_write;
+            }
+            else {
+                m->write_page[page] = under_write[page];
+                m->write_handler[page] = under_write_handler[page];
+            }
+            taken[page] = want;
+        }
+    }
+
+    uint8_t* read_host( int page ) const override
+    {
+        return ( taken[page] & WATCH_READ ) ? under_read[page] : nullptr;
+    }
+};